@@ -41,6 +41,7 @@ OpenCLBackend::OpenCLBackend(OpenCLBackend&& other) noexcept
     , core_(std::move(other.core_))  // ✅ MULTI-GPU: Move core
     , memory_manager_(std::move(other.memory_manager_))
     , svm_capabilities_(std::move(other.svm_capabilities_))
+    , queue_pool_(std::move(other.queue_pool_))
     , context_(other.context_)
     , device_(other.device_)
     , queue_(other.queue_) {
@@ -64,6 +65,7 @@ OpenCLBackend& OpenCLBackend::operator=(OpenCLBackend&& other) noexcept {
         core_ = std::move(other.core_);  // ✅ MULTI-GPU: Move core
         memory_manager_ = std::move(other.memory_manager_);
         svm_capabilities_ = std::move(other.svm_capabilities_);
+        queue_pool_ = std::move(other.queue_pool_);
         context_ = other.context_;
         device_ = other.device_;
         queue_ = other.queue_;
@@ -183,6 +185,9 @@ void OpenCLBackend::Cleanup() {
     svm_capabilities_.reset();
     memory_manager_.reset();
 
+    // Очереди пула созданы бэкендом на контексте — до освобождения контекста
+    queue_pool_.reset();
+
     if (owns_resources_) {
         // ═══════════════════════════════════════════════════════════════════
         // OWNING MODE: Освобождаем ресурсы
@@ -440,8 +445,34 @@ const SVMCapabilities& OpenCLBackend::GetSVMCapabilities() const {
 }
 
 void OpenCLBackend::InitializeCommandQueuePool(size_t num_queues) {
-    (void)num_queues;
-    // TODO: реализовать если есть CommandQueuePool
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!initialized_ || !context_ || !device_) {
+        throw std::runtime_error("OpenCLBackend::InitializeCommandQueuePool: backend not initialized");
+    }
+
+    // Новый пул вместо CommandQueuePool::Initialize повторно: старые очереди
+    // освобождает деструктор прежнего пула
+    auto pool = std::make_unique<CommandQueuePool>();
+    if (!pool->Initialize(context_, device_, num_queues)) {
+        throw std::runtime_error("OpenCLBackend::InitializeCommandQueuePool: no queues created on device " +
+                                 std::to_string(device_index_));
+    }
+    queue_pool_ = std::move(pool);
+
+    DRVGPU_LOG_INFO("OpenCLBackend", "Command queue pool: " +
+                    std::to_string(queue_pool_->GetQueueCount()) + " queue(s) on device " +
+                    std::to_string(device_index_));
+}
+
+CommandQueuePool* OpenCLBackend::GetCommandQueuePool() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_pool_.get();
+}
+
+size_t OpenCLBackend::GetQueueCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_pool_ ? queue_pool_->GetQueueCount() : 1;
 }
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -206,9 +206,26 @@ public:
     /**
      * @brief Инициализировать CommandQueuePool
      * @param num_queues Количество очередей (0 = auto)
+     *
+     * Дополнительные очереди на контексте устройства (queue_count из
+     * configGPU.json); основная очередь GetNativeQueue() не меняется.
+     * Повторный вызов пересоздаёт пул.
+     *
+     * @throws std::runtime_error если бэкенд не инициализирован или
+     *         не создано ни одной очереди
      */
     void InitializeCommandQueuePool(size_t num_queues = 0);
 
+    /**
+     * @brief Пул очередей (nullptr — не создавался)
+     */
+    drv_gpu_lib::CommandQueuePool* GetCommandQueuePool() const;
+
+    /**
+     * @brief Число очередей устройства: размер пула или 1 (основная)
+     */
+    size_t GetQueueCount() const;
+
 protected:
     // ═══════════════════════════════════════════════════════════════
     // ✅ Protected члены для доступа из OpenCLBackendExternal
@@ -240,6 +257,7 @@ protected:
     // Интеграция с вашим OpenCL кодом
     std::unique_ptr<drv_gpu_lib::MemoryManager> memory_manager_;
     std::unique_ptr<drv_gpu_lib::SVMCapabilities> svm_capabilities_;
+    std::unique_ptr<drv_gpu_lib::CommandQueuePool> queue_pool_;
 
     // OpenCL objects (кэшируем для быстрого доступа)
     cl_context context_;
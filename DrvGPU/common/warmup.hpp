@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * @file warmup.hpp
+ * @brief Прогрев модулей при старте (планы FFT, kernels, пулы, пробный кадр)
+ *
+ * Первый кадр через модуль платит за bake планов clFFT, JIT kernels и
+ * первое выделение буферов. Warmup переносит эти затраты на старт:
+ * каждый модуль выполняет их заранее, задачи прогрева разных модулей
+ * и устройств идут параллельно (RunWarmupTasks).
+ *
+ * @code
+ * WarmupConfig config;
+ * config.batch_sizes = { 64, 17 };            // ожидаемые размеры пакетов
+ *
+ * auto results = manager.WarmupAll(config);   // все модули всех GPU
+ * std::cout << FormatWarmupResults(results);
+ * @endcode
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-12
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+/**
+ * @struct WarmupConfig
+ * @brief Что прогревать
+ */
+struct WarmupConfig {
+    /// Дополнительные размеры пакета для планов (размеры пакета и хвоста
+    /// из собственной конфигурации модуль добавляет сам)
+    std::vector<size_t> batch_sizes;
+
+    bool allocate_pools  = true;   ///< Выделить рабочие буферы под наибольший пакет
+    bool run_dummy_frame = true;   ///< Прогнать кадр из нулей (JIT, первый запуск kernels)
+    bool parallel        = true;   ///< Задачи прогрева — на отдельных потоках
+};
+
+/**
+ * @struct WarmupResult
+ * @brief Итог прогрева одного модуля
+ */
+struct WarmupResult {
+    std::string module;             ///< Имя модуля
+    int         device_index = -1;  ///< Устройство (-1 — неизвестно)
+    bool        success      = false;
+    double      warmup_ms    = 0.0;
+    std::string error;              ///< Пусто при успехе
+};
+
+/**
+ * @struct WarmupTask
+ * @brief Прогрев одного модуля (для RunWarmupTasks)
+ *
+ * Модули вне ModuleRegistry (AntennaFFTProcMax, SpectrumMaximaFinder)
+ * добавляются в общий параллельный прогрев как задачи:
+ * @code
+ * tasks.push_back({ "AntennaFFT", 0, [&] { fft.Warmup(config); } });
+ * @endcode
+ */
+struct WarmupTask {
+    std::string           module;
+    int                   device_index = -1;
+    std::function<void()> run;
+};
+
+/**
+ * @brief Выполнить задачи прогрева
+ *
+ * Исключение задачи не прерывает остальные: оно попадает в WarmupResult.
+ * Порядок результатов = порядок задач.
+ *
+ * @param parallel false — последовательно на вызывающем потоке
+ */
+inline std::vector<WarmupResult> RunWarmupTasks(const std::vector<WarmupTask>& tasks,
+                                                bool parallel = true) {
+    std::vector<WarmupResult> results(tasks.size());
+
+    auto run_one = [&tasks, &results](size_t i) {
+        WarmupResult& r = results[i];
+        r.module = tasks[i].module;
+        r.device_index = tasks[i].device_index;
+
+        auto start = std::chrono::steady_clock::now();
+        try {
+            if (tasks[i].run) {
+                tasks[i].run();
+            }
+            r.success = true;
+        } catch (const std::exception& e) {
+            r.error = e.what();
+        } catch (...) {
+            r.error = "unknown exception";
+        }
+        r.warmup_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+    };
+
+    if (!parallel || tasks.size() <= 1) {
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            run_one(i);
+        }
+        return results;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        workers.emplace_back(run_one, i);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return results;
+}
+
+/**
+ * @brief Таблица результатов прогрева
+ */
+inline std::string FormatWarmupResults(const std::vector<WarmupResult>& results) {
+    std::ostringstream oss;
+    oss << "Warmup (" << results.size() << " module(s)):\n";
+    for (const auto& r : results) {
+        oss << "  GPU " << r.device_index << "  " << std::left << std::setw(24) << r.module
+            << std::right << std::fixed << std::setprecision(1) << std::setw(9)
+            << r.warmup_ms << " ms  " << (r.success ? "OK" : "FAILED: " + r.error) << "\n";
+    }
+    return oss.str();
+}
+
+} // namespace drv_gpu_lib
@@ -56,6 +56,8 @@ namespace drv_gpu_lib {
  * - is_active: инициализировать ли этот GPU при старте
  * - is_db: вывод в БД (будущая возможность)
  * - max_memory_percent: макс. использование памяти GPU (% от общей)
+ * - queue_count: число command queues устройства
+ * - memory_strategy: стратегия памяти по умолчанию (для MemoryStrategy::AUTO)
  * - log_level: минимальный уровень лога ("DEBUG", "INFO", "WARNING", "ERROR")
  */
 struct GPUConfigEntry {
@@ -97,10 +99,20 @@ struct GPUConfigEntry {
     // ========================================================================
 
     /// Максимальная доля памяти GPU (процент от общей глобальной памяти)
-    /// Используется BatchManager для расчёта размеров пакетов
+    /// Бюджет MemoryManager: выделение сверх него отклоняется (с освобождением
+    /// по колбэкам и повтором), BatchManager считает пакеты от остатка бюджета
     /// По умолчанию: 70% (с запасом для ОС и других процессов)
     size_t max_memory_percent = 70;
 
+    /// Число command queues устройства (1 — только основная очередь)
+    /// При > 1 бэкенд создаёт CommandQueuePool из queue_count очередей
+    size_t queue_count = 1;
+
+    /// Стратегия памяти для буферов MemoryStrategy::AUTO
+    /// Варианты: "AUTO" (эвристика устройства), "REGULAR_BUFFER",
+    /// "SVM_COARSE_GRAIN", "SVM_FINE_GRAIN", "SVM_FINE_SYSTEM", "HOST_MAPPED"
+    std::string memory_strategy = "AUTO";
+
     // ========================================================================
     // Настройки логирования
     // ========================================================================
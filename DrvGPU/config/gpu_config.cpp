@@ -29,6 +29,7 @@
 // nlohmann/json - header-only JSON library
 #include "../../third_party/nlohmann/json.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -70,6 +71,18 @@ static GPUConfigEntry ParseGPUEntry(const json& j) {
 
     // Resource limits
     entry.max_memory_percent = j.value("max_memory_percent", entry.max_memory_percent);
+    entry.queue_count       = j.value("queue_count", entry.queue_count);
+    entry.memory_strategy   = j.value("memory_strategy", entry.memory_strategy);
+
+    if (entry.max_memory_percent == 0 || entry.max_memory_percent > 100) {
+        std::cerr << "[GPUConfig] WARNING: GPU " << entry.id << " max_memory_percent="
+                  << entry.max_memory_percent << " out of range [1, 100], clamped\n";
+        entry.max_memory_percent = std::clamp<size_t>(entry.max_memory_percent, 1, 100);
+    }
+    if (entry.queue_count == 0) {
+        std::cerr << "[GPUConfig] WARNING: GPU " << entry.id << " queue_count=0, using 1\n";
+        entry.queue_count = 1;
+    }
 
     // Logging settings
     entry.log_level         = j.value("log_level", entry.log_level);
@@ -94,6 +107,8 @@ static json SerializeGPUEntry(const GPUConfigEntry& entry) {
     j["is_active"]          = entry.is_active;
     j["is_db"]              = entry.is_db;
     j["max_memory_percent"] = entry.max_memory_percent;
+    j["queue_count"]        = entry.queue_count;
+    j["memory_strategy"]    = entry.memory_strategy;
     j["log_level"]          = entry.log_level;
 
     return j;
@@ -297,6 +312,31 @@ std::vector<int> GPUConfig::GetActiveGPUIDs() const {
     return active_ids;
 }
 
+std::vector<GPUConfigEntry> GPUConfig::GetActiveConfigs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<GPUConfigEntry> active;
+    for (const auto& entry : data_.gpus) {
+        if (entry.is_active) {
+            active.push_back(entry);
+        }
+    }
+    return active;
+}
+
+GPUConfigEntry GPUConfig::GetConfigCopy(int gpu_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const GPUConfigEntry* found = FindConfig(gpu_id);
+    if (found) {
+        return *found;
+    }
+
+    GPUConfigEntry entry;
+    entry.id = gpu_id;
+    return entry;
+}
+
 bool GPUConfig::IsProfilingEnabled(int gpu_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -380,6 +420,8 @@ void GPUConfig::Print() const {
         std::cout << "  │  Console: " << (entry.is_console ? "ON" : "off") << "\n";
         std::cout << "  │  DB:      " << (entry.is_db ? "ON" : "off") << "\n";
         std::cout << "  │  MaxMem:  " << entry.max_memory_percent << "%\n";
+        std::cout << "  │  Queues:  " << entry.queue_count << "\n";
+        std::cout << "  │  MemStr:  " << entry.memory_strategy << "\n";
         std::cout << "  │  LogLvl:  " << entry.log_level << "\n";
         std::cout << "  └───────────────────────────────────\n";
     }
@@ -171,6 +171,22 @@ public:
      */
     std::vector<int> GetActiveGPUIDs() const;
 
+    /**
+     * @brief Get copies of active GPU configurations (is_active == true)
+     * @return Entries in config order (safe to use after the lock is released)
+     */
+    std::vector<GPUConfigEntry> GetActiveConfigs() const;
+
+    /**
+     * @brief Get a copy of the configuration for a GPU
+     * @param gpu_id GPU device index
+     * @return Entry from config, or default GPUConfigEntry with the given id
+     *
+     * Unlike GetConfig(), safe to call from several threads for
+     * unconfigured GPUs (no shared default entry).
+     */
+    GPUConfigEntry GetConfigCopy(int gpu_id) const;
+
     /**
      * @brief Check if a specific GPU has profiling enabled
      * @param gpu_id GPU device index
@@ -20,6 +20,7 @@
 #include "interface/i_backend.hpp"
 #include "common/backend_type.hpp"
 #include "common/gpu_device_info.hpp"
+#include "config/config_types.hpp"
 #include "memory/memory_manager.hpp"
 #include "module_registry.hpp"
 #include <memory>
@@ -108,6 +109,19 @@ public:
      */
     bool IsInitialized() const { return initialized_; }
     
+    /**
+     * @brief Применить лимиты устройства из configGPU.json (после Initialize)
+     * 
+     * - max_memory_percent → бюджет MemoryManager (общий с менеджером бэкенда)
+     * - memory_strategy → стратегия для MemoryStrategy::AUTO
+     * - queue_count > 1 → CommandQueuePool бэкенда OpenCL
+     * 
+     * Вызывается GPUManager для каждого устройства.
+     * 
+     * @throws std::runtime_error если GPU не инициализирован
+     */
+    void ApplyConfig(const GPUConfigEntry& config);
+    
     /**
      * @brief Очистить все ресурсы (вызывается автоматически в деструкторе)
      */
@@ -13,28 +13,50 @@
  * - Load balancing (Round-Robin, Least Loaded, Manual)
  * - Централизованное управление ресурсами
  * - Thread-safe доступ к GPU
+ * - Параллельная инициализация устройств (время старта почти не зависит
+ *   от числа GPU), ошибки и время инициализации по каждому устройству
  *
  * @author DrvGPU Team
  * @date 2026-02-06
+ * @updated 2026-02-12 - Параллельная инициализация, DeviceInitResult
+ * @updated 2026-02-12 - WarmupAll: прогрев модулей всех GPU
  */
 
 #include "drv_gpu.hpp"
 #include "backend_type.hpp"
 #include "load_balancing.hpp"
 #include "logger/logger.hpp"
+#include "config/gpu_config.hpp"
 #include "backends/opencl/opencl_core.hpp"  // ✅ MULTI-GPU: Для реального обнаружения устройств
 
 #include <vector>
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <thread>
 #include <stdexcept>
 #include <iostream>
+#include <iomanip>
 #include <sstream>
 #include <algorithm>
 
 namespace drv_gpu_lib {
 
+/**
+ * @struct DeviceInitResult
+ * @brief Итог инициализации одного устройства в GPUManager
+ */
+struct DeviceInitResult {
+    int         device_index = -1;
+    bool        success      = false;
+    double      init_ms      = 0.0;   ///< Время DrvGPU::Initialize на своём потоке
+    std::string device_name;          ///< Пусто при ошибке
+    std::string error;                ///< Пусто при успехе
+    std::string config_name;          ///< GPUConfigEntry::name
+    size_t      memory_budget = 0;    ///< Бюджет памяти, байт (0 — без лимита)
+};
+
 // ════════════════════════════════════════════════════════════════════════════
 // Class: GPUManager - Координатор для Multi-GPU
 // ════════════════════════════════════════════════════════════════════════════
@@ -102,19 +124,46 @@ public:
     
     /**
      * @brief Инициализировать все доступные GPU
+     *
+     * Если GPUConfig загружен (Load/LoadOrCreate) — только активные
+     * (is_active) устройства из конфигурации, которые есть в системе;
+     * иначе все найденные. К каждому устройству применяется его
+     * GPUConfigEntry (DrvGPU::ApplyConfig: бюджет памяти, очереди,
+     * стратегия памяти).
+     *
+     * Устройства инициализируются параллельно, каждое на своём потоке.
+     * Ошибка одного устройства не мешает остальным: она попадает
+     * в GetInitResults().
+     *
      * @param backend_type Тип бэкенда (OPENCL, CUDA, VULKAN)
-     * @throws std::runtime_error если не найдено ни одной GPU
+     * @throws std::runtime_error если не найдено ни одной GPU, в конфигурации
+     *         нет ни одного активного найденного устройства или
+     *         не инициализировалась ни одна (сообщение — ошибки всех устройств)
      */
     void InitializeAll(BackendType backend_type);
     
     /**
-     * @brief Инициализировать конкретные GPU по индексам
+     * @brief Инициализировать конкретные GPU по индексам (параллельно)
      * @param backend_type Тип бэкенда
      * @param device_indices Список индексов GPU для инициализации
+     *
+     * Порядок GPU в менеджере — порядок device_indices (без неудавшихся).
+     * is_active не проверяется (устройства заданы явно), лимиты из
+     * GPUConfig (или значения по умолчанию) применяются.
      */
     void InitializeSpecific(BackendType backend_type, 
                            const std::vector<int>& device_indices);
     
+    /**
+     * @brief Результаты последней инициализации по каждому устройству
+     */
+    std::vector<DeviceInitResult> GetInitResults() const;
+    
+    /**
+     * @brief Таблица: устройство, время, ошибка + общее время старта
+     */
+    std::string GetInitReport() const;
+    
     /**
      * @brief Проверить, инициализирован ли менеджер
      */
@@ -194,6 +243,16 @@ public:
     // Синхронизация
     // ═══════════════════════════════════════════════════════════════
     
+    /**
+     * @brief Прогреть модули всех GPU одним параллельным запуском
+     *
+     * Задачи — модули из ModuleRegistry каждой GPU плюс extra_tasks
+     * (модули, живущие вне реестра). Все задачи всех устройств идут
+     * параллельно, ошибки собираются в результатах.
+     */
+    std::vector<WarmupResult> WarmupAll(const WarmupConfig& config,
+                                        const std::vector<WarmupTask>& extra_tasks = {});
+    
     /**
      * @brief Синхронизировать все GPU (ждать завершения всех операций)
      */
@@ -250,6 +309,10 @@ private:
     // Load tracking (простая метрика: количество задач, защищено мьютексом)
     std::vector<size_t> gpu_task_count_;
     
+    // Последняя инициализация (под mutex_)
+    std::vector<DeviceInitResult> init_results_;
+    double init_wall_ms_ = 0.0;
+    
     // Thread-safety
     mutable std::mutex mutex_;
     
@@ -263,9 +326,31 @@ private:
     int DiscoverGPUs(BackendType backend_type);
     
     /**
-     * @brief Инициализировать GPU по индексу
+     * @brief Создать, инициализировать DrvGPU и применить конфигурацию
+     *        (вызывается на рабочем потоке)
+     * @param[out] result Время, имя устройства или текст ошибки
+     * @return nullptr при ошибке
+     */
+    std::unique_ptr<DrvGPU> InitializeGPU(const GPUConfigEntry& config,
+                                          DeviceInitResult& result) const;
+    
+    /**
+     * @brief Параллельно инициализировать устройства, добавить удавшиеся в gpus_
+     * Вызывается под mutex_
      */
-    void InitializeGPU(int device_index);
+    void InitializeDevices(const std::vector<GPUConfigEntry>& devices);
+    
+    /**
+     * @brief Устройства для InitializeAll: активные из GPUConfig или все найденные
+     * @param gpu_count Число найденных устройств
+     */
+    static std::vector<GPUConfigEntry> SelectDevices(int gpu_count);
+    
+    /**
+     * @brief Параметры устройства: из GPUConfig или, если он не загружен,
+     *        по умолчанию без лимита памяти
+     */
+    static GPUConfigEntry DeviceConfig(int device_index);
     
     /**
      * @brief Получить индекс наименее загруженной GPU
@@ -299,7 +384,9 @@ inline GPUManager::GPUManager(GPUManager&& other) noexcept
     , lb_strategy_(other.lb_strategy_)
     , gpus_(std::move(other.gpus_))
     , round_robin_index_(other.round_robin_index_.load())
-    , gpu_task_count_(std::move(other.gpu_task_count_)) {
+    , gpu_task_count_(std::move(other.gpu_task_count_))
+    , init_results_(std::move(other.init_results_))
+    , init_wall_ms_(other.init_wall_ms_) {
 }
 
 inline GPUManager& GPUManager::operator=(GPUManager&& other) noexcept {
@@ -312,6 +399,8 @@ inline GPUManager& GPUManager::operator=(GPUManager&& other) noexcept {
         gpus_ = std::move(other.gpus_);
         round_robin_index_ = other.round_robin_index_.load();
         gpu_task_count_ = std::move(other.gpu_task_count_);
+        init_results_ = std::move(other.init_results_);
+        init_wall_ms_ = other.init_wall_ms_;
     }
     
     return *this;
@@ -330,8 +419,20 @@ inline void GPUManager::InitializeAll(BackendType backend_type) {
         throw std::runtime_error("No GPUs available for backend type");
     }
     
-    for (int i = 0; i < gpu_count; ++i) {
-        InitializeGPU(i);
+    std::vector<GPUConfigEntry> devices = SelectDevices(gpu_count);
+    if (devices.empty()) {
+        throw std::runtime_error("GPUManager: no active configured GPU among " +
+                                 std::to_string(gpu_count) + " discovered device(s)");
+    }
+    InitializeDevices(devices);
+    
+    if (gpus_.empty()) {
+        std::ostringstream oss;
+        oss << "GPUManager: failed to initialize all " << devices.size() << " GPU(s):";
+        for (const auto& r : init_results_) {
+            oss << "\n  GPU " << r.device_index << ": " << r.error;
+        }
+        throw std::runtime_error(oss.str());
     }
     
     DRVGPU_LOG_INFO("GPUManager", "Initialized " + std::to_string(gpus_.size()) + " GPU(s)");
@@ -346,13 +447,124 @@ inline void GPUManager::InitializeSpecific(BackendType backend_type,
     // ✅ FIX: Вызываем ВНУТРЕННИЙ метод (БЕЗ блокировки)
     CleanupInternal();
     
+    std::vector<GPUConfigEntry> devices;
+    devices.reserve(device_indices.size());
     for (int index : device_indices) {
-        InitializeGPU(index);
+        devices.push_back(DeviceConfig(index));
     }
+    InitializeDevices(devices);
     
     DRVGPU_LOG_INFO("GPUManager", "Initialized " + std::to_string(gpus_.size()) + " specific GPU(s)");
 }
 
+inline GPUConfigEntry GPUManager::DeviceConfig(int device_index) {
+    const GPUConfig& config = GPUConfig::GetInstance();
+    GPUConfigEntry entry = config.GetConfigCopy(device_index);
+    if (!config.IsLoaded()) {
+        // Без configGPU.json жёсткого лимита нет: 70% по умолчанию —
+        // значение поля в файле, а не ограничение для всех
+        entry.max_memory_percent = 100;
+    }
+    return entry;
+}
+
+inline std::vector<GPUConfigEntry> GPUManager::SelectDevices(int gpu_count) {
+    const GPUConfig& config = GPUConfig::GetInstance();
+    std::vector<GPUConfigEntry> devices;
+    
+    if (!config.IsLoaded()) {
+        // Конфигурация не загружена — все найденные устройства, как без GPUConfig
+        for (int i = 0; i < gpu_count; ++i) {
+            devices.push_back(DeviceConfig(i));
+        }
+        return devices;
+    }
+    
+    for (const auto& entry : config.GetActiveConfigs()) {
+        if (entry.id < 0 || entry.id >= gpu_count) {
+            DRVGPU_LOG_WARNING("GPUManager", "Configured GPU " + std::to_string(entry.id) + " (\"" +
+                               entry.name + "\") not found: " + std::to_string(gpu_count) +
+                               " device(s) discovered");
+            continue;
+        }
+        bool duplicate = std::any_of(devices.begin(), devices.end(),
+                                     [&entry](const GPUConfigEntry& d) { return d.id == entry.id; });
+        if (!duplicate) {
+            devices.push_back(entry);
+        }
+    }
+    
+    DRVGPU_LOG_INFO("GPUManager", "Config selects " + std::to_string(devices.size()) + " of " +
+                    std::to_string(gpu_count) + " discovered GPU(s)");
+    return devices;
+}
+
+inline void GPUManager::InitializeDevices(const std::vector<GPUConfigEntry>& devices) {
+    // Каждое устройство — свой OpenCLCore/контекст/очередь: DrvGPU::Initialize
+    // разных устройств не делят состояние и идут параллельно
+    std::vector<std::unique_ptr<DrvGPU>> created(devices.size());
+    std::vector<DeviceInitResult> results(devices.size());
+    
+    auto start = std::chrono::steady_clock::now();
+    if (devices.size() == 1) {
+        created[0] = InitializeGPU(devices[0], results[0]);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(devices.size());
+        for (size_t i = 0; i < devices.size(); ++i) {
+            workers.emplace_back([this, &created, &results, &devices, i] {
+                created[i] = InitializeGPU(devices[i], results[i]);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    init_wall_ms_ = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    
+    // Порядок gpus_ = порядок devices, независимо от того, кто успел первым
+    for (auto& gpu : created) {
+        if (gpu) {
+            gpus_.push_back(std::move(gpu));
+            gpu_task_count_.emplace_back(0);
+        }
+    }
+    init_results_ = std::move(results);
+    
+    DRVGPU_LOG_INFO("GPUManager", "Device initialization took " +
+                    std::to_string(init_wall_ms_) + " ms for " +
+                    std::to_string(devices.size()) + " device(s)");
+}
+
+inline std::vector<DeviceInitResult> GPUManager::GetInitResults() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return init_results_;
+}
+
+inline std::string GPUManager::GetInitReport() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::ostringstream oss;
+    oss << "GPU initialization (" << std::fixed << std::setprecision(1)
+        << init_wall_ms_ << " ms total):\n";
+    double sum_ms = 0.0;
+    for (const auto& r : init_results_) {
+        sum_ms += r.init_ms;
+        oss << "  GPU " << r.device_index << ": " << std::setw(8) << r.init_ms << " ms  "
+            << (r.success ? r.device_name : "FAILED: " + r.error);
+        if (r.success && r.memory_budget > 0) {
+            oss << "  (budget " << (r.memory_budget / (1024 * 1024)) << " MB)";
+        }
+        oss << "\n";
+    }
+    if (init_results_.size() > 1 && init_wall_ms_ > 0.0) {
+        oss << "  Sequential equivalent: " << sum_ms << " ms ("
+            << std::setprecision(2) << (sum_ms / init_wall_ms_) << "x)\n";
+    }
+    return oss.str();
+}
+
 // ════════════════════════════════════════════════════════════════════════════
 // ✅ DEADLOCK FIX: Два варианта метода Cleanup
 // ════════════════════════════════════════════════════════════════════════════
@@ -471,6 +683,39 @@ inline void GPUManager::SetLoadBalancingStrategy(LoadBalancingStrategy strategy)
     lb_strategy_ = strategy;
 }
 
+inline std::vector<WarmupResult> GPUManager::WarmupAll(const WarmupConfig& config,
+                                                      const std::vector<WarmupTask>& extra_tasks) {
+    std::vector<WarmupTask> tasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& gpu : gpus_) {
+            auto gpu_tasks = gpu->GetModuleRegistry().CollectWarmupTasks(config);
+            for (auto& task : gpu_tasks) {
+                tasks.push_back(std::move(task));
+            }
+        }
+    }
+    tasks.insert(tasks.end(), extra_tasks.begin(), extra_tasks.end());
+    
+    // Без mutex_: прогрев долгий, модули могут обращаться к GPUManager
+    auto start = std::chrono::steady_clock::now();
+    auto results = RunWarmupTasks(tasks, config.parallel);
+    double wall_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    
+    size_t failed = 0;
+    for (const auto& r : results) {
+        if (!r.success) {
+            ++failed;
+            DRVGPU_LOG_ERROR("GPUManager", "Warmup of '" + r.module + "' on GPU " +
+                             std::to_string(r.device_index) + " failed: " + r.error);
+        }
+    }
+    DRVGPU_LOG_INFO("GPUManager", "Warmup of " + std::to_string(results.size()) + " module(s) took " +
+                    std::to_string(wall_ms) + " ms (" + std::to_string(failed) + " failed)");
+    return results;
+}
+
 inline void GPUManager::SynchronizeAll() {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -559,16 +804,34 @@ inline int GPUManager::DiscoverGPUs(BackendType backend_type) {
     return device_count;
 }
 
-inline void GPUManager::InitializeGPU(int device_index) {
+inline std::unique_ptr<DrvGPU> GPUManager::InitializeGPU(const GPUConfigEntry& config,
+                                                       DeviceInitResult& result) const {
+    const int device_index = config.id;
+    result.device_index = device_index;
+    result.config_name = config.name;
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed_ms = [&start] {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+    };
+    
     try {
         auto gpu = std::make_unique<DrvGPU>(backend_type_, device_index);
         gpu->Initialize();
-        gpus_.push_back(std::move(gpu));
-        gpu_task_count_.emplace_back(0);
-        DRVGPU_LOG_INFO("GPUManager", "Initialized GPU " + std::to_string(device_index));
+        gpu->ApplyConfig(config);
+        result.memory_budget = gpu->GetMemoryManager().GetMemoryBudget();
+        result.init_ms = elapsed_ms();
+        result.success = true;
+        result.device_name = gpu->GetDeviceName();
+        DRVGPU_LOG_INFO("GPUManager", "Initialized GPU " + std::to_string(device_index) +
+                        " in " + std::to_string(result.init_ms) + " ms");
+        return gpu;
     } catch (const std::exception& e) {
+        result.init_ms = elapsed_ms();
+        result.error = e.what();
         DRVGPU_LOG_ERROR("GPUManager", "Failed to initialize GPU " + std::to_string(device_index) + ": " + e.what());
     }
+    return nullptr;
 }
 
 inline size_t GPUManager::GetLeastLoadedGPUIndex() const {
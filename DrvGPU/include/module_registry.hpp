@@ -7,11 +7,19 @@
  * ModuleRegistry управляет compute модулями (FFT, Matrix, etc.)
  * и предоставляет централизованный доступ к ним.
  * 
+ * Два пути доступа:
+ * - по имени (GetModule) — mutex + поиск в map + dynamic_cast на каждый
+ *   вызов; для настройки и редких обращений
+ * - по ModuleHandle (Get) — один atomic load таблицы и индекс, без lock;
+ *   для обращений на каждом кадре из многих потоков
+ * 
  * @author DrvGPU Team
  * @date 2026-01-31
  */
 
 #include "../interface/i_compute_module.hpp"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -21,6 +29,42 @@
 
 namespace drv_gpu_lib {
 
+class ModuleRegistry;
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: ModuleHandle - типизированный индекс модуля в реестре
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class ModuleHandle
+ * @brief Стабильный индекс модуля, полученный один раз при регистрации
+ * 
+ * Тип проверен при выдаче handle (dynamic_cast), поэтому
+ * ModuleRegistry::Get(handle) обходится static_cast.
+ * Индексы не переиспользуются: после UnregisterModule или Clear старый
+ * handle даёт nullptr, а не чужой модуль.
+ * Handle относится к реестру, который его выдал.
+ * 
+ * @tparam T Тип модуля (наследник IComputeModule)
+ */
+template<typename T>
+class ModuleHandle {
+public:
+    ModuleHandle() = default;
+    
+    bool IsValid() const { return index_ != kInvalidIndex; }
+    uint32_t GetIndex() const { return index_; }
+    
+private:
+    friend class ModuleRegistry;
+    
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+    
+    explicit ModuleHandle(uint32_t index) : index_(index) {}
+    
+    uint32_t index_ = kInvalidIndex;
+};
+
 // ════════════════════════════════════════════════════════════════════════════
 // Class: ModuleRegistry - Регистр compute модулей
 // ════════════════════════════════════════════════════════════════════════════
@@ -50,6 +94,10 @@ namespace drv_gpu_lib {
  * auto fft = registry.GetModule("FFT");
  * fft->Initialize();
  * fft->Execute(params);
+ * 
+ * // Доступ на каждом кадре: handle один раз, дальше без lock
+ * ModuleHandle<FFTModule> fft_handle = registry.RegisterModule("FFT2", fft_module2);
+ * FFTModule* fft2 = registry.Get(fft_handle);
  * @endcode
  * 
  * Паттерн: Registry (хранилище объектов по ключу)
@@ -88,15 +136,27 @@ public:
      * @brief Зарегистрировать compute модуль
      * @param name Имя модуля (уникальное)
      * @param module Shared pointer на модуль
+     * @return Handle для доступа без lock (можно не сохранять)
      * @throws std::runtime_error если модуль с таким именем уже существует
      */
-    void RegisterModule(const std::string& name, 
-                       std::shared_ptr<IComputeModule> module);
+    ModuleHandle<IComputeModule> RegisterModule(const std::string& name, 
+                                                std::shared_ptr<IComputeModule> module);
+    
+    /**
+     * @brief Зарегистрировать модуль и получить типизированный handle
+     * @tparam T Тип модуля (наследник IComputeModule)
+     */
+    template<typename T>
+    ModuleHandle<T> RegisterModule(const std::string& name, std::shared_ptr<T> module);
     
     /**
      * @brief Удалить модуль из реестра
      * @param name Имя модуля
      * @return true если модуль был удалён
+     * 
+     * Handle модуля начинает возвращать nullptr. Сам объект живёт до
+     * Reclaim, Clear или деструктора реестра: поток, прочитавший таблицу
+     * до удаления, может ещё обращаться к модулю.
      */
     bool UnregisterModule(const std::string& name);
     
@@ -128,6 +188,27 @@ public:
     template<typename T>
     std::shared_ptr<T> GetModule(const std::string& name);
     
+    // ═══════════════════════════════════════════════════════════════
+    // Доступ без блокировок (handle)
+    // ═══════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Handle уже зарегистрированного модуля
+     * @throws std::runtime_error если модуль не найден или другого типа
+     */
+    template<typename T>
+    ModuleHandle<T> GetHandle(const std::string& name) const;
+    
+    /**
+     * @brief Модуль по handle: один acquire load таблицы + индекс
+     * @return nullptr, если handle пуст или модуль удалён
+     * 
+     * Указатель действителен, пока модуль не удалён и реестр не очищен.
+     * Clear и деструктор не должны идти параллельно с Get.
+     */
+    template<typename T>
+    T* Get(ModuleHandle<T> handle) const noexcept;
+    
     // ═══════════════════════════════════════════════════════════════
     // Информация о реестре
     // ═══════════════════════════════════════════════════════════════
@@ -147,6 +228,21 @@ public:
      */
     void PrintModules() const;
     
+    // ═══════════════════════════════════════════════════════════════
+    // Прогрев
+    // ═══════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Задачи прогрева всех модулей (для общего запуска по нескольким GPU)
+     */
+    std::vector<WarmupTask> CollectWarmupTasks(const WarmupConfig& config) const;
+    
+    /**
+     * @brief Прогреть все модули (параллельно, если config.parallel)
+     * @return Результат по каждому модулю; ошибки не бросаются
+     */
+    std::vector<WarmupResult> WarmupAll(const WarmupConfig& config) const;
+    
     // ═══════════════════════════════════════════════════════════════
     // Очистка
     // ═══════════════════════════════════════════════════════════════
@@ -155,8 +251,42 @@ public:
      * @brief Очистить все модули
      */
     void Clear();
+    
+    /**
+     * @brief Освободить удалённые модули и устаревшие таблицы
+     * @return Число освобождённых модулей
+     * 
+     * Точка покоя: вызывать, когда никто не выполняет Get(handle) и не
+     * держит полученный из него указатель на удалённый модуль (тот же
+     * контракт, что у Clear). Например, после замены модулей между
+     * сеансами обработки. Текущая таблица и живые модули не затрагиваются.
+     */
+    size_t Reclaim();
 
 private:
+    // ═══════════════════════════════════════════════════════════════
+    // Таблица для доступа по handle
+    // ═══════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Неизменяемый снимок слотов (индекс handle -> модуль)
+     * 
+     * Регистрация копирует таблицу и публикует новую; читатели видят
+     * либо старую, либо новую целиком. Старые таблицы не удаляются до
+     * Reclaim/Clear: без учёта читателей нельзя знать, что их уже никто
+     * не держит.
+     * Регистрация редкая (старт), таблица — по указателю на модуль.
+     */
+    struct ModuleTable {
+        std::vector<IComputeModule*> modules;
+    };
+    
+    /// Скопировать slots_ в новую таблицу и опубликовать (под mutex_)
+    void PublishTableLocked();
+    
+    /// Индекс слота по имени (под mutex_); kInvalidIndex, если нет
+    uint32_t FindSlotLocked(const std::string& name) const;
+    
     // ═══════════════════════════════════════════════════════════════
     // Члены класса
     // ═══════════════════════════════════════════════════════════════
@@ -164,6 +294,17 @@ private:
     // Хранилище модулей (имя -> модуль)
     std::unordered_map<std::string, std::shared_ptr<IComputeModule>> modules_;
     
+    // Слоты handle (только растут; удалённый модуль — nullptr)
+    std::vector<std::shared_ptr<IComputeModule>> slots_;
+    std::unordered_map<std::string, uint32_t> slot_index_;
+    
+    // Удалённые модули: могут быть ещё видны через старые таблицы
+    std::vector<std::shared_ptr<IComputeModule>> retired_;
+    
+    // Все опубликованные таблицы; текущая — table_
+    std::vector<std::unique_ptr<const ModuleTable>> tables_;
+    std::atomic<const ModuleTable*> table_{nullptr};
+    
     // Thread-safety
     mutable std::mutex mutex_;
 };
@@ -189,4 +330,43 @@ std::shared_ptr<T> ModuleRegistry::GetModule(const std::string& name) {
     return typed_module;
 }
 
+template<typename T>
+ModuleHandle<T> ModuleRegistry::RegisterModule(const std::string& name,
+                                               std::shared_ptr<T> module) {
+    static_assert(std::is_base_of<IComputeModule, T>::value,
+                  "T must be derived from IComputeModule");
+    
+    auto handle = RegisterModule(name, std::static_pointer_cast<IComputeModule>(module));
+    return ModuleHandle<T>(handle.index_);
+}
+
+template<typename T>
+ModuleHandle<T> ModuleRegistry::GetHandle(const std::string& name) const {
+    static_assert(std::is_base_of<IComputeModule, T>::value,
+                  "T must be derived from IComputeModule");
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    const uint32_t index = FindSlotLocked(name);
+    if (index == ModuleHandle<T>::kInvalidIndex) {
+        throw std::runtime_error("ModuleRegistry: module '" + name + "' not found");
+    }
+    if (!dynamic_cast<T*>(slots_[index].get())) {
+        throw std::runtime_error(
+            "ModuleRegistry::GetHandle: module '" + name +
+            "' is not of requested type");
+    }
+    
+    return ModuleHandle<T>(index);
+}
+
+template<typename T>
+T* ModuleRegistry::Get(ModuleHandle<T> handle) const noexcept {
+    const ModuleTable* table = table_.load(std::memory_order_acquire);
+    if (!table || handle.index_ >= table->modules.size()) {
+        return nullptr;
+    }
+    return static_cast<T*>(table->modules[handle.index_]);
+}
+
 } // namespace drv_gpu_lib
@@ -11,6 +11,8 @@
  * @date 2026-01-31
  */
 
+#include "../common/warmup.hpp"
+
 #include <string>
 #include <memory>
 
@@ -39,6 +41,7 @@ class IBackend;
  * Жизненный цикл модуля:
  * 1. Создание (конструктор)
  * 2. Initialize() - компиляция kernels, подготовка
+ *    Warmup() - (опц.) планы, пулы и пробный кадр до первого реального кадра
  * 3. Execute() - выполнение вычислений (многократно)
  * 4. Cleanup() - освобождение ресурсов
  * 5. Деструктор
@@ -70,6 +73,23 @@ public:
      */
     virtual void Cleanup() = 0;
     
+    /**
+     * @brief Прогреть модуль до первого кадра
+     *
+     * Модуль переопределяет, если первый кадр дороже остальных (планы FFT
+     * под ожидаемые размеры пакетов, пулы буферов, пробный кадр).
+     * По умолчанию — только Initialize(), если модуль ещё не инициализирован.
+     * Вызывается на рабочем потоке (ModuleRegistry::WarmupAll).
+     *
+     * @throws std::runtime_error при ошибке прогрева
+     */
+    virtual void Warmup(const WarmupConfig& config) {
+        (void)config;
+        if (!IsInitialized()) {
+            Initialize();
+        }
+    }
+    
     // ═══════════════════════════════════════════════════════════════════════
     // Информация о модуле
     // ═══════════════════════════════════════════════════════════════════════
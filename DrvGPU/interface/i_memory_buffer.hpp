@@ -4,6 +4,11 @@
  * @file i_memory_buffer.hpp
  * @brief Абстрактный интерфейс для GPU буферов
  * 
+ * IMemoryBufferBase — операции, не зависящие от типа элемента (raw I/O,
+ * kernel arg, map/unmap, информация); IMemoryBuffer<T> добавляет
+ * типизированные Read/Write. T по умолчанию — complex<float>, поэтому
+ * IMemoryBuffer<> совпадает с прежним нетипизированным интерфейсом.
+ * 
  * Определяет общий интерфейс для всех типов буферов:
  * - RegularBuffer (традиционный cl_mem)
  * - SVMBuffer (Shared Virtual Memory)
@@ -21,12 +26,11 @@
 #include <memory>
 #include <string>
 #include <functional>
+#include <sstream>
+#include <type_traits>
 
 namespace drv_gpu_lib {
 
-// Предварительные объявления
-class IMemoryBuffer;
-
 // ════════════════════════════════════════════════════════════════════════════
 // Type aliases
 // ════════════════════════════════════════════════════════════════════════════
@@ -45,6 +49,7 @@ using ComplexVector = std::vector<ComplexFloat>;
 struct BufferInfo {
     size_t          num_elements   = 0;
     size_t          size_bytes     = 0;
+    size_t          element_size   = 0;
     MemoryType      memory_type    = MemoryType::GPU_READ_WRITE;
     MemoryStrategy  strategy       = MemoryStrategy::REGULAR_BUFFER;
     bool            is_external    = false;
@@ -54,46 +59,29 @@ struct BufferInfo {
 };
 
 // ════════════════════════════════════════════════════════════════════════════
-// Interface: IMemoryBuffer - абстрактный интерфейс для GPU буферов
+// Interface: IMemoryBufferBase - часть интерфейса, не зависящая от типа
 // ════════════════════════════════════════════════════════════════════════════
 
 /**
- * @class IMemoryBuffer
- * @brief Абстрактный интерфейс для работы с GPU памятью
- * 
- * Все реализации буферов должны наследовать этот интерфейс.
- * Это позволяет использовать разные стратегии (SVM/Regular) 
- * через единый полиморфный интерфейс.
+ * @class IMemoryBufferBase
+ * @brief Нетипизированная часть интерфейса GPU буфера
  * 
- * Паттерн: Strategy Pattern + RAII
- * 
- * @code
- * std::unique_ptr<IMemoryBuffer> buffer = factory.CreateBuffer(size);
- * buffer->Write(data);
- * kernel.SetArg(0, buffer.get());
- * // ... kernel execution ...
- * auto result = buffer->Read();
- * @endcode
+ * Всё, что работает с байтами и OpenCL-ресурсами. Позволяет хранить и
+ * передавать буферы разных типов элемента через один указатель
+ * (ScopedMap, менеджеры памяти).
  */
-class IMemoryBuffer {
+class IMemoryBufferBase {
 public:
     // ═══════════════════════════════════════════════════════════════
     // Виртуальный деструктор (RAII)
     // ═══════════════════════════════════════════════════════════════
     
-    virtual ~IMemoryBuffer() = default;
+    virtual ~IMemoryBufferBase() = default;
     
     // ═══════════════════════════════════════════════════════════════
-    // Основные операции чтения/записи
+    // Raw чтение/запись
     // ═══════════════════════════════════════════════════════════════
     
-    /**
-     * @brief Записать данные в буфер (синхронно)
-     * @param data Вектор данных для записи
-     * @throws std::runtime_error если размер превышает буфер
-     */
-    virtual void Write(const ComplexVector& data) = 0;
-    
     /**
      * @brief Записать raw данные в буфер
      * @param data Указатель на данные
@@ -101,19 +89,6 @@ public:
      */
     virtual void WriteRaw(const void* data, size_t size_bytes) = 0;
     
-    /**
-     * @brief Прочитать все данные из буфера (синхронно)
-     * @return Вектор данных
-     */
-    virtual ComplexVector Read() = 0;
-    
-    /**
-     * @brief Прочитать часть данных из буфера
-     * @param num_elements Количество элементов для чтения
-     * @return Вектор данных
-     */
-    virtual ComplexVector ReadPartial(size_t num_elements) = 0;
-    
     /**
      * @brief Прочитать raw данные из буфера
      * @param dest Указатель на приёмник
@@ -121,24 +96,6 @@ public:
      */
     virtual void ReadRaw(void* dest, size_t size_bytes) = 0;
     
-    // ═══════════════════════════════════════════════════════════════
-    // Асинхронные операции
-    // ═══════════════════════════════════════════════════════════════
-    
-    /**
-     * @brief Записать данные асинхронно
-     * @param data Вектор данных
-     * @return cl_event для синхронизации
-     */
-    virtual cl_event WriteAsync(const ComplexVector& data) = 0;
-    
-    /**
-     * @brief Прочитать данные асинхронно
-     * @param out_data Указатель на выходной вектор (должен быть выделен!)
-     * @return cl_event для синхронизации
-     */
-    virtual cl_event ReadAsync(ComplexVector& out_data) = 0;
-    
     // ═══════════════════════════════════════════════════════════════
     // Доступ к OpenCL ресурсам
     // ═══════════════════════════════════════════════════════════════
@@ -176,6 +133,11 @@ public:
      */
     virtual size_t GetSizeBytes() const = 0;
     
+    /**
+     * @brief Размер одного элемента в байтах
+     */
+    virtual size_t GetElementSize() const = 0;
+    
     /**
      * @brief Получить тип памяти (READ_ONLY, WRITE_ONLY, READ_WRITE)
      */
@@ -229,13 +191,99 @@ public:
 
 protected:
     // Защищённый конструктор (только для наследников)
-    IMemoryBuffer() = default;
+    IMemoryBufferBase() = default;
     
     // Запрет копирования
-    IMemoryBuffer(const IMemoryBuffer&) = delete;
-    IMemoryBuffer& operator=(const IMemoryBuffer&) = delete;
+    IMemoryBufferBase(const IMemoryBufferBase&) = delete;
+    IMemoryBufferBase& operator=(const IMemoryBufferBase&) = delete;
 };
 
+// ════════════════════════════════════════════════════════════════════════════
+// Interface: IMemoryBuffer<T> - типизированный интерфейс GPU буфера
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class IMemoryBuffer
+ * @brief Абстрактный интерфейс для работы с GPU памятью
+ * 
+ * Все реализации буферов должны наследовать этот интерфейс.
+ * Это позволяет использовать разные стратегии (SVM/Regular) 
+ * через единый полиморфный интерфейс.
+ * 
+ * T — тип элемента: complex<float> (по умолчанию), float, int16_t или
+ * POD-структура (например, результат поиска максимумов). Данные
+ * копируются побайтно, поэтому T должен быть trivially copyable.
+ * 
+ * Паттерн: Strategy Pattern + RAII
+ * 
+ * @code
+ * std::unique_ptr<IMemoryBuffer<float>> buffer = factory.CreateBuffer(size);
+ * buffer->Write(data);
+ * kernel.SetArg(0, buffer.get());
+ * // ... kernel execution ...
+ * auto result = buffer->Read();
+ * @endcode
+ */
+template <typename T = ComplexFloat>
+class IMemoryBuffer : public IMemoryBufferBase {
+public:
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "IMemoryBuffer<T>: T must be trivially copyable");
+    
+    using value_type = T;
+    using Vector = std::vector<T>;
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Основные операции чтения/записи
+    // ═══════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Записать данные в буфер (синхронно)
+     * @param data Вектор данных для записи
+     * @throws std::runtime_error если размер превышает буфер
+     */
+    virtual void Write(const Vector& data) = 0;
+    
+    /**
+     * @brief Прочитать все данные из буфера (синхронно)
+     * @return Вектор данных
+     */
+    virtual Vector Read() = 0;
+    
+    /**
+     * @brief Прочитать часть данных из буфера
+     * @param num_elements Количество элементов для чтения
+     * @return Вектор данных
+     */
+    virtual Vector ReadPartial(size_t num_elements) = 0;
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Асинхронные операции
+    // ═══════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Записать данные асинхронно
+     * @param data Вектор данных
+     * @return cl_event для синхронизации
+     */
+    virtual cl_event WriteAsync(const Vector& data) = 0;
+    
+    /**
+     * @brief Прочитать данные асинхронно
+     * @param out_data Указатель на выходной вектор (должен быть выделен!)
+     * @return cl_event для синхронизации
+     */
+    virtual cl_event ReadAsync(Vector& out_data) = 0;
+    
+    size_t GetElementSize() const override { return sizeof(T); }
+
+protected:
+    IMemoryBuffer() = default;
+};
+
+/// Прежний (комплексный) интерфейс
+using ComplexMemoryBuffer = IMemoryBuffer<ComplexFloat>;
+
 // ════════════════════════════════════════════════════════════════════════════
 // Inline реализация BufferInfo::ToString
 // ════════════════════════════════════════════════════════════════════════════
@@ -245,6 +293,7 @@ inline std::string BufferInfo::ToString() const {
     oss << "BufferInfo:\n";
     oss << "  Elements:   " << num_elements << "\n";
     oss << "  Size:       " << (size_bytes / (1024.0 * 1024.0)) << " MB\n";
+    oss << "  Element:    " << element_size << " bytes\n";
     oss << "  Strategy:   " << MemoryStrategyToString(strategy) << "\n";
     oss << "  External:   " << (is_external ? "YES" : "NO") << "\n";
     oss << "  Mapped:     " << (is_mapped ? "YES" : "NO") << "\n";
@@ -257,7 +306,7 @@ inline std::string BufferInfo::ToString() const {
 
 /**
  * @class ScopedMap
- * @brief RAII guard для автоматического unmap SVM буфера
+ * @brief RAII guard для автоматического unmap SVM / host-mapped буфера
  * 
  * @code
  * {
@@ -268,15 +317,15 @@ inline std::string BufferInfo::ToString() const {
  */
 class ScopedMap {
 public:
-    explicit ScopedMap(IMemoryBuffer* buffer, bool write = true, bool read = true)
+    explicit ScopedMap(IMemoryBufferBase* buffer, bool write = true, bool read = true)
         : buffer_(buffer) {
-        if (buffer_ && buffer_->IsSVM()) {
+        if (buffer_ && NeedsMap()) {
             buffer_->Map(write, read);
         }
     }
     
     ~ScopedMap() {
-        if (buffer_ && buffer_->IsSVM() && buffer_->IsMapped()) {
+        if (buffer_ && NeedsMap() && buffer_->IsMapped()) {
             buffer_->Unmap();
         }
     }
@@ -292,7 +341,7 @@ public:
     
     ScopedMap& operator=(ScopedMap&& other) noexcept {
         if (this != &other) {
-            if (buffer_ && buffer_->IsSVM() && buffer_->IsMapped()) {
+            if (buffer_ && NeedsMap() && buffer_->IsMapped()) {
                 buffer_->Unmap();
             }
             buffer_ = other.buffer_;
@@ -302,7 +351,12 @@ public:
     }
 
 private:
-    IMemoryBuffer* buffer_;
+    IMemoryBufferBase* buffer_;
+    
+    /// SVM и host-mapped cl_mem (HOST_MAPPED) доступны хосту только через map
+    bool NeedsMap() const {
+        return buffer_->IsSVM() || buffer_->GetStrategy() == MemoryStrategy::HOST_MAPPED;
+    }
 };
 
 } // namespace drv_gpu_lib
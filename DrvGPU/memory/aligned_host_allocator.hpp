@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * @file aligned_host_allocator.hpp
+ * @brief Выровненная host-память для zero-copy буферов (CL_MEM_USE_HOST_PTR)
+ *
+ * Драйверы используют host-указатель без копии только если он выровнен:
+ * Intel — по 4096 байт и размер кратен 64, AMD APU / PoCL — по странице.
+ * Иначе clCreateBuffer(CL_MEM_USE_HOST_PTR) молча делает теневую копию.
+ *
+ * @code
+ * AlignedHostVector<std::complex<float>> samples(n);
+ * auto buffer = mem_mgr.WrapHostMemory(samples.data(), samples.size());
+ * @endcode
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace drv_gpu_lib {
+
+/// Выравнивание host-указателя для zero-copy (страница)
+constexpr size_t kHostPtrAlignment = 4096;
+
+/**
+ * @brief Выделить host-память, выровненную по kHostPtrAlignment
+ *
+ * Размер округляется вверх до кратного выравниванию (требование
+ * std::aligned_alloc и Intel для zero-copy).
+ *
+ * @throws std::bad_alloc
+ */
+inline void* AlignedHostAlloc(size_t size_bytes) {
+    size_t rounded = (size_bytes + kHostPtrAlignment - 1) / kHostPtrAlignment * kHostPtrAlignment;
+    if (rounded == 0) {
+        rounded = kHostPtrAlignment;
+    }
+#ifdef _WIN32
+    void* ptr = _aligned_malloc(rounded, kHostPtrAlignment);
+#else
+    void* ptr = std::aligned_alloc(kHostPtrAlignment, rounded);
+#endif
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+/**
+ * @brief Освободить память из AlignedHostAlloc
+ */
+inline void AlignedHostFree(void* ptr) noexcept {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+/**
+ * @brief Проверить, подходит ли указатель для CL_MEM_USE_HOST_PTR без копии
+ */
+inline bool IsHostPtrAligned(const void* ptr) {
+    return reinterpret_cast<std::uintptr_t>(ptr) % kHostPtrAlignment == 0;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// AlignedHostAllocator - аллокатор для std::vector
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class AlignedHostAllocator
+ * @brief STL-аллокатор поверх AlignedHostAlloc
+ */
+template <typename T>
+struct AlignedHostAllocator {
+    using value_type = T;
+
+    AlignedHostAllocator() noexcept = default;
+    template <typename U>
+    AlignedHostAllocator(const AlignedHostAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(AlignedHostAlloc(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t) noexcept {
+        AlignedHostFree(ptr);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedHostAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedHostAllocator<U>&) const noexcept { return false; }
+};
+
+/// Вектор с выровненным хранилищем (data() подходит для WrapHostMemory)
+template <typename T>
+using AlignedHostVector = std::vector<T, AlignedHostAllocator<T>>;
+
+} // namespace drv_gpu_lib
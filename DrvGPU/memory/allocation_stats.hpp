@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * @file allocation_stats.hpp
+ * @brief Счётчики выделений MemoryManager без блокировок
+ *
+ * Раньше счётчики обновлялись под MemoryManager::mutex_, и все потоки,
+ * выделяющие память на устройстве, выстраивались в очередь за одним lock.
+ * Теперь:
+ * - число выделений/освобождений — в шардах (по потоку), каждый шард
+ *   в своей кэш-линии: потоки не делят строки кэша
+ * - текущий объём — один atomic: точный high-water mark требует общего
+ *   значения, fetch_add не блокирует
+ * - пик — CAS-максимум, обновляется только при росте
+ *
+ * Чтение (Snapshot) суммирует шарды; при конкурентных выделениях это
+ * согласованный «примерно сейчас» срез, не атомарный снимок.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-12
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace drv_gpu_lib {
+
+/**
+ * @struct AllocationStatsSnapshot
+ * @brief Значения счётчиков на момент чтения
+ */
+struct AllocationStatsSnapshot {
+    size_t total_allocations   = 0;
+    size_t total_frees         = 0;
+    size_t current_allocations = 0;
+    size_t current_bytes       = 0;
+    size_t peak_bytes          = 0;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: AllocationStats - шардированные атомарные счётчики
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class AllocationStats
+ * @brief Статистика выделений, безопасная для вызова из любых потоков без lock
+ */
+class AllocationStats {
+public:
+    static constexpr size_t kShards = 16;
+
+    AllocationStats() = default;
+    AllocationStats(const AllocationStats&) = delete;
+    AllocationStats& operator=(const AllocationStats&) = delete;
+
+    void OnAllocate(size_t size_bytes) {
+        LocalShard().allocations.fetch_add(1, std::memory_order_relaxed);
+
+        const int64_t current = current_bytes_.fetch_add(static_cast<int64_t>(size_bytes),
+                                                         std::memory_order_relaxed) +
+                                static_cast<int64_t>(size_bytes);
+        UpdatePeak(current);
+    }
+
+    void OnFree(size_t size_bytes) {
+        LocalShard().frees.fetch_add(1, std::memory_order_relaxed);
+        current_bytes_.fetch_sub(static_cast<int64_t>(size_bytes), std::memory_order_relaxed);
+    }
+
+    AllocationStatsSnapshot Snapshot() const {
+        AllocationStatsSnapshot s;
+        for (const auto& shard : shards_) {
+            s.total_allocations += shard.allocations.load(std::memory_order_relaxed);
+            s.total_frees += shard.frees.load(std::memory_order_relaxed);
+        }
+        const int64_t live = live_base_.load(std::memory_order_relaxed) +
+                             static_cast<int64_t>(s.total_allocations) -
+                             static_cast<int64_t>(s.total_frees);
+        s.current_allocations = live > 0 ? static_cast<size_t>(live) : 0;
+        s.current_bytes = GetCurrentBytes();
+        s.peak_bytes = static_cast<size_t>(peak_bytes_.load(std::memory_order_relaxed));
+        return s;
+    }
+
+    size_t GetCurrentBytes() const {
+        // Освобождение раньше учёта выделения (гонка между потоками) может
+        // на мгновение дать отрицательный остаток; показываем 0
+        const int64_t current = current_bytes_.load(std::memory_order_relaxed);
+        return current > 0 ? static_cast<size_t>(current) : 0;
+    }
+
+    size_t GetCurrentAllocations() const {
+        return Snapshot().current_allocations;
+    }
+
+    /**
+     * @brief Начать новое окно наблюдения
+     *
+     * Сбрасываются только счётчики выделений/освобождений; пик := текущий
+     * объём. Живые байты и число живых выделений остаются: их читает
+     * MemoryBudget, и обнуление при живых буферах занизило бы занятую
+     * память на всё, что было выделено до сброса.
+     */
+    void Reset() {
+        int64_t live = live_base_.load(std::memory_order_relaxed);
+        for (auto& shard : shards_) {
+            live += static_cast<int64_t>(shard.allocations.exchange(0, std::memory_order_relaxed));
+            live -= static_cast<int64_t>(shard.frees.exchange(0, std::memory_order_relaxed));
+        }
+        live_base_.store(live, std::memory_order_relaxed);
+        peak_bytes_.store(current_bytes_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+private:
+    /// 64 байта — кэш-линия x86/ARM; std::hardware_destructive_interference_size есть не везде
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> frees{0};
+    };
+
+    std::array<Shard, kShards> shards_;
+    alignas(64) std::atomic<int64_t> current_bytes_{0};
+    alignas(64) std::atomic<int64_t> peak_bytes_{0};
+    // Живые выделения на момент последнего Reset (шарды после него с нуля)
+    std::atomic<int64_t> live_base_{0};
+
+    Shard& LocalShard() {
+        // Потоки получают шарды по кругу — равномерно при любом числе потоков
+        static std::atomic<size_t> next_shard{0};
+        thread_local const size_t index =
+            next_shard.fetch_add(1, std::memory_order_relaxed) % kShards;
+        return shards_[index];
+    }
+
+    void UpdatePeak(int64_t current) {
+        int64_t peak = peak_bytes_.load(std::memory_order_relaxed);
+        while (current > peak &&
+               !peak_bytes_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+} // namespace drv_gpu_lib
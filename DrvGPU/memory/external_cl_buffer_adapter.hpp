@@ -8,12 +8,20 @@
  * 
  * USE CASE: Обмен данными между DrvGPU и вашим существующим OpenCL кодом
  * 
+ * Событийный обмен (внешний производитель и наш конвейер перекрываются):
+ * - все Async-операции принимают wait-события производителя и
+ *   возвращают событие завершения
+ * - SetComputeQueue / SignalCompute / WaitForCompute — синхронизация,
+ *   когда очередь адаптера и очередь вычислений разные
+ * - ReadAsync(dest, offset, count) — асинхронное чтение диапазона
+ * 
  * @author DrvGPU Team
  * @date 2026-02-01
  */
 
 #include <CL/cl.h>
 #include <vector>
+#include <string>
 #include <stdexcept>
 #include <iostream>
 #include <memory>
@@ -58,6 +66,23 @@ namespace drv_gpu_lib {
  * 
  * // Адаптер НЕ уничтожит your_buffer (owns_buffer = false по умолчанию)
  * @endcode
+ * 
+ * Покадровый обмен без блокировок:
+ * @code
+ * adapter.SetComputeQueue(drvgpu_queue);
+ * 
+ * // Производитель пишет в your_buffer на своей очереди → produced
+ * cl_event ready = adapter.SignalCompute({produced});
+ * // ... kernel на drvgpu_queue с wait-list {ready} → computed ...
+ * 
+ * adapter.WaitForCompute(computed);               // следующая операция адаптера ждёт kernel
+ * cl_event read = adapter.ReadAsync(peaks.data(), offset, count);
+ * // ... CPU занят другим ...
+ * clWaitForEvents(1, &read);
+ * clReleaseEvent(read); clReleaseEvent(ready); clReleaseEvent(computed);
+ * @endcode
+ * 
+ * Возвращаемые cl_event принадлежат вызывающему (clReleaseEvent).
  */
 template<typename T>
 class ExternalCLBufferAdapter {
@@ -129,8 +154,10 @@ public:
      * @brief ЗАГРУЗИТЬ данные в существующий буфер
      * @param host_dest Указатель на буфер CPU (должен быть выделен!)
      * @param num_elements Количество элементов для чтения
+     * @param wait_events События, которых ждёт чтение (например, производителя)
      */
-    void ReadTo(T* host_dest, size_t num_elements);
+    void ReadTo(T* host_dest, size_t num_elements,
+                const std::vector<cl_event>& wait_events = {});
 
     /**
      * @brief ВЫГРУЗИТЬ данные с Host -> GPU (синхронно)
@@ -153,22 +180,78 @@ public:
      * @brief ВЫГРУЗИТЬ данные из raw указателя
      * @param host_data Указатель на данные CPU
      * @param num_elements Количество элементов для записи
+     * @param wait_events События, которых ждёт запись
      */
-    void WriteFrom(const T* host_data, size_t num_elements);
+    void WriteFrom(const T* host_data, size_t num_elements,
+                   const std::vector<cl_event>& wait_events = {});
 
     /**
      * @brief Асинхронное чтение (возвращает event)
      * @param out_data Выходной вектор (будет изменен размер)
+     * @param wait_events События, которых ждёт чтение
+     * @return cl_event для синхронизации
+     */
+    cl_event ReadAsync(std::vector<T>& out_data,
+                       const std::vector<cl_event>& wait_events = {});
+
+    /**
+     * @brief Асинхронное чтение диапазона [offset, offset + count)
+     * @param host_dest Приёмник (count элементов, живёт до завершения события)
+     * @param offset Первый элемент
+     * @param count Количество элементов
+     * @param wait_events События, которых ждёт чтение
      * @return cl_event для синхронизации
      */
-    cl_event ReadAsync(std::vector<T>& out_data);
+    cl_event ReadAsync(T* host_dest, size_t offset, size_t count,
+                       const std::vector<cl_event>& wait_events = {});
 
     /**
      * @brief Асинхронная запись (возвращает event)
-     * @param data Данные для записи
+     * @param data Данные для записи (живут до завершения события)
+     * @param wait_events События, которых ждёт запись
      * @return cl_event для синхронизации
      */
-    cl_event WriteAsync(const std::vector<T>& data);
+    cl_event WriteAsync(const std::vector<T>& data,
+                        const std::vector<cl_event>& wait_events = {});
+
+    /**
+     * @brief Асинхронная запись диапазона [offset, offset + count)
+     */
+    cl_event WriteAsync(const T* host_data, size_t offset, size_t count,
+                        const std::vector<cl_event>& wait_events = {});
+
+    // ═══════════════════════════════════════════════════════════════
+    // Синхронизация с очередью вычислений
+    // ═══════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Задать очередь вычислений (DrvGPU), с которой обменивается адаптер
+     * @throws std::invalid_argument если очередь из другого cl_context
+     */
+    void SetComputeQueue(cl_command_queue compute_queue);
+
+    /**
+     * @brief Очереди адаптера и вычислений разные (нужна синхронизация событиями)
+     */
+    bool NeedsCrossQueueSync() const {
+        return compute_queue_ != nullptr && compute_queue_ != queue_;
+    }
+
+    /**
+     * @brief Событие «данные в буфере готовы» для очереди вычислений
+     * 
+     * Marker на очереди адаптера после producer_events и всех ранее
+     * поставленных операций адаптера. При разных очередях очередь
+     * адаптера сбрасывается (clFlush), иначе событие может не наступить.
+     */
+    cl_event SignalCompute(const std::vector<cl_event>& producer_events = {});
+
+    /**
+     * @brief Следующая операция адаптера дождётся compute_event
+     * 
+     * Для общей in-order очереди ничего не делает (порядок и так сохранён).
+     */
+    void WaitForCompute(cl_event compute_event);
 
     // ═══════════════════════════════════════════════════════════════
     // Информация о буфере
@@ -204,6 +287,11 @@ public:
      */
     void Flush();
 
+    /**
+     * @brief Вывести информацию об адаптере
+     */
+    void PrintInfo() const;
+
 private:
     // ═══════════════════════════════════════════════════════════════
     // Члены класса
@@ -214,6 +302,8 @@ private:
     size_t size_bytes_;          ///< Размер в байтах
     cl_command_queue queue_;     ///< Command queue для операций
     bool owns_buffer_;           ///< Владеет ли адаптер буфером
+    cl_command_queue compute_queue_ = nullptr;  ///< Очередь вычислений (не владеет)
+    std::vector<cl_event> pending_waits_;       ///< От WaitForCompute (retained)
 
     // ═══════════════════════════════════════════════════════════════
     // Приватные методы
@@ -223,6 +313,18 @@ private:
      * @brief Проверка OpenCL ошибок
      */
     static void CheckCLError(cl_int err, const std::string& operation);
+
+    /**
+     * @brief wait_events + отложенные события WaitForCompute
+     */
+    std::vector<cl_event> BuildWaitList(const std::vector<cl_event>& wait_events) const;
+
+    /**
+     * @brief Освободить отложенные события (после успешной постановки)
+     */
+    void ReleasePendingWaits();
+
+    void CheckRange(size_t offset, size_t count, const char* operation) const;
 };
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -252,18 +354,13 @@ ExternalCLBufferAdapter<T>::ExternalCLBufferAdapter(
     if (num_elements_ == 0) {
         throw std::invalid_argument("ExternalCLBufferAdapter: num_elements must be > 0");
     }
-
-    std::cout << "[ExternalCLBufferAdapter] Created adapter for " 
-              << num_elements_ << " elements (" 
-              << (size_bytes_ / 1024.0 / 1024.0) << " MB)\n";
-    std::cout << "[ExternalCLBufferAdapter] Owns buffer: " 
-              << (owns_buffer_ ? "YES" : "NO") << "\n";
+    // Без вывода: адаптер создаётся на каждый кадр (см. PrintInfo)
 }
 
 template<typename T>
 ExternalCLBufferAdapter<T>::~ExternalCLBufferAdapter() {
+    ReleasePendingWaits();
     if (owns_buffer_ && buffer_) {
-        std::cout << "[ExternalCLBufferAdapter] Releasing owned cl_mem buffer\n";
         clReleaseMemObject(buffer_);
     }
     buffer_ = nullptr;
@@ -276,9 +373,12 @@ ExternalCLBufferAdapter<T>::ExternalCLBufferAdapter(ExternalCLBufferAdapter&& ot
     , size_bytes_(other.size_bytes_)
     , queue_(other.queue_)
     , owns_buffer_(other.owns_buffer_)
+    , compute_queue_(other.compute_queue_)
+    , pending_waits_(std::move(other.pending_waits_))
 {
     other.buffer_ = nullptr;
     other.owns_buffer_ = false;
+    other.pending_waits_.clear();
 }
 
 template<typename T>
@@ -290,6 +390,7 @@ ExternalCLBufferAdapter<T>& ExternalCLBufferAdapter<T>::operator=(
         if (owns_buffer_ && buffer_) {
             clReleaseMemObject(buffer_);
         }
+        ReleasePendingWaits();
 
         // Переместить ресурсы
         buffer_ = other.buffer_;
@@ -297,10 +398,13 @@ ExternalCLBufferAdapter<T>& ExternalCLBufferAdapter<T>::operator=(
         size_bytes_ = other.size_bytes_;
         queue_ = other.queue_;
         owns_buffer_ = other.owns_buffer_;
+        compute_queue_ = other.compute_queue_;
+        pending_waits_ = std::move(other.pending_waits_);
 
         // Инвалидировать источник
         other.buffer_ = nullptr;
         other.owns_buffer_ = false;
+        other.pending_waits_.clear();
     }
     return *this;
 }
@@ -328,7 +432,8 @@ std::vector<T> ExternalCLBufferAdapter<T>::ReadPartial(size_t num_elements) {
 }
 
 template<typename T>
-void ExternalCLBufferAdapter<T>::ReadTo(T* host_dest, size_t num_elements) {
+void ExternalCLBufferAdapter<T>::ReadTo(T* host_dest, size_t num_elements,
+                                        const std::vector<cl_event>& wait_events) {
     if (!host_dest) {
         throw std::invalid_argument("ReadTo: host_dest is null");
     }
@@ -338,6 +443,7 @@ void ExternalCLBufferAdapter<T>::ReadTo(T* host_dest, size_t num_elements) {
     }
 
     // Синхронное чтение с GPU -> Host
+    std::vector<cl_event> waits = BuildWaitList(wait_events);
     cl_int err = clEnqueueReadBuffer(
         queue_,
         buffer_,
@@ -345,12 +451,13 @@ void ExternalCLBufferAdapter<T>::ReadTo(T* host_dest, size_t num_elements) {
         0,                              // offset
         num_elements * sizeof(T),       // size
         host_dest,                      // dest pointer
-        0,                              // num_events_in_wait_list
-        nullptr,                        // event_wait_list
+        static_cast<cl_uint>(waits.size()),
+        waits.empty() ? nullptr : waits.data(),
         nullptr                         // event
     );
 
     CheckCLError(err, "ReadTo (clEnqueueReadBuffer)");
+    ReleasePendingWaits();
 }
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -370,7 +477,8 @@ void ExternalCLBufferAdapter<T>::Write(const std::vector<T>& data) {
 }
 
 template<typename T>
-void ExternalCLBufferAdapter<T>::WriteFrom(const T* host_data, size_t num_elements) {
+void ExternalCLBufferAdapter<T>::WriteFrom(const T* host_data, size_t num_elements,
+                                           const std::vector<cl_event>& wait_events) {
     if (!host_data) {
         throw std::invalid_argument("WriteFrom: host_data is null");
     }
@@ -380,6 +488,7 @@ void ExternalCLBufferAdapter<T>::WriteFrom(const T* host_data, size_t num_elemen
     }
 
     // Синхронная запись с Host -> GPU
+    std::vector<cl_event> waits = BuildWaitList(wait_events);
     cl_int err = clEnqueueWriteBuffer(
         queue_,
         buffer_,
@@ -387,12 +496,13 @@ void ExternalCLBufferAdapter<T>::WriteFrom(const T* host_data, size_t num_elemen
         0,                              // offset
         num_elements * sizeof(T),       // size
         host_data,                      // src pointer
-        0,                              // num_events_in_wait_list
-        nullptr,                        // event_wait_list
+        static_cast<cl_uint>(waits.size()),
+        waits.empty() ? nullptr : waits.data(),
         nullptr                         // event
     );
 
     CheckCLError(err, "WriteFrom (clEnqueueWriteBuffer)");
+    ReleasePendingWaits();
 }
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -400,51 +510,159 @@ void ExternalCLBufferAdapter<T>::WriteFrom(const T* host_data, size_t num_elemen
 // ════════════════════════════════════════════════════════════════════════════
 
 template<typename T>
-cl_event ExternalCLBufferAdapter<T>::ReadAsync(std::vector<T>& out_data) {
+cl_event ExternalCLBufferAdapter<T>::ReadAsync(std::vector<T>& out_data,
+                                               const std::vector<cl_event>& wait_events) {
     if (out_data.size() < num_elements_) {
         out_data.resize(num_elements_);
     }
+    return ReadAsync(out_data.data(), 0, num_elements_, wait_events);
+}
+
+template<typename T>
+cl_event ExternalCLBufferAdapter<T>::ReadAsync(T* host_dest, size_t offset, size_t count,
+                                               const std::vector<cl_event>& wait_events) {
+    if (!host_dest) {
+        throw std::invalid_argument("ReadAsync: host_dest is null");
+    }
+    CheckRange(offset, count, "ReadAsync");
 
+    std::vector<cl_event> waits = BuildWaitList(wait_events);
     cl_event event = nullptr;
     cl_int err = clEnqueueReadBuffer(
         queue_,
         buffer_,
         CL_FALSE,                       // non-blocking
-        0,
-        num_elements_ * sizeof(T),
-        out_data.data(),
-        0,
-        nullptr,
+        offset * sizeof(T),
+        count * sizeof(T),
+        host_dest,
+        static_cast<cl_uint>(waits.size()),
+        waits.empty() ? nullptr : waits.data(),
         &event
     );
 
     CheckCLError(err, "ReadAsync (clEnqueueReadBuffer)");
+    ReleasePendingWaits();
     return event;
 }
 
 template<typename T>
-cl_event ExternalCLBufferAdapter<T>::WriteAsync(const std::vector<T>& data) {
+cl_event ExternalCLBufferAdapter<T>::WriteAsync(const std::vector<T>& data,
+                                                const std::vector<cl_event>& wait_events) {
     if (data.size() > num_elements_) {
         throw std::runtime_error("WriteAsync: data size exceeds buffer capacity");
     }
+    return WriteAsync(data.data(), 0, data.size(), wait_events);
+}
+
+template<typename T>
+cl_event ExternalCLBufferAdapter<T>::WriteAsync(const T* host_data, size_t offset, size_t count,
+                                                const std::vector<cl_event>& wait_events) {
+    if (!host_data) {
+        throw std::invalid_argument("WriteAsync: host_data is null");
+    }
+    CheckRange(offset, count, "WriteAsync");
 
+    std::vector<cl_event> waits = BuildWaitList(wait_events);
     cl_event event = nullptr;
     cl_int err = clEnqueueWriteBuffer(
         queue_,
         buffer_,
         CL_FALSE,                       // non-blocking
-        0,
-        data.size() * sizeof(T),
-        data.data(),
-        0,
-        nullptr,
+        offset * sizeof(T),
+        count * sizeof(T),
+        host_data,
+        static_cast<cl_uint>(waits.size()),
+        waits.empty() ? nullptr : waits.data(),
         &event
     );
 
     CheckCLError(err, "WriteAsync (clEnqueueWriteBuffer)");
+    ReleasePendingWaits();
     return event;
 }
 
+// ════════════════════════════════════════════════════════════════════════════
+// Синхронизация с очередью вычислений
+// ════════════════════════════════════════════════════════════════════════════
+
+template<typename T>
+void ExternalCLBufferAdapter<T>::SetComputeQueue(cl_command_queue compute_queue) {
+    if (compute_queue && compute_queue != queue_) {
+        // События переходят между очередями только внутри одного контекста
+        cl_context own_context = nullptr;
+        cl_context compute_context = nullptr;
+        clGetCommandQueueInfo(queue_, CL_QUEUE_CONTEXT, sizeof(own_context), &own_context, nullptr);
+        clGetCommandQueueInfo(compute_queue, CL_QUEUE_CONTEXT, sizeof(compute_context),
+                              &compute_context, nullptr);
+        if (own_context != compute_context) {
+            throw std::invalid_argument(
+                "SetComputeQueue: compute queue belongs to a different cl_context");
+        }
+    }
+    compute_queue_ = compute_queue;
+}
+
+template<typename T>
+cl_event ExternalCLBufferAdapter<T>::SignalCompute(const std::vector<cl_event>& producer_events) {
+    std::vector<cl_event> waits = BuildWaitList(producer_events);
+    cl_event event = nullptr;
+    cl_int err = clEnqueueMarkerWithWaitList(
+        queue_,
+        static_cast<cl_uint>(waits.size()),
+        waits.empty() ? nullptr : waits.data(),
+        &event
+    );
+    CheckCLError(err, "SignalCompute (clEnqueueMarkerWithWaitList)");
+    ReleasePendingWaits();
+
+    if (NeedsCrossQueueSync()) {
+        clFlush(queue_);
+    }
+    return event;
+}
+
+template<typename T>
+void ExternalCLBufferAdapter<T>::WaitForCompute(cl_event compute_event) {
+    if (!compute_event || (compute_queue_ && !NeedsCrossQueueSync())) {
+        return;
+    }
+    clRetainEvent(compute_event);
+    pending_waits_.push_back(compute_event);
+}
+
+template<typename T>
+std::vector<cl_event> ExternalCLBufferAdapter<T>::BuildWaitList(
+    const std::vector<cl_event>& wait_events) const
+{
+    std::vector<cl_event> waits;
+    waits.reserve(wait_events.size() + pending_waits_.size());
+    for (cl_event e : wait_events) {
+        if (e) waits.push_back(e);
+    }
+    waits.insert(waits.end(), pending_waits_.begin(), pending_waits_.end());
+    return waits;
+}
+
+template<typename T>
+void ExternalCLBufferAdapter<T>::ReleasePendingWaits() {
+    for (cl_event e : pending_waits_) {
+        clReleaseEvent(e);
+    }
+    pending_waits_.clear();
+}
+
+template<typename T>
+void ExternalCLBufferAdapter<T>::CheckRange(size_t offset, size_t count,
+                                            const char* operation) const {
+    if (offset > num_elements_ || count > num_elements_ - offset) {
+        throw std::runtime_error(
+            std::string(operation) + ": range [" + std::to_string(offset) + ", " +
+            std::to_string(offset + count) + ") exceeds buffer size (" +
+            std::to_string(num_elements_) + ")"
+        );
+    }
+}
+
 // ════════════════════════════════════════════════════════════════════════════
 // Утилиты
 // ════════════════════════════════════════════════════════════════════════════
@@ -463,6 +681,14 @@ void ExternalCLBufferAdapter<T>::Flush() {
     }
 }
 
+template<typename T>
+void ExternalCLBufferAdapter<T>::PrintInfo() const {
+    std::cout << "[ExternalCLBufferAdapter] " << num_elements_ << " elements ("
+              << (size_bytes_ / 1024.0 / 1024.0) << " MB), owns buffer: "
+              << (owns_buffer_ ? "YES" : "NO") << ", compute queue: "
+              << (NeedsCrossQueueSync() ? "separate" : "shared") << "\n";
+}
+
 template<typename T>
 void ExternalCLBufferAdapter<T>::CheckCLError(cl_int err, const std::string& operation) {
     if (err != CL_SUCCESS) {
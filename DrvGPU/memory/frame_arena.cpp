@@ -0,0 +1,241 @@
+/**
+ * @file frame_arena.cpp
+ * @brief Реализация FrameArena / FrameBufferView
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "memory/frame_arena.hpp"
+#include "interface/i_backend.hpp"
+#include "logger/logger.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace drv_gpu_lib {
+
+namespace {
+
+/// Шаблон заливки освобождённой памяти в debug-режиме
+constexpr uint32_t kPoisonPattern = 0xDEADBEEFu;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool IsPowerOfTwo(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+} // anonymous namespace
+
+// ════════════════════════════════════════════════════════════════════════════
+// FrameBufferView
+// ════════════════════════════════════════════════════════════════════════════
+
+FrameBufferView::FrameBufferView(cl_mem sub_buffer, size_t offset, size_t size,
+                                 std::shared_ptr<const FrameArenaState> state,
+                                 bool debug_checks)
+    : sub_buffer_(sub_buffer)
+    , offset_(offset)
+    , size_(size)
+    , generation_(state->generation)
+    , debug_checks_(debug_checks)
+    , state_(std::move(state))
+{
+}
+
+FrameBufferView::~FrameBufferView() {
+    Release();
+}
+
+FrameBufferView::FrameBufferView(FrameBufferView&& other) noexcept
+    : sub_buffer_(other.sub_buffer_)
+    , offset_(other.offset_)
+    , size_(other.size_)
+    , generation_(other.generation_)
+    , debug_checks_(other.debug_checks_)
+    , state_(std::move(other.state_))
+{
+    other.sub_buffer_ = nullptr;
+    other.size_ = 0;
+}
+
+FrameBufferView& FrameBufferView::operator=(FrameBufferView&& other) noexcept {
+    if (this != &other) {
+        Release();
+
+        sub_buffer_ = other.sub_buffer_;
+        offset_ = other.offset_;
+        size_ = other.size_;
+        generation_ = other.generation_;
+        debug_checks_ = other.debug_checks_;
+        state_ = std::move(other.state_);
+
+        other.sub_buffer_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+void FrameBufferView::Release() {
+    if (sub_buffer_) {
+        // Sub-buffer держит ссылку на родителя — освобождается и после арены
+        clReleaseMemObject(sub_buffer_);
+        sub_buffer_ = nullptr;
+    }
+    state_.reset();
+}
+
+bool FrameBufferView::IsValid() const {
+    return sub_buffer_ && state_ && state_->alive && state_->generation == generation_;
+}
+
+cl_mem FrameBufferView::Get() const {
+    if (debug_checks_ && !IsValid()) {
+        std::string reason = !sub_buffer_ ? "empty view"
+                           : !state_->alive ? "arena destroyed"
+                           : "arena reset (generation " + std::to_string(generation_) +
+                             " → " + std::to_string(state_->generation) + ")";
+        DRVGPU_LOG_ERROR("FrameArena", "use-after-reset: " + reason);
+        throw std::logic_error("FrameBufferView: use after reset (" + reason + ")");
+    }
+    return sub_buffer_;
+}
+
+void FrameBufferView::SetAsKernelArg(cl_kernel kernel, cl_uint arg_index) const {
+    cl_mem mem = Get();
+    cl_int err = clSetKernelArg(kernel, arg_index, sizeof(cl_mem), &mem);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("FrameBufferView: clSetKernelArg failed: " + std::to_string(err));
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// FrameArena
+// ════════════════════════════════════════════════════════════════════════════
+
+FrameArena::FrameArena(cl_context context, cl_device_id device, cl_command_queue queue,
+                       size_t capacity_bytes)
+    : context_(context)
+    , queue_(queue)
+    , capacity_(capacity_bytes)
+{
+    Create(device);
+}
+
+FrameArena::FrameArena(IBackend* backend, size_t capacity_bytes)
+    : capacity_(capacity_bytes)
+{
+    if (!backend || !backend->IsInitialized()) {
+        throw std::invalid_argument("FrameArena: backend is null or not initialized");
+    }
+    context_ = static_cast<cl_context>(backend->GetNativeContext());
+    queue_ = static_cast<cl_command_queue>(backend->GetNativeQueue());
+    Create(static_cast<cl_device_id>(backend->GetNativeDevice()));
+}
+
+void FrameArena::Create(cl_device_id device) {
+    if (!context_ || !device || !queue_) {
+        throw std::invalid_argument("FrameArena: context, device and queue must not be null");
+    }
+    if (capacity_ == 0) {
+        throw std::invalid_argument("FrameArena: capacity must be > 0");
+    }
+
+    // Origin sub-buffer должен быть кратен CL_DEVICE_MEM_BASE_ADDR_ALIGN (в битах);
+    // не меньше 128 байт, чтобы соседние view не делили кэш-линию
+    cl_uint align_bits = 0;
+    clGetDeviceInfo(device, CL_DEVICE_MEM_BASE_ADDR_ALIGN, sizeof(align_bits), &align_bits, nullptr);
+    base_alignment_ = std::max<size_t>(align_bits / 8, 128);
+
+    cl_int err = CL_SUCCESS;
+    buffer_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, capacity_, nullptr, &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("FrameArena: clCreateBuffer failed for " +
+                                 std::to_string(capacity_) + " bytes: " + std::to_string(err));
+    }
+
+    state_ = std::make_shared<FrameArenaState>();
+}
+
+FrameArena::~FrameArena() {
+    if (state_) {
+        state_->alive = false;
+    }
+    if (buffer_) {
+        clReleaseMemObject(buffer_);
+        buffer_ = nullptr;
+    }
+    if (release_callback_) {
+        release_callback_();
+    }
+}
+
+FrameBufferView FrameArena::Allocate(size_t size_bytes, size_t alignment) {
+    if (size_bytes == 0) {
+        throw std::invalid_argument("FrameArena::Allocate: size must be > 0");
+    }
+    if (alignment != 0 && !IsPowerOfTwo(alignment)) {
+        throw std::invalid_argument("FrameArena::Allocate: alignment must be a power of two");
+    }
+
+    const size_t align = std::max(alignment, base_alignment_);
+    const size_t origin = AlignUp(offset_, align);
+    if (origin > capacity_ || size_bytes > capacity_ - origin) {
+        throw std::runtime_error(
+            "FrameArena::Allocate: out of arena memory (requested " + std::to_string(size_bytes) +
+            " bytes, used " + std::to_string(offset_) + " of " + std::to_string(capacity_) + ")");
+    }
+
+    cl_buffer_region region;
+    region.origin = origin;
+    region.size = size_bytes;
+
+    cl_int err = CL_SUCCESS;
+    cl_mem sub_buffer = clCreateSubBuffer(buffer_, CL_MEM_READ_WRITE,
+                                          CL_BUFFER_CREATE_TYPE_REGION, &region, &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("FrameArena::Allocate: clCreateSubBuffer failed: " +
+                                 std::to_string(err));
+    }
+
+    offset_ = origin + size_bytes;
+    peak_ = std::max(peak_, offset_);
+    ++allocations_;
+
+    return FrameBufferView(sub_buffer, origin, size_bytes, state_, debug_checks_);
+}
+
+void FrameArena::Reset() {
+    if (debug_checks_ && offset_ > 0) {
+        // Заливка освобождённого: устаревший view в kernel → заметный мусор
+        const size_t fill_bytes = std::min(AlignUp(offset_, sizeof(kPoisonPattern)),
+                                           capacity_ / sizeof(kPoisonPattern) * sizeof(kPoisonPattern));
+        cl_int err = clEnqueueFillBuffer(queue_, buffer_, &kPoisonPattern, sizeof(kPoisonPattern),
+                                         0, fill_bytes, 0, nullptr, nullptr);
+        if (err != CL_SUCCESS) {
+            DRVGPU_LOG_WARNING("FrameArena", "poison fill failed: " + std::to_string(err));
+        }
+    }
+
+    offset_ = 0;
+    allocations_ = 0;
+    ++state_->generation;
+}
+
+std::string FrameArena::GetStatistics() const {
+    std::ostringstream oss;
+    oss << "FrameArena: " << std::fixed << std::setprecision(2)
+        << (offset_ / (1024.0 * 1024.0)) << " / " << (capacity_ / (1024.0 * 1024.0))
+        << " MB used (peak " << (peak_ / (1024.0 * 1024.0)) << " MB), "
+        << allocations_ << " allocations, generation " << state_->generation
+        << ", alignment " << base_alignment_ << " B"
+        << (debug_checks_ ? ", debug checks" : "") << "\n";
+    return oss.str();
+}
+
+} // namespace drv_gpu_lib
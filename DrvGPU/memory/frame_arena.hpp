@@ -0,0 +1,220 @@
+#pragma once
+
+/**
+ * @file frame_arena.hpp
+ * @brief Арена памяти устройства на один кадр (per-stream)
+ *
+ * Временные буферы модулей (userdata, maxima, selected) живут ровно один
+ * кадр. Вместо clCreateBuffer/clReleaseMemObject на каждый кадр:
+ * - один большой cl_mem резервируется заранее
+ * - Allocate() сдвигает указатель (bump) с выравниванием и отдаёт
+ *   sub-buffer (clCreateSubBuffer) — без выделения памяти драйвером
+ * - Reset() в конце кадра освобождает всё разом
+ *
+ * Debug-режим (по умолчанию в сборке без NDEBUG): обращение к view после
+ * Reset() бросает std::logic_error, а освобождённый диапазон заливается
+ * шаблоном 0xDEADBEEF — kernel, прочитавший устаревший view, сразу даёт мусор.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include <CL/cl.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace drv_gpu_lib {
+
+class IBackend;
+
+/**
+ * @brief Общее состояние арены: поколение кадра (для проверки view)
+ */
+struct FrameArenaState {
+    uint64_t generation = 0;   ///< Увеличивается на каждом Reset()
+    bool     alive      = true;  ///< false после уничтожения арены
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: FrameBufferView - sub-buffer арены на один кадр
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class FrameBufferView
+ * @brief Sub-buffer внутри FrameArena (RAII для cl_mem sub-buffer)
+ *
+ * Действителен до ближайшего FrameArena::Reset(). Копирование запрещено,
+ * перемещение разрешено (view можно вернуть из функции / хранить в векторе).
+ */
+class FrameBufferView {
+public:
+    FrameBufferView() = default;
+    ~FrameBufferView();
+
+    FrameBufferView(const FrameBufferView&) = delete;
+    FrameBufferView& operator=(const FrameBufferView&) = delete;
+
+    FrameBufferView(FrameBufferView&& other) noexcept;
+    FrameBufferView& operator=(FrameBufferView&& other) noexcept;
+
+    /**
+     * @brief cl_mem sub-buffer для clSetKernelArg / clEnqueue*
+     * @throws std::logic_error в debug-режиме, если арена сброшена (use-after-reset)
+     */
+    cl_mem Get() const;
+
+    /**
+     * @brief Установить как аргумент kernel (с той же проверкой, что Get())
+     */
+    void SetAsKernelArg(cl_kernel kernel, cl_uint arg_index) const;
+
+    /// View принадлежит текущему кадру арены
+    bool IsValid() const;
+
+    size_t GetOffset() const { return offset_; }
+    size_t GetSize() const { return size_; }
+    uint64_t GetGeneration() const { return generation_; }
+
+private:
+    friend class FrameArena;
+
+    FrameBufferView(cl_mem sub_buffer, size_t offset, size_t size,
+                    std::shared_ptr<const FrameArenaState> state, bool debug_checks);
+
+    void Release();
+
+    cl_mem   sub_buffer_   = nullptr;
+    size_t   offset_       = 0;
+    size_t   size_         = 0;
+    uint64_t generation_   = 0;
+    bool     debug_checks_ = false;
+    std::shared_ptr<const FrameArenaState> state_;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: FrameArena - bump-аллокатор поверх одного cl_mem
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class FrameArena
+ * @brief Арена временных буферов одного потока (очереди) на кадр
+ *
+ * Не потокобезопасна: одна арена — одна очередь (stream). Для нескольких
+ * потоков обработки — по арене на поток.
+ *
+ * @code
+ * auto arena = mem_mgr.CreateFrameArena(64 * 1024 * 1024);
+ *
+ * for (auto& frame : frames) {
+ *     FrameBufferView userdata = arena->Allocate(userdata_bytes);
+ *     FrameBufferView maxima = arena->AllocateArray<MaxValue>(beams * 4);
+ *     userdata.SetAsKernelArg(kernel, 0);
+ *     maxima.SetAsKernelArg(kernel, 1);
+ *     // ... enqueue, read results ...
+ *     arena->Reset();   // конец кадра (работа над кадром завершена)
+ * }
+ * @endcode
+ */
+class FrameArena {
+public:
+    /**
+     * @brief Зарезервировать арену
+     * @param context OpenCL context
+     * @param device Устройство (выравнивание CL_DEVICE_MEM_BASE_ADDR_ALIGN)
+     * @param queue Очередь потока (заливка в debug-режиме)
+     * @param capacity_bytes Размер резерва
+     * @throws std::runtime_error если clCreateBuffer failed
+     */
+    FrameArena(cl_context context, cl_device_id device, cl_command_queue queue,
+               size_t capacity_bytes);
+
+    /**
+     * @brief Арена на контексте/устройстве/очереди бэкенда
+     */
+    FrameArena(IBackend* backend, size_t capacity_bytes);
+
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // ═══════════════════════════════════════════════════════════════
+    // Выделение
+    // ═══════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Выделить sub-buffer на текущий кадр
+     * @param size_bytes Размер (> 0)
+     * @param alignment Выравнивание в байтах (степень двойки); не меньше
+     *        базового выравнивания устройства, 0 — базовое
+     * @throws std::runtime_error если арена переполнена
+     */
+    FrameBufferView Allocate(size_t size_bytes, size_t alignment = 0);
+
+    /**
+     * @brief Выделить массив из count элементов T
+     */
+    template<typename T>
+    FrameBufferView AllocateArray(size_t count, size_t alignment = 0) {
+        return Allocate(count * sizeof(T), alignment);
+    }
+
+    /**
+     * @brief Конец кадра: все view становятся недействительными
+     *
+     * Вызывать после завершения работы над кадром на устройстве
+     * (clFinish / ожидание последнего события). В debug-режиме занятая
+     * часть заливается 0xDEADBEEF.
+     */
+    void Reset();
+
+    // ═══════════════════════════════════════════════════════════════
+    // Информация
+    // ═══════════════════════════════════════════════════════════════
+
+    size_t GetCapacity() const { return capacity_; }
+    size_t GetUsedBytes() const { return offset_; }
+    size_t GetPeakBytes() const { return peak_; }
+    size_t GetBaseAlignment() const { return base_alignment_; }
+    uint64_t GetGeneration() const { return state_->generation; }
+    cl_mem GetCLMem() const { return buffer_; }
+
+    /**
+     * @brief Включить/выключить проверки use-after-reset
+     *
+     * Действует на view, выделенные после вызова.
+     */
+    void SetDebugChecks(bool enabled) { debug_checks_ = enabled; }
+    bool IsDebugChecksEnabled() const { return debug_checks_; }
+
+    std::string GetStatistics() const;
+
+    /**
+     * @brief Вызвать после освобождения резерва (учёт в MemoryManager)
+     */
+    void SetReleaseCallback(std::function<void()> callback) { release_callback_ = std::move(callback); }
+
+private:
+    cl_context       context_        = nullptr;
+    cl_command_queue queue_          = nullptr;
+    cl_mem           buffer_         = nullptr;
+    size_t           capacity_       = 0;
+    size_t           offset_         = 0;
+    size_t           peak_           = 0;
+    size_t           base_alignment_ = 0;
+    size_t           allocations_    = 0;   ///< Выделений в текущем кадре
+#ifdef NDEBUG
+    bool             debug_checks_   = false;
+#else
+    bool             debug_checks_   = true;
+#endif
+    std::shared_ptr<FrameArenaState> state_;
+    std::function<void()> release_callback_;
+
+    void Create(cl_device_id device);
+};
+
+} // namespace drv_gpu_lib
@@ -0,0 +1,132 @@
+#pragma once
+
+/**
+ * @file memory_budget.hpp
+ * @brief Бюджет памяти устройства (max_memory_percent из configGPU.json)
+ *
+ * Один бюджет на устройство, общий для всех MemoryManager этого устройства
+ * (DrvGPU и бэкенда — модули выделяют через backend->GetMemoryManager()).
+ * Занятый объём — сумма AllocationStats подключённых менеджеров, отдельного
+ * счётчика нет: учёт остаётся там, где он уже ведётся.
+ *
+ * Список менеджеров публикуется неизменяемым снимком (как таблица
+ * ModuleRegistry): Attach редкий, а Fits() на каждом выделении читает
+ * его одним acquire load, без mutex.
+ *
+ * Проверка мягкая: Fits() перед выделением, без резервирования. Параллельные
+ * выделения могут превысить лимит не больше чем на одно выделение каждое —
+ * для бюджета «не занимать всю карту» этого достаточно.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-12
+ */
+
+#include "allocation_stats.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: MemoryBudget - лимит памяти устройства
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class MemoryBudget
+ * @brief Лимит байт на устройство поверх счётчиков MemoryManager
+ */
+class MemoryBudget {
+public:
+    /// Остаток бюджета без лимита
+    static constexpr size_t kUnlimited = std::numeric_limits<size_t>::max();
+
+    MemoryBudget() = default;
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    /**
+     * @brief Установить лимит (0 — без лимита)
+     */
+    void SetLimit(size_t limit_bytes) {
+        limit_bytes_.store(limit_bytes, std::memory_order_relaxed);
+    }
+
+    size_t GetLimit() const {
+        return limit_bytes_.load(std::memory_order_relaxed);
+    }
+
+    bool HasLimit() const { return GetLimit() != 0; }
+
+    /**
+     * @brief Учитывать выделения ещё одного менеджера
+     *
+     * Копирует список и публикует новый снимок; прежние снимки живут
+     * до уничтожения бюджета (их может ещё читать GetUsedBytes).
+     */
+    void Attach(std::shared_ptr<const AllocationStats> stats) {
+        if (!stats) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        const StatsList* current = current_.load(std::memory_order_relaxed);
+        auto list = std::make_unique<StatsList>();
+        if (current) {
+            for (const auto& existing : *current) {
+                if (existing == stats) return;
+            }
+            *list = *current;
+        }
+        list->push_back(std::move(stats));
+        lists_.push_back(std::move(list));
+        current_.store(lists_.back().get(), std::memory_order_release);
+    }
+
+    /**
+     * @brief Занято всеми подключёнными менеджерами (без блокировок)
+     */
+    size_t GetUsedBytes() const {
+        const StatsList* list = current_.load(std::memory_order_acquire);
+        if (!list) {
+            return 0;
+        }
+        size_t used = 0;
+        for (const auto& stats : *list) {
+            used += stats->GetCurrentBytes();
+        }
+        return used;
+    }
+
+    /**
+     * @brief Свободно в бюджете (kUnlimited, если лимита нет)
+     */
+    size_t GetRemainingBytes() const {
+        const size_t limit = GetLimit();
+        if (limit == 0) {
+            return kUnlimited;
+        }
+        const size_t used = GetUsedBytes();
+        return used < limit ? limit - used : 0;
+    }
+
+    /**
+     * @brief Поместится ли выделение size_bytes
+     */
+    bool Fits(size_t size_bytes) const {
+        return !HasLimit() || size_bytes <= GetRemainingBytes();
+    }
+
+private:
+    using StatsList = std::vector<std::shared_ptr<const AllocationStats>>;
+
+    std::atomic<size_t> limit_bytes_{0};
+
+    // Все опубликованные снимки; текущий — current_. mutex_ — только для Attach
+    std::vector<std::unique_ptr<const StatsList>> lists_;
+    std::atomic<const StatsList*> current_{nullptr};
+    std::mutex mutex_;
+};
+
+} // namespace drv_gpu_lib
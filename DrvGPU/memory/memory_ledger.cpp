@@ -0,0 +1,257 @@
+/**
+ * @file memory_ledger.cpp
+ * @brief Реализация MemoryLedger / ScopedMemoryTag
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-11
+ */
+
+#include "memory/memory_ledger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <sstream>
+
+namespace drv_gpu_lib {
+
+namespace {
+
+/**
+ * Метка потока и счётчики, в которые она уже разрешена.
+ * Несколько слотов — поток может выделять через разные MemoryManager
+ * (у каждого свой ledger) в одной области метки.
+ */
+struct ThreadTagState {
+    static constexpr size_t kSlots = 4;
+
+    std::string tag = MemoryLedger::kUntagged;
+    std::array<uint64_t, kSlots> ledger_ids{};
+    std::array<MemoryLedger::TagCounters*, kSlots> counters{};
+    size_t next_slot = 0;
+
+    void Invalidate() {
+        ledger_ids.fill(0);
+        next_slot = 0;
+    }
+};
+
+ThreadTagState& CurrentState() {
+    thread_local ThreadTagState state;
+    return state;
+}
+
+uint64_t NextLedgerId() {
+    static std::atomic<uint64_t> next_id{1};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+// ════════════════════════════════════════════════════════════════════════════
+// ScopedMemoryTag
+// ════════════════════════════════════════════════════════════════════════════
+
+ScopedMemoryTag::ScopedMemoryTag(std::string tag)
+    : previous_(std::move(CurrentState().tag))
+{
+    ThreadTagState& state = CurrentState();
+    state.tag = std::move(tag);
+    state.Invalidate();
+}
+
+ScopedMemoryTag::~ScopedMemoryTag() {
+    ThreadTagState& state = CurrentState();
+    state.tag = std::move(previous_);
+    state.Invalidate();
+}
+
+const std::string& ScopedMemoryTag::Current() {
+    return CurrentState().tag;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// MemoryLedger
+// ════════════════════════════════════════════════════════════════════════════
+
+MemoryLedger::MemoryLedger()
+    : id_(NextLedgerId())
+{
+}
+
+MemoryLedger::TagCounters& MemoryLedger::CurrentCounters() {
+    ThreadTagState& state = CurrentState();
+    for (size_t i = 0; i < ThreadTagState::kSlots; ++i) {
+        if (state.ledger_ids[i] == id_) {
+            return *state.counters[i];
+        }
+    }
+
+    TagCounters& c = Counters(state.tag);
+    const size_t slot = state.next_slot;
+    state.ledger_ids[slot] = id_;
+    state.counters[slot] = &c;
+    state.next_slot = (slot + 1) % ThreadTagState::kSlots;
+    return c;
+}
+
+void MemoryLedger::Allocate(const std::string& tag, size_t size_bytes) {
+    Allocate(Counters(tag), size_bytes);
+}
+
+void MemoryLedger::Release(const std::string& tag, size_t size_bytes) {
+    if (TagCounters* c = FindCounters(tag)) {
+        Release(*c, size_bytes);
+    }
+}
+
+void MemoryLedger::Allocate(TagCounters& c, size_t size_bytes) {
+    c.live_allocations.fetch_add(1, std::memory_order_relaxed);
+    c.total_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    const size_t current = c.current_bytes.fetch_add(size_bytes, std::memory_order_relaxed) + size_bytes;
+    size_t peak = c.peak_bytes.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !c.peak_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryLedger::Release(TagCounters& c, size_t size_bytes) {
+    // Не ниже нуля: Release без парного Allocate не должен переполнять счётчик
+    size_t current = c.current_bytes.load(std::memory_order_relaxed);
+    while (!c.current_bytes.compare_exchange_weak(current, current - std::min(current, size_bytes),
+                                                  std::memory_order_relaxed)) {
+    }
+    size_t live = c.live_allocations.load(std::memory_order_relaxed);
+    while (live > 0 &&
+           !c.live_allocations.compare_exchange_weak(live, live - 1, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryLedger::RegisterHandle(const void* handle, size_t size_bytes, const std::string& tag) {
+    if (!handle) return;
+    RegisterHandle(handle, size_bytes, Counters(tag));
+}
+
+void MemoryLedger::RegisterHandle(const void* handle, size_t size_bytes, TagCounters& counters) {
+    if (!handle) return;
+
+    std::pair<size_t, TagCounters*> previous{0, nullptr};
+    {
+        std::lock_guard<std::mutex> lock(handles_mutex_);
+        auto it = handles_.find(handle);
+        if (it != handles_.end()) {
+            previous = it->second;
+        }
+        handles_[handle] = { size_bytes, &counters };
+    }
+    if (previous.second) {
+        Release(*previous.second, previous.first);
+    }
+    Allocate(counters, size_bytes);
+}
+
+bool MemoryLedger::ReleaseHandle(const void* handle, size_t* size_bytes) {
+    std::pair<size_t, TagCounters*> entry;
+    {
+        std::lock_guard<std::mutex> lock(handles_mutex_);
+        auto it = handles_.find(handle);
+        if (it == handles_.end()) {
+            return false;
+        }
+        entry = it->second;
+        handles_.erase(it);
+    }
+    if (size_bytes) {
+        *size_bytes = entry.first;
+    }
+    Release(*entry.second, entry.first);
+    return true;
+}
+
+std::vector<MemoryTagStats> MemoryLedger::GetStats() const {
+    std::vector<MemoryTagStats> stats;
+    {
+        std::shared_lock<std::shared_mutex> lock(tags_mutex_);
+        stats.reserve(tags_.size());
+        for (const auto& [tag, c] : tags_) {
+            stats.push_back(ToStats(tag, *c));
+        }
+    }
+    std::sort(stats.begin(), stats.end(), [](const MemoryTagStats& a, const MemoryTagStats& b) {
+        return a.current_bytes != b.current_bytes ? a.current_bytes > b.current_bytes
+                                                  : a.tag < b.tag;
+    });
+    return stats;
+}
+
+MemoryTagStats MemoryLedger::GetTagStats(const std::string& tag) const {
+    if (const TagCounters* c = FindCounters(tag)) {
+        return ToStats(tag, *c);
+    }
+    MemoryTagStats empty;
+    empty.tag = tag;
+    return empty;
+}
+
+size_t MemoryLedger::GetCurrentBytes() const {
+    std::shared_lock<std::shared_mutex> lock(tags_mutex_);
+    size_t total = 0;
+    for (const auto& [tag, c] : tags_) {
+        total += c->current_bytes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void MemoryLedger::ResetPeaks() {
+    std::shared_lock<std::shared_mutex> lock(tags_mutex_);
+    for (auto& [tag, c] : tags_) {
+        c->peak_bytes.store(c->current_bytes.load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+    }
+}
+
+std::string MemoryLedger::ToString() const {
+    std::ostringstream oss;
+    oss << "  " << std::left << std::setw(32) << "Tag"
+        << std::right << std::setw(12) << "current MB" << std::setw(12) << "peak MB"
+        << std::setw(8) << "live" << "\n";
+    for (const auto& s : GetStats()) {
+        oss << "  " << std::left << std::setw(32) << s.tag
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << (s.current_bytes / (1024.0 * 1024.0))
+            << std::setw(12) << (s.peak_bytes / (1024.0 * 1024.0))
+            << std::setw(8) << s.live_allocations << "\n";
+    }
+    return oss.str();
+}
+
+MemoryLedger::TagCounters& MemoryLedger::Counters(const std::string& tag) {
+    if (TagCounters* c = FindCounters(tag)) {
+        return *c;
+    }
+    std::unique_lock<std::shared_mutex> lock(tags_mutex_);
+    auto& entry = tags_[tag];
+    if (!entry) {
+        entry = std::make_unique<TagCounters>();
+    }
+    return *entry;
+}
+
+MemoryLedger::TagCounters* MemoryLedger::FindCounters(const std::string& tag) const {
+    std::shared_lock<std::shared_mutex> lock(tags_mutex_);
+    auto it = tags_.find(tag);
+    return it != tags_.end() ? it->second.get() : nullptr;
+}
+
+MemoryTagStats MemoryLedger::ToStats(const std::string& tag, const TagCounters& c) {
+    MemoryTagStats s;
+    s.tag = tag;
+    s.current_bytes = c.current_bytes.load(std::memory_order_relaxed);
+    s.peak_bytes = c.peak_bytes.load(std::memory_order_relaxed);
+    s.live_allocations = c.live_allocations.load(std::memory_order_relaxed);
+    s.total_allocations = c.total_allocations.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace drv_gpu_lib
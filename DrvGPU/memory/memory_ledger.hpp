@@ -0,0 +1,192 @@
+#pragma once
+
+/**
+ * @file memory_ledger.hpp
+ * @brief Учёт памяти устройства по меткам (модуль/назначение)
+ *
+ * MemoryManager считает общие итоги; MemoryLedger отвечает на вопрос
+ * «кто занял память»: текущий и пиковый объём по каждой метке.
+ *
+ * Метка — строка "Модуль/назначение" ("AntennaFFT/fft_input").
+ * Источники:
+ * - буферы MemoryManager::Create* — метка ScopedMemoryTag потока
+ *   (по умолчанию "untagged"); освобождение учитывается при
+ *   уничтожении буфера
+ * - сырые cl_mem модулей — MemoryManager::RegisterExternalAllocation /
+ *   UnregisterExternalAllocation
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-11
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+/**
+ * @struct MemoryTagStats
+ * @brief Память одной метки
+ */
+struct MemoryTagStats {
+    std::string tag;
+    size_t current_bytes     = 0;   ///< Занято сейчас
+    size_t peak_bytes        = 0;   ///< Максимум current_bytes (high-water mark)
+    size_t live_allocations  = 0;   ///< Живых выделений
+    size_t total_allocations = 0;   ///< Выделений всего
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: ScopedMemoryTag - метка выделений текущего потока
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class ScopedMemoryTag
+ * @brief Метка для выделений через MemoryManager в пределах области видимости
+ *
+ * @code
+ * {
+ *     ScopedMemoryTag tag("VectorOps/pool");
+ *     auto a = mem_mgr.CreateBuffer<float>(n);   // учтён как "VectorOps/pool"
+ * }
+ * @endcode
+ *
+ * Вложенные области восстанавливают предыдущую метку.
+ * Смена метки сбрасывает кэш разрешённых счётчиков потока
+ * (MemoryLedger::CurrentCounters).
+ */
+class ScopedMemoryTag {
+public:
+    explicit ScopedMemoryTag(std::string tag);
+    ~ScopedMemoryTag();
+
+    ScopedMemoryTag(const ScopedMemoryTag&) = delete;
+    ScopedMemoryTag& operator=(const ScopedMemoryTag&) = delete;
+
+    /// Метка текущего потока ("untagged" вне областей)
+    static const std::string& Current();
+
+private:
+    std::string previous_;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: MemoryLedger - объём памяти по меткам
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class MemoryLedger
+ * @brief Потокобезопасный учёт current/peak по меткам
+ *
+ * Владеет им MemoryManager через shared_ptr: буферы, пережившие менеджер,
+ * корректно списывают себя при уничтожении.
+ *
+ * Счётчики меток — атомики. Метка разрешается в TagCounters* один раз:
+ * CurrentCounters() кэширует указатель в потоке до смены ScopedMemoryTag,
+ * буфер захватывает его для освобождения. Горячий путь выделения/освобождения
+ * не обращается к таблице меток и её shared_mutex — только атомики своей
+ * метки (потоки с одной меткой делят её кэш-линию).
+ * Таблица читается при первой встрече метки в потоке, при учёте хэндлов
+ * и при сборе статистики.
+ */
+class MemoryLedger {
+public:
+    static constexpr const char* kUntagged = "untagged";
+
+    /**
+     * @struct TagCounters
+     * @brief Счётчики одной метки
+     *
+     * Метки не удаляются: адрес стабилен, пока жив ledger.
+     */
+    struct TagCounters {
+        std::atomic<size_t> current_bytes{0};
+        std::atomic<size_t> peak_bytes{0};
+        std::atomic<size_t> live_allocations{0};
+        std::atomic<size_t> total_allocations{0};
+    };
+
+    MemoryLedger();
+    MemoryLedger(const MemoryLedger&) = delete;
+    MemoryLedger& operator=(const MemoryLedger&) = delete;
+
+    /**
+     * @brief Счётчики метки текущего потока (ScopedMemoryTag::Current())
+     *
+     * Поиск в таблице — при первом выделении в области метки,
+     * дальше указатель из кэша потока.
+     */
+    TagCounters& CurrentCounters();
+
+    /// Счётчики метки (создаются при первом обращении)
+    TagCounters& Counters(const std::string& tag);
+
+    /// Выделение по разрешённым счётчикам (без таблицы меток)
+    static void Allocate(TagCounters& counters, size_t size_bytes);
+
+    /// Освобождение по разрешённым счётчикам (без таблицы меток)
+    static void Release(TagCounters& counters, size_t size_bytes);
+
+    /// Выделение size_bytes под меткой tag
+    void Allocate(const std::string& tag, size_t size_bytes);
+
+    /// Освобождение ранее учтённого выделения
+    void Release(const std::string& tag, size_t size_bytes);
+
+    /**
+     * @brief Учесть выделение по хэндлу (cl_mem, void* бэкенда)
+     *
+     * Повторная регистрация того же хэндла заменяет прежнюю запись.
+     */
+    void RegisterHandle(const void* handle, size_t size_bytes, const std::string& tag);
+
+    /// То же по разрешённым счётчикам (CurrentCounters / Counters этого ledger)
+    void RegisterHandle(const void* handle, size_t size_bytes, TagCounters& counters);
+
+    /**
+     * @brief Списать выделение по хэндлу
+     * @param[out] size_bytes Размер списанного (если не nullptr)
+     * @return false — хэндл не зарегистрирован
+     */
+    bool ReleaseHandle(const void* handle, size_t* size_bytes = nullptr);
+
+    /// Все метки, по убыванию текущего объёма
+    std::vector<MemoryTagStats> GetStats() const;
+
+    /// Одна метка (пустая статистика, если меток не было)
+    MemoryTagStats GetTagStats(const std::string& tag) const;
+
+    /// Сумма current_bytes по всем меткам
+    size_t GetCurrentBytes() const;
+
+    /// Пики := текущие значения (начать новое окно наблюдения)
+    void ResetPeaks();
+
+    std::string ToString() const;
+
+private:
+    // Ключ кэша потока: адрес ledger может достаться новому объекту
+    const uint64_t id_;
+
+    // Метки не удаляются: указатели на TagCounters стабильны
+    mutable std::shared_mutex tags_mutex_;
+    std::unordered_map<std::string, std::unique_ptr<TagCounters>> tags_;
+
+    std::mutex handles_mutex_;
+    std::unordered_map<const void*, std::pair<size_t, TagCounters*>> handles_;
+
+    /// nullptr, если метки не было
+    TagCounters* FindCounters(const std::string& tag) const;
+
+    static MemoryTagStats ToStats(const std::string& tag, const TagCounters& c);
+};
+
+} // namespace drv_gpu_lib
@@ -5,9 +5,16 @@
  * @author DrvGPU Team
  * @date 2026-01-31
  * @fixed 2026-02-02 - Deadlock fix (TrackAllocation/TrackFree БЕЗ mutex lock)
+ * @updated 2026-02-12 - Статистика на атомиках (AllocationStats)
+ * @updated 2026-02-12 - Бюджет памяти устройства (MemoryBudget)
  */
 
 #include "memory/memory_manager.hpp"
+#include "logger/logger.hpp"
+#include "services/gpu_profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -20,15 +27,14 @@ namespace drv_gpu_lib {
 
 MemoryManager::MemoryManager(IBackend* backend)
     : backend_(backend)
-    , total_allocations_(0)
-    , total_frees_(0)
-    , current_allocations_(0)
-    , total_bytes_allocated_(0)
-    , peak_bytes_allocated_(0)
+    , stats_(std::make_shared<AllocationStats>())
+    , ledger_(std::make_shared<MemoryLedger>())
+    , budget_(std::make_shared<MemoryBudget>())
 {
     if (!backend_) {
         throw std::invalid_argument("MemoryManager: backend cannot be null");
     }
+    budget_->Attach(stats_);
 }
 
 MemoryManager::~MemoryManager() {
@@ -37,11 +43,21 @@ MemoryManager::~MemoryManager() {
 
 MemoryManager::MemoryManager(MemoryManager&& other) noexcept
     : backend_(other.backend_)
-    , total_allocations_(other.total_allocations_)
-    , total_frees_(other.total_frees_)
-    , current_allocations_(other.current_allocations_)
-    , total_bytes_allocated_(other.total_bytes_allocated_)
-    , peak_bytes_allocated_(other.peak_bytes_allocated_)
+    , stats_(other.stats_)
+    , ledger_(other.ledger_)
+    , export_interval_ms_(other.export_interval_ms_.load())
+    , last_export_ns_(other.last_export_ns_.load())
+    , pressure_events_(other.pressure_events_)
+    , pressure_recovered_(other.pressure_recovered_)
+    , pressure_failed_(other.pressure_failed_)
+    , bytes_evicted_(other.bytes_evicted_)
+    , budget_rejections_(other.budget_rejections_)
+    , budget_(other.budget_)
+    , preferred_strategy_(other.preferred_strategy_.load())
+    , eviction_callbacks_(std::move(other.eviction_callbacks_))
+    , next_eviction_id_(other.next_eviction_id_)
+    , svm_caps_(other.svm_caps_)
+    , svm_caps_valid_(other.svm_caps_valid_)
 {
     other.backend_ = nullptr;
 }
@@ -51,17 +67,540 @@ MemoryManager& MemoryManager::operator=(MemoryManager&& other) noexcept {
         Cleanup();
         
         backend_ = other.backend_;
-        total_allocations_ = other.total_allocations_;
-        total_frees_ = other.total_frees_;
-        current_allocations_ = other.current_allocations_;
-        total_bytes_allocated_ = other.total_bytes_allocated_;
-        peak_bytes_allocated_ = other.peak_bytes_allocated_;
+        stats_ = other.stats_;
+        ledger_ = other.ledger_;
+        export_interval_ms_ = other.export_interval_ms_.load();
+        last_export_ns_ = other.last_export_ns_.load();
+        pressure_events_ = other.pressure_events_;
+        pressure_recovered_ = other.pressure_recovered_;
+        pressure_failed_ = other.pressure_failed_;
+        bytes_evicted_ = other.bytes_evicted_;
+        budget_rejections_ = other.budget_rejections_;
+        budget_ = other.budget_;
+        preferred_strategy_ = other.preferred_strategy_.load();
+        eviction_callbacks_ = std::move(other.eviction_callbacks_);
+        next_eviction_id_ = other.next_eviction_id_;
+        svm_caps_ = other.svm_caps_;
+        svm_caps_valid_ = other.svm_caps_valid_;
         
         other.backend_ = nullptr;
     }
     return *this;
 }
 
+// ════════════════════════════════════════════════════════════════════════════
+// Стратегии памяти
+// ════════════════════════════════════════════════════════════════════════════
+
+SVMCapabilities MemoryManager::GetSVMCapabilities() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (!svm_caps_valid_ && backend_ && backend_->IsInitialized() &&
+        backend_->GetType() != BackendType::ROCm) {
+        svm_caps_ = SVMCapabilities::Query(static_cast<cl_device_id>(backend_->GetNativeDevice()));
+        svm_caps_valid_ = true;
+    }
+    // До инициализации бэкенда — пустые возможности (только REGULAR_BUFFER)
+    return svm_caps_;
+}
+
+bool MemoryManager::HasUnifiedMemory() const {
+    return GetSVMCapabilities().host_unified_memory;
+}
+
+MemoryStrategy MemoryManager::RecommendStrategy(size_t size_bytes,
+                                                const BufferUsageHint& hint) const {
+    return GetSVMCapabilities().RecommendStrategy(size_bytes, hint);
+}
+
+void MemoryManager::SetPreferredStrategy(MemoryStrategy strategy) {
+    preferred_strategy_.store(strategy, std::memory_order_relaxed);
+}
+
+MemoryStrategy MemoryManager::GetPreferredStrategy() const {
+    return preferred_strategy_.load(std::memory_order_relaxed);
+}
+
+MemoryStrategy MemoryManager::ResolveStrategy(size_t size_bytes, MemoryStrategy strategy) const {
+    SVMCapabilities caps = GetSVMCapabilities();
+    
+    // AUTO → стратегия из конфигурации устройства, если задана
+    if (strategy == MemoryStrategy::AUTO) {
+        strategy = GetPreferredStrategy();
+    }
+    
+    switch (strategy) {
+        case MemoryStrategy::AUTO:
+            return caps.RecommendStrategy(size_bytes, BufferUsageHint::Default());
+        case MemoryStrategy::SVM_COARSE_GRAIN:
+            return caps.svm_supported && caps.coarse_grain_buffer
+                 ? strategy : MemoryStrategy::REGULAR_BUFFER;
+        case MemoryStrategy::SVM_FINE_GRAIN:
+            return caps.svm_supported && caps.fine_grain_buffer
+                 ? strategy : MemoryStrategy::REGULAR_BUFFER;
+        case MemoryStrategy::SVM_FINE_SYSTEM:
+            return caps.svm_supported && caps.fine_grain_system
+                 ? strategy : MemoryStrategy::REGULAR_BUFFER;
+        default:
+            return strategy;
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Бенчмарк стратегий
+// ════════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+/// Проход по буферу: каждый элемент читается и пишется один раз
+const char* kTouchKernelSource =
+    "__kernel void memory_strategy_touch(__global uint* data) {\n"
+    "    size_t i = get_global_id(0);\n"
+    "    data[i] = data[i] + 1u;\n"
+    "}\n";
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+} // anonymous namespace
+
+StrategyBenchmarkReport MemoryManager::BenchmarkStrategies(size_t size_bytes,
+                                                           const BufferUsageHint& hint,
+                                                           int iterations) {
+    if (!backend_ || !backend_->IsInitialized()) {
+        throw std::runtime_error("MemoryManager::BenchmarkStrategies: backend is not initialized");
+    }
+    if (size_bytes < sizeof(uint32_t) || iterations <= 0) {
+        throw std::invalid_argument("MemoryManager::BenchmarkStrategies: empty benchmark");
+    }
+    
+    auto context = static_cast<cl_context>(backend_->GetNativeContext());
+    auto device = static_cast<cl_device_id>(backend_->GetNativeDevice());
+    auto queue = static_cast<cl_command_queue>(backend_->GetNativeQueue());
+    
+    SVMCapabilities caps = GetSVMCapabilities();
+    
+    StrategyBenchmarkReport report;
+    report.device_name = backend_->GetDeviceName();
+    report.size_bytes = size_bytes;
+    report.hint = hint;
+    report.recommended = caps.RecommendStrategy(size_bytes, hint);
+    
+    // ── Kernel ─────────────────────────────────────────────────────────
+    cl_int err = CL_SUCCESS;
+    cl_program program = clCreateProgramWithSource(context, 1, &kTouchKernelSource, nullptr, &err);
+    if (err != CL_SUCCESS ||
+        clBuildProgram(program, 1, &device, nullptr, nullptr, nullptr) != CL_SUCCESS) {
+        if (program) clReleaseProgram(program);
+        throw std::runtime_error("MemoryManager::BenchmarkStrategies: kernel build failed");
+    }
+    cl_kernel kernel = clCreateKernel(program, "memory_strategy_touch", &err);
+    if (err != CL_SUCCESS) {
+        clReleaseProgram(program);
+        throw std::runtime_error("MemoryManager::BenchmarkStrategies: clCreateKernel failed");
+    }
+    
+    // ── Кандидаты ──────────────────────────────────────────────────────
+    std::vector<MemoryStrategy> candidates = {
+        MemoryStrategy::REGULAR_BUFFER, MemoryStrategy::HOST_MAPPED
+    };
+    if (caps.svm_supported && caps.coarse_grain_buffer) {
+        candidates.push_back(MemoryStrategy::SVM_COARSE_GRAIN);
+    }
+    if (caps.svm_supported && caps.fine_grain_buffer) {
+        candidates.push_back(MemoryStrategy::SVM_FINE_GRAIN);
+    }
+    
+    const size_t count = size_bytes / sizeof(uint32_t);
+    std::vector<uint32_t> host_in(count, 1u);
+    std::vector<uint32_t> host_out(count);
+    
+    const bool host_write = !hint.gpu_only && hint.frequent_host_write;
+    const bool host_read = !hint.gpu_only && hint.frequent_host_read;
+    
+    try {
+        for (MemoryStrategy strategy : candidates) {
+            auto buffer = MakeBuffer<uint32_t>(count, strategy, MemoryType::GPU_READ_WRITE);
+            buffer->SetAsKernelArg(kernel, 0);
+            
+            StrategyBenchmarkEntry entry;
+            entry.strategy = strategy;
+            
+            // Первый прогон — прогрев (first-touch, ленивое выделение драйвером)
+            for (int it = -1; it < iterations; ++it) {
+                auto start = std::chrono::steady_clock::now();
+                buffer->WriteRaw(host_in.data(), size_bytes);
+                double write_ms = ElapsedMs(start);
+                
+                start = std::chrono::steady_clock::now();
+                size_t global = count;
+                err = clEnqueueNDRangeKernel(queue, kernel, 1, nullptr, &global, nullptr,
+                                             0, nullptr, nullptr);
+                if (err != CL_SUCCESS) {
+                    throw std::runtime_error("MemoryManager::BenchmarkStrategies: "
+                                             "clEnqueueNDRangeKernel failed: " + std::to_string(err));
+                }
+                clFinish(queue);
+                double kernel_ms = ElapsedMs(start);
+                
+                start = std::chrono::steady_clock::now();
+                buffer->ReadRaw(host_out.data(), size_bytes);
+                double read_ms = ElapsedMs(start);
+                
+                if (it >= 0) {
+                    entry.write_ms += write_ms;
+                    entry.kernel_ms += kernel_ms;
+                    entry.read_ms += read_ms;
+                }
+            }
+            
+            entry.write_ms /= iterations;
+            entry.kernel_ms /= iterations;
+            entry.read_ms /= iterations;
+            entry.frame_ms = entry.kernel_ms +
+                             (host_write ? entry.write_ms : 0.0) +
+                             (host_read ? entry.read_ms : 0.0);
+            report.entries.push_back(entry);
+        }
+    } catch (...) {
+        clReleaseKernel(kernel);
+        clReleaseProgram(program);
+        throw;
+    }
+    
+    clReleaseKernel(kernel);
+    clReleaseProgram(program);
+    
+    auto fastest = std::min_element(report.entries.begin(), report.entries.end(),
+        [](const StrategyBenchmarkEntry& a, const StrategyBenchmarkEntry& b) {
+            return a.frame_ms < b.frame_ms;
+        });
+    report.fastest = fastest->strategy;
+    return report;
+}
+
+double StrategyBenchmarkReport::FrameMs(MemoryStrategy strategy) const {
+    for (const auto& entry : entries) {
+        if (entry.strategy == strategy) {
+            return entry.frame_ms;
+        }
+    }
+    return 0.0;
+}
+
+bool StrategyBenchmarkReport::RecommendationValid(double tolerance) const {
+    const double best = FrameMs(fastest);
+    const double chosen = FrameMs(recommended);
+    if (chosen <= 0.0) {
+        return false;  // Рекомендация не замерялась (недоступна)
+    }
+    // Абсолютный допуск 0.05 мс — на малых буферах разница в шуме таймера
+    return chosen <= best * (1.0 + tolerance) + 0.05;
+}
+
+std::string StrategyBenchmarkReport::ToString() const {
+    std::ostringstream oss;
+    oss << "Memory strategies on " << device_name << " ("
+        << std::fixed << std::setprecision(2) << (size_bytes / (1024.0 * 1024.0)) << " MB, hint:"
+        << (hint.gpu_only ? " gpu_only" : "")
+        << (hint.frequent_host_write ? " host_write" : "")
+        << (hint.frequent_host_read ? " host_read" : "")
+        << (hint.requires_atomics ? " atomics" : "") << ")\n";
+    oss << "  " << std::left << std::setw(18) << "Strategy"
+        << std::right << std::setw(10) << "write ms" << std::setw(10) << "kernel ms"
+        << std::setw(10) << "read ms" << std::setw(10) << "frame ms" << "\n";
+    for (const auto& e : entries) {
+        oss << "  " << std::left << std::setw(18) << MemoryStrategyToString(e.strategy)
+            << std::right << std::setprecision(3)
+            << std::setw(10) << e.write_ms << std::setw(10) << e.kernel_ms
+            << std::setw(10) << e.read_ms << std::setw(10) << e.frame_ms
+            << (e.strategy == recommended ? "  <- recommended" : "")
+            << (e.strategy == fastest ? "  <- fastest" : "") << "\n";
+    }
+    return oss.str();
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Арена кадра
+// ════════════════════════════════════════════════════════════════════════════
+
+std::unique_ptr<FrameArena> MemoryManager::CreateFrameArena(size_t capacity_bytes) {
+    auto arena = AllocateWithRetry(capacity_bytes, [&] {
+        return std::make_unique<FrameArena>(backend_, capacity_bytes);
+    });
+    
+    TrackAllocation(capacity_bytes);
+    
+    // Резерв арены — под меткой потока; списывается в деструкторе арены
+    MemoryLedger::TagCounters& counters = ledger_->CurrentCounters();
+    MemoryLedger::Allocate(counters, capacity_bytes);
+    arena->SetReleaseCallback([ledger = ledger_, counters = &counters, stats = stats_, capacity_bytes] {
+        MemoryLedger::Release(*counters, capacity_bytes);
+        stats->OnFree(capacity_bytes);
+    });
+    
+    MaybePublishMemoryStats();
+    return arena;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Учёт по меткам
+// ════════════════════════════════════════════════════════════════════════════
+
+void MemoryManager::RegisterExternalAllocation(cl_mem mem, const std::string& tag) {
+    if (!mem) return;
+    
+    size_t size_bytes = 0;
+    cl_int err = clGetMemObjectInfo(mem, CL_MEM_SIZE, sizeof(size_bytes), &size_bytes, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::invalid_argument("MemoryManager::RegisterExternalAllocation: "
+                                    "clGetMemObjectInfo failed: " + std::to_string(err));
+    }
+    RegisterExternalAllocation(static_cast<const void*>(mem), size_bytes, tag);
+}
+
+void MemoryManager::RegisterExternalAllocation(const void* handle, size_t size_bytes,
+                                               const std::string& tag) {
+    if (!handle) return;
+    
+    // Повторная регистрация хэндла заменяет прежнюю запись
+    size_t previous = 0;
+    bool replaced = ledger_->ReleaseHandle(handle, &previous);
+    ledger_->RegisterHandle(handle, size_bytes, tag);
+    
+    if (replaced) TrackFree(previous);
+    TrackAllocation(size_bytes);
+    MaybePublishMemoryStats();
+}
+
+void MemoryManager::UnregisterExternalAllocation(const void* handle) {
+    size_t size_bytes = 0;
+    if (!handle || !ledger_->ReleaseHandle(handle, &size_bytes)) {
+        return;
+    }
+    
+    TrackFree(size_bytes);
+    MaybePublishMemoryStats();
+}
+
+std::vector<MemoryTagStats> MemoryManager::GetTagStatistics() const {
+    return ledger_->GetStats();
+}
+
+MemoryTagStats MemoryManager::GetTagStatistics(const std::string& tag) const {
+    return ledger_->GetTagStats(tag);
+}
+
+void MemoryManager::ResetTagPeaks() {
+    ledger_->ResetPeaks();
+}
+
+void MemoryManager::PublishMemoryStats() {
+    const int gpu_id = backend_ ? backend_->GetDeviceIndex() : 0;
+    auto& profiler = GPUProfiler::GetInstance();
+    
+    for (const auto& tag : ledger_->GetStats()) {
+        profiler.RecordMemory(gpu_id, tag.tag, tag.current_bytes, tag.peak_bytes);
+    }
+    
+    const auto stats = stats_->Snapshot();
+    profiler.RecordMemory(gpu_id, "total", stats.current_bytes, stats.peak_bytes);
+}
+
+void MemoryManager::SetMemoryExportInterval(std::chrono::milliseconds interval) {
+    last_export_ns_.store(0, std::memory_order_relaxed);
+    export_interval_ms_.store(interval.count(), std::memory_order_relaxed);
+}
+
+void MemoryManager::MaybePublishMemoryStats() {
+    const int64_t interval_ms = export_interval_ms_.load(std::memory_order_relaxed);
+    if (interval_ms <= 0) {
+        return;
+    }
+    
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t last = last_export_ns_.load(std::memory_order_relaxed);
+    if (now - last < interval_ms * 1000000) {
+        return;
+    }
+    // Экспортирует один поток из одновременно увидевших истёкший интервал
+    if (!last_export_ns_.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+        return;
+    }
+    PublishMemoryStats();
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Нехватка памяти
+// ════════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+/// Колбэк, выделяющий память, не запускает освобождение повторно
+thread_local bool t_relieving_pressure = false;
+
+} // anonymous namespace
+
+void EvictionRegistration::Reset() {
+    if (manager_) {
+        manager_->UnregisterEvictionCallback(id_);
+        manager_ = nullptr;
+        id_ = 0;
+    }
+}
+
+EvictionRegistration MemoryManager::RegisterEvictionCallback(const std::string& name,
+                                                             EvictionCallback callback,
+                                                             int priority) {
+    if (!callback) {
+        throw std::invalid_argument("MemoryManager::RegisterEvictionCallback: empty callback");
+    }
+    
+    std::lock_guard<std::mutex> lock(eviction_mutex_);
+    
+    const size_t id = next_eviction_id_++;
+    
+    EvictionEntry entry;
+    entry.id = id;
+    entry.name = name;
+    entry.priority = priority;
+    entry.slot = std::make_shared<EvictionSlot>();
+    entry.slot->callback = std::move(callback);
+    
+    // Порядок вызова: по приоритету, при равном — по регистрации
+    auto pos = std::upper_bound(eviction_callbacks_.begin(), eviction_callbacks_.end(), priority,
+        [](int p, const EvictionEntry& e) { return p < e.priority; });
+    eviction_callbacks_.insert(pos, std::move(entry));
+    
+    return EvictionRegistration(this, id);
+}
+
+void MemoryManager::UnregisterEvictionCallback(size_t id) {
+    std::shared_ptr<EvictionSlot> slot;
+    {
+        std::lock_guard<std::mutex> lock(eviction_mutex_);
+        auto it = std::find_if(eviction_callbacks_.begin(), eviction_callbacks_.end(),
+                               [id](const EvictionEntry& e) { return e.id == id; });
+        if (it == eviction_callbacks_.end()) {
+            return;
+        }
+        slot = std::move(it->slot);
+        eviction_callbacks_.erase(it);
+    }
+    
+    // Вне eviction_mutex_: ждём колбэк, запущенный по копии списка
+    std::lock_guard<std::recursive_mutex> run_lock(slot->run_mutex);
+    slot->active = false;
+}
+
+size_t MemoryManager::RelieveMemoryPressure(size_t bytes_needed) {
+    if (t_relieving_pressure) {
+        return 0;
+    }
+    
+    // Копия списка: колбэк может снять регистрацию или выделять память.
+    // Снятый после копирования колбэк пропускается (EvictionSlot::active)
+    std::vector<EvictionEntry> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(eviction_mutex_);
+        callbacks = eviction_callbacks_;
+    }
+    
+    t_relieving_pressure = true;
+    size_t freed = 0;
+    for (const auto& entry : callbacks) {
+        if (freed >= bytes_needed) break;
+        std::lock_guard<std::recursive_mutex> run_lock(entry.slot->run_mutex);
+        if (!entry.slot->active) continue;
+        try {
+            size_t released = entry.slot->callback(bytes_needed - freed);
+            freed += released;
+            if (released > 0) {
+                DRVGPU_LOG_INFO("MemoryManager", "memory pressure: '" + entry.name + "' released " +
+                                std::to_string(released) + " bytes");
+            }
+        } catch (const std::exception& e) {
+            DRVGPU_LOG_WARNING("MemoryManager", "eviction callback '" + entry.name +
+                               "' failed: " + e.what());
+        }
+    }
+    t_relieving_pressure = false;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pressure_events_++;
+        bytes_evicted_ += freed;
+    }
+    
+    DRVGPU_LOG_WARNING("MemoryManager", "memory pressure: needed " + std::to_string(bytes_needed) +
+                       " bytes, released " + std::to_string(freed) + " by " +
+                       std::to_string(callbacks.size()) + " callbacks");
+    return freed;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Бюджет памяти устройства
+// ════════════════════════════════════════════════════════════════════════════
+
+void MemoryManager::SetMemoryBudget(size_t limit_bytes) {
+    budget_->SetLimit(limit_bytes);
+    DRVGPU_LOG_INFO("MemoryManager", limit_bytes == 0
+        ? std::string("memory budget: unlimited")
+        : "memory budget: " + std::to_string(limit_bytes / (1024 * 1024)) + " MB");
+}
+
+void MemoryManager::SetMemoryBudgetPercent(size_t percent) {
+    if (percent == 0 || percent > 100) {
+        throw std::invalid_argument("MemoryManager::SetMemoryBudgetPercent: percent must be in [1, 100], got " +
+                                    std::to_string(percent));
+    }
+    if (!backend_ || !backend_->IsInitialized()) {
+        throw std::runtime_error("MemoryManager::SetMemoryBudgetPercent: backend is not initialized");
+    }
+    const size_t total = backend_->GetGlobalMemorySize();
+    SetMemoryBudget(percent == 100 ? 0 : total / 100 * percent);
+}
+
+size_t MemoryManager::GetMemoryBudget() const {
+    return budget_->GetLimit();
+}
+
+size_t MemoryManager::GetMemoryBudgetRemaining() const {
+    return budget_->GetRemainingBytes();
+}
+
+void MemoryManager::ShareMemoryBudget(MemoryManager& other) {
+    if (&other == this || other.budget_ == budget_) {
+        return;
+    }
+    budget_->Attach(other.stats_);
+    other.budget_ = budget_;
+}
+
+void MemoryManager::ThrowBudgetExceeded(size_t size_bytes) {
+    const size_t limit = budget_->GetLimit();
+    const size_t used = budget_->GetUsedBytes();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        budget_rejections_++;
+    }
+    throw std::runtime_error("MemoryManager: memory budget exceeded (requested " +
+                             std::to_string(size_bytes) + " bytes, used " + std::to_string(used) +
+                             " of " + std::to_string(limit) + ")");
+}
+
+void MemoryManager::NotePressureOutcome(bool recovered) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (recovered) {
+        pressure_recovered_++;
+    } else {
+        pressure_failed_++;
+    }
+}
+
 // ════════════════════════════════════════════════════════════════════════════
 // Прямое выделение памяти
 // ════════════════════════════════════════════════════════════════════════════
@@ -71,11 +610,14 @@ void* MemoryManager::Allocate(size_t size_bytes, unsigned int flags) {
         throw std::runtime_error("MemoryManager: backend is null");
     }
     
-    void* ptr = backend_->Allocate(size_bytes, flags);
+    void* ptr = AllocateWithRetry(size_bytes, [&] {
+        return backend_->Allocate(size_bytes, flags);
+    });
     
     if (ptr) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        ledger_->RegisterHandle(ptr, size_bytes, ledger_->CurrentCounters());
         TrackAllocation(size_bytes);
+        MaybePublishMemoryStats();
     }
     
     return ptr;
@@ -84,8 +626,11 @@ void* MemoryManager::Allocate(size_t size_bytes, unsigned int flags) {
 void MemoryManager::Free(void* ptr) {
     if (!ptr) return;
     
-    // TODO: Если нужна статистика Free, храните map<void*, size_t>
-    // и вызывайте TrackFree(size_bytes) здесь
+    // Размер известен по хэндлу из Allocate()
+    size_t size_bytes = 0;
+    if (ledger_->ReleaseHandle(ptr, &size_bytes)) {
+        TrackFree(size_bytes);
+    }
     
     if (backend_) {
         backend_->Free(ptr);
@@ -97,13 +642,11 @@ void MemoryManager::Free(void* ptr) {
 // ════════════════════════════════════════════════════════════════════════════
 
 size_t MemoryManager::GetAllocationCount() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return current_allocations_;
+    return stats_->GetCurrentAllocations();
 }
 
 size_t MemoryManager::GetTotalAllocatedBytes() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return total_bytes_allocated_;
+    return stats_->GetCurrentBytes();
 }
 
 void MemoryManager::PrintStatistics() const {
@@ -111,6 +654,9 @@ void MemoryManager::PrintStatistics() const {
 }
 
 std::string MemoryManager::GetStatistics() const {
+    const auto tags = ledger_->GetStats();
+    const auto stats = stats_->Snapshot();
+    
     std::lock_guard<std::mutex> lock(mutex_);
     
     std::ostringstream oss;
@@ -118,30 +664,52 @@ std::string MemoryManager::GetStatistics() const {
     oss << "MemoryManager Statistics\n";
     oss << std::string(60, '=') << "\n";
     oss << std::left << std::setw(30) << "Total Allocations:" 
-        << total_allocations_ << "\n";
+        << stats.total_allocations << "\n";
     oss << std::left << std::setw(30) << "Total Frees:" 
-        << total_frees_ << "\n";
+        << stats.total_frees << "\n";
     oss << std::left << std::setw(30) << "Current Allocations:" 
-        << current_allocations_ << "\n";
-    oss << std::left << std::setw(30) << "Total Allocated:" 
+        << stats.current_allocations << "\n";
+    oss << std::left << std::setw(30) << "Current Allocated:" 
         << std::fixed << std::setprecision(2)
-        << (total_bytes_allocated_ / (1024.0 * 1024.0)) << " MB\n";
+        << (stats.current_bytes / (1024.0 * 1024.0)) << " MB\n";
     oss << std::left << std::setw(30) << "Peak Allocated:" 
         << std::fixed << std::setprecision(2)
-        << (peak_bytes_allocated_ / (1024.0 * 1024.0)) << " MB\n";
+        << (stats.peak_bytes / (1024.0 * 1024.0)) << " MB\n";
+    if (budget_->HasLimit()) {
+        oss << std::left << std::setw(30) << "Memory Budget:" 
+            << std::fixed << std::setprecision(2)
+            << (budget_->GetUsedBytes() / (1024.0 * 1024.0)) << " / "
+            << (budget_->GetLimit() / (1024.0 * 1024.0)) << " MB (device)";
+        if (budget_rejections_ > 0) {
+            oss << ", " << budget_rejections_ << " rejected";
+        }
+        oss << "\n";
+    }
+    if (pressure_events_ > 0) {
+        oss << std::left << std::setw(30) << "Memory Pressure Events:" 
+            << pressure_events_ << " (recovered " << pressure_recovered_
+            << ", failed " << pressure_failed_ << ")\n";
+        oss << std::left << std::setw(30) << "Evicted by Callbacks:" 
+            << std::fixed << std::setprecision(2)
+            << (bytes_evicted_ / (1024.0 * 1024.0)) << " MB\n";
+    }
+    if (!tags.empty()) {
+        oss << "By tag:\n" << ledger_->ToString();
+    }
     oss << std::string(60, '=') << "\n";
     
     return oss.str();
 }
 
 void MemoryManager::ResetStatistics() {
-    std::lock_guard<std::mutex> lock(mutex_);
+    stats_->Reset();
     
-    total_allocations_ = 0;
-    total_frees_ = 0;
-    current_allocations_ = 0;
-    total_bytes_allocated_ = 0;
-    peak_bytes_allocated_ = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    pressure_events_ = 0;
+    pressure_recovered_ = 0;
+    pressure_failed_ = 0;
+    bytes_evicted_ = 0;
+    budget_rejections_ = 0;
 }
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -149,60 +717,14 @@ void MemoryManager::ResetStatistics() {
 // ════════════════════════════════════════════════════════════════════════════
 
 void MemoryManager::Cleanup() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     // Буферы управляются через shared_ptr и освобождаются автоматически
     // Здесь можно добавить логирование, если остались неосвобождённые буферы
     
-    if (current_allocations_ > 0) {
-        std::cerr << "[MemoryManager] WARNING: " << current_allocations_ 
+    const size_t live = stats_->GetCurrentAllocations();
+    if (live > 0) {
+        std::cerr << "[MemoryManager] WARNING: " << live 
                   << " allocations still active during cleanup!\n";
     }
 }
 
-// ════════════════════════════════════════════════════════════════════════════
-// Приватные методы
-// ════════════════════════════════════════════════════════════════════════════
-
-/**
- * @brief Отслеживать выделение памяти (внутренний метод)
- * @param size_bytes Размер выделенной памяти
- * 
- * ⚠️ КРИТИЧЕСКИЙ МОМЕНТ (DEADLOCK FIX):
- * Этот метод НЕ захватывает mutex_!
- * Он вызывается ТОЛЬКО из мест, где mutex_ УЖЕ захвачен:
- * - CreateBuffer() в memory_manager.hpp (template метод)
- * - Возможно из других мест под lock
- * 
- * НИКОГДА не добавляйте std::lock_guard здесь - это приведёт к deadlock!
- */
-void MemoryManager::TrackAllocation(size_t size_bytes) {
-    // ⚠️ DEADLOCK FIX: НЕ добавляем std::lock_guard!
-    // Этот метод вызывается ТОЛЬКО под уже захваченным mutex_
-    
-    total_allocations_++;
-    current_allocations_++;
-    total_bytes_allocated_ += size_bytes;
-    
-    if (total_bytes_allocated_ > peak_bytes_allocated_) {
-        peak_bytes_allocated_ = total_bytes_allocated_;
-    }
-}
-
-/**
- * @brief Отслеживать освобождение памяти (внутренний метод)
- * @param size_bytes Размер освобождённой памяти
- * 
- * ⚠️ КРИТИЧЕСКИЙ МОМЕНТ (DEADLOCK FIX):
- * Этот метод НЕ захватывает mutex_!
- * Вызывается только под уже захваченным lock.
- */
-void MemoryManager::TrackFree(size_t size_bytes) {
-    // ⚠️ DEADLOCK FIX: НЕ добавляем std::lock_guard!
-    
-    total_frees_++;
-    current_allocations_--;
-    total_bytes_allocated_ -= size_bytes;
-}
-
 } // namespace drv_gpu_lib
\ No newline at end of file
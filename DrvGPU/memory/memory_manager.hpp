@@ -11,17 +11,136 @@
  * @author DrvGPU Team
  * @date 2026-01-31
  * @fixed 2026-02-02 - Deadlock fix (TrackAllocation/TrackFree)
+ * @updated 2026-02-11 - Учёт по меткам (MemoryLedger), экспорт в GPUProfiler
+ * @updated 2026-02-12 - Статистика на атомиках (AllocationStats), без mutex_ на выделении
+ * @updated 2026-02-12 - Бюджет памяти устройства (MemoryBudget), стратегия по умолчанию
  */
 
 #include "../interface/i_backend.hpp"
 #include "gpu_buffer.hpp"
+#include "aligned_host_allocator.hpp"
+#include "allocation_stats.hpp"
+#include "frame_arena.hpp"
+#include "memory_budget.hpp"
+#include "memory_ledger.hpp"
+#include "regular_buffer.hpp"
+#include "svm_buffer.hpp"
+#include "svm_capabilities.hpp"
+#include <CL/cl.h>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace drv_gpu_lib {
 
+// ════════════════════════════════════════════════════════════════════════════
+// Struct: StrategyBenchmarkReport - замер стратегий памяти на устройстве
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @struct StrategyBenchmarkEntry
+ * @brief Время одного кадра для одной стратегии (среднее по итерациям, мс)
+ *
+ * Кадр = запись с хоста + проход kernel + чтение на хост; какие части
+ * входят в frame_ms, определяет BufferUsageHint (для gpu_only — только kernel).
+ */
+struct StrategyBenchmarkEntry {
+    MemoryStrategy strategy  = MemoryStrategy::REGULAR_BUFFER;
+    double         write_ms  = 0.0;
+    double         kernel_ms = 0.0;
+    double         read_ms   = 0.0;
+    double         frame_ms  = 0.0;
+};
+
+/**
+ * @struct StrategyBenchmarkReport
+ * @brief Результат MemoryManager::BenchmarkStrategies
+ */
+struct StrategyBenchmarkReport {
+    std::string     device_name;
+    size_t          size_bytes  = 0;
+    BufferUsageHint hint;
+    MemoryStrategy  recommended = MemoryStrategy::REGULAR_BUFFER;
+    MemoryStrategy  fastest     = MemoryStrategy::REGULAR_BUFFER;
+    std::vector<StrategyBenchmarkEntry> entries;
+
+    /// Время кадра стратегии (0 — если не замерялась)
+    double FrameMs(MemoryStrategy strategy) const;
+
+    /**
+     * @brief Рекомендация подтверждена замером
+     * @param tolerance Допустимое отставание от самой быстрой (0.25 = 25%)
+     */
+    bool RecommendationValid(double tolerance = 0.25) const;
+
+    std::string ToString() const;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Нехватка памяти: колбэки освобождения
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Колбэк освобождения памяти (сбросить кэш планов, ужать пул)
+ * @param bytes_needed Сколько не хватило последнему выделению
+ * @return Сколько байт освобождено (0 — освобождать нечего)
+ *
+ * Вызывается в потоке, где выделение не удалось, без захваченных
+ * блокировок MemoryManager.
+ */
+using EvictionCallback = std::function<size_t(size_t bytes_needed)>;
+
+class MemoryManager;
+
+/**
+ * @class EvictionRegistration
+ * @brief RAII-регистрация EvictionCallback (снимает колбэк в деструкторе)
+ *
+ * Хранится в модуле рядом с ресурсами, которые освобождает колбэк.
+ * MemoryManager должен жить дольше регистрации.
+ */
+class EvictionRegistration {
+public:
+    EvictionRegistration() = default;
+    EvictionRegistration(MemoryManager* manager, size_t id) : manager_(manager), id_(id) {}
+    ~EvictionRegistration() { Reset(); }
+
+    EvictionRegistration(const EvictionRegistration&) = delete;
+    EvictionRegistration& operator=(const EvictionRegistration&) = delete;
+
+    EvictionRegistration(EvictionRegistration&& other) noexcept
+        : manager_(other.manager_), id_(other.id_) {
+        other.manager_ = nullptr;
+        other.id_ = 0;
+    }
+    EvictionRegistration& operator=(EvictionRegistration&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            manager_ = other.manager_;
+            id_ = other.id_;
+            other.manager_ = nullptr;
+            other.id_ = 0;
+        }
+        return *this;
+    }
+
+    /// Снять колбэк досрочно
+    void Reset();
+
+    bool IsRegistered() const { return manager_ != nullptr; }
+    size_t GetId() const { return id_; }
+
+private:
+    MemoryManager* manager_ = nullptr;
+    size_t id_ = 0;
+};
+
 // ════════════════════════════════════════════════════════════════════════════
 // Class: MemoryManager - Управление памятью GPU
 // ════════════════════════════════════════════════════════════════════════════
@@ -36,7 +155,7 @@ namespace drv_gpu_lib {
  * Основные возможности:
  * - Создание GPU буферов (GPUBuffer<T>)
  * - Отслеживание аллокаций
- * - Статистика использования памяти
+ * - Статистика использования памяти (общая и по меткам модулей)
  * - RAII для автоматической очистки
  * 
  * Использование:
@@ -108,6 +227,288 @@ public:
                                                 size_t num_elements,
                                                 unsigned int flags = 0);
     
+    // ═══════════════════════════════════════════════════════════════
+    // Создание буферов по стратегии (IMemoryBuffer<T>)
+    // ═══════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Создать буфер оптимальной для устройства стратегии
+     * 
+     * Стратегия выбирается RecommendStrategy(size, hint): обычный cl_mem,
+     * SVM coarse/fine или HOST_MAPPED (zero-copy на integrated GPU / CPU).
+     * 
+     * @code
+     * auto spectrum = mem_mgr.CreateBufferWithHint<float>(
+     *     n, BufferUsageHint::FrequentTransfer());
+     * spectrum->SetAsKernelArg(kernel, 0);
+     * @endcode
+     */
+    template<typename T = ComplexFloat>
+    std::shared_ptr<IMemoryBuffer<T>> CreateBufferWithHint(
+        size_t num_elements,
+        const BufferUsageHint& hint = BufferUsageHint::Default(),
+        MemoryType mem_type = MemoryType::GPU_READ_WRITE);
+    
+    /**
+     * @brief Создать буфер заданной стратегии
+     * 
+     * AUTO → RecommendStrategy(size, Default()). SVM-стратегия, которую
+     * устройство не поддерживает, заменяется на REGULAR_BUFFER.
+     */
+    template<typename T = ComplexFloat>
+    std::shared_ptr<IMemoryBuffer<T>> CreateBufferWithStrategy(
+        size_t num_elements,
+        MemoryStrategy strategy,
+        MemoryType mem_type = MemoryType::GPU_READ_WRITE);
+    
+    /**
+     * @brief Рекомендуемая стратегия для буфера на этом устройстве
+     */
+    MemoryStrategy RecommendStrategy(size_t size_bytes, const BufferUsageHint& hint) const;
+    
+    /**
+     * @brief Стратегия для MemoryStrategy::AUTO вместо эвристики
+     * 
+     * AUTO (по умолчанию) — RecommendStrategy. Из configGPU.json
+     * (memory_strategy); неподдерживаемый SVM → REGULAR_BUFFER.
+     */
+    void SetPreferredStrategy(MemoryStrategy strategy);
+    MemoryStrategy GetPreferredStrategy() const;
+    
+    /**
+     * @brief Возможности устройства (SVM, общая память)
+     * 
+     * Запрашиваются при первом вызове после инициализации бэкенда
+     * (MemoryManager создаётся раньше, чем бэкенд открывает устройство).
+     */
+    SVMCapabilities GetSVMCapabilities() const;
+    
+    /**
+     * @brief Замерить все доступные стратегии на паттерне hint
+     * 
+     * Для каждой стратегии: запись с хоста, проход kernel (uint += 1),
+     * чтение на хост; сравнивает рекомендацию с самой быстрой.
+     * Буферы бенчмарка не попадают в статистику.
+     * 
+     * @param size_bytes Размер буфера
+     * @param hint Паттерн использования
+     * @param iterations Число замеров (после одного прогревочного)
+     */
+    StrategyBenchmarkReport BenchmarkStrategies(size_t size_bytes,
+                                                const BufferUsageHint& hint,
+                                                int iterations = 10);
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Zero-copy буферы (integrated GPU / CPU-устройства)
+    // ═══════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Устройство работает в общей с хостом памяти
+     * 
+     * CPU-устройства OpenCL, AMD APU, Intel iGPU. Здесь clEnqueueWriteBuffer
+     * копирует данные внутри одной физической памяти — вместо него
+     * используйте CreateZeroCopyBuffer / WrapHostMemory + map/unmap.
+     */
+    bool HasUnifiedMemory() const;
+    
+    /**
+     * @brief Буфер в памяти, которую выделяет драйвер (CL_MEM_ALLOC_HOST_PTR)
+     * 
+     * Хост пишет в него через Map()/MapRegion(): на общей памяти map
+     * возвращает указатель на сами данные, без копии.
+     */
+    template<typename T>
+    std::shared_ptr<RegularBuffer<T>> CreateZeroCopyBuffer(
+        size_t num_elements,
+        MemoryType mem_type = MemoryType::GPU_READ_WRITE);
+    
+    /**
+     * @brief Буфер поверх памяти пользователя (CL_MEM_USE_HOST_PTR)
+     * 
+     * host_ptr выровнен по kHostPtrAlignment (AlignedHostVector /
+     * AllocateHostAligned) и живёт дольше буфера.
+     * 
+     * @throws std::invalid_argument если host_ptr не выровнен
+     */
+    template<typename T>
+    std::shared_ptr<RegularBuffer<T>> WrapHostMemory(
+        T* host_ptr,
+        size_t num_elements,
+        MemoryType mem_type = MemoryType::GPU_READ_WRITE);
+    
+    /**
+     * @brief Выделить выровненную host-память (для WrapHostMemory)
+     * @see AlignedHostVector — то же для std::vector
+     */
+    static void* AllocateHostAligned(size_t size_bytes) { return AlignedHostAlloc(size_bytes); }
+    
+    /**
+     * @brief Освободить память из AllocateHostAligned
+     */
+    static void FreeHostAligned(void* ptr) { AlignedHostFree(ptr); }
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Арена временных буферов кадра
+    // ═══════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Зарезервировать арену на один поток (очередь бэкенда)
+     * 
+     * Резерв учитывается в статистике как одна аллокация.
+     * @see FrameArena
+     */
+    std::unique_ptr<FrameArena> CreateFrameArena(size_t capacity_bytes);
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Нехватка памяти: освобождение и повтор выделения
+    // ═══════════════════════════════════════════════════════════════
+    
+    /// Сколько раз выделение повторяется после RelieveMemoryPressure
+    static constexpr int kMaxPressureRetries = 3;
+    
+    /**
+     * @brief Зарегистрировать колбэк освобождения памяти
+     * 
+     * @param name Имя (для лога)
+     * @param callback Колбэк
+     * @param priority Порядок вызова: меньше — раньше (дешёвое в
+     *        пересоздании освобождается первым)
+     * 
+     * @code
+     * eviction_ = mem_mgr->RegisterEvictionCallback("AntennaFFT plans",
+     *     [cache](size_t) { return cache->EvictIdle(); });
+     * @endcode
+     */
+    EvictionRegistration RegisterEvictionCallback(const std::string& name,
+                                                  EvictionCallback callback,
+                                                  int priority = 0);
+    
+    /**
+     * @brief Снять колбэк (обычно через EvictionRegistration)
+     * 
+     * Если колбэк сейчас выполняется в другом потоке (RelieveMemoryPressure),
+     * ждёт его завершения: после возврата колбэк больше не вызывается, и
+     * ресурсы, которые он захватил, можно освобождать.
+     */
+    void UnregisterEvictionCallback(size_t id);
+    
+    /**
+     * @brief Вызвать колбэки по приоритету, пока не освобождено bytes_needed
+     * @return Сколько байт освобождено всего
+     */
+    size_t RelieveMemoryPressure(size_t bytes_needed);
+    
+    /**
+     * @brief Выделить с повтором при нехватке памяти
+     * 
+     * allocate() — любое выделение (clCreateBuffer, буфер модуля), которое
+     * при неудаче бросает std::runtime_error или возвращает пустой результат.
+     * После неудачи вызывается RelieveMemoryPressure(size_bytes), и выделение
+     * повторяется, пока колбэки что-то освобождают (не более kMaxPressureRetries).
+     * Если освободить нечего — исходная ошибка (исключение или пустой результат).
+     */
+    template<typename AllocFn>
+    auto AllocateWithRetry(size_t size_bytes, AllocFn&& allocate) -> decltype(allocate());
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Бюджет памяти устройства
+    // ═══════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Лимит памяти устройства в байтах (0 — без лимита)
+     * 
+     * Выделение, не помещающееся в бюджет, обрабатывается как нехватка
+     * памяти: колбэки освобождения, повтор, затем std::runtime_error —
+     * модули с деградацией пакета (AllocateBuffersDegrading) ужимают пакет.
+     */
+    void SetMemoryBudget(size_t limit_bytes);
+    
+    /**
+     * @brief Лимит в процентах глобальной памяти устройства (max_memory_percent)
+     * @throws std::invalid_argument если percent вне [1, 100]
+     * @throws std::runtime_error если бэкенд не инициализирован
+     */
+    void SetMemoryBudgetPercent(size_t percent);
+    
+    /**
+     * @brief Текущий лимит (0 — без лимита)
+     */
+    size_t GetMemoryBudget() const;
+    
+    /**
+     * @brief Остаток бюджета с учётом всех менеджеров устройства
+     * @return MemoryBudget::kUnlimited, если лимита нет
+     */
+    size_t GetMemoryBudgetRemaining() const;
+    
+    /**
+     * @brief Общий бюджет с другим менеджером того же устройства
+     * 
+     * other начинает проверять и пополнять бюджет этого менеджера:
+     * DrvGPU делит бюджет с менеджером бэкенда, через который выделяют модули.
+     */
+    void ShareMemoryBudget(MemoryManager& other);
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Учёт по меткам (модуль/назначение)
+    // ═══════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Учесть cl_mem, созданный модулем напрямую (clCreateBuffer)
+     * 
+     * Размер — CL_MEM_SIZE. Перед clReleaseMemObject вызвать
+     * UnregisterExternalAllocation, иначе объём останется в статистике.
+     * 
+     * @code
+     * buffer_fft_input_ = clCreateBuffer(...);
+     * mem_mgr->RegisterExternalAllocation(buffer_fft_input_, "AntennaFFT/fft_input");
+     * ...
+     * mem_mgr->UnregisterExternalAllocation(buffer_fft_input_);
+     * clReleaseMemObject(buffer_fft_input_);
+     * @endcode
+     */
+    void RegisterExternalAllocation(cl_mem mem, const std::string& tag);
+    
+    /**
+     * @brief Учесть внешнее выделение с известным размером (любой хэндл)
+     */
+    void RegisterExternalAllocation(const void* handle, size_t size_bytes, const std::string& tag);
+    
+    /**
+     * @brief Списать внешнее выделение (неизвестный хэндл игнорируется)
+     */
+    void UnregisterExternalAllocation(const void* handle);
+    
+    /**
+     * @brief Память по меткам, по убыванию текущего объёма
+     * 
+     * Буферы Create* учитываются под меткой ScopedMemoryTag потока.
+     */
+    std::vector<MemoryTagStats> GetTagStatistics() const;
+    
+    /**
+     * @brief Память одной метки
+     */
+    MemoryTagStats GetTagStatistics(const std::string& tag) const;
+    
+    /**
+     * @brief Начать новое окно high-water: пики := текущие значения
+     */
+    void ResetTagPeaks();
+    
+    /**
+     * @brief Отправить снимок памяти по меткам в GPUProfiler
+     * 
+     * Метка "total" — общий объём и пик MemoryManager.
+     */
+    void PublishMemoryStats();
+    
+    /**
+     * @brief Периодический экспорт: PublishMemoryStats не чаще interval,
+     *        при выделениях/освобождениях через MemoryManager (0 — выключен)
+     */
+    void SetMemoryExportInterval(std::chrono::milliseconds interval);
+    
     // ═══════════════════════════════════════════════════════════════
     // Прямое выделение памяти (низкоуровневое)
     // ═══════════════════════════════════════════════════════════════
@@ -136,7 +537,7 @@ public:
     size_t GetAllocationCount() const;
     
     /**
-     * @brief Получить общий размер выделенной памяти (bytes)
+     * @brief Получить объём живых выделений (bytes)
      */
     size_t GetTotalAllocatedBytes() const;
     
@@ -152,6 +553,9 @@ public:
     
     /**
      * @brief Сбросить статистику
+     * 
+     * Счётчики выделений и событий обнуляются, пик := текущий объём.
+     * Живые байты не сбрасываются — по ним считается бюджет памяти.
      */
     void ResetStatistics();
     
@@ -170,12 +574,52 @@ private:
     // ═══════════════════════════════════════════════════════════════
     IBackend* backend_;  ///< Указатель на бэкенд (не владеет)
     
-    // Статистика
-    size_t total_allocations_;
-    size_t total_frees_;
-    size_t current_allocations_;
-    size_t total_bytes_allocated_;
-    size_t peak_bytes_allocated_;
+    // Статистика (атомики, без mutex_; shared_ptr — списание в deleter'ах буферов)
+    std::shared_ptr<AllocationStats> stats_;
+    
+    // Учёт по меткам (собственный mutex; переживает менеджер в deleter'ах буферов)
+    std::shared_ptr<MemoryLedger> ledger_;
+    
+    // Периодический экспорт в GPUProfiler (атомики: проверяется на каждом выделении)
+    std::atomic<int64_t> export_interval_ms_{0};
+    std::atomic<int64_t> last_export_ns_{0};
+    
+    // Нехватка памяти (под mutex_)
+    size_t pressure_events_ = 0;      ///< Вызовов RelieveMemoryPressure
+    size_t pressure_recovered_ = 0;   ///< Выделений, удавшихся после освобождения
+    size_t pressure_failed_ = 0;      ///< Выделений, не удавшихся и после колбэков
+    size_t bytes_evicted_ = 0;        ///< Освобождено колбэками всего
+    size_t budget_rejections_ = 0;    ///< Выделений сверх бюджета
+    
+    // Бюджет устройства (общий с другими менеджерами устройства)
+    std::shared_ptr<MemoryBudget> budget_;
+    
+    // Стратегия для AUTO (AUTO — эвристика устройства)
+    std::atomic<MemoryStrategy> preferred_strategy_{MemoryStrategy::AUTO};
+    
+    // Колбэк и признак регистрации. RelieveMemoryPressure вызывает колбэк
+    // под run_mutex, Unregister сбрасывает active под ним же — и ждёт вызов.
+    // recursive: колбэк может снять собственную регистрацию
+    struct EvictionSlot {
+        EvictionCallback callback;
+        std::recursive_mutex run_mutex;
+        bool active = true;                 ///< Под run_mutex
+    };
+    
+    // Колбэки освобождения (под eviction_mutex_)
+    struct EvictionEntry {
+        size_t id = 0;
+        std::string name;
+        int priority = 0;
+        std::shared_ptr<EvictionSlot> slot;
+    };
+    std::vector<EvictionEntry> eviction_callbacks_;
+    size_t next_eviction_id_ = 1;
+    mutable std::mutex eviction_mutex_;
+    
+    // Возможности устройства (ленивый запрос, под mutex_)
+    mutable SVMCapabilities svm_caps_;
+    mutable bool svm_caps_valid_ = false;
     
     // Thread-safety
     mutable std::mutex mutex_;
@@ -184,10 +628,31 @@ private:
     // Приватные методы
     // ═══════════════════════════════════════════════════════════════
     
-    // ⚠️ ВАЖНО: Эти методы вызываются ТОЛЬКО под mutex_ lock!
-    // НЕ добавляйте std::lock_guard внутрь - приведёт к deadlock!
-    void TrackAllocation(size_t size_bytes);
-    void TrackFree(size_t size_bytes);
+    // Обновление статистики; lock не нужен (AllocationStats на атомиках)
+    void TrackAllocation(size_t size_bytes) { stats_->OnAllocate(size_bytes); }
+    void TrackFree(size_t size_bytes) { stats_->OnFree(size_bytes); }
+    
+    /// Учесть буфер под текущей меткой; освобождение (метка + статистика) — при уничтожении буфера
+    template<typename B>
+    std::shared_ptr<B> TagBuffer(std::shared_ptr<B> buffer, size_t size_bytes);
+    
+    /// PublishMemoryStats, если прошёл export_interval_
+    void MaybePublishMemoryStats();
+    
+    /// Итог AllocateWithRetry после неудачной первой попытки
+    void NotePressureOutcome(bool recovered);
+    
+    /// Выделение не помещается в бюджет: учесть и бросить std::runtime_error
+    [[noreturn]] void ThrowBudgetExceeded(size_t size_bytes);
+    
+    /// AUTO → рекомендация; неподдерживаемый SVM → REGULAR_BUFFER
+    MemoryStrategy ResolveStrategy(size_t size_bytes, MemoryStrategy strategy) const;
+    
+    /// Создать буфер без учёта в статистике
+    template<typename T>
+    std::shared_ptr<IMemoryBuffer<T>> MakeBuffer(size_t num_elements,
+                                                  MemoryStrategy strategy,
+                                                  MemoryType mem_type) const;
 };
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -199,14 +664,18 @@ std::shared_ptr<GPUBuffer<T>> MemoryManager::CreateBuffer(
     size_t num_elements, 
     unsigned int flags)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     size_t size_bytes = num_elements * sizeof(T);
-    void* ptr = backend_->Allocate(size_bytes, flags);
     
-    TrackAllocation(size_bytes);  // ✅ Вызывается под lock - безопасно
+    // Без lock: колбэки освобождения могут обращаться к MemoryManager
+    void* ptr = AllocateWithRetry(size_bytes, [&] {
+        return backend_->Allocate(size_bytes, flags);
+    });
+    
+    TrackAllocation(size_bytes);
     
-    return std::make_shared<GPUBuffer<T>>(ptr, num_elements, backend_);
+    auto buffer = TagBuffer(std::make_shared<GPUBuffer<T>>(ptr, num_elements, backend_), size_bytes);
+    MaybePublishMemoryStats();
+    return buffer;
 }
 
 template<typename T>
@@ -220,4 +689,149 @@ std::shared_ptr<GPUBuffer<T>> MemoryManager::CreateBuffer(
     return buffer;
 }
 
+template<typename B>
+std::shared_ptr<B> MemoryManager::TagBuffer(std::shared_ptr<B> buffer, size_t size_bytes) {
+    // Метка разрешена один раз на область ScopedMemoryTag; освобождение —
+    // по захваченным счётчикам, без поиска по строке
+    MemoryLedger::TagCounters& counters = ledger_->CurrentCounters();
+    MemoryLedger::Allocate(counters, size_bytes);
+    
+    // Внешний shared_ptr владеет исходным: при уничтожении списывает метку и статистику.
+    // ledger захвачен ради времени жизни counters
+    B* raw = buffer.get();
+    return std::shared_ptr<B>(raw,
+        [owner = std::move(buffer), ledger = ledger_, counters = &counters,
+         stats = stats_, size_bytes](B*) mutable {
+            owner.reset();
+            MemoryLedger::Release(*counters, size_bytes);
+            stats->OnFree(size_bytes);
+        });
+}
+
+template<typename AllocFn>
+auto MemoryManager::AllocateWithRetry(size_t size_bytes, AllocFn&& allocate)
+    -> decltype(allocate())
+{
+    std::exception_ptr error;
+    
+    for (int attempt = 0; attempt <= kMaxPressureRetries; ++attempt) {
+        if (attempt > 0 && RelieveMemoryPressure(size_bytes) == 0) {
+            break;  // Освобождать больше нечего
+        }
+        
+        try {
+            if (!budget_->Fits(size_bytes)) {
+                ThrowBudgetExceeded(size_bytes);
+            }
+            auto result = allocate();
+            if (result) {
+                if (attempt > 0) NotePressureOutcome(true);
+                return result;
+            }
+            error = nullptr;
+        } catch (const std::runtime_error&) {
+            error = std::current_exception();
+        }
+    }
+    
+    NotePressureOutcome(false);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return decltype(allocate()){};
+}
+
+template<typename T>
+std::shared_ptr<IMemoryBuffer<T>> MemoryManager::MakeBuffer(
+    size_t num_elements,
+    MemoryStrategy strategy,
+    MemoryType mem_type) const
+{
+    if (!backend_ || !backend_->IsInitialized()) {
+        throw std::runtime_error("MemoryManager: backend is not initialized");
+    }
+    
+    auto context = static_cast<cl_context>(backend_->GetNativeContext());
+    auto queue = static_cast<cl_command_queue>(backend_->GetNativeQueue());
+    
+    switch (strategy) {
+        case MemoryStrategy::SVM_COARSE_GRAIN:
+        case MemoryStrategy::SVM_FINE_GRAIN:
+        case MemoryStrategy::SVM_FINE_SYSTEM:
+            return std::make_shared<SVMBuffer<T>>(context, queue, num_elements, strategy, mem_type);
+        default:
+            return std::make_shared<RegularBuffer<T>>(context, queue, num_elements, strategy, mem_type);
+    }
+}
+
+template<typename T>
+std::shared_ptr<IMemoryBuffer<T>> MemoryManager::CreateBufferWithStrategy(
+    size_t num_elements,
+    MemoryStrategy strategy,
+    MemoryType mem_type)
+{
+    const size_t size_bytes = num_elements * sizeof(T);
+    strategy = ResolveStrategy(size_bytes, strategy);
+    
+    auto buffer = AllocateWithRetry(size_bytes, [&] {
+        return MakeBuffer<T>(num_elements, strategy, mem_type);
+    });
+    
+    TrackAllocation(size_bytes);
+    
+    buffer = TagBuffer(std::move(buffer), size_bytes);
+    MaybePublishMemoryStats();
+    return buffer;
+}
+
+template<typename T>
+std::shared_ptr<RegularBuffer<T>> MemoryManager::CreateZeroCopyBuffer(
+    size_t num_elements,
+    MemoryType mem_type)
+{
+    if (!backend_ || !backend_->IsInitialized()) {
+        throw std::runtime_error("MemoryManager: backend is not initialized");
+    }
+    
+    auto buffer = AllocateWithRetry(num_elements * sizeof(T), [&] {
+        return std::make_shared<RegularBuffer<T>>(
+            static_cast<cl_context>(backend_->GetNativeContext()),
+            static_cast<cl_command_queue>(backend_->GetNativeQueue()),
+            num_elements, MemoryStrategy::HOST_MAPPED, mem_type);
+    });
+    
+    TrackAllocation(num_elements * sizeof(T));
+    
+    buffer = TagBuffer(std::move(buffer), num_elements * sizeof(T));
+    MaybePublishMemoryStats();
+    return buffer;
+}
+
+template<typename T>
+std::shared_ptr<RegularBuffer<T>> MemoryManager::WrapHostMemory(
+    T* host_ptr,
+    size_t num_elements,
+    MemoryType mem_type)
+{
+    if (!backend_ || !backend_->IsInitialized()) {
+        throw std::runtime_error("MemoryManager: backend is not initialized");
+    }
+    
+    // Память принадлежит вызывающему — в статистику не попадает
+    return std::make_shared<RegularBuffer<T>>(
+        static_cast<cl_context>(backend_->GetNativeContext()),
+        static_cast<cl_command_queue>(backend_->GetNativeQueue()),
+        host_ptr, num_elements, mem_type);
+}
+
+template<typename T>
+std::shared_ptr<IMemoryBuffer<T>> MemoryManager::CreateBufferWithHint(
+    size_t num_elements,
+    const BufferUsageHint& hint,
+    MemoryType mem_type)
+{
+    return CreateBufferWithStrategy<T>(
+        num_elements, RecommendStrategy(num_elements * sizeof(T), hint), mem_type);
+}
+
 } // namespace drv_gpu_lib
\ No newline at end of file
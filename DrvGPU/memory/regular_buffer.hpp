@@ -0,0 +1,523 @@
+#pragma once
+
+/**
+ * @file regular_buffer.hpp
+ * @brief RAII обёртка над cl_mem, реализующая IMemoryBuffer<T>
+ *
+ * Варианты:
+ * - REGULAR_BUFFER: обычный clCreateBuffer, обмен через
+ *   clEnqueueRead/WriteBuffer
+ * - HOST_MAPPED: clCreateBuffer с CL_MEM_ALLOC_HOST_PTR, обмен через
+ *   map/unmap. На integrated GPU и CPU-устройствах драйвер размещает такой
+ *   буфер в общей памяти, и map не копирует данные (zero-copy)
+ * - HOST_MAPPED поверх памяти пользователя: CL_MEM_USE_HOST_PTR, указатель
+ *   выровнен по kHostPtrAlignment (см. aligned_host_allocator.hpp)
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "i_memory_buffer.hpp"
+#include "aligned_host_allocator.hpp"
+#include "svm_capabilities.hpp"
+#include "memory_type.hpp"
+#include <CL/cl.h>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+namespace drv_gpu_lib {
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: RegularBuffer - cl_mem буфер (обычный или host-mapped)
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class RegularBuffer
+ * @brief cl_mem буфер за интерфейсом IMemoryBuffer<T>
+ *
+ * Позволяет MemoryManager возвращать один тип (IMemoryBuffer<T>) для всех
+ * стратегий: вызывающий код не знает, SVM под ним или cl_mem.
+ *
+ * @code
+ * RegularBuffer<float> buffer(context, queue, n, MemoryStrategy::HOST_MAPPED);
+ * buffer.Write(data);            // map + memcpy + unmap
+ * buffer.SetAsKernelArg(kernel, 0);
+ * // ... clEnqueueNDRangeKernel ...
+ * {
+ *     ScopedMap guard(&buffer, false, true);
+ *     float first = buffer.Data()[0];   // без копии на общей памяти
+ * }
+ * @endcode
+ */
+template <typename T = ComplexFloat>
+class RegularBuffer : public IMemoryBuffer<T> {
+public:
+    using Vector = std::vector<T>;
+
+    // ═══════════════════════════════════════════════════════════════
+    // Конструкторы
+    // ═══════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Создать буфер
+     * @param context OpenCL context
+     * @param queue Command queue для операций
+     * @param num_elements Количество элементов T
+     * @param strategy REGULAR_BUFFER или HOST_MAPPED
+     * @param mem_type Тип памяти (READ_ONLY, WRITE_ONLY, READ_WRITE)
+     * @throws std::invalid_argument если strategy — SVM
+     * @throws std::runtime_error если clCreateBuffer failed
+     */
+    RegularBuffer(
+        cl_context context,
+        cl_command_queue queue,
+        size_t num_elements,
+        MemoryStrategy strategy = MemoryStrategy::REGULAR_BUFFER,
+        MemoryType mem_type = MemoryType::GPU_READ_WRITE
+    );
+
+    /**
+     * @brief Буфер поверх памяти пользователя (CL_MEM_USE_HOST_PTR)
+     * 
+     * Стратегия — HOST_MAPPED. Память не копируется и не освобождается:
+     * она должна жить дольше буфера; между Map() и Unmap() Data() == host_ptr
+     * на устройствах с общей памятью.
+     * 
+     * @throws std::invalid_argument если host_ptr не выровнен по kHostPtrAlignment
+     */
+    RegularBuffer(
+        cl_context context,
+        cl_command_queue queue,
+        T* host_ptr,
+        size_t num_elements,
+        MemoryType mem_type = MemoryType::GPU_READ_WRITE
+    );
+
+    ~RegularBuffer() override;
+
+    RegularBuffer(const RegularBuffer&) = delete;
+    RegularBuffer& operator=(const RegularBuffer&) = delete;
+
+    // ═══════════════════════════════════════════════════════════════
+    // Реализация IMemoryBuffer интерфейса
+    // ═══════════════════════════════════════════════════════════════
+
+    // --- Чтение/Запись ---
+    void Write(const Vector& data) override;
+    void WriteRaw(const void* data, size_t size_bytes) override;
+    Vector Read() override;
+    Vector ReadPartial(size_t num_elements) override;
+    void ReadRaw(void* dest, size_t size_bytes) override;
+
+    // --- Асинхронные операции ---
+    cl_event WriteAsync(const Vector& data) override;
+    cl_event ReadAsync(Vector& out_data) override;
+
+    // --- OpenCL ресурсы ---
+    cl_mem GetCLMem() const override { return buffer_; }
+    void* GetSVMPointer() const override { return nullptr; }
+    void SetAsKernelArg(cl_kernel kernel, cl_uint arg_index) override;
+
+    // --- Информация ---
+    size_t GetNumElements() const override { return num_elements_; }
+    size_t GetSizeBytes() const override { return size_bytes_; }
+    MemoryType GetMemoryType() const override { return mem_type_; }
+    MemoryStrategy GetStrategy() const override { return strategy_; }
+    bool IsExternal() const override { return false; }
+    bool IsSVM() const override { return false; }
+    BufferInfo GetInfo() const override;
+    void PrintStats() const override;
+
+    // --- Map/Unmap (clEnqueueMapBuffer) ---
+    void Map(bool write = true, bool read = true) override;
+    void Unmap() override;
+    bool IsMapped() const override { return mapped_ptr_ != nullptr; }
+
+    /**
+     * @brief Указатель на замапленные данные
+     * @throws std::logic_error если буфер не замаплен
+     */
+    T* Data();
+    const T* Data() const;
+
+    // --- Map/Unmap части буфера (без учёта в IsMapped) ---
+
+    /**
+     * @brief Замапить диапазон байт (blocking)
+     * @param offset_bytes Смещение от начала буфера
+     * @param size_bytes Размер диапазона
+     * @param flags CL_MAP_READ / CL_MAP_WRITE / CL_MAP_WRITE_INVALIDATE_REGION
+     * @return Указатель на диапазон (отдать в UnmapRegion)
+     */
+    void* MapRegion(size_t offset_bytes, size_t size_bytes, cl_map_flags flags);
+
+    /**
+     * @brief Unmap диапазона из MapRegion (non-blocking)
+     * @return Событие unmap — после него данные видны kernel'ам
+     */
+    cl_event UnmapRegion(void* region_ptr);
+
+    /// Буфер использует память пользователя (CL_MEM_USE_HOST_PTR)
+    bool UsesHostPtr() const { return host_ptr_ != nullptr; }
+
+private:
+    cl_context       context_      = nullptr;
+    cl_command_queue queue_        = nullptr;
+    cl_mem           buffer_       = nullptr;
+    void*            mapped_ptr_   = nullptr;
+    void*            host_ptr_     = nullptr;   ///< Для CL_MEM_USE_HOST_PTR (не владеет)
+    size_t           num_elements_ = 0;
+    size_t           size_bytes_   = 0;
+    MemoryStrategy   strategy_     = MemoryStrategy::REGULAR_BUFFER;
+    MemoryType       mem_type_     = MemoryType::GPU_READ_WRITE;
+
+    cl_mem_flags GetCLFlags() const;
+
+    static void CheckCLError(cl_int err, const std::string& operation);
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Реализация
+// ════════════════════════════════════════════════════════════════════════════
+
+template <typename T>
+inline RegularBuffer<T>::RegularBuffer(
+    cl_context context,
+    cl_command_queue queue,
+    size_t num_elements,
+    MemoryStrategy strategy,
+    MemoryType mem_type)
+    : context_(context),
+      queue_(queue),
+      num_elements_(num_elements),
+      size_bytes_(num_elements * sizeof(T)),
+      strategy_(strategy),
+      mem_type_(mem_type) {
+
+    if (!context_ || !queue_) {
+        throw std::invalid_argument("RegularBuffer: context and queue must not be null");
+    }
+    if (num_elements_ == 0) {
+        throw std::invalid_argument("RegularBuffer: num_elements must be > 0");
+    }
+    if (strategy_ != MemoryStrategy::REGULAR_BUFFER &&
+        strategy_ != MemoryStrategy::HOST_MAPPED) {
+        throw std::invalid_argument(
+            std::string("RegularBuffer: unsupported strategy ") +
+            MemoryStrategyToString(strategy_));
+    }
+
+    cl_int err = CL_SUCCESS;
+    buffer_ = clCreateBuffer(context_, GetCLFlags(), size_bytes_, nullptr, &err);
+    CheckCLError(err, "clCreateBuffer");
+}
+
+template <typename T>
+inline RegularBuffer<T>::RegularBuffer(
+    cl_context context,
+    cl_command_queue queue,
+    T* host_ptr,
+    size_t num_elements,
+    MemoryType mem_type)
+    : context_(context),
+      queue_(queue),
+      host_ptr_(host_ptr),
+      num_elements_(num_elements),
+      size_bytes_(num_elements * sizeof(T)),
+      strategy_(MemoryStrategy::HOST_MAPPED),
+      mem_type_(mem_type) {
+
+    if (!context_ || !queue_) {
+        throw std::invalid_argument("RegularBuffer: context and queue must not be null");
+    }
+    if (!host_ptr_ || num_elements_ == 0) {
+        throw std::invalid_argument("RegularBuffer: host_ptr must not be null, num_elements > 0");
+    }
+    if (!IsHostPtrAligned(host_ptr_)) {
+        throw std::invalid_argument(
+            "RegularBuffer: host_ptr must be aligned to " +
+            std::to_string(kHostPtrAlignment) + " bytes (use AlignedHostVector)");
+    }
+
+    cl_int err = CL_SUCCESS;
+    buffer_ = clCreateBuffer(context_, GetCLFlags(), size_bytes_, host_ptr_, &err);
+    CheckCLError(err, "clCreateBuffer (CL_MEM_USE_HOST_PTR)");
+}
+
+template <typename T>
+inline RegularBuffer<T>::~RegularBuffer() {
+    if (mapped_ptr_) {
+        clEnqueueUnmapMemObject(queue_, buffer_, mapped_ptr_, 0, nullptr, nullptr);
+        clFinish(queue_);
+        mapped_ptr_ = nullptr;
+    }
+    if (buffer_) {
+        clReleaseMemObject(buffer_);
+        buffer_ = nullptr;
+    }
+}
+
+template <typename T>
+inline cl_mem_flags RegularBuffer<T>::GetCLFlags() const {
+    cl_mem_flags flags = 0;
+    switch (mem_type_) {
+        case MemoryType::GPU_READ_ONLY:  flags = CL_MEM_READ_ONLY;  break;
+        case MemoryType::GPU_WRITE_ONLY: flags = CL_MEM_WRITE_ONLY; break;
+        case MemoryType::GPU_READ_WRITE:
+        default:                         flags = CL_MEM_READ_WRITE; break;
+    }
+    if (host_ptr_) {
+        flags |= CL_MEM_USE_HOST_PTR;
+    } else if (strategy_ == MemoryStrategy::HOST_MAPPED) {
+        flags |= CL_MEM_ALLOC_HOST_PTR;
+    }
+    return flags;
+}
+
+template <typename T>
+inline void RegularBuffer<T>::Map(bool write, bool read) {
+    if (mapped_ptr_) {
+        return;  // Already mapped
+    }
+
+    cl_map_flags map_flags = 0;
+    if (write) map_flags |= read ? CL_MAP_WRITE : CL_MAP_WRITE_INVALIDATE_REGION;
+    if (read)  map_flags |= CL_MAP_READ;
+
+    cl_int err = CL_SUCCESS;
+    mapped_ptr_ = clEnqueueMapBuffer(
+        queue_, buffer_,
+        CL_TRUE,  // Blocking
+        map_flags,
+        0, size_bytes_,
+        0, nullptr, nullptr,
+        &err
+    );
+    if (err != CL_SUCCESS) {
+        mapped_ptr_ = nullptr;
+    }
+    CheckCLError(err, "clEnqueueMapBuffer");
+}
+
+template <typename T>
+inline void RegularBuffer<T>::Unmap() {
+    if (!mapped_ptr_) {
+        return;  // Not mapped
+    }
+
+    cl_int err = clEnqueueUnmapMemObject(queue_, buffer_, mapped_ptr_, 0, nullptr, nullptr);
+    mapped_ptr_ = nullptr;
+    CheckCLError(err, "clEnqueueUnmapMemObject");
+
+    // Flush to ensure unmap completes
+    clFlush(queue_);
+}
+
+template <typename T>
+inline void* RegularBuffer<T>::MapRegion(size_t offset_bytes, size_t size_bytes,
+                                         cl_map_flags flags) {
+    if (offset_bytes + size_bytes > size_bytes_) {
+        throw std::runtime_error(
+            "RegularBuffer::MapRegion: region exceeds buffer size"
+        );
+    }
+
+    cl_int err = CL_SUCCESS;
+    void* ptr = clEnqueueMapBuffer(
+        queue_, buffer_,
+        CL_TRUE,  // Blocking
+        flags,
+        offset_bytes, size_bytes,
+        0, nullptr, nullptr,
+        &err
+    );
+    CheckCLError(err, "clEnqueueMapBuffer (region)");
+    return ptr;
+}
+
+template <typename T>
+inline cl_event RegularBuffer<T>::UnmapRegion(void* region_ptr) {
+    cl_event event = nullptr;
+    cl_int err = clEnqueueUnmapMemObject(queue_, buffer_, region_ptr, 0, nullptr, &event);
+    CheckCLError(err, "clEnqueueUnmapMemObject (region)");
+    return event;
+}
+
+template <typename T>
+inline void RegularBuffer<T>::Write(const std::vector<T>& data) {
+    if (data.size() > num_elements_) {
+        throw std::runtime_error(
+            "RegularBuffer::Write: data size exceeds buffer capacity"
+        );
+    }
+    WriteRaw(data.data(), data.size() * sizeof(T));
+}
+
+template <typename T>
+inline void RegularBuffer<T>::WriteRaw(const void* data, size_t size_bytes) {
+    if (size_bytes > size_bytes_) {
+        throw std::runtime_error(
+            "RegularBuffer::WriteRaw: size exceeds buffer capacity"
+        );
+    }
+
+    if (strategy_ == MemoryStrategy::HOST_MAPPED || mapped_ptr_) {
+        bool was_mapped = mapped_ptr_ != nullptr;
+        if (!was_mapped) {
+            // Весь буфер перезаписывается → без чтения старого содержимого
+            Map(true, size_bytes < size_bytes_);
+        }
+        std::memcpy(mapped_ptr_, data, size_bytes);
+        if (!was_mapped) {
+            Unmap();
+        }
+        return;
+    }
+
+    cl_int err = clEnqueueWriteBuffer(
+        queue_, buffer_, CL_TRUE, 0, size_bytes, data, 0, nullptr, nullptr);
+    CheckCLError(err, "clEnqueueWriteBuffer");
+}
+
+template <typename T>
+inline std::vector<T> RegularBuffer<T>::Read() {
+    return ReadPartial(num_elements_);
+}
+
+template <typename T>
+inline std::vector<T> RegularBuffer<T>::ReadPartial(size_t num_elements) {
+    if (num_elements > num_elements_) {
+        throw std::runtime_error(
+            "RegularBuffer::ReadPartial: requested elements exceed buffer size"
+        );
+    }
+    std::vector<T> result(num_elements);
+    ReadRaw(result.data(), num_elements * sizeof(T));
+    return result;
+}
+
+template <typename T>
+inline void RegularBuffer<T>::ReadRaw(void* dest, size_t size_bytes) {
+    if (size_bytes > size_bytes_) {
+        throw std::runtime_error(
+            "RegularBuffer::ReadRaw: size exceeds buffer capacity"
+        );
+    }
+
+    if (strategy_ == MemoryStrategy::HOST_MAPPED || mapped_ptr_) {
+        bool was_mapped = mapped_ptr_ != nullptr;
+        if (!was_mapped) {
+            Map(false, true);
+        }
+        std::memcpy(dest, mapped_ptr_, size_bytes);
+        if (!was_mapped) {
+            Unmap();
+        }
+        return;
+    }
+
+    cl_int err = clEnqueueReadBuffer(
+        queue_, buffer_, CL_TRUE, 0, size_bytes, dest, 0, nullptr, nullptr);
+    CheckCLError(err, "clEnqueueReadBuffer");
+}
+
+template <typename T>
+inline cl_event RegularBuffer<T>::WriteAsync(const std::vector<T>& data) {
+    if (data.size() > num_elements_) {
+        throw std::runtime_error(
+            "RegularBuffer::WriteAsync: data size exceeds buffer capacity"
+        );
+    }
+
+    cl_event event = nullptr;
+    cl_int err = clEnqueueWriteBuffer(
+        queue_, buffer_, CL_FALSE, 0, data.size() * sizeof(T), data.data(),
+        0, nullptr, &event);
+    CheckCLError(err, "clEnqueueWriteBuffer (async)");
+    return event;
+}
+
+template <typename T>
+inline cl_event RegularBuffer<T>::ReadAsync(std::vector<T>& out_data) {
+    if (out_data.size() < num_elements_) {
+        out_data.resize(num_elements_);
+    }
+
+    cl_event event = nullptr;
+    cl_int err = clEnqueueReadBuffer(
+        queue_, buffer_, CL_FALSE, 0, size_bytes_, out_data.data(),
+        0, nullptr, &event);
+    CheckCLError(err, "clEnqueueReadBuffer (async)");
+    return event;
+}
+
+template <typename T>
+inline T* RegularBuffer<T>::Data() {
+    if (!mapped_ptr_) {
+        throw std::logic_error("RegularBuffer::Data: buffer must be mapped");
+    }
+    return static_cast<T*>(mapped_ptr_);
+}
+
+template <typename T>
+inline const T* RegularBuffer<T>::Data() const {
+    if (!mapped_ptr_) {
+        throw std::logic_error("RegularBuffer::Data: buffer must be mapped");
+    }
+    return static_cast<const T*>(mapped_ptr_);
+}
+
+template <typename T>
+inline void RegularBuffer<T>::SetAsKernelArg(cl_kernel kernel, cl_uint arg_index) {
+    cl_int err = clSetKernelArg(kernel, arg_index, sizeof(cl_mem), &buffer_);
+    CheckCLError(err, "clSetKernelArg");
+}
+
+template <typename T>
+inline BufferInfo RegularBuffer<T>::GetInfo() const {
+    BufferInfo info;
+    info.num_elements = num_elements_;
+    info.size_bytes   = size_bytes_;
+    info.element_size = sizeof(T);
+    info.memory_type  = mem_type_;
+    info.strategy     = strategy_;
+    info.is_external  = false;
+    info.is_mapped    = mapped_ptr_ != nullptr;
+    return info;
+}
+
+template <typename T>
+inline void RegularBuffer<T>::PrintStats() const {
+    std::cout << "\n" << std::string(50, '-') << "\n";
+    std::cout << "RegularBuffer Statistics\n";
+    std::cout << std::string(50, '-') << "\n";
+    std::cout << std::left << std::setw(20) << "Elements:" << num_elements_
+              << " × " << sizeof(T) << " bytes\n";
+    std::cout << std::left << std::setw(20) << "Size:"
+              << std::fixed << std::setprecision(2)
+              << (size_bytes_ / (1024.0 * 1024.0)) << " MB\n";
+    std::cout << std::left << std::setw(20) << "Strategy:"
+              << MemoryStrategyToString(strategy_) << "\n";
+    std::cout << std::left << std::setw(20) << "Mapped:"
+              << (mapped_ptr_ ? "YES" : "NO") << "\n";
+    std::cout << std::left << std::setw(20) << "cl_mem:"
+              << buffer_ << "\n";
+    std::cout << std::left << std::setw(20) << "Host pointer:"
+              << (host_ptr_ ? "USE_HOST_PTR" : "-") << "\n";
+    std::cout << std::string(50, '-') << "\n";
+}
+
+template <typename T>
+inline void RegularBuffer<T>::CheckCLError(cl_int err, const std::string& operation) {
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error(
+            "OpenCL Error in " + operation + ": " + std::to_string(err)
+        );
+    }
+}
+
+} // namespace drv_gpu_lib
@@ -41,14 +41,26 @@ namespace drv_gpu_lib {
  * - Zero-copy операции где возможно
  * - Thread-safe (но не concurrent access!)
  * 
+ * T — тип элемента (по умолчанию complex<float>): float для массивов
+ * модулей, int16_t для сырых отсчётов, POD-структуры для результатов.
+ * 
  * @code
- * SVMBuffer buffer(context, queue, 1024, MemoryStrategy::SVM_COARSE_GRAIN);
+ * SVMBuffer<> buffer(context, queue, 1024, MemoryStrategy::SVM_COARSE_GRAIN);
  * buffer.Write(data);  // Автоматический map/unmap внутри
  * auto result = buffer.Read();
+ * 
+ * // Модули спектра в fine-grained SVM: хост читает без копирования
+ * SVMBuffer<float> magnitudes(context, queue, n, MemoryStrategy::SVM_FINE_GRAIN);
+ * magnitudes.SetAsKernelArg(kernel, 1);
+ * // ... clEnqueueNDRangeKernel + clFinish ...
+ * float peak = *std::max_element(magnitudes.Data(), magnitudes.Data() + n);
  * @endcode
  */
-class SVMBuffer : public IMemoryBuffer {
+template <typename T = ComplexFloat>
+class SVMBuffer : public IMemoryBuffer<T> {
 public:
+    using Vector = std::vector<T>;
+    
     // ═══════════════════════════════════════════════════════════════
     // Конструкторы
     // ═══════════════════════════════════════════════════════════════
@@ -57,7 +69,7 @@ public:
      * @brief Создать SVM буфер
      * @param context OpenCL context
      * @param queue Command queue для операций
-     * @param num_elements Количество complex<float> элементов
+     * @param num_elements Количество элементов T
      * @param strategy SVM стратегия (COARSE или FINE)
      * @param mem_type Тип памяти (READ_ONLY, WRITE_ONLY, READ_WRITE)
      * @throws std::runtime_error если SVM allocation failed
@@ -76,7 +88,7 @@ public:
     SVMBuffer(
         cl_context context,
         cl_command_queue queue,
-        const ComplexVector& initial_data,
+        const Vector& initial_data,
         MemoryStrategy strategy = MemoryStrategy::SVM_COARSE_GRAIN,
         MemoryType mem_type = MemoryType::GPU_READ_WRITE
     );
@@ -102,15 +114,15 @@ public:
     // ═══════════════════════════════════════════════════════════════
     
     // --- Чтение/Запись ---
-    void Write(const ComplexVector& data) override;
+    void Write(const Vector& data) override;
     void WriteRaw(const void* data, size_t size_bytes) override;
-    ComplexVector Read() override;
-    ComplexVector ReadPartial(size_t num_elements) override;
+    Vector Read() override;
+    Vector ReadPartial(size_t num_elements) override;
     void ReadRaw(void* dest, size_t size_bytes) override;
     
     // --- Асинхронные операции ---
-    cl_event WriteAsync(const ComplexVector& data) override;
-    cl_event ReadAsync(ComplexVector& out_data) override;
+    cl_event WriteAsync(const Vector& data) override;
+    cl_event ReadAsync(Vector& out_data) override;
     
     // --- OpenCL ресурсы ---
     cl_mem GetCLMem() const override { return nullptr; }  // SVM не использует cl_mem
@@ -131,6 +143,29 @@ public:
     void Map(bool write = true, bool read = true) override;
     void Unmap() override;
     bool IsMapped() const override { return is_mapped_; }
+    
+    // --- Прямой доступ с хоста (без копирования) ---
+    
+    /**
+     * @brief Можно ли сейчас обращаться к данным через Data()
+     * 
+     * Fine-grained — всегда; coarse-grained — только между Map() и Unmap().
+     */
+    bool IsHostAccessible() const;
+    
+    /**
+     * @brief Типизированный указатель на данные
+     * 
+     * Для fine-grained SVM хост читает результаты kernel прямо отсюда
+     * (после clFinish / ожидания события), без Read() и без копии.
+     * 
+     * @throws std::logic_error если coarse-grained буфер не замаплен
+     */
+    T* Data();
+    const T* Data() const;
+    
+    T& operator[](size_t index) { return Data()[index]; }
+    const T& operator[](size_t index) const { return Data()[index]; }
 
 private:
     // ═══════════════════════════════════════════════════════════════
@@ -162,7 +197,8 @@ private:
 // Реализация (inline для header-only или в .cpp)
 // ════════════════════════════════════════════════════════════════════════════
 
-inline SVMBuffer::SVMBuffer(
+template <typename T>
+inline SVMBuffer<T>::SVMBuffer(
     cl_context context,
     cl_command_queue queue,
     size_t num_elements,
@@ -171,7 +207,7 @@ inline SVMBuffer::SVMBuffer(
     : context_(context),
       queue_(queue),
       num_elements_(num_elements),
-      size_bytes_(num_elements * sizeof(ComplexFloat)),
+      size_bytes_(num_elements * sizeof(T)),
       strategy_(strategy),
       mem_type_(mem_type) {
     
@@ -186,10 +222,11 @@ inline SVMBuffer::SVMBuffer(
     AllocateSVM();
 }
 
-inline SVMBuffer::SVMBuffer(
+template <typename T>
+inline SVMBuffer<T>::SVMBuffer(
     cl_context context,
     cl_command_queue queue,
-    const ComplexVector& initial_data,
+    const std::vector<T>& initial_data,
     MemoryStrategy strategy,
     MemoryType mem_type)
     : SVMBuffer(context, queue, initial_data.size(), strategy, mem_type) {
@@ -197,11 +234,13 @@ inline SVMBuffer::SVMBuffer(
     Write(initial_data);
 }
 
-inline SVMBuffer::~SVMBuffer() {
+template <typename T>
+inline SVMBuffer<T>::~SVMBuffer() {
     FreeSVM();
 }
 
-inline SVMBuffer::SVMBuffer(SVMBuffer&& other) noexcept
+template <typename T>
+inline SVMBuffer<T>::SVMBuffer(SVMBuffer&& other) noexcept
     : context_(other.context_),
       queue_(other.queue_),
       svm_ptr_(other.svm_ptr_),
@@ -216,7 +255,8 @@ inline SVMBuffer::SVMBuffer(SVMBuffer&& other) noexcept
     other.is_mapped_ = false;
 }
 
-inline SVMBuffer& SVMBuffer::operator=(SVMBuffer&& other) noexcept {
+template <typename T>
+inline SVMBuffer<T>& SVMBuffer<T>::operator=(SVMBuffer&& other) noexcept {
     if (this != &other) {
         // Free current resources
         FreeSVM();
@@ -238,7 +278,8 @@ inline SVMBuffer& SVMBuffer::operator=(SVMBuffer&& other) noexcept {
     return *this;
 }
 
-inline void SVMBuffer::AllocateSVM() {
+template <typename T>
+inline void SVMBuffer<T>::AllocateSVM() {
     cl_svm_mem_flags flags = GetSVMFlags();
     
     // clSVMAlloc: OpenCL 2.0+
@@ -252,7 +293,8 @@ inline void SVMBuffer::AllocateSVM() {
     }
 }
 
-inline void SVMBuffer::FreeSVM() {
+template <typename T>
+inline void SVMBuffer<T>::FreeSVM() {
     if (svm_ptr_) {
         // Unmap first if needed
         if (is_mapped_) {
@@ -264,7 +306,8 @@ inline void SVMBuffer::FreeSVM() {
     }
 }
 
-inline cl_svm_mem_flags SVMBuffer::GetSVMFlags() const {
+template <typename T>
+inline cl_svm_mem_flags SVMBuffer<T>::GetSVMFlags() const {
     cl_svm_mem_flags flags = 0;
     
     // Base flags based on strategy
@@ -300,7 +343,8 @@ inline cl_svm_mem_flags SVMBuffer::GetSVMFlags() const {
     return flags;
 }
 
-inline void SVMBuffer::Map(bool write, bool read) {
+template <typename T>
+inline void SVMBuffer<T>::Map(bool write, bool read) {
     if (is_mapped_) {
         return;  // Already mapped
     }
@@ -330,7 +374,8 @@ inline void SVMBuffer::Map(bool write, bool read) {
     is_mapped_ = true;
 }
 
-inline void SVMBuffer::Unmap() {
+template <typename T>
+inline void SVMBuffer<T>::Unmap() {
     if (!is_mapped_) {
         return;  // Not mapped
     }
@@ -357,17 +402,19 @@ inline void SVMBuffer::Unmap() {
     is_mapped_ = false;
 }
 
-inline void SVMBuffer::Write(const ComplexVector& data) {
+template <typename T>
+inline void SVMBuffer<T>::Write(const std::vector<T>& data) {
     if (data.size() > num_elements_) {
         throw std::runtime_error(
             "SVMBuffer::Write: data size exceeds buffer capacity"
         );
     }
     
-    WriteRaw(data.data(), data.size() * sizeof(ComplexFloat));
+    WriteRaw(data.data(), data.size() * sizeof(T));
 }
 
-inline void SVMBuffer::WriteRaw(const void* data, size_t size_bytes) {
+template <typename T>
+inline void SVMBuffer<T>::WriteRaw(const void* data, size_t size_bytes) {
     if (size_bytes > size_bytes_) {
         throw std::runtime_error(
             "SVMBuffer::WriteRaw: size exceeds buffer capacity"
@@ -388,23 +435,26 @@ inline void SVMBuffer::WriteRaw(const void* data, size_t size_bytes) {
     }
 }
 
-inline ComplexVector SVMBuffer::Read() {
+template <typename T>
+inline std::vector<T> SVMBuffer<T>::Read() {
     return ReadPartial(num_elements_);
 }
 
-inline ComplexVector SVMBuffer::ReadPartial(size_t num_elements) {
+template <typename T>
+inline std::vector<T> SVMBuffer<T>::ReadPartial(size_t num_elements) {
     if (num_elements > num_elements_) {
         throw std::runtime_error(
             "SVMBuffer::ReadPartial: requested elements exceed buffer size"
         );
     }
     
-    ComplexVector result(num_elements);
-    ReadRaw(result.data(), num_elements * sizeof(ComplexFloat));
+    std::vector<T> result(num_elements);
+    ReadRaw(result.data(), num_elements * sizeof(T));
     return result;
 }
 
-inline void SVMBuffer::ReadRaw(void* dest, size_t size_bytes) {
+template <typename T>
+inline void SVMBuffer<T>::ReadRaw(void* dest, size_t size_bytes) {
     if (size_bytes > size_bytes_) {
         throw std::runtime_error(
             "SVMBuffer::ReadRaw: size exceeds buffer capacity"
@@ -425,7 +475,8 @@ inline void SVMBuffer::ReadRaw(void* dest, size_t size_bytes) {
     }
 }
 
-inline cl_event SVMBuffer::WriteAsync(const ComplexVector& data) {
+template <typename T>
+inline cl_event SVMBuffer<T>::WriteAsync(const std::vector<T>& data) {
     if (data.size() > num_elements_) {
         throw std::runtime_error(
             "SVMBuffer::WriteAsync: data size exceeds buffer capacity"
@@ -440,7 +491,7 @@ inline cl_event SVMBuffer::WriteAsync(const ComplexVector& data) {
         CL_FALSE,  // Non-blocking
         svm_ptr_,
         data.data(),
-        data.size() * sizeof(ComplexFloat),
+        data.size() * sizeof(T),
         0, nullptr,
         &event
     );
@@ -449,7 +500,8 @@ inline cl_event SVMBuffer::WriteAsync(const ComplexVector& data) {
     return event;
 }
 
-inline cl_event SVMBuffer::ReadAsync(ComplexVector& out_data) {
+template <typename T>
+inline cl_event SVMBuffer<T>::ReadAsync(std::vector<T>& out_data) {
     if (out_data.size() < num_elements_) {
         out_data.resize(num_elements_);
     }
@@ -461,7 +513,7 @@ inline cl_event SVMBuffer::ReadAsync(ComplexVector& out_data) {
         CL_FALSE,  // Non-blocking
         out_data.data(),
         svm_ptr_,
-        num_elements_ * sizeof(ComplexFloat),
+        num_elements_ * sizeof(T),
         0, nullptr,
         &event
     );
@@ -470,15 +522,41 @@ inline cl_event SVMBuffer::ReadAsync(ComplexVector& out_data) {
     return event;
 }
 
-inline void SVMBuffer::SetAsKernelArg(cl_kernel kernel, cl_uint arg_index) {
+template <typename T>
+inline bool SVMBuffer<T>::IsHostAccessible() const {
+    return is_mapped_ ||
+           strategy_ == MemoryStrategy::SVM_FINE_GRAIN ||
+           strategy_ == MemoryStrategy::SVM_FINE_SYSTEM;
+}
+
+template <typename T>
+inline T* SVMBuffer<T>::Data() {
+    if (!IsHostAccessible()) {
+        throw std::logic_error("SVMBuffer::Data: coarse-grained buffer must be mapped");
+    }
+    return static_cast<T*>(svm_ptr_);
+}
+
+template <typename T>
+inline const T* SVMBuffer<T>::Data() const {
+    if (!IsHostAccessible()) {
+        throw std::logic_error("SVMBuffer::Data: coarse-grained buffer must be mapped");
+    }
+    return static_cast<const T*>(svm_ptr_);
+}
+
+template <typename T>
+inline void SVMBuffer<T>::SetAsKernelArg(cl_kernel kernel, cl_uint arg_index) {
     cl_int err = clSetKernelArgSVMPointer(kernel, arg_index, svm_ptr_);
     CheckCLError(err, "clSetKernelArgSVMPointer");
 }
 
-inline BufferInfo SVMBuffer::GetInfo() const {
+template <typename T>
+inline BufferInfo SVMBuffer<T>::GetInfo() const {
     BufferInfo info;
     info.num_elements = num_elements_;
     info.size_bytes   = size_bytes_;
+    info.element_size = sizeof(T);
     info.memory_type  = mem_type_;
     info.strategy     = strategy_;
     info.is_external  = false;
@@ -486,11 +564,13 @@ inline BufferInfo SVMBuffer::GetInfo() const {
     return info;
 }
 
-inline void SVMBuffer::PrintStats() const {
+template <typename T>
+inline void SVMBuffer<T>::PrintStats() const {
     std::cout << "\n" << std::string(50, '─') << "\n";
     std::cout << "SVMBuffer Statistics\n";
     std::cout << std::string(50, '─') << "\n";
-    std::cout << std::left << std::setw(20) << "Elements:" << num_elements_ << "\n";
+    std::cout << std::left << std::setw(20) << "Elements:" << num_elements_
+              << " × " << sizeof(T) << " bytes\n";
     std::cout << std::left << std::setw(20) << "Size:" 
               << std::fixed << std::setprecision(2) 
               << (size_bytes_ / (1024.0 * 1024.0)) << " MB\n";
@@ -503,7 +583,8 @@ inline void SVMBuffer::PrintStats() const {
     std::cout << std::string(50, '─') << "\n";
 }
 
-inline void SVMBuffer::CheckCLError(cl_int err, const std::string& operation) {
+template <typename T>
+inline void SVMBuffer<T>::CheckCLError(cl_int err, const std::string& operation) {
     if (err != CL_SUCCESS) {
         throw std::runtime_error(
             "OpenCL Error in " + operation + ": " + std::to_string(err)
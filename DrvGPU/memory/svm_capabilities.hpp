@@ -38,6 +38,8 @@ enum class MemoryStrategy {
     SVM_COARSE_GRAIN,    ///< SVM Coarse-Grained Buffer (map/unmap required)
     SVM_FINE_GRAIN,      ///< SVM Fine-Grained Buffer (atomics optional)
     SVM_FINE_SYSTEM,     ///< SVM Fine-Grained System (unified memory)
+    HOST_MAPPED,         ///< cl_mem с CL_MEM_ALLOC_HOST_PTR + map/unmap
+                         ///< (zero-copy на integrated GPU / CPU-устройствах)
     AUTO                 ///< Автоматический выбор на основе эвристик
 };
 
@@ -50,11 +52,28 @@ inline std::string MemoryStrategyToString(MemoryStrategy strategy) {
         case MemoryStrategy::SVM_COARSE_GRAIN: return "SVM_COARSE_GRAIN";
         case MemoryStrategy::SVM_FINE_GRAIN:   return "SVM_FINE_GRAIN";
         case MemoryStrategy::SVM_FINE_SYSTEM:  return "SVM_FINE_SYSTEM";
+        case MemoryStrategy::HOST_MAPPED:      return "HOST_MAPPED";
         case MemoryStrategy::AUTO:             return "AUTO";
         default:                               return "UNKNOWN";
     }
 }
 
+/**
+ * @brief Разобрать стратегию из строки (configGPU.json)
+ * @return false — неизвестное имя, strategy не изменяется
+ */
+inline bool MemoryStrategyFromString(const std::string& name, MemoryStrategy& strategy) {
+    for (MemoryStrategy s : { MemoryStrategy::REGULAR_BUFFER, MemoryStrategy::SVM_COARSE_GRAIN,
+                              MemoryStrategy::SVM_FINE_GRAIN, MemoryStrategy::SVM_FINE_SYSTEM,
+                              MemoryStrategy::HOST_MAPPED, MemoryStrategy::AUTO }) {
+        if (MemoryStrategyToString(s) == name) {
+            strategy = s;
+            return true;
+        }
+    }
+    return false;
+}
+
 // ════════════════════════════════════════════════════════════════════════════
 // Struct: SVMCapabilities - возможности SVM устройства
 // ════════════════════════════════════════════════════════════════════════════
@@ -88,6 +107,8 @@ struct SVMCapabilities {
     cl_uint opencl_major_version = 0;  ///< Мажорная версия OpenCL
     cl_uint opencl_minor_version = 0;  ///< Минорная версия OpenCL
     bool    svm_supported        = false;  ///< SVM поддерживается вообще
+    bool    host_unified_memory  = false;  ///< Общая с хостом память (integrated GPU / CPU)
+    bool    cpu_device           = false;  ///< CL_DEVICE_TYPE_CPU
     
     // ═══════════════════════════════════════════════════════════════
     // Статический метод: запросить возможности устройства
@@ -126,7 +147,20 @@ struct SVMCapabilities {
             }
         }
         
-        // 2. Проверить SVM capabilities (только для OpenCL 2.0+)
+        // 2. Общая с хостом память: integrated GPU и CPU-устройства
+        //    (CL_DEVICE_HOST_UNIFIED_MEMORY устарел в 2.0, но драйверы отвечают)
+        cl_bool unified = CL_FALSE;
+        if (clGetDeviceInfo(device, CL_DEVICE_HOST_UNIFIED_MEMORY,
+                            sizeof(unified), &unified, nullptr) == CL_SUCCESS) {
+            caps.host_unified_memory = (unified == CL_TRUE);
+        }
+        cl_device_type type = 0;
+        if (clGetDeviceInfo(device, CL_DEVICE_TYPE, sizeof(type), &type, nullptr) == CL_SUCCESS) {
+            caps.cpu_device = (type & CL_DEVICE_TYPE_CPU) != 0;
+            caps.host_unified_memory = caps.host_unified_memory || caps.cpu_device;
+        }
+        
+        // 3. Проверить SVM capabilities (только для OpenCL 2.0+)
         if (caps.opencl_major_version >= 2) {
             cl_device_svm_capabilities svm_caps = 0;
             err = clGetDeviceInfo(
@@ -217,6 +251,12 @@ struct SVMCapabilities {
         return MemoryStrategy::REGULAR_BUFFER;
     }
     
+    /**
+     * @brief Рекомендуемая стратегия с учётом паттерна использования
+     * @see определение после BufferUsageHint
+     */
+    MemoryStrategy RecommendStrategy(size_t size_bytes, const struct BufferUsageHint& hint) const;
+    
     /**
      * @brief Получить строковое представление capabilities
      */
@@ -243,6 +283,8 @@ struct SVMCapabilities {
             oss << "  " << std::left << std::setw(23) << "Atomics:" 
                 << (atomics ? "YES ✅" : "NO ❌") << "\n";
         }
+        oss << std::left << std::setw(25) << "Host Unified Memory:" 
+            << (host_unified_memory ? "YES ✅" : "NO ❌") << "\n";
         
         oss << "\n" << std::left << std::setw(25) << "Recommended Strategy:" 
             << MemoryStrategyToString(GetBestSVMStrategy()) << "\n";
@@ -294,5 +336,47 @@ struct BufferUsageHint {
     }
 };
 
+// ════════════════════════════════════════════════════════════════════════════
+// SVMCapabilities::RecommendStrategy(size, hint)
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Эвристика:
+ * - Атомики хост↔GPU: fine-grain SVM с atomics, иначе обычный буфер
+ * - Только GPU: обычный буфер (память устройства, без лишних флагов)
+ * - Общая память (integrated GPU / CPU) + частый обмен с хостом:
+ *   fine-grain SVM, иначе HOST_MAPPED — хост и устройство видят одну память
+ * - Дискретный GPU + частый обмен: как RecommendStrategy(size) — для
+ *   крупных буферов coarse-grain SVM, для мелких обычный буфер
+ */
+inline MemoryStrategy SVMCapabilities::RecommendStrategy(
+    size_t size_bytes, const BufferUsageHint& hint) const
+{
+    if (hint.requires_atomics) {
+        if (svm_supported && fine_grain_buffer && atomics) {
+            return MemoryStrategy::SVM_FINE_GRAIN;
+        }
+        return MemoryStrategy::REGULAR_BUFFER;
+    }
+    
+    if (hint.gpu_only) {
+        return MemoryStrategy::REGULAR_BUFFER;
+    }
+    
+    const bool host_traffic = hint.frequent_host_read || hint.frequent_host_write;
+    
+    if (host_unified_memory) {
+        if (!host_traffic) {
+            return MemoryStrategy::REGULAR_BUFFER;
+        }
+        if (svm_supported && fine_grain_buffer) {
+            return MemoryStrategy::SVM_FINE_GRAIN;
+        }
+        return MemoryStrategy::HOST_MAPPED;
+    }
+    
+    return host_traffic ? RecommendStrategy(size_bytes) : MemoryStrategy::REGULAR_BUFFER;
+}
+
 } // namespace 
 
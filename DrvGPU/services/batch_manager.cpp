@@ -16,6 +16,7 @@
 
 #include "batch_manager.hpp"
 #include "../interface/i_backend.hpp"
+#include "../memory/memory_manager.hpp"
 
 #include <algorithm>
 #include <iostream>
@@ -43,6 +44,22 @@ size_t BatchManager::GetAvailableMemory(IBackend* backend) {
     return estimated_available;
 }
 
+size_t BatchManager::GetUsableMemory(IBackend* backend, double memory_limit) {
+    if (!backend || !backend->IsInitialized()) {
+        return 0;
+    }
+
+    // Бюджет устройства (max_memory_percent) — жёсткий лимит, он и есть доля памяти
+    if (const MemoryManager* mem_mgr = backend->GetMemoryManager()) {
+        if (mem_mgr->GetMemoryBudget() != 0) {
+            return mem_mgr->GetMemoryBudgetRemaining();
+        }
+    }
+
+    return static_cast<size_t>(
+        static_cast<double>(GetAvailableMemory(backend)) * memory_limit);
+}
+
 size_t BatchManager::CalculateOptimalBatchSize(
     IBackend* backend,
     size_t total_items,
@@ -53,10 +70,10 @@ size_t BatchManager::CalculateOptimalBatchSize(
         return total_items;
     }
 
-    // Получить доступную память
-    size_t available = GetAvailableMemory(backend);
+    // Получить доступную память (остаток бюджета или доля от оценки)
+    size_t available = GetUsableMemory(backend, memory_limit);
 
-    if (available == 0) {
+    if (available == 0 && GetAvailableMemory(backend) == 0) {
         // Запасной вариант: 22% элементов (консервативная оценка)
         size_t fallback = std::max(
             static_cast<size_t>(total_items * 0.22),
@@ -66,13 +83,49 @@ size_t BatchManager::CalculateOptimalBatchSize(
         return fallback;
     }
 
-    // Расчёт через inline-вспомогательную функцию
+    // Расчёт через inline-вспомогательную функцию (доля уже учтена)
     size_t batch_size = CalculateBatchSizeFromMemory(
-        available, total_items, item_memory_bytes, memory_limit);
+        available, total_items, item_memory_bytes, 1.0);
 
     return batch_size;
 }
 
+size_t BatchManager::RecalculateAfterAllocationFailure(
+    IBackend* backend,
+    size_t total_items,
+    size_t item_memory_bytes,
+    size_t failed_batch_size,
+    double memory_limit,
+    size_t min_batch)
+{
+    size_t batch_size = ShrinkBatchSize(failed_batch_size, min_batch);
+    if (batch_size == 0 || !backend || item_memory_bytes == 0) {
+        return batch_size;
+    }
+
+    // Свободная память за вычетом уже выделенного через MemoryManager
+    size_t available = GetAvailableMemory(backend);
+    double fraction = memory_limit;
+    if (const MemoryManager* mem_mgr = backend->GetMemoryManager()) {
+        if (mem_mgr->GetMemoryBudget() != 0) {
+            // Остаток бюджета уже за вычетом выделенного
+            available = mem_mgr->GetMemoryBudgetRemaining();
+            fraction = 1.0;
+        } else {
+            size_t tracked = mem_mgr->GetTotalAllocatedBytes();
+            available = available > tracked ? available - tracked : 0;
+        }
+    }
+
+    size_t fits = CalculateBatchSizeFromMemory(
+        available, total_items, item_memory_bytes, fraction);
+    batch_size = std::max(std::min(batch_size, fits), std::max(min_batch, static_cast<size_t>(1)));
+
+    std::cerr << "[BatchManager] WARNING: allocation failed for batch of "
+              << failed_batch_size << ", retrying with " << batch_size << "\n";
+    return batch_size;
+}
+
 bool BatchManager::AllItemsFit(
     IBackend* backend,
     size_t total_items,
@@ -83,9 +136,7 @@ bool BatchManager::AllItemsFit(
         return true;
     }
 
-    size_t available = GetAvailableMemory(backend);
-    size_t usable = static_cast<size_t>(
-        static_cast<double>(available) * memory_limit);
+    size_t usable = GetUsableMemory(backend, memory_limit);
     size_t required = total_items * item_memory_bytes;
 
     return required <= usable;
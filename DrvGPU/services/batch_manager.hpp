@@ -12,7 +12,10 @@
  * ВОЗМОЖНОСТИ:
  *   - Учитывает реальную доступную память GPU (не только общий объём)
  *   - Настраиваемый % доступной памяти (по умолчанию 70%)
+ *   - Бюджет устройства MemoryManager (max_memory_percent), если задан,
+ *     заменяет эвристику: пакет считается от остатка бюджета
  *   - Умное слияние хвоста: если в последнем пакете 1–3 элемента — объединить с предыдущим
+ *   - Уменьшение пакета после неудачного выделения памяти (деградация вместо отказа)
  *   - Работает с любым IBackend (не привязан к OpenCL)
  *
  * ИСПОЛЬЗОВАНИЕ:
@@ -187,6 +190,17 @@ public:
      */
     static size_t GetAvailableMemory(IBackend* backend);
 
+    /**
+     * @brief Память, которую можно занять пакетами
+     * @param backend Pointer to IBackend
+     * @param memory_limit Fraction of available memory (без бюджета)
+     * @return Остаток бюджета MemoryManager бэкенда, если бюджет задан;
+     *         иначе GetAvailableMemory * memory_limit
+     *
+     * Бюджет уже учитывает выделенное через MemoryManager, эвристика — нет.
+     */
+    static size_t GetUsableMemory(IBackend* backend, double memory_limit = 0.7);
+
     /**
      * @brief Check if all items fit in memory (no batching needed)
      * @param backend Pointer to IBackend
@@ -201,6 +215,36 @@ public:
         size_t item_memory_bytes,
         double memory_limit = 0.7);
 
+    // ========================================================================
+    // Memory Pressure
+    // ========================================================================
+
+    /**
+     * @brief Уменьшить размер пакета вдвое
+     * @param failed_batch_size Размер, на котором не хватило памяти
+     * @param min_batch Меньше этого пакет не бывает
+     * @return Новый размер (>= min_batch) или 0, если ужать уже нельзя
+     */
+    static size_t ShrinkBatchSize(size_t failed_batch_size, size_t min_batch = 1);
+
+    /**
+     * @brief Пересчитать размер пакета после неудачного выделения памяти
+     *
+     * Не больше половины failed_batch_size и не больше того, что помещается
+     * в оценку свободной памяти за вычетом учтённого MemoryManager бэкенда.
+     * Модуль продолжает кадр меньшими пакетами — падает пропускная
+     * способность, но кадр не теряется.
+     *
+     * @return Новый размер пакета или 0, если меньше min_batch не ужать
+     */
+    static size_t RecalculateAfterAllocationFailure(
+        IBackend* backend,
+        size_t total_items,
+        size_t item_memory_bytes,
+        size_t failed_batch_size,
+        double memory_limit = 0.7,
+        size_t min_batch = 1);
+
     // ========================================================================
     // Diagnostics
     // ========================================================================
@@ -302,6 +346,14 @@ inline std::vector<BatchRange> BatchManager::CreateBatches(
     return batches;
 }
 
+inline size_t BatchManager::ShrinkBatchSize(size_t failed_batch_size, size_t min_batch) {
+    min_batch = std::max(min_batch, static_cast<size_t>(1));
+    if (failed_batch_size <= min_batch) {
+        return 0;
+    }
+    return std::max(failed_batch_size / 2, min_batch);
+}
+
 inline void BatchManager::PrintBatchInfo(
     const std::vector<BatchRange>& batches,
     size_t total_items)
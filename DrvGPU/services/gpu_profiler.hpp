@@ -31,6 +31,10 @@
  *   auto stats = GPUProfiler::GetInstance().GetStats(0);
  *   auto all_stats = GPUProfiler::GetInstance().GetAllStats();
  *
+ *   // Memory by tag (MemoryManager::PublishMemoryStats does this periodically):
+ *   GPUProfiler::GetInstance().RecordMemory(0, "AntennaFFT/fft_input", current, peak);
+ *   auto memory = GPUProfiler::GetInstance().GetMemoryStats(0);
+ *
  *   // Export to JSON:
  *   GPUProfiler::GetInstance().ExportJSON("./Results/Profiler/2026-02-07_14-30-00.json");
  *
@@ -81,6 +85,13 @@ struct ProfilingMessage {
     /// Duration in milliseconds
     double duration_ms = 0.0;
 
+    /// Memory snapshot instead of timing (event_name = memory tag)
+    bool is_memory = false;
+
+    /// Memory snapshot: bytes in use / high-water mark for the tag
+    size_t current_bytes = 0;
+    size_t peak_bytes = 0;
+
     /// Timestamp (auto-set on creation)
     std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
 };
@@ -161,6 +172,39 @@ struct ModuleStats {
     }
 };
 
+// ============================================================================
+// MemoryTagSnapshot - Memory usage of one tag on one GPU
+// ============================================================================
+
+/**
+ * @struct MemoryTagSnapshot
+ * @brief Latest memory snapshot for a tag (e.g., "AntennaFFT/fft_input")
+ */
+struct MemoryTagSnapshot {
+    /// Memory tag ("Module/purpose")
+    std::string tag;
+
+    /// Bytes in use at the last snapshot
+    size_t current_bytes = 0;
+
+    /// High-water mark reported by MemoryManager
+    size_t peak_bytes = 0;
+
+    /// Largest current_bytes seen across snapshots
+    size_t max_current_bytes = 0;
+
+    /// Number of snapshots received
+    uint64_t samples = 0;
+
+    /// Update with new snapshot
+    void Update(size_t current, size_t peak) {
+        current_bytes = current;
+        peak_bytes = std::max(peak_bytes, peak);
+        max_current_bytes = std::max(max_current_bytes, current);
+        samples++;
+    }
+};
+
 // ============================================================================
 // GPUProfiler - Async profiling service
 // ============================================================================
@@ -220,6 +264,31 @@ public:
         Enqueue(std::move(msg));
     }
 
+    /**
+     * @brief Record a memory snapshot for a tag
+     * @param gpu_id GPU device index
+     * @param tag Memory tag ("Module/purpose")
+     * @param current_bytes Bytes in use
+     * @param peak_bytes High-water mark
+     *
+     * Non-blocking, same queue as Record().
+     */
+    void RecordMemory(int gpu_id, const std::string& tag,
+                      size_t current_bytes, size_t peak_bytes) {
+        if (!enabled_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        ProfilingMessage msg;
+        msg.gpu_id = gpu_id;
+        msg.module_name = "Memory";
+        msg.event_name = tag;
+        msg.is_memory = true;
+        msg.current_bytes = current_bytes;
+        msg.peak_bytes = peak_bytes;
+        Enqueue(std::move(msg));
+    }
+
     // ========================================================================
     // Statistics Access (thread-safe reads)
     // ========================================================================
@@ -247,12 +316,27 @@ public:
         return stats_;
     }
 
+    /**
+     * @brief Get memory snapshots for a specific GPU
+     * @param gpu_id GPU device index
+     * @return Map of tag -> MemoryTagSnapshot
+     */
+    std::map<std::string, MemoryTagSnapshot> GetMemoryStats(int gpu_id) const {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        auto it = memory_stats_.find(gpu_id);
+        if (it != memory_stats_.end()) {
+            return it->second;
+        }
+        return {};
+    }
+
     /**
      * @brief Reset all collected statistics
      */
     void Reset() {
         std::lock_guard<std::mutex> lock(stats_mutex_);
         stats_.clear();
+        memory_stats_.clear();
     }
 
     // ========================================================================
@@ -359,8 +443,32 @@ public:
                 }
                 file << "\n    }";
             }
-            file << "\n  }\n";
-            file << "}\n";
+            file << "\n  }";
+
+            // Memory by tag
+            if (!memory_stats_.empty()) {
+                file << ",\n  \"memory\": {\n";
+                bool first_mem_gpu = true;
+                for (const auto& [gpu_id, tags] : memory_stats_) {
+                    if (!first_mem_gpu) file << ",\n";
+                    first_mem_gpu = false;
+
+                    file << "    \"" << gpu_id << "\": {\n";
+                    bool first_tag = true;
+                    for (const auto& [tag, snap] : tags) {
+                        if (!first_tag) file << ",\n";
+                        first_tag = false;
+
+                        file << "      \"" << tag << "\": { "
+                             << "\"current_bytes\": " << snap.current_bytes << ", "
+                             << "\"peak_bytes\": " << snap.peak_bytes << ", "
+                             << "\"samples\": " << snap.samples << " }";
+                    }
+                    file << "\n    }";
+                }
+                file << "\n  }";
+            }
+            file << "\n}\n";
 
             file.close();
             std::cout << "[GPUProfiler] Exported to: " << file_path << "\n";
@@ -403,6 +511,19 @@ public:
                               << " max=" << std::setw(8) << evt_stats.max_time_ms << "ms\n";
                 }
             }
+
+            auto mem_it = memory_stats_.find(gpu_id);
+            if (mem_it != memory_stats_.end()) {
+                PrintMemory(mem_it->second);
+            }
+        }
+
+        // GPUs with memory snapshots only
+        for (const auto& [gpu_id, tags] : memory_stats_) {
+            if (stats_.count(gpu_id) == 0) {
+                std::cout << "\n  GPU " << gpu_id << ":\n";
+                PrintMemory(tags);
+            }
         }
         std::cout << "\n";
     }
@@ -420,6 +541,13 @@ protected:
     void ProcessMessage(const ProfilingMessage& msg) override {
         std::lock_guard<std::mutex> lock(stats_mutex_);
 
+        if (msg.is_memory) {
+            auto& snap = memory_stats_[msg.gpu_id][msg.event_name];
+            snap.tag = msg.event_name;
+            snap.Update(msg.current_bytes, msg.peak_bytes);
+            return;
+        }
+
         // Get or create module stats for this GPU
         auto& module_stats = stats_[msg.gpu_id][msg.module_name];
         module_stats.module_name = msg.module_name;
@@ -446,6 +574,17 @@ private:
 
     GPUProfiler() : enabled_(true) {}
 
+    /// Memory section of PrintSummary (stats_mutex_ held)
+    static void PrintMemory(const std::map<std::string, MemoryTagSnapshot>& tags) {
+        std::cout << "    Memory:\n";
+        for (const auto& [tag, snap] : tags) {
+            std::cout << "      " << std::left << std::setw(25) << tag
+                      << " current=" << std::setw(9) << std::fixed << std::setprecision(2)
+                      << (snap.current_bytes / (1024.0 * 1024.0)) << "MB"
+                      << " peak=" << std::setw(9) << (snap.peak_bytes / (1024.0 * 1024.0)) << "MB\n";
+        }
+    }
+
     // ========================================================================
     // Private members
     // ========================================================================
@@ -453,6 +592,9 @@ private:
     /// Aggregated statistics: gpu_id -> module_name -> ModuleStats
     std::map<int, std::map<std::string, ModuleStats>> stats_;
 
+    /// Memory snapshots: gpu_id -> tag -> MemoryTagSnapshot
+    std::map<int, std::map<std::string, MemoryTagSnapshot>> memory_stats_;
+
     /// Mutex for stats access
     mutable std::mutex stats_mutex_;
 
@@ -150,10 +150,57 @@ void DrvGPU::Initialize() {
     }
 
     backend_->Initialize(device_index_);
+
+    // Модули выделяют через менеджер бэкенда — бюджет устройства один на оба
+    if (MemoryManager* backend_memory = backend_->GetMemoryManager()) {
+        memory_manager_->ShareMemoryBudget(*backend_memory);
+    }
+
     initialized_ = true;
     DRVGPU_LOG_INFO("DrvGPU", "Initialized successfully");
 }
 
+/**
+ * @brief Применить конфигурацию устройства
+ * 
+ * Неизвестная memory_strategy — предупреждение и AUTO: ошибка в
+ * configGPU.json не должна останавливать устройство.
+ */
+void DrvGPU::ApplyConfig(const GPUConfigEntry& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_) {
+        throw std::runtime_error("DrvGPU::ApplyConfig: GPU not initialized");
+    }
+
+    // 1. Бюджет памяти (общий MemoryBudget — достаточно одного менеджера)
+    memory_manager_->SetMemoryBudgetPercent(config.max_memory_percent);
+
+    // 2. Стратегия памяти по умолчанию
+    MemoryStrategy strategy = MemoryStrategy::AUTO;
+    if (!MemoryStrategyFromString(config.memory_strategy, strategy)) {
+        DRVGPU_LOG_WARNING("DrvGPU", "Unknown memory_strategy \"" + config.memory_strategy +
+                           "\" for GPU " + std::to_string(device_index_) + ", using AUTO");
+    }
+    memory_manager_->SetPreferredStrategy(strategy);
+    if (MemoryManager* backend_memory = backend_->GetMemoryManager()) {
+        backend_memory->SetPreferredStrategy(strategy);
+    }
+
+    // 3. Очереди
+    if (config.queue_count > 1) {
+        if (auto* opencl = dynamic_cast<OpenCLBackend*>(backend_.get())) {
+            opencl->InitializeCommandQueuePool(config.queue_count);
+        } else {
+            DRVGPU_LOG_WARNING("DrvGPU", "queue_count ignored: backend has no queue pool");
+        }
+    }
+
+    DRVGPU_LOG_INFO("DrvGPU", "Config applied: max_memory_percent=" +
+                    std::to_string(config.max_memory_percent) + ", queue_count=" +
+                    std::to_string(config.queue_count) + ", memory_strategy=" +
+                    MemoryStrategyToString(strategy));
+}
+
 /**
  * @brief Очистить все ресурсы
  * 
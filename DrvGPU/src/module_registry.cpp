@@ -1,5 +1,7 @@
 #include "module_registry.hpp"
+#include "../interface/i_backend.hpp"
 #include "../logger/logger.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace drv_gpu_lib {
@@ -38,6 +40,12 @@ ModuleRegistry::~ModuleRegistry() {
 ModuleRegistry::ModuleRegistry(ModuleRegistry&& other) noexcept {
     std::lock_guard<std::mutex> lock(other.mutex_);
     modules_ = std::move(other.modules_);
+    slots_ = std::move(other.slots_);
+    slot_index_ = std::move(other.slot_index_);
+    retired_ = std::move(other.retired_);
+    tables_ = std::move(other.tables_);
+    table_.store(other.table_.exchange(nullptr, std::memory_order_acq_rel),
+                 std::memory_order_release);
 }
 
 /**
@@ -50,6 +58,12 @@ ModuleRegistry& ModuleRegistry::operator=(ModuleRegistry&& other) noexcept {
         std::lock_guard<std::mutex> lock_this(mutex_);
         std::lock_guard<std::mutex> lock_other(other.mutex_);
         modules_ = std::move(other.modules_);
+        slots_ = std::move(other.slots_);
+        slot_index_ = std::move(other.slot_index_);
+        retired_ = std::move(other.retired_);
+        tables_ = std::move(other.tables_);
+        table_.store(other.table_.exchange(nullptr, std::memory_order_acq_rel),
+                     std::memory_order_release);
     }
     return *this;
 }
@@ -63,7 +77,8 @@ ModuleRegistry& ModuleRegistry::operator=(ModuleRegistry&& other) noexcept {
  * @param name Уникальное имя модуля
  * @param module Shared pointer на модуль
  * 
- * Добавляет модуль в реестр по уникальному имени.
+ * Добавляет модуль в реестр по уникальному имени и занимает новый слот
+ * в таблице handle (слоты не переиспользуются).
  * 
  * @throws std::runtime_error если модуль с таким именем уже существует
  * 
@@ -73,15 +88,31 @@ ModuleRegistry& ModuleRegistry::operator=(ModuleRegistry&& other) noexcept {
  * registry.RegisterModule("FFT", fft_module);
  * @endcode
  */
-void ModuleRegistry::RegisterModule(const std::string& name, 
-                                     std::shared_ptr<IComputeModule> module) {
+ModuleHandle<IComputeModule> ModuleRegistry::RegisterModule(
+        const std::string& name, std::shared_ptr<IComputeModule> module) {
     std::lock_guard<std::mutex> lock(mutex_);
     
     if (modules_.find(name) != modules_.end()) {
         throw std::runtime_error("ModuleRegistry: module '" + name + "' already registered");
     }
+    if (slots_.size() >= ModuleHandle<IComputeModule>::kInvalidIndex) {
+        throw std::runtime_error("ModuleRegistry: handle slots exhausted");
+    }
+    
+    const auto index = static_cast<uint32_t>(slots_.size());
+    slots_.push_back(module);
+    try {
+        slot_index_[name] = index;
+        modules_[name] = module;
+        PublishTableLocked();
+    } catch (...) {
+        slots_.pop_back();
+        slot_index_.erase(name);
+        modules_.erase(name);
+        throw;
+    }
     
-    modules_[name] = module;
+    return ModuleHandle<IComputeModule>(index);
 }
 
 /**
@@ -93,7 +124,18 @@ void ModuleRegistry::RegisterModule(const std::string& name,
  */
 bool ModuleRegistry::UnregisterModule(const std::string& name) {
     std::lock_guard<std::mutex> lock(mutex_);
-    return modules_.erase(name) > 0;
+    
+    if (modules_.erase(name) == 0) {
+        return false;
+    }
+    
+    const uint32_t index = FindSlotLocked(name);
+    if (index != ModuleHandle<IComputeModule>::kInvalidIndex) {
+        retired_.push_back(std::move(slots_[index]));  // moved-from → nullptr
+        slot_index_.erase(name);
+        PublishTableLocked();
+    }
+    return true;
 }
 
 /**
@@ -144,6 +186,35 @@ std::shared_ptr<const IComputeModule> ModuleRegistry::GetModule(const std::strin
     return it->second;
 }
 
+// ════════════════════════════════════════════════════════════════════════════
+// Таблица handle
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Опубликовать текущие слоты новой неизменяемой таблицей
+ * 
+ * Вызывается под mutex_. Release-store парный acquire-load в Get():
+ * читатель, увидевший новую таблицу, видит и её заполненный вектор.
+ */
+void ModuleRegistry::PublishTableLocked() {
+    auto table = std::make_unique<ModuleTable>();
+    table->modules.reserve(slots_.size());
+    for (const auto& module : slots_) {
+        table->modules.push_back(module.get());
+    }
+    
+    tables_.push_back(std::move(table));
+    table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+/**
+ * @brief Индекс слота по имени (под mutex_)
+ */
+uint32_t ModuleRegistry::FindSlotLocked(const std::string& name) const {
+    auto it = slot_index_.find(name);
+    return it != slot_index_.end() ? it->second : ModuleHandle<IComputeModule>::kInvalidIndex;
+}
+
 // ════════════════════════════════════════════════════════════════════════════
 // Информация о реестре
 // ════════════════════════════════════════════════════════════════════════════
@@ -194,6 +265,56 @@ void ModuleRegistry::PrintModules() const {
     }
 }
 
+// ════════════════════════════════════════════════════════════════════════════
+// Прогрев
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Задачи прогрева всех модулей
+ * @param config Конфигурация прогрева (копируется в каждую задачу)
+ *
+ * Задача держит shared_ptr модуля: UnregisterModule во время прогрева
+ * безопасен.
+ */
+std::vector<WarmupTask> ModuleRegistry::CollectWarmupTasks(const WarmupConfig& config) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::vector<WarmupTask> tasks;
+    tasks.reserve(modules_.size());
+    
+    for (const auto& pair : modules_) {
+        std::shared_ptr<IComputeModule> module = pair.second;
+        IBackend* backend = module ? module->GetBackend() : nullptr;
+        
+        WarmupTask task;
+        task.module = pair.first;
+        task.device_index = backend ? backend->GetDeviceIndex() : -1;
+        task.run = [module, config] {
+            if (module) {
+                module->Warmup(config);
+            }
+        };
+        tasks.push_back(std::move(task));
+    }
+    
+    return tasks;
+}
+
+/**
+ * @brief Прогреть все модули
+ * @return Результаты по модулям (ошибки в WarmupResult::error)
+ */
+std::vector<WarmupResult> ModuleRegistry::WarmupAll(const WarmupConfig& config) const {
+    auto results = RunWarmupTasks(CollectWarmupTasks(config), config.parallel);
+    
+    for (const auto& r : results) {
+        if (!r.success) {
+            DRVGPU_LOG_ERROR("ModuleRegistry", "Warmup of '" + r.module + "' failed: " + r.error);
+        }
+    }
+    return results;
+}
+
 // ════════════════════════════════════════════════════════════════════════════
 // Очистка
 // ════════════════════════════════════════════════════════════════════════════
@@ -201,12 +322,61 @@ void ModuleRegistry::PrintModules() const {
 /**
  * @brief Очистить все модули из реестра
  * 
- * Удаляет все модули и освобождает память.
- * Thread-safe через mutex.
+ * Удаляет все модули и освобождает память, включая старые таблицы.
+ * Число слотов сохраняется: выданные handle дают nullptr, а не модули,
+ * зарегистрированные после Clear.
+ * Thread-safe через mutex; параллельно с Get(handle) не вызывать.
  */
 void ModuleRegistry::Clear() {
     std::lock_guard<std::mutex> lock(mutex_);
     modules_.clear();
+    slot_index_.clear();
+    retired_.clear();
+    for (auto& module : slots_) {
+        module.reset();
+    }
+    
+    std::vector<std::unique_ptr<const ModuleTable>> old_tables;
+    old_tables.swap(tables_);
+    if (!slots_.empty()) {
+        PublishTableLocked();
+    } else {
+        table_.store(nullptr, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Освободить удалённые модули и все таблицы, кроме текущей
+ * 
+ * Без Reclaim долгоживущий процесс, заменяющий модули, держал бы их
+ * (и их GPU буферы) до Clear, а таблицы копились бы с каждой регистрацией.
+ * Текущая таблица не содержит удалённых модулей (их слоты — nullptr),
+ * поэтому после Reclaim на них никто не ссылается.
+ * Thread-safe через mutex; параллельно с Get(handle) не вызывать.
+ */
+size_t ModuleRegistry::Reclaim() {
+    std::vector<std::shared_ptr<IComputeModule>> retired;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired.swap(retired_);
+        
+        if (tables_.size() > 1) {
+            const ModuleTable* current = table_.load(std::memory_order_relaxed);
+            tables_.erase(std::remove_if(tables_.begin(), tables_.end(),
+                                         [current](const std::unique_ptr<const ModuleTable>& t) {
+                                             return t.get() != current;
+                                         }),
+                          tables_.end());
+        }
+    }
+    
+    // Модули уничтожаются вне mutex_: их деструкторы освобождают GPU ресурсы
+    const size_t count = retired.size();
+    retired.clear();
+    if (count > 0) {
+        DRVGPU_LOG_DEBUG("ModuleRegistry", "Reclaimed " + std::to_string(count) + " module(s)");
+    }
+    return count;
 }
 
 } // namespace drv_gpu_lib
@@ -32,7 +32,8 @@ namespace example_drv_gpu_multi
       manager.InitializeAll(BackendType::OPENCL);
 
       size_t gpu_count = manager.GetGPUCount();
-      std::cout << "Found " << gpu_count << " GPU(s)\n\n";
+      std::cout << "Found " << gpu_count << " GPU(s)\n";
+      std::cout << manager.GetInitReport() << "\n";
 
       if (gpu_count == 0)
       {
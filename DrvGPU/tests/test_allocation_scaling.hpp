@@ -0,0 +1,150 @@
+#pragma once
+/**
+ * @file test_allocation_scaling.hpp
+ * @brief Бенчмарк многопоточных выделений MemoryManager (1..16 потоков)
+ *
+ * 1. CreateBuffer + освобождение из 1, 2, 4, 8, 16 потоков: выделений/с
+ *    и ускорение относительно одного потока. Драйвер может сам
+ *    сериализовать clCreateBuffer — тогда масштабирование ограничено им,
+ *    а не MemoryManager
+ * 2. Только учёт: AllocationStats против счётчиков под std::mutex
+ *    (как было до перехода на атомики) — стоимость статистики без драйвера
+ * 3. После всех потоков: счётчики сходятся, живых выделений 0
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-12
+ */
+
+#include "drv_gpu.hpp"
+#include "common/backend_type.hpp"
+#include "../memory/memory_manager.hpp"
+#include "../memory/allocation_stats.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace test_allocation_scaling {
+
+using namespace drv_gpu_lib;
+
+/// Запустить fn(thread_index) в num_threads потоках, вернуть время в мс
+template<typename Fn>
+inline double RunThreads(size_t num_threads, Fn&& fn) {
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&fn, t] { fn(t); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+/// Счётчики под mutex — прежняя схема MemoryManager, для сравнения
+struct MutexStats {
+    std::mutex mutex;
+    size_t allocations = 0;
+    size_t frees = 0;
+    size_t bytes = 0;
+    size_t peak = 0;
+
+    void OnAllocate(size_t size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        allocations++;
+        bytes += size;
+        if (bytes > peak) peak = bytes;
+    }
+    void OnFree(size_t size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        frees++;
+        bytes -= size;
+    }
+};
+
+inline int run() {
+    try {
+        std::cout << "\n=== TEST: MemoryManager allocation scaling ===\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        auto& mem_mgr = gpu.GetMemoryManager();
+        bool passed = true;
+
+        const size_t thread_counts[] = { 1, 2, 4, 8, 16 };
+        const size_t kBuffersPerThread = 2000;
+        const size_t kStatsOpsPerThread = 1000000;
+
+        // 1. Реальные выделения
+        std::cout << "  CreateBuffer<float>(256) + release, " << kBuffersPerThread << " per thread\n";
+        std::cout << "  " << std::setw(8) << "threads" << std::setw(14) << "allocs/s"
+                  << std::setw(10) << "speedup" << "\n";
+
+        mem_mgr.ResetStatistics();
+        double base_rate = 0.0;
+        size_t expected = 0;
+        for (size_t threads : thread_counts) {
+            double ms = RunThreads(threads, [&](size_t) {
+                for (size_t i = 0; i < kBuffersPerThread; ++i) {
+                    auto buffer = mem_mgr.CreateBuffer<float>(256);
+                }
+            });
+            expected += threads * kBuffersPerThread;
+
+            double rate = threads * kBuffersPerThread / (ms / 1000.0);
+            if (threads == 1) base_rate = rate;
+            std::cout << "  " << std::setw(8) << threads << std::setw(14) << std::fixed
+                      << std::setprecision(0) << rate << std::setw(9) << std::setprecision(2)
+                      << (rate / base_rate) << "x\n";
+        }
+
+        // 2. Только учёт статистики
+        std::cout << "  Statistics only, " << kStatsOpsPerThread << " alloc+free per thread\n";
+        std::cout << "  " << std::setw(8) << "threads" << std::setw(14) << "mutex ms"
+                  << std::setw(14) << "atomic ms" << "\n";
+        for (size_t threads : thread_counts) {
+            MutexStats locked;
+            AllocationStats atomic;
+            double mutex_ms = RunThreads(threads, [&](size_t) {
+                for (size_t i = 0; i < kStatsOpsPerThread; ++i) {
+                    locked.OnAllocate(1024);
+                    locked.OnFree(1024);
+                }
+            });
+            double atomic_ms = RunThreads(threads, [&](size_t) {
+                for (size_t i = 0; i < kStatsOpsPerThread; ++i) {
+                    atomic.OnAllocate(1024);
+                    atomic.OnFree(1024);
+                }
+            });
+            auto s = atomic.Snapshot();
+            passed &= s.total_allocations == threads * kStatsOpsPerThread &&
+                      s.total_frees == s.total_allocations && s.current_bytes == 0;
+            std::cout << "  " << std::setw(8) << threads << std::setw(14) << std::setprecision(1)
+                      << mutex_ms << std::setw(14) << atomic_ms << "\n";
+        }
+
+        // 3. Счётчики MemoryManager
+        bool ok = mem_mgr.GetAllocationCount() == 0 && mem_mgr.GetTotalAllocatedBytes() == 0;
+        std::string stats = mem_mgr.GetStatistics();
+        ok &= stats.find(std::to_string(expected)) != std::string::npos;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " " << expected
+                  << " allocations counted, none live\n";
+
+        std::cout << (passed ? "ALL PASSED" : "SOME FAILED") << "\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+} // namespace test_allocation_scaling
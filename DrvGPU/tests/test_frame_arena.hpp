@@ -0,0 +1,132 @@
+#pragma once
+/**
+ * @file test_frame_arena.hpp
+ * @brief Тест FrameArena — временные буферы кадра в одном резерве
+ *
+ * 1. Allocate: смещения выровнены, view не пересекаются, kernel пишет
+ *    в каждый view своё значение и не задевает соседей
+ * 2. Reset: память переиспользуется с нуля, поколение растёт
+ * 3. Debug: Get() устаревшего view бросает std::logic_error
+ * 4. Переполнение арены → std::runtime_error
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "common/backend_type.hpp"
+#include "../memory/memory_manager.hpp"
+#include "../memory/frame_arena.hpp"
+
+#include <CL/cl.h>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+
+namespace test_frame_arena {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n=== TEST: FrameArena ===\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+
+        auto& backend = gpu.GetBackend();
+        auto context = static_cast<cl_context>(backend.GetNativeContext());
+        auto device = static_cast<cl_device_id>(backend.GetNativeDevice());
+        auto queue = static_cast<cl_command_queue>(backend.GetNativeQueue());
+
+        auto arena = gpu.GetMemoryManager().CreateFrameArena(1 << 20);
+        arena->SetDebugChecks(true);
+        bool passed = true;
+
+        // Kernel: заполнить view значением
+        const char* source =
+            "__kernel void fill(__global uint* data, uint value) {\n"
+            "    data[get_global_id(0)] = value;\n"
+            "}\n";
+        cl_int err;
+        cl_program program = clCreateProgramWithSource(context, 1, &source, nullptr, &err);
+        clBuildProgram(program, 1, &device, nullptr, nullptr, nullptr);
+        cl_kernel kernel = clCreateKernel(program, "fill", &err);
+
+        // 1. Несколько view разного размера
+        const size_t counts[] = { 3, 1000, 64, 4097 };
+        std::vector<FrameBufferView> views;
+        bool ok = true;
+        for (size_t i = 0; i < 4; ++i) {
+            views.push_back(arena->AllocateArray<uint32_t>(counts[i]));
+            const auto& v = views.back();
+            ok &= v.GetOffset() % arena->GetBaseAlignment() == 0;
+            if (i > 0) {
+                ok &= v.GetOffset() >= views[i - 1].GetOffset() + views[i - 1].GetSize();
+            }
+            cl_uint value = static_cast<cl_uint>(100 + i);
+            v.SetAsKernelArg(kernel, 0);
+            clSetKernelArg(kernel, 1, sizeof(value), &value);
+            size_t global = counts[i];
+            clEnqueueNDRangeKernel(queue, kernel, 1, nullptr, &global, nullptr, 0, nullptr, nullptr);
+        }
+        clFinish(queue);
+
+        for (size_t i = 0; i < 4 && ok; ++i) {
+            std::vector<uint32_t> back(counts[i]);
+            clEnqueueReadBuffer(queue, views[i].Get(), CL_TRUE, 0, back.size() * sizeof(uint32_t),
+                                back.data(), 0, nullptr, nullptr);
+            for (uint32_t x : back) ok &= x == 100 + i;
+        }
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " 4 aligned views, no overlap ("
+                  << arena->GetUsedBytes() << " bytes used)\n";
+
+        // 2. Reset → переиспользование
+        const uint64_t generation = arena->GetGeneration();
+        arena->Reset();
+        clFinish(queue);
+        FrameBufferView next = arena->Allocate(256);
+        ok = next.GetOffset() == 0 && arena->GetGeneration() == generation + 1 &&
+             next.IsValid() && !views[0].IsValid();
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " Reset: offset 0, generation "
+                  << arena->GetGeneration() << "\n";
+
+        // 3. Use-after-reset
+        ok = false;
+        try {
+            views[1].Get();
+        } catch (const std::logic_error&) {
+            ok = true;
+        }
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " use-after-reset detected\n";
+
+        // 4. Переполнение
+        ok = false;
+        try {
+            arena->Allocate(arena->GetCapacity());
+        } catch (const std::runtime_error&) {
+            ok = true;
+        }
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " overflow → runtime_error\n";
+
+        std::cout << arena->GetStatistics();
+
+        views.clear();
+        clReleaseKernel(kernel);
+        clReleaseProgram(program);
+
+        std::cout << (passed ? "ALL PASSED" : "SOME FAILED") << "\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+} // namespace test_frame_arena
@@ -0,0 +1,146 @@
+#pragma once
+/**
+ * @file test_gpu_config_limits.hpp
+ * @brief Тест лимитов устройства из configGPU.json
+ *
+ * 1. Бюджет MemoryManager: выделение сверх лимита отклоняется, после
+ *    освобождения проходит; бюджет общий с менеджером бэкенда
+ * 2. BatchManager считает пакет от остатка бюджета; ResetStatistics при
+ *    живых буферах не занижает занятую память
+ * 3. DrvGPU::ApplyConfig: max_memory_percent, queue_count, memory_strategy
+ * 4. GPUManager::InitializeAll по загруженной конфигурации: только активные
+ *    и существующие устройства
+ * 5. Без загруженной конфигурации лимита памяти нет
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-12
+ */
+
+#include "gpu_manager.hpp"
+#include "common/backend_type.hpp"
+#include "config/gpu_config.hpp"
+#include "services/batch_manager.hpp"
+#include "backends/opencl/opencl_backend.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace test_gpu_config_limits {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n=== TEST: GPU config limits (budget, queues, device selection) ===\n";
+        bool passed = true;
+        const size_t MB = 1024 * 1024;
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        auto& mem_mgr = gpu.GetMemoryManager();
+        IBackend& backend = gpu.GetBackend();
+
+        // 1. Бюджет 16 MB на устройство
+        mem_mgr.SetMemoryBudget(16 * MB);
+        {
+            auto module_buffer = backend.GetMemoryManager()->CreateBuffer<char>(6 * MB);
+            auto first = mem_mgr.CreateBuffer<char>(8 * MB);
+
+            bool rejected = false;
+            try {
+                auto second = mem_mgr.CreateBuffer<char>(4 * MB);
+            } catch (const std::runtime_error&) {
+                rejected = true;
+            }
+            first.reset();
+            auto retry = mem_mgr.CreateBuffer<char>(4 * MB);
+
+            bool ok = rejected && retry && mem_mgr.GetMemoryBudgetRemaining() == 6 * MB &&
+                      mem_mgr.GetStatistics().find("rejected") != std::string::npos;
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " 4 MB over budget rejected (6 MB via backend manager), "
+                      << "accepted after free\n";
+
+            // 2. Пакет по остатку бюджета: 6 MB свободно → не больше 6 элементов по 1 MB
+            size_t batch = BatchManager::CalculateOptimalBatchSize(&backend, 1000, MB);
+            ok = batch <= 6 && batch >= 1 && !BatchManager::AllItemsFit(&backend, 7, MB);
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " batch from budget remainder: " << batch << "\n";
+
+            // Сброс статистики при живых буферах: освобождение после него
+            // не должно «освобождать» бюджет сверх выделенного
+            mem_mgr.ResetStatistics();
+            backend.GetMemoryManager()->ResetStatistics();
+            retry.reset();
+            ok = mem_mgr.GetMemoryBudgetRemaining() == 10 * MB &&
+                 backend.GetMemoryManager()->GetTotalAllocatedBytes() == 6 * MB;
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " ResetStatistics keeps live bytes: "
+                      << (mem_mgr.GetMemoryBudgetRemaining() / MB) << " MB remaining\n";
+        }
+
+        // 3. Конфигурация устройства
+        GPUConfigEntry entry;
+        entry.id = 0;
+        entry.max_memory_percent = 50;
+        entry.queue_count = 3;
+        entry.memory_strategy = "REGULAR_BUFFER";
+        gpu.ApplyConfig(entry);
+
+        auto* opencl = dynamic_cast<OpenCLBackend*>(&backend);
+        auto buffer = mem_mgr.CreateBufferWithStrategy<float>(1024, MemoryStrategy::AUTO);
+        bool ok = mem_mgr.GetMemoryBudget() == backend.GetGlobalMemorySize() / 100 * 50 &&
+                  opencl && opencl->GetQueueCount() == 3 &&
+                  buffer->GetStrategy() == MemoryStrategy::REGULAR_BUFFER;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " ApplyConfig: budget "
+                  << (mem_mgr.GetMemoryBudget() / MB) << " MB, "
+                  << (opencl ? opencl->GetQueueCount() : 0) << " queues, AUTO -> "
+                  << MemoryStrategyToString(buffer->GetStrategy()) << "\n";
+
+        // 4. Выбор устройств по конфигурации: 0 активен, 1 выключен, 99 не существует
+        const std::string path = "test_gpu_config_limits.json";
+        {
+            std::ofstream file(path);
+            file << R"({ "gpus": [
+                { "id": 0, "name": "main", "max_memory_percent": 60, "queue_count": 2 },
+                { "id": 1, "name": "off", "is_active": false },
+                { "id": 99, "name": "missing" } ] })";
+        }
+        GPUConfig::GetInstance().Load(path);
+
+        GPUManager manager;
+        manager.InitializeAll(BackendType::OPENCL);
+        auto results = manager.GetInitResults();
+        ok = results.size() == 1 && results[0].device_index == 0 && results[0].success &&
+             results[0].config_name == "main" && manager.GetGPUCount() == 1 &&
+             manager.GetGPU(0).GetMemoryManager().GetMemoryBudget() ==
+                 manager.GetGPU(0).GetBackend().GetGlobalMemorySize() / 100 * 60;
+        passed &= ok;
+        std::cout << manager.GetInitReport();
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " InitializeAll: only active configured GPU 0\n";
+
+        GPUConfig::GetInstance().ResetToDefault();
+        std::remove(path.c_str());
+
+        // 5. Конфигурация не загружена — все устройства, без лимита памяти
+        GPUManager unconfigured;
+        unconfigured.InitializeAll(BackendType::OPENCL);
+        ok = unconfigured.GetGPUCount() > 0 &&
+             unconfigured.GetGPU(0).GetMemoryManager().GetMemoryBudget() == 0;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " InitializeAll without config: no memory budget\n";
+
+        std::cout << (passed ? "ALL PASSED" : "SOME FAILED") << "\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        GPUConfig::GetInstance().ResetToDefault();
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+} // namespace test_gpu_config_limits
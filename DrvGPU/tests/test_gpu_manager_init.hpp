@@ -0,0 +1,66 @@
+#pragma once
+/**
+ * @file test_gpu_manager_init.hpp
+ * @brief Тест параллельной инициализации устройств в GPUManager
+ *
+ * 1. InitializeAll: результат по каждому найденному устройству, все успешны,
+ *    общее время и время каждого устройства в GetInitReport()
+ * 2. InitializeSpecific с несуществующим индексом: ошибка собрана
+ *    в DeviceInitResult, остальные устройства работают
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-12
+ */
+
+#include "gpu_manager.hpp"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace test_gpu_manager_init {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n=== TEST: GPUManager parallel initialization ===\n";
+        bool passed = true;
+
+        // 1. Все устройства
+        GPUManager manager;
+        manager.InitializeAll(BackendType::OPENCL);
+
+        auto results = manager.GetInitResults();
+        bool ok = static_cast<int>(results.size()) == GPUManager::GetAvailableGPUCount(BackendType::OPENCL) &&
+                  manager.GetGPUCount() == results.size();
+        for (const auto& r : results) {
+            ok &= r.success && r.init_ms > 0.0 && !r.device_name.empty();
+        }
+        passed &= ok;
+        std::cout << manager.GetInitReport();
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " " << results.size() << " device(s) initialized\n";
+
+        // 2. Ошибка одного устройства не мешает остальным
+        const int kMissing = 999;
+        manager.InitializeSpecific(BackendType::OPENCL, { kMissing, 0 });
+        results = manager.GetInitResults();
+        ok = results.size() == 2 &&
+             results[0].device_index == kMissing && !results[0].success && !results[0].error.empty() &&
+             results[1].device_index == 0 && results[1].success &&
+             manager.GetGPUCount() == 1 && manager.GetGPU(0).GetDeviceIndex() == 0;
+        passed &= ok;
+        std::cout << manager.GetInitReport();
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " failure of GPU " << kMissing
+                  << " reported, GPU 0 available\n";
+
+        std::cout << (passed ? "ALL PASSED" : "SOME FAILED") << "\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+} // namespace test_gpu_manager_init
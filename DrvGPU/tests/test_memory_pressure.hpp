@@ -0,0 +1,137 @@
+#pragma once
+/**
+ * @file test_memory_pressure.hpp
+ * @brief Тест колбэков нехватки памяти MemoryManager и уменьшения пакета
+ *
+ * 1. RelieveMemoryPressure: колбэки по приоритету, остановка, когда
+ *    освобождено достаточно
+ * 2. AllocateWithRetry: выделение, удавшееся после освобождения;
+ *    исходная ошибка, если освобождать нечего
+ * 3. EvictionRegistration снимает колбэк в деструкторе
+ * 4. BatchManager: пересчёт пакета после неудачного выделения
+ * 5. Снятие регистрации ждёт колбэк, уже запущенный другим потоком,
+ *    и после снятия колбэк не вызывается
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-11
+ */
+
+#include "drv_gpu.hpp"
+#include "common/backend_type.hpp"
+#include "../memory/memory_manager.hpp"
+#include "../services/batch_manager.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test_memory_pressure {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n=== TEST: Memory pressure callbacks ===\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        auto& mem_mgr = gpu.GetMemoryManager();
+        bool passed = true;
+
+        // 1. Порядок колбэков
+        std::vector<std::string> calls;
+        {
+            auto pools = mem_mgr.RegisterEvictionCallback("pools",
+                [&](size_t) { calls.push_back("pools"); return size_t(600); }, 10);
+            auto plans = mem_mgr.RegisterEvictionCallback("plans",
+                [&](size_t) { calls.push_back("plans"); return size_t(500); }, 0);
+            auto last = mem_mgr.RegisterEvictionCallback("last",
+                [&](size_t) { calls.push_back("last"); return size_t(1); }, 20);
+
+            size_t freed = mem_mgr.RelieveMemoryPressure(1000);
+            bool ok = freed == 1100 && calls.size() == 2 &&
+                      calls[0] == "plans" && calls[1] == "pools";
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " callbacks by priority, stop at 1000 bytes\n";
+
+            // 2. Повтор выделения
+            int attempts = 0;
+            auto buffer = mem_mgr.AllocateWithRetry(1 << 20, [&] {
+                if (++attempts < 2) {
+                    throw std::runtime_error("simulated CL_MEM_OBJECT_ALLOCATION_FAILURE");
+                }
+                return mem_mgr.CreateBuffer<float>(256);
+            });
+            ok = buffer != nullptr && attempts == 2;
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " AllocateWithRetry recovered after eviction\n";
+        }
+
+        // 3. Колбэки сняты → освобождать нечего → исходная ошибка
+        calls.clear();
+        bool ok = false;
+        try {
+            mem_mgr.AllocateWithRetry(1 << 20, []() -> std::shared_ptr<int> {
+                throw std::runtime_error("out of memory");
+            });
+        } catch (const std::runtime_error& e) {
+            ok = std::string(e.what()) == "out of memory" && calls.empty();
+        }
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " unregistered on scope exit, error propagated\n";
+
+        // 4. Пакет после неудачного выделения
+        auto* backend = &gpu.GetBackend();
+        size_t smaller = BatchManager::RecalculateAfterAllocationFailure(backend, 256, 1 << 20, 256);
+        ok = smaller >= 1 && smaller <= 128 &&
+             BatchManager::ShrinkBatchSize(1) == 0 &&
+             BatchManager::ShrinkBatchSize(7, 4) == 4;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " batch 256 → " << smaller << " after allocation failure\n";
+
+        // 5. Снятие регистрации во время выполнения колбэка
+        {
+            auto cache = std::make_unique<std::atomic<int>>(0);  // «ресурс» колбэка
+            std::atomic<bool> started{false};
+            std::atomic<bool> finished{false};
+            auto* resource = cache.get();
+            auto registration = std::make_unique<EvictionRegistration>(
+                mem_mgr.RegisterEvictionCallback("slow",
+                    [&, resource](size_t) {
+                        started = true;
+                        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                        resource->fetch_add(1);
+                        finished = true;
+                        return size_t(0);
+                    }));
+
+            std::thread relieving([&] { mem_mgr.RelieveMemoryPressure(1); });
+            while (!started) {
+                std::this_thread::yield();
+            }
+            registration.reset();               // должен дождаться колбэка
+            const bool waited = finished.load();
+            cache.reset();                      // теперь освобождать безопасно
+            relieving.join();
+
+            ok = waited && mem_mgr.RelieveMemoryPressure(1) == 0;
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " unregister waits for running callback\n";
+        }
+
+        std::cout << mem_mgr.GetStatistics();
+        std::cout << (passed ? "ALL PASSED" : "SOME FAILED") << "\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+} // namespace test_memory_pressure
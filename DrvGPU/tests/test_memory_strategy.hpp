@@ -0,0 +1,174 @@
+#pragma once
+/**
+ * @file test_memory_strategy.hpp
+ * @brief Тест фабрики буферов MemoryManager по BufferUsageHint
+ *
+ * 1. CreateBufferWithHint: для каждого hint стратегия буфера совпадает с
+ *    RecommendStrategy, round-trip Write/Read и kernel через SetAsKernelArg
+ * 2. Неподдерживаемая SVM-стратегия → REGULAR_BUFFER
+ * 3. Zero-copy: WrapHostMemory поверх AlignedHostVector (CL_MEM_USE_HOST_PTR)
+ *    и CreateZeroCopyBuffer + MapRegion/UnmapRegion
+ * 4. BenchmarkStrategies: замер всех стратегий и проверка рекомендации
+ *    на этом устройстве (расхождение — предупреждение, не ошибка:
+ *    рекомендация эвристическая)
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "common/backend_type.hpp"
+#include "../memory/memory_manager.hpp"
+#include "../memory/svm_capabilities.hpp"
+
+#include <CL/cl.h>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <string>
+
+namespace test_memory_strategy {
+
+using namespace drv_gpu_lib;
+
+struct NamedHint {
+    const char* name;
+    BufferUsageHint hint;
+};
+
+inline std::vector<NamedHint> Hints() {
+    return {
+        { "Default",          BufferUsageHint::Default() },
+        { "GPUOnly",          BufferUsageHint::GPUOnly() },
+        { "FrequentTransfer", BufferUsageHint::FrequentTransfer() },
+    };
+}
+
+/// Kernel инвертирует знак; буфер привязан через IMemoryBuffer::SetAsKernelArg
+inline bool NegateOnDevice(cl_context context, cl_device_id device, cl_command_queue queue,
+                           IMemoryBuffer<float>& buffer) {
+    const char* source =
+        "__kernel void negate(__global float* x) {\n"
+        "    size_t i = get_global_id(0);\n"
+        "    x[i] = -x[i];\n"
+        "}\n";
+
+    cl_int err;
+    cl_program program = clCreateProgramWithSource(context, 1, &source, nullptr, &err);
+    if (err != CL_SUCCESS ||
+        clBuildProgram(program, 1, &device, nullptr, nullptr, nullptr) != CL_SUCCESS) {
+        if (program) clReleaseProgram(program);
+        return false;
+    }
+    cl_kernel kernel = clCreateKernel(program, "negate", &err);
+    buffer.SetAsKernelArg(kernel, 0);
+    size_t global = buffer.GetNumElements();
+    err = clEnqueueNDRangeKernel(queue, kernel, 1, nullptr, &global, nullptr, 0, nullptr, nullptr);
+    clFinish(queue);
+    clReleaseKernel(kernel);
+    clReleaseProgram(program);
+    return err == CL_SUCCESS;
+}
+
+inline int run() {
+    try {
+        std::cout << "\n=== TEST: MemoryManager strategy factory ===\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+
+        auto& backend = gpu.GetBackend();
+        auto context = static_cast<cl_context>(backend.GetNativeContext());
+        auto device = static_cast<cl_device_id>(backend.GetNativeDevice());
+        auto queue = static_cast<cl_command_queue>(backend.GetNativeQueue());
+        auto& mem_mgr = gpu.GetMemoryManager();
+
+        SVMCapabilities caps = mem_mgr.GetSVMCapabilities();
+        std::cout << caps.ToString();
+
+        bool passed = true;
+
+        // 1. Фабрика по hint
+        const size_t n = 4099;
+        std::vector<float> data(n);
+        for (size_t i = 0; i < n; ++i) data[i] = 0.25f * static_cast<float>(i);
+
+        for (const auto& h : Hints()) {
+            auto buffer = mem_mgr.CreateBufferWithHint<float>(n, h.hint);
+            MemoryStrategy expected = mem_mgr.RecommendStrategy(n * sizeof(float), h.hint);
+
+            buffer->Write(data);
+            bool ok = buffer->GetStrategy() == expected &&
+                      NegateOnDevice(context, device, queue, *buffer);
+            auto back = buffer->Read();
+            for (size_t i = 0; i < n && ok; ++i) ok = back[i] == -data[i];
+
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " " << h.name << " → "
+                      << MemoryStrategyToString(buffer->GetStrategy()) << "\n";
+        }
+
+        // 2. Fallback
+        if (!caps.svm_supported) {
+            auto buffer = mem_mgr.CreateBufferWithStrategy<float>(n, MemoryStrategy::SVM_FINE_GRAIN);
+            bool ok = buffer->GetStrategy() == MemoryStrategy::REGULAR_BUFFER;
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " SVM_FINE_GRAIN without SVM → REGULAR_BUFFER\n";
+        }
+
+        // 3. Zero-copy буферы
+        {
+            AlignedHostVector<float> host(n);
+            for (size_t i = 0; i < n; ++i) host[i] = data[i];
+
+            auto wrapped = mem_mgr.WrapHostMemory(host.data(), n);
+            bool ok = wrapped->UsesHostPtr() && NegateOnDevice(context, device, queue, *wrapped);
+            {
+                ScopedMap guard(wrapped.get(), false, true);
+                const float* mapped = wrapped->Data();
+                for (size_t i = 0; i < n && ok; ++i) ok = mapped[i] == -data[i];
+                if (mem_mgr.HasUnifiedMemory()) {
+                    std::cout << "       map → " << (mapped == host.data() ? "host pointer (zero-copy)"
+                                                                           : "driver copy") << "\n";
+                }
+            }
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " WrapHostMemory (CL_MEM_USE_HOST_PTR)\n";
+
+            auto staged = mem_mgr.CreateZeroCopyBuffer<float>(n);
+            float* region = static_cast<float*>(
+                staged->MapRegion(sizeof(float), (n - 1) * sizeof(float), CL_MAP_WRITE_INVALIDATE_REGION));
+            for (size_t i = 1; i < n; ++i) region[i - 1] = data[i];
+            cl_event unmapped = staged->UnmapRegion(region);
+            clWaitForEvents(1, &unmapped);
+            clReleaseEvent(unmapped);
+            auto back = staged->Read();
+            ok = true;
+            for (size_t i = 1; i < n && ok; ++i) ok = back[i] == data[i];
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " CreateZeroCopyBuffer + MapRegion\n";
+        }
+
+        // 4. Бенчмарк: рекомендация против замера
+        const size_t sizes[] = { 64 * 1024, 16 * 1024 * 1024 };
+        for (size_t size : sizes) {
+            for (const auto& h : Hints()) {
+                auto report = mem_mgr.BenchmarkStrategies(size, h.hint, 5);
+                std::cout << report.ToString();
+                std::cout << (report.RecommendationValid() ? "[PASS]" : "[WARN]")
+                          << " " << h.name << ": recommended "
+                          << MemoryStrategyToString(report.recommended) << ", fastest "
+                          << MemoryStrategyToString(report.fastest) << "\n";
+            }
+        }
+
+        std::cout << (passed ? "ALL PASSED" : "SOME FAILED") << "\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+} // namespace test_memory_strategy
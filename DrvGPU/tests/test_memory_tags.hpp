@@ -0,0 +1,131 @@
+#pragma once
+/**
+ * @file test_memory_tags.hpp
+ * @brief Тест учёта памяти по меткам (MemoryLedger) и экспорта в GPUProfiler
+ *
+ * 1. ScopedMemoryTag: буфер CreateBuffer учтён под меткой области
+ * 2. Уничтожение буфера: current метки → 0, peak сохраняется
+ * 3. RegisterExternalAllocation / UnregisterExternalAllocation для сырого cl_mem
+ * 4. PublishMemoryStats → GPUProfiler::GetMemoryStats
+ * 5. Вложенные области: счётчики, закэшированные в потоке, не переносятся
+ *    на другую метку; буфер списывается с метки, под которой создан
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-11
+ */
+
+#include "drv_gpu.hpp"
+#include "common/backend_type.hpp"
+#include "../memory/memory_manager.hpp"
+#include "../memory/memory_ledger.hpp"
+#include "../services/gpu_profiler.hpp"
+
+#include <CL/cl.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace test_memory_tags {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n=== TEST: Memory tags (per-module attribution) ===\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        auto& mem_mgr = gpu.GetMemoryManager();
+        auto context = static_cast<cl_context>(gpu.GetBackend().GetNativeContext());
+        bool passed = true;
+
+        const size_t kCount = 1 << 18;
+        const size_t kBytes = kCount * sizeof(float);
+
+        // 1. Метка области
+        {
+            ScopedMemoryTag tag("TestTags/pool");
+            auto buffer = mem_mgr.CreateBuffer<float>(kCount);
+
+            auto stats = mem_mgr.GetTagStatistics("TestTags/pool");
+            bool ok = stats.current_bytes == kBytes && stats.live_allocations == 1 &&
+                      ScopedMemoryTag::Current() == "TestTags/pool";
+            passed &= ok;
+            std::cout << (ok ? "[PASS]" : "[FAIL]") << " CreateBuffer under \"TestTags/pool\": "
+                      << stats.current_bytes << " bytes\n";
+        }
+
+        // 2. Буфер уничтожен — current 0, peak остался
+        auto stats = mem_mgr.GetTagStatistics("TestTags/pool");
+        bool ok = stats.current_bytes == 0 && stats.peak_bytes == kBytes &&
+                  stats.live_allocations == 0 && ScopedMemoryTag::Current() == MemoryLedger::kUntagged;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " released: current 0, peak "
+                  << stats.peak_bytes << " bytes\n";
+
+        // 3. Сырой cl_mem модуля
+        cl_int err = CL_SUCCESS;
+        cl_mem raw = clCreateBuffer(context, CL_MEM_READ_WRITE, kBytes, nullptr, &err);
+        if (err != CL_SUCCESS) {
+            throw std::runtime_error("clCreateBuffer failed: " + std::to_string(err));
+        }
+        mem_mgr.RegisterExternalAllocation(raw, "TestTags/raw");
+        ok = mem_mgr.GetTagStatistics("TestTags/raw").current_bytes == kBytes;
+
+        // 4. Экспорт в профайлер (Stop дожидается обработки очереди)
+        auto& profiler = GPUProfiler::GetInstance();
+        profiler.Start();
+        mem_mgr.PublishMemoryStats();
+        profiler.Stop();
+
+        auto exported = profiler.GetMemoryStats(0);
+        auto it = exported.find("TestTags/raw");
+        bool exported_ok = it != exported.end() && it->second.current_bytes == kBytes &&
+                           exported.count("total") == 1;
+
+        mem_mgr.UnregisterExternalAllocation(raw);
+        clReleaseMemObject(raw);
+        auto raw_stats = mem_mgr.GetTagStatistics("TestTags/raw");
+        ok &= raw_stats.current_bytes == 0 && raw_stats.peak_bytes == kBytes;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " external cl_mem registered and unregistered\n";
+
+        passed &= exported_ok;
+        std::cout << (exported_ok ? "[PASS]" : "[FAIL]") << " GPUProfiler memory section: "
+                  << exported.size() << " tags\n";
+
+        // 5. Вложенные метки и кэш счётчиков потока
+        {
+            ScopedMemoryTag outer("TestTags/outer");
+            auto a = mem_mgr.CreateBuffer<float>(kCount);
+            std::shared_ptr<GPUBuffer<float>> inner_buffer;
+            {
+                ScopedMemoryTag inner("TestTags/inner");
+                inner_buffer = mem_mgr.CreateBuffer<float>(kCount);
+                inner_buffer = mem_mgr.CreateBuffer<float>(kCount);
+            }
+            auto b = mem_mgr.CreateBuffer<float>(kCount);
+
+            ok = mem_mgr.GetTagStatistics("TestTags/outer").current_bytes == 2 * kBytes &&
+                 mem_mgr.GetTagStatistics("TestTags/inner").current_bytes == kBytes;
+            // Буфер внутренней метки переживает её область
+            inner_buffer.reset();
+            ok &= mem_mgr.GetTagStatistics("TestTags/inner").current_bytes == 0 &&
+                  mem_mgr.GetTagStatistics("TestTags/inner").peak_bytes == 2 * kBytes &&
+                  mem_mgr.GetTagStatistics("TestTags/outer").current_bytes == 2 * kBytes;
+        }
+        ok &= mem_mgr.GetTagStatistics("TestTags/outer").current_bytes == 0;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " nested tags: outer restored, inner released\n";
+
+        std::cout << mem_mgr.GetStatistics();
+        std::cout << (passed ? "ALL PASSED" : "SOME FAILED") << "\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+} // namespace test_memory_tags
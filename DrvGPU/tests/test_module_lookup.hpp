@@ -0,0 +1,166 @@
+#pragma once
+/**
+ * @file test_module_lookup.hpp
+ * @brief Доступ к модулю: GetModule<T>(name) против ModuleRegistry::Get(handle)
+ *
+ * 1. Handle возвращает тот же модуль, что и поиск по имени; GetHandle
+ *    с чужим типом бросает исключение
+ * 2. После UnregisterModule handle даёт nullptr; повторная регистрация
+ *    с тем же именем получает новый индекс
+ * 3. Reclaim освобождает удалённые модули; живые handle продолжают работать
+ * 4. Бенчмарк: N потоков, каждый кадр — обращение к модулю.
+ *    Поиск по имени (mutex + map + dynamic_cast) против handle (atomic load)
+ *
+ * GPU не нужен: модуль-заглушка без бэкенда.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-12
+ */
+
+#include "module_registry.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test_module_lookup {
+
+using namespace drv_gpu_lib;
+
+/// Модуль-заглушка: счётчик вызовов вместо вычислений
+class CounterModule : public IComputeModule {
+public:
+    void Initialize() override { initialized_ = true; }
+    bool IsInitialized() const override { return initialized_; }
+    void Cleanup() override { initialized_ = false; }
+    std::string GetName() const override { return "Counter"; }
+    std::string GetVersion() const override { return "1.0"; }
+    std::string GetDescription() const override { return "lookup benchmark stub"; }
+    IBackend* GetBackend() const override { return nullptr; }
+
+    void Touch() { calls_.fetch_add(1, std::memory_order_relaxed); }
+    size_t GetCalls() const { return calls_.load(std::memory_order_relaxed); }
+
+private:
+    bool initialized_ = false;
+    std::atomic<size_t> calls_{0};
+};
+
+class OtherModule : public CounterModule {};
+
+/// Среднее время одного обращения (нс) при threads потоках
+template<typename Lookup>
+inline double BenchLookup(size_t threads, size_t iterations, Lookup lookup) {
+    std::atomic<bool> start{false};
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < iterations; ++i) {
+                lookup()->Touch();
+            }
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - begin).count();
+    return ns / static_cast<double>(iterations);
+}
+
+inline int run() {
+    try {
+        std::cout << "\n=== TEST: ModuleRegistry lookup (name vs handle) ===\n";
+        bool passed = true;
+
+        ModuleRegistry registry;
+        auto counter = std::make_shared<CounterModule>();
+        ModuleHandle<CounterModule> handle = registry.RegisterModule("Counter", counter);
+        registry.RegisterModule("Other", std::make_shared<OtherModule>());
+
+        // 1. Тот же модуль, проверка типа
+        bool type_rejected = false;
+        try {
+            registry.GetHandle<OtherModule>("Counter");
+        } catch (const std::runtime_error&) {
+            type_rejected = true;
+        }
+        bool ok = handle.IsValid() && registry.Get(handle) == counter.get() &&
+                  registry.Get(registry.GetHandle<CounterModule>("Counter")) ==
+                      registry.GetModule<CounterModule>("Counter").get() &&
+                  type_rejected;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " handle == GetModule<T>, wrong type rejected\n";
+
+        // 2. Удаление и повторная регистрация
+        auto temp_handle = registry.RegisterModule("Temp", std::make_shared<CounterModule>());
+        registry.UnregisterModule("Temp");
+        auto new_handle = registry.RegisterModule("Temp", std::make_shared<CounterModule>());
+        ok = registry.Get(temp_handle) == nullptr && registry.Get(new_handle) != nullptr &&
+             new_handle.GetIndex() != temp_handle.GetIndex() &&
+             registry.Get(ModuleHandle<CounterModule>()) == nullptr;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " unregistered handle -> nullptr, new index "
+                  << new_handle.GetIndex() << "\n";
+
+        // 3. Reclaim: удалённый модуль освобождается, живые доступны
+        std::weak_ptr<CounterModule> retired;
+        {
+            auto module = std::make_shared<CounterModule>();
+            retired = module;
+            registry.RegisterModule("Swap", module);
+        }
+        registry.UnregisterModule("Swap");
+        const bool kept_until_reclaim = !retired.expired();
+        const size_t reclaimed = registry.Reclaim();
+        ok = kept_until_reclaim && retired.expired() && reclaimed == 2 &&
+             registry.Get(handle) == counter.get() && registry.Get(new_handle) != nullptr &&
+             registry.Get(temp_handle) == nullptr && registry.Reclaim() == 0;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " Reclaim freed " << reclaimed
+                  << " retired module(s), live handles intact\n";
+
+        // 4. Бенчмарк
+        const size_t iterations = 1000000;
+        const size_t max_threads = std::max(2u, std::thread::hardware_concurrency());
+        std::cout << "  threads   by name (ns)   by handle (ns)   speedup\n";
+        for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+            const size_t calls_before = counter->GetCalls();
+            const double by_name = BenchLookup(threads, iterations, [&] {
+                return registry.GetModule<CounterModule>("Counter");
+            });
+            const double by_handle = BenchLookup(threads, iterations, [&] {
+                return registry.Get(handle);
+            });
+
+            ok = counter->GetCalls() - calls_before == 2 * threads * iterations;
+            passed &= ok;
+            std::cout << "  " << std::setw(7) << threads << std::fixed << std::setprecision(1)
+                      << std::setw(15) << by_name << std::setw(17) << by_handle
+                      << std::setw(9) << by_name / by_handle << "x"
+                      << (ok ? "" : "  [FAIL] lost calls") << "\n";
+        }
+
+        std::cout << (passed ? "ALL PASSED" : "SOME FAILED") << "\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+} // namespace test_module_lookup
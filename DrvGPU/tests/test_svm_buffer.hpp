@@ -0,0 +1,142 @@
+#pragma once
+/**
+ * @file test_svm_buffer.hpp
+ * @brief Тест типизированного SVMBuffer<T>
+ *
+ * 1. SVMBuffer<> (complex) — прежнее поведение, round-trip Write/Read
+ * 2. SVMBuffer<int16_t> и SVMBuffer<PeakRecord> — round-trip не-complex типов
+ * 3. Fine-grained SVMBuffer<float>: kernel пишет модули, хост читает
+ *    через Data() без Read() (если устройство поддерживает fine-grain)
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "common/backend_type.hpp"
+#include "../memory/svm_buffer.hpp"
+#include "../memory/svm_capabilities.hpp"
+
+#include <CL/cl.h>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <string>
+
+namespace test_svm_buffer {
+
+using namespace drv_gpu_lib;
+
+/// Пример POD-структуры результата (как у поиска максимумов)
+struct PeakRecord {
+    uint32_t index;
+    float    magnitude;
+    float    phase;
+    float    frequency;
+};
+
+inline bool TestFineGrainKernelWrite(cl_context context, cl_device_id device,
+                                     cl_command_queue queue) {
+    const char* source =
+        "__kernel void write_magnitudes(__global float* out) {\n"
+        "    uint i = get_global_id(0);\n"
+        "    out[i] = 0.5f * (float)i;\n"
+        "}\n";
+
+    cl_int err;
+    cl_program program = clCreateProgramWithSource(context, 1, &source, nullptr, &err);
+    if (err != CL_SUCCESS ||
+        clBuildProgram(program, 1, &device, "-cl-std=CL2.0", nullptr, nullptr) != CL_SUCCESS) {
+        if (program) clReleaseProgram(program);
+        std::cout << "[SKIP] fine-grain: program build failed\n";
+        return true;
+    }
+    cl_kernel kernel = clCreateKernel(program, "write_magnitudes", &err);
+
+    const size_t n = 1024;
+    bool ok = false;
+    {
+        SVMBuffer<float> magnitudes(context, queue, n, MemoryStrategy::SVM_FINE_GRAIN);
+        magnitudes.SetAsKernelArg(kernel, 0);
+        size_t global = n;
+        clEnqueueNDRangeKernel(queue, kernel, 1, nullptr, &global, nullptr, 0, nullptr, nullptr);
+        clFinish(queue);
+
+        // Без Read(): хост читает ту же память
+        ok = magnitudes.IsHostAccessible();
+        const float* data = magnitudes.Data();
+        for (size_t i = 0; i < n && ok; ++i) {
+            ok = data[i] == 0.5f * static_cast<float>(i);
+        }
+    }
+
+    clReleaseKernel(kernel);
+    clReleaseProgram(program);
+    std::cout << (ok ? "[PASS]" : "[FAIL]") << " SVMBuffer<float> fine-grain: kernel → Data()\n";
+    return ok;
+}
+
+inline int run() {
+    try {
+        std::cout << "\n=== TEST: SVMBuffer<T> ===\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+
+        auto& backend = gpu.GetBackend();
+        auto context = static_cast<cl_context>(backend.GetNativeContext());
+        auto device = static_cast<cl_device_id>(backend.GetNativeDevice());
+        auto queue = static_cast<cl_command_queue>(backend.GetNativeQueue());
+
+        SVMCapabilities caps = SVMCapabilities::Query(device);
+        if (!caps.HasAnySVM()) {
+            std::cout << "[SKIP] " << gpu.GetDeviceName() << ": SVM not supported\n";
+            return 0;
+        }
+
+        bool passed = true;
+
+        // 1. complex (T по умолчанию)
+        ComplexVector signal(257);
+        for (size_t i = 0; i < signal.size(); ++i) {
+            signal[i] = ComplexFloat(static_cast<float>(i), -static_cast<float>(i));
+        }
+        SVMBuffer<> complex_buffer(context, queue, signal);
+        bool ok = complex_buffer.Read() == signal &&
+                  complex_buffer.GetElementSize() == sizeof(ComplexFloat);
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " SVMBuffer<> (complex) round-trip\n";
+
+        // 2. int16 и POD-структура
+        std::vector<int16_t> samples = { -32768, -1, 0, 1, 12345, 32767 };
+        SVMBuffer<int16_t> sample_buffer(context, queue, samples);
+        ok = sample_buffer.Read() == samples;
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " SVMBuffer<int16_t> round-trip\n";
+
+        std::vector<PeakRecord> peaks = { {3, 1.5f, 0.25f, 100.0f}, {77, 9.0f, -1.0f, 2500.0f} };
+        SVMBuffer<PeakRecord> peak_buffer(context, queue, peaks);
+        auto peaks_back = peak_buffer.Read();
+        ok = peaks_back.size() == peaks.size() &&
+             peaks_back[1].index == 77 && peaks_back[1].magnitude == 9.0f &&
+             peak_buffer.GetInfo().element_size == sizeof(PeakRecord);
+        passed &= ok;
+        std::cout << (ok ? "[PASS]" : "[FAIL]") << " SVMBuffer<PeakRecord> round-trip\n";
+
+        // 3. fine-grain: без копии
+        if (caps.fine_grain_buffer) {
+            passed &= TestFineGrainKernelWrite(context, device, queue);
+        } else {
+            std::cout << "[SKIP] fine-grain SVM not supported\n";
+        }
+
+        std::cout << (passed ? "ALL PASSED" : "SOME FAILED") << "\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+} // namespace test_svm_buffer
@@ -0,0 +1,210 @@
+#pragma once
+
+/**
+ * @file beamformer_module.hpp
+ * @brief Beamformer Module - цифровое диаграммообразование (ЦДО) на GPU
+ *
+ * Реализует IComputeModule интерфейс:
+ * - Лучи = весовая матрица × отсчёты элементов решётки (комплексное GEMM)
+ * - Тайловый kernel с локальной памятью (TILE × TILE), пакет кадров — 3-е измерение
+ * - Веса направлений по сетке углов LFMParameters (angle_start/stop/step)
+ * - Выход [num_beams × count_points] — тот буфер, который потребляет
+ *   AntennaFFTProcMax::ProcessNew(cl_mem)
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "i_compute_module.hpp"
+#include "i_backend.hpp"
+#include "memory/gpu_buffer.hpp"
+#include "interface/lfm_parameters.h"
+#include <CL/cl.h>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+// ════════════════════════════════════════════════════════════════════════════
+// Параметры
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @struct BeamformerParams
+ * @brief Геометрия входных данных
+ */
+struct BeamformerParams {
+    uint32_t num_elements = 0;          ///< Элементов решётки (каналов)
+    uint32_t count_points = 0;          ///< Отсчётов на канал
+    uint32_t num_frames = 1;            ///< Кадров в пакете (одни и те же веса)
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: BeamformerModule
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class BeamformerModule
+ * @brief Compute модуль цифрового диаграммообразования
+ *
+ * Для каждого кадра f:
+ *   Y_f[b][n] = Σ_e W[b][e] · X_f[e][n]
+ *   X: [num_frames × num_elements × count_points]
+ *   W: [num_beams × num_elements]
+ *   Y: [num_frames × num_beams × count_points]
+ *
+ * Веса направлений (решётка с шагом d = λ/2, как в LFMGeneratorModule):
+ *   θ_b = angle_start_deg + b · angle_step_deg,  b < lfm.num_beams
+ *   W[b][e] = exp(+j·π·e·sin θ_b) / num_elements
+ * Плоская волна с направления θ_b складывается в луче b синфазно
+ * (амплитуда 1 на центральной частоте).
+ *
+ * Веса загружаются один раз (SetSteering / SetWeights) и переиспользуются.
+ *
+ * Использование:
+ * @code
+ * BeamformerModule bf(backend);
+ * bf.Initialize();
+ * bf.SetSteering(lfm, 64);                        // 64 элемента → lfm.num_beams лучей
+ * bf.Process(params, elements, beams);            // beams: [num_beams × count_points]
+ * fft.ProcessNew(static_cast<cl_mem>(beams->GetPtr()));
+ * @endcode
+ */
+class BeamformerModule : public IComputeModule {
+public:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Конструктор и деструктор
+    // ═══════════════════════════════════════════════════════════════════════
+
+    explicit BeamformerModule(IBackend* backend);
+    ~BeamformerModule() override;
+
+    BeamformerModule(const BeamformerModule&) = delete;
+    BeamformerModule& operator=(const BeamformerModule&) = delete;
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Реализация IComputeModule
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void Initialize() override;
+    bool IsInitialized() const override { return initialized_; }
+    void Cleanup() override;
+
+    std::string GetName() const override { return "Beamformer"; }
+    std::string GetVersion() const override { return "1.0.0"; }
+    std::string GetDescription() const override {
+        return "Digital beamformer: tiled complex GEMM (beams x elements) x (elements x samples)";
+    }
+
+    IBackend* GetBackend() const override { return backend_; }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Веса
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Веса направлений по сетке углов LFMParameters
+     * @param lfm          angle_start/step_deg, num_beams, f_start/f_stop
+     * @param num_elements Элементов решётки
+     * @throws std::invalid_argument если сетка углов не задана
+     */
+    void SetSteering(const LFMParameters& lfm, uint32_t num_elements);
+
+    /**
+     * @brief Произвольные веса [num_beams × num_elements] (например, с окном)
+     */
+    void SetWeights(const std::vector<std::complex<float>>& weights,
+                    uint32_t num_beams, uint32_t num_elements);
+
+    uint32_t GetNumBeams() const { return num_beams_; }
+    uint32_t GetNumElements() const { return num_elements_; }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Диаграммообразование
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Сформировать лучи (блокирующий)
+     * @param input  [num_frames × num_elements × count_points] complex<float>
+     * @param output [num_frames × num_beams × count_points] complex<float>
+     * @throws std::invalid_argument при неверных параметрах / малом буфере
+     */
+    void Process(
+        const BeamformerParams& params,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> output);
+
+    /**
+     * @brief Сформировать лучи из произвольных cl_mem (только постановка в очередь)
+     *
+     * @param params    Геометрия данных (num_elements == GetNumElements())
+     * @param input     cl_mem отсчётов элементов
+     * @param output    cl_mem лучей (не совпадает с input)
+     * @param out_event [out] Событие завершения (опционально)
+     */
+    void ProcessAsync(
+        const BeamformerParams& params,
+        cl_mem input,
+        cl_mem output,
+        cl_event* out_event = nullptr);
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Утилиты
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Углы лучей (градусы): angle_start_deg + b · angle_step_deg
+     */
+    static std::vector<double> ComputeSteeringAngles(const LFMParameters& lfm);
+
+    /**
+     * @brief Веса направлений [lfm.num_beams × num_elements]
+     */
+    static std::vector<std::complex<float>> ComputeSteeringWeights(
+        const LFMParameters& lfm, uint32_t num_elements);
+
+    /**
+     * @brief Эталонное диаграммообразование на CPU (double) — для тестов
+     */
+    static std::vector<std::complex<float>> ProcessReferenceCPU(
+        const BeamformerParams& params,
+        const std::vector<std::complex<float>>& weights,
+        uint32_t num_beams,
+        const std::vector<std::complex<float>>& input);
+
+private:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Члены класса
+    // ═══════════════════════════════════════════════════════════════════════
+
+    IBackend* backend_;         ///< Указатель на бэкенд (не владеет)
+    bool initialized_;          ///< Флаг инициализации
+
+    cl_program program_;        ///< Скомпилированная программа
+    cl_kernel kernel_beamform_; ///< Kernel: beamform_tiled
+
+    cl_context context_;        ///< Кэш контекста
+    cl_device_id device_;       ///< Кэш устройства
+    cl_command_queue queue_;    ///< Кэш очереди команд
+
+    cl_mem weights_buffer_;     ///< W [num_beams × num_elements] (переиспользуется)
+    size_t weights_capacity_;   ///< Ёмкость weights_buffer_ (элементов W)
+    uint32_t num_beams_;        ///< Лучей в текущих весах
+    uint32_t num_elements_;     ///< Элементов в текущих весах
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Приватные методы
+    // ═══════════════════════════════════════════════════════════════════════
+
+    static void ValidateParams(const BeamformerParams& params);
+
+    void ReleaseBuffers();
+    void CompileKernels();
+    void ReleaseKernels();
+    std::string LoadKernelSource(const std::string& filename);
+};
+
+} // namespace drv_gpu_lib
@@ -0,0 +1,89 @@
+/**
+ * @file beamformer.cl
+ * @brief OpenCL kernel цифрового диаграммообразования (тайловое комплексное GEMM)
+ *
+ * Y_f[b][n] = Σ_e W[b][e] · X_f[e][n]
+ *
+ * Рабочая группа BF_TILE × BF_TILE считает тайл (лучи × отсчёты).
+ * На каждом шаге по элементам в локальную память загружаются:
+ *   w_tile[луч][элемент]    — BF_TILE строк весов
+ *   x_tile[элемент][отсчёт] — BF_TILE строк отсчётов
+ * Каждый отсчёт X читается из глобальной памяти один раз на BF_TILE лучей,
+ * каждый вес — один раз на BF_TILE отсчётов.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#ifndef BF_TILE
+#define BF_TILE 16
+#endif
+
+inline float2 cmul(float2 a, float2 b) {
+    return (float2)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Диаграммообразование
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Лучи всех кадров пакета
+ *
+ * NDRange: (count_points, num_beams, num_frames) с округлением до BF_TILE,
+ * local = (BF_TILE, BF_TILE, 1); gid0 = отсчёт, gid1 = луч, gid2 = кадр
+ *
+ * @param input        X [num_frames × num_elements × count_points]
+ * @param weights      W [num_beams × num_elements]
+ * @param output       Y [num_frames × num_beams × count_points]
+ * @param num_elements Элементов решётки
+ * @param num_beams    Лучей
+ * @param count_points Отсчётов на канал
+ */
+__kernel __attribute__((reqd_work_group_size(BF_TILE, BF_TILE, 1)))
+void beamform_tiled(
+    __global const float2* input,
+    __global const float2* weights,
+    __global float2* output,
+    const uint num_elements,
+    const uint num_beams,
+    const uint count_points)
+{
+    __local float2 w_tile[BF_TILE][BF_TILE];
+    __local float2 x_tile[BF_TILE][BF_TILE];
+
+    const uint lx = get_local_id(0);
+    const uint ly = get_local_id(1);
+    const uint n = get_group_id(0) * BF_TILE + lx;
+    const uint beam = get_group_id(1) * BF_TILE + ly;
+    const uint frame = get_global_id(2);
+
+    __global const float2* x = input + (size_t)frame * num_elements * count_points;
+
+    float2 acc = (float2)(0.0f, 0.0f);
+
+    for (uint e0 = 0; e0 < num_elements; e0 += BF_TILE) {
+        // Вес: строка — луч этого work-item, столбец — элемент e0 + lx
+        uint ew = e0 + lx;
+        w_tile[ly][lx] = (beam < num_beams && ew < num_elements)
+            ? weights[(size_t)beam * num_elements + ew] : (float2)(0.0f, 0.0f);
+
+        // Отсчёт: строка — элемент e0 + ly, столбец — отсчёт этого work-item
+        uint ex = e0 + ly;
+        x_tile[ly][lx] = (n < count_points && ex < num_elements)
+            ? x[(size_t)ex * count_points + n] : (float2)(0.0f, 0.0f);
+
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        #pragma unroll
+        for (uint k = 0; k < BF_TILE; ++k) {
+            acc += cmul(w_tile[ly][k], x_tile[k][lx]);
+        }
+
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if (beam < num_beams && n < count_points) {
+        output[((size_t)frame * num_beams + beam) * count_points + n] = acc;
+    }
+}
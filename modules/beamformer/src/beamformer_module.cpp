@@ -0,0 +1,400 @@
+#include "beamformer_module.hpp"
+#include "logger/logger.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cmath>
+
+// Определено в CMakeLists.txt
+#ifndef BEAMFORMER_KERNELS_PATH
+#define BEAMFORMER_KERNELS_PATH "kernels"
+#endif
+
+namespace drv_gpu_lib {
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+constexpr size_t kTile = 16;     ///< Должен совпадать с BF_TILE (передаётся в -D)
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Конструктор и деструктор
+// ════════════════════════════════════════════════════════════════════════════
+
+BeamformerModule::BeamformerModule(IBackend* backend)
+    : backend_(backend)
+    , initialized_(false)
+    , program_(nullptr)
+    , kernel_beamform_(nullptr)
+    , context_(nullptr)
+    , device_(nullptr)
+    , queue_(nullptr)
+    , weights_buffer_(nullptr)
+    , weights_capacity_(0)
+    , num_beams_(0)
+    , num_elements_(0)
+{
+    if (!backend_) {
+        throw std::invalid_argument("BeamformerModule: backend cannot be null");
+    }
+
+    DRVGPU_LOG_INFO("BeamformerModule", "Created (not initialized)");
+}
+
+BeamformerModule::~BeamformerModule() {
+    Cleanup();
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Жизненный цикл
+// ════════════════════════════════════════════════════════════════════════════
+
+void BeamformerModule::Initialize() {
+    if (initialized_) {
+        DRVGPU_LOG_WARNING("BeamformerModule", "Already initialized");
+        return;
+    }
+
+    DRVGPU_LOG_INFO("BeamformerModule", "Initializing...");
+
+    context_ = static_cast<cl_context>(backend_->GetNativeContext());
+    device_ = static_cast<cl_device_id>(backend_->GetNativeDevice());
+    queue_ = static_cast<cl_command_queue>(backend_->GetNativeQueue());
+
+    if (!context_ || !device_ || !queue_) {
+        throw std::runtime_error("BeamformerModule: Invalid OpenCL handles from backend");
+    }
+
+    CompileKernels();
+
+    initialized_ = true;
+    DRVGPU_LOG_INFO("BeamformerModule", "Initialized successfully ✅");
+}
+
+void BeamformerModule::Cleanup() {
+    if (!initialized_) {
+        return;
+    }
+
+    DRVGPU_LOG_INFO("BeamformerModule", "Cleanup...");
+
+    ReleaseBuffers();
+    ReleaseKernels();
+
+    initialized_ = false;
+    DRVGPU_LOG_INFO("BeamformerModule", "Cleanup complete");
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Веса
+// ════════════════════════════════════════════════════════════════════════════
+
+void BeamformerModule::SetSteering(const LFMParameters& lfm, uint32_t num_elements) {
+    auto weights = ComputeSteeringWeights(lfm, num_elements);
+    SetWeights(weights, static_cast<uint32_t>(lfm.num_beams), num_elements);
+}
+
+void BeamformerModule::SetWeights(
+    const std::vector<std::complex<float>>& weights,
+    uint32_t num_beams,
+    uint32_t num_elements)
+{
+    if (!initialized_) {
+        throw std::runtime_error("BeamformerModule: not initialized");
+    }
+    if (num_beams == 0 || num_elements == 0) {
+        throw std::invalid_argument("BeamformerModule::SetWeights - empty weight matrix");
+    }
+    const size_t count = static_cast<size_t>(num_beams) * num_elements;
+    if (weights.size() != count) {
+        throw std::invalid_argument(
+            "BeamformerModule::SetWeights - weights.size() != num_beams * num_elements");
+    }
+
+    if (count > weights_capacity_) {
+        if (weights_buffer_) {
+            clReleaseMemObject(weights_buffer_);
+            weights_buffer_ = nullptr;
+        }
+        cl_int err;
+        weights_buffer_ = clCreateBuffer(context_, CL_MEM_READ_ONLY,
+                                         count * sizeof(cl_float2), nullptr, &err);
+        if (err != CL_SUCCESS || !weights_buffer_) {
+            weights_capacity_ = 0;
+            num_beams_ = num_elements_ = 0;
+            throw std::runtime_error("BeamformerModule: Failed to allocate weights buffer");
+        }
+        weights_capacity_ = count;
+    }
+
+    // Блокирующая запись: weights принадлежит вызывающему
+    cl_int err = clEnqueueWriteBuffer(queue_, weights_buffer_, CL_TRUE, 0,
+                                      count * sizeof(cl_float2),
+                                      weights.data(), 0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        num_beams_ = num_elements_ = 0;
+        throw std::runtime_error("BeamformerModule: Failed to upload weights");
+    }
+
+    num_beams_ = num_beams;
+    num_elements_ = num_elements;
+    DRVGPU_LOG_DEBUG("BeamformerModule", "Weights: " + std::to_string(num_beams) +
+                     " beams x " + std::to_string(num_elements) + " elements");
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Диаграммообразование
+// ════════════════════════════════════════════════════════════════════════════
+
+void BeamformerModule::Process(
+    const BeamformerParams& params,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> output)
+{
+    if (!input || !output) {
+        throw std::invalid_argument("BeamformerModule::Process - buffer is null");
+    }
+    const size_t frames = params.num_frames;
+    if (input->GetNumElements() < frames * params.num_elements * params.count_points) {
+        throw std::invalid_argument("BeamformerModule::Process - input buffer too small");
+    }
+    if (output->GetNumElements() < frames * num_beams_ * params.count_points) {
+        throw std::invalid_argument("BeamformerModule::Process - output buffer too small");
+    }
+
+    ProcessAsync(params, static_cast<cl_mem>(input->GetPtr()),
+                 static_cast<cl_mem>(output->GetPtr()), nullptr);
+
+    clFinish(queue_); // Ждём завершения
+}
+
+void BeamformerModule::ProcessAsync(
+    const BeamformerParams& params,
+    cl_mem input,
+    cl_mem output,
+    cl_event* out_event)
+{
+    if (!initialized_) {
+        throw std::runtime_error("BeamformerModule: not initialized");
+    }
+    if (!weights_buffer_ || num_beams_ == 0) {
+        throw std::runtime_error("BeamformerModule: weights not set (SetSteering / SetWeights)");
+    }
+    if (input == output) {
+        throw std::invalid_argument("BeamformerModule::ProcessAsync - input == output");
+    }
+    ValidateParams(params);
+    if (params.num_elements != num_elements_) {
+        throw std::invalid_argument(
+            "BeamformerModule::ProcessAsync - num_elements does not match weights");
+    }
+
+    cl_uint num_elements = params.num_elements;
+    cl_uint num_beams = num_beams_;
+    cl_uint count_points = params.count_points;
+
+    cl_int err;
+    err = clSetKernelArg(kernel_beamform_, 0, sizeof(cl_mem), &input);
+    err |= clSetKernelArg(kernel_beamform_, 1, sizeof(cl_mem), &weights_buffer_);
+    err |= clSetKernelArg(kernel_beamform_, 2, sizeof(cl_mem), &output);
+    err |= clSetKernelArg(kernel_beamform_, 3, sizeof(cl_uint), &num_elements);
+    err |= clSetKernelArg(kernel_beamform_, 4, sizeof(cl_uint), &num_beams);
+    err |= clSetKernelArg(kernel_beamform_, 5, sizeof(cl_uint), &count_points);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("BeamformerModule::ProcessAsync - Failed to set kernel args");
+    }
+
+    size_t global_size[3] = {
+        ((count_points + kTile - 1) / kTile) * kTile,
+        ((num_beams + kTile - 1) / kTile) * kTile,
+        params.num_frames
+    };
+    size_t local_size[3] = { kTile, kTile, 1 };
+
+    err = clEnqueueNDRangeKernel(queue_, kernel_beamform_, 3, nullptr,
+                                 global_size, local_size, 0, nullptr, out_event);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("BeamformerModule::ProcessAsync - Failed to enqueue kernel");
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Буферы
+// ════════════════════════════════════════════════════════════════════════════
+
+void BeamformerModule::ValidateParams(const BeamformerParams& params) {
+    if (params.num_elements == 0 || params.count_points == 0 || params.num_frames == 0) {
+        throw std::invalid_argument("BeamformerModule: invalid BeamformerParams");
+    }
+}
+
+void BeamformerModule::ReleaseBuffers() {
+    if (weights_buffer_) {
+        clReleaseMemObject(weights_buffer_);
+        weights_buffer_ = nullptr;
+        weights_capacity_ = 0;
+    }
+    num_beams_ = 0;
+    num_elements_ = 0;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Утилиты
+// ════════════════════════════════════════════════════════════════════════════
+
+std::vector<double> BeamformerModule::ComputeSteeringAngles(const LFMParameters& lfm) {
+    if (lfm.num_beams == 0 || lfm.angle_step_deg <= 0.0f ||
+        lfm.angle_stop_deg == lfm.angle_start_deg) {
+        throw std::invalid_argument(
+            "BeamformerModule: angle grid not set (angle_start/stop/step_deg, num_beams)");
+    }
+
+    std::vector<double> angles(lfm.num_beams);
+    for (size_t b = 0; b < lfm.num_beams; ++b) {
+        angles[b] = lfm.angle_start_deg + b * static_cast<double>(lfm.angle_step_deg);
+    }
+    return angles;
+}
+
+std::vector<std::complex<float>> BeamformerModule::ComputeSteeringWeights(
+    const LFMParameters& lfm, uint32_t num_elements)
+{
+    if (num_elements == 0) {
+        throw std::invalid_argument("BeamformerModule: num_elements == 0");
+    }
+    auto angles = ComputeSteeringAngles(lfm);
+
+    // d = λ/2 на центральной частоте → набег фазы между элементами π·sin θ
+    const double deg2rad = kPi / 180.0;
+    const double scale = 1.0 / static_cast<double>(num_elements);
+
+    std::vector<std::complex<float>> weights(angles.size() * num_elements);
+    for (size_t b = 0; b < angles.size(); ++b) {
+        const double psi = kPi * std::sin(angles[b] * deg2rad);
+        for (uint32_t e = 0; e < num_elements; ++e) {
+            const double ph = psi * static_cast<double>(e);
+            weights[b * num_elements + e] = std::complex<float>(
+                static_cast<float>(scale * std::cos(ph)),
+                static_cast<float>(scale * std::sin(ph)));
+        }
+    }
+    return weights;
+}
+
+std::vector<std::complex<float>> BeamformerModule::ProcessReferenceCPU(
+    const BeamformerParams& params,
+    const std::vector<std::complex<float>>& weights,
+    uint32_t num_beams,
+    const std::vector<std::complex<float>>& input)
+{
+    ValidateParams(params);
+    const size_t elements = params.num_elements;
+    const size_t count = params.count_points;
+    if (weights.size() != num_beams * elements ||
+        input.size() < params.num_frames * elements * count) {
+        throw std::invalid_argument("BeamformerModule::ProcessReferenceCPU - size mismatch");
+    }
+
+    std::vector<std::complex<float>> output(params.num_frames * num_beams * count);
+
+    for (size_t f = 0; f < params.num_frames; ++f) {
+        const std::complex<float>* x = &input[f * elements * count];
+        for (size_t b = 0; b < num_beams; ++b) {
+            for (size_t n = 0; n < count; ++n) {
+                std::complex<double> acc(0.0, 0.0);
+                for (size_t e = 0; e < elements; ++e) {
+                    acc += std::complex<double>(weights[b * elements + e]) *
+                           std::complex<double>(x[e * count + n]);
+                }
+                output[(f * num_beams + b) * count + n] = std::complex<float>(
+                    static_cast<float>(acc.real()), static_cast<float>(acc.imag()));
+            }
+        }
+    }
+    return output;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Компиляция kernels
+// ════════════════════════════════════════════════════════════════════════════
+
+void BeamformerModule::CompileKernels() {
+    std::string kernel_source = LoadKernelSource("beamformer.cl");
+
+    const char* source_ptr = kernel_source.c_str();
+    size_t source_size = kernel_source.size();
+
+    cl_int err;
+    program_ = clCreateProgramWithSource(context_, 1, &source_ptr, &source_size, &err);
+
+    if (err != CL_SUCCESS || !program_) {
+        throw std::runtime_error("BeamformerModule: Failed to create program");
+    }
+
+    const std::string options = "-DBF_TILE=" + std::to_string(kTile);
+    err = clBuildProgram(program_, 1, &device_, options.c_str(), nullptr, nullptr);
+
+    if (err != CL_SUCCESS) {
+        size_t log_size;
+        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+
+        std::vector<char> log(log_size);
+        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, log_size, log.data(), nullptr);
+
+        DRVGPU_LOG_ERROR("BeamformerModule", "Kernel compilation failed:");
+        DRVGPU_LOG_ERROR("BeamformerModule", std::string(log.data()));
+
+        clReleaseProgram(program_);
+        program_ = nullptr;
+
+        throw std::runtime_error("BeamformerModule: Kernel compilation failed");
+    }
+
+    kernel_beamform_ = clCreateKernel(program_, "beamform_tiled", &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create kernel: beamform_tiled");
+    }
+
+    DRVGPU_LOG_INFO("BeamformerModule", "Kernels compiled successfully ✅");
+}
+
+void BeamformerModule::ReleaseKernels() {
+    if (kernel_beamform_) {
+        clReleaseKernel(kernel_beamform_);
+        kernel_beamform_ = nullptr;
+    }
+    if (program_) {
+        clReleaseProgram(program_);
+        program_ = nullptr;
+    }
+}
+
+std::string BeamformerModule::LoadKernelSource(const std::string& filename) {
+    std::vector<std::string> search_paths = {
+        std::string(BEAMFORMER_KERNELS_PATH) + "/" + filename,
+        "modules/beamformer/kernels/" + filename,
+        "../modules/beamformer/kernels/" + filename,
+        "../../modules/beamformer/kernels/" + filename
+    };
+
+    for (const auto& path : search_paths) {
+        std::ifstream file(path);
+        if (file.is_open()) {
+            DRVGPU_LOG_DEBUG("BeamformerModule", "Kernel loaded from: " + path);
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            return buffer.str();
+        }
+    }
+
+    DRVGPU_LOG_ERROR("BeamformerModule", "Failed to load kernel: " + filename);
+    for (const auto& path : search_paths) {
+        DRVGPU_LOG_ERROR("BeamformerModule", "  - " + path);
+    }
+
+    throw std::runtime_error("BeamformerModule: Failed to load kernel source: " + filename);
+}
+
+} // namespace drv_gpu_lib
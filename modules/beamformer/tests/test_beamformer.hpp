@@ -0,0 +1,130 @@
+#pragma once
+/**
+ * @file test_beamformer.hpp
+ * @brief Тест BeamformerModule: тайловое ЦДО на GPU
+ *
+ * Плоская волна (тон на центральной частоте) с направления одного из лучей
+ * сетки на решётке 40 элементов (не кратно тайлу), 2 кадра.
+ * 1. GPU против ProcessReferenceCPU()
+ * 2. Луч на направлении волны: |y| ≈ 1, максимум среди лучей
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "beamformer_module.hpp"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <algorithm>
+#define _USE_MATH_DEFINES  // ✅ Windows: для M_PI
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace test_beamformer {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║     TEST: BeamformerModule — ЦДО (тайловое GEMM)         ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        auto module = std::make_shared<BeamformerModule>(&gpu.GetBackend());
+        module->Initialize();
+        gpu.GetModuleRegistry().RegisterModule("Beamformer", module);
+
+        // Сетка: 37 лучей от -45° с шагом 2.5°
+        LFMParameters lfm;
+        lfm.f_start = 1.0e6f;
+        lfm.f_stop = 2.0e6f;
+        lfm.sample_rate = 12.0e6f;
+        lfm.num_beams = 37;
+        lfm.angle_start_deg = -45.0f;
+        lfm.angle_step_deg = 2.5f;
+        lfm.angle_stop_deg = lfm.angle_start_deg + lfm.angle_step_deg * (lfm.num_beams - 1);
+
+        BeamformerParams params;
+        params.num_elements = 40;
+        params.count_points = 1000;
+        params.num_frames = 2;
+
+        module->SetSteering(lfm, params.num_elements);
+        auto angles = BeamformerModule::ComputeSteeringAngles(lfm);
+
+        // Кадр f: волна с направления луча target[f]
+        const size_t target[2] = { 5, 29 };
+        const double f_center = 0.5 * (lfm.f_start + lfm.f_stop);
+        const size_t frame_size = static_cast<size_t>(params.num_elements) * params.count_points;
+        std::vector<std::complex<float>> input(params.num_frames * frame_size);
+        for (size_t f = 0; f < params.num_frames; ++f) {
+            double psi = M_PI * std::sin(angles[target[f]] * M_PI / 180.0);
+            for (size_t e = 0; e < params.num_elements; ++e) {
+                for (size_t n = 0; n < params.count_points; ++n) {
+                    double ph = 2.0 * M_PI * f_center * n / lfm.sample_rate - psi * e;
+                    input[f * frame_size + e * params.count_points + n] = std::complex<float>(
+                        static_cast<float>(std::cos(ph)), static_cast<float>(std::sin(ph)));
+                }
+            }
+        }
+
+        auto& mem_mgr = gpu.GetMemoryManager();
+        const size_t out_total = params.num_frames * lfm.num_beams * params.count_points;
+        auto gpu_in = mem_mgr.CreateBuffer<std::complex<float>>(input.data(), input.size());
+        auto gpu_out = mem_mgr.CreateBuffer<std::complex<float>>(out_total);
+
+        module->Process(params, gpu_in, gpu_out);
+        auto result = gpu_out->Read();
+
+        // ── 1. GPU против CPU ──────────────────────────────────────────────
+        auto weights = BeamformerModule::ComputeSteeringWeights(lfm, params.num_elements);
+        auto reference = BeamformerModule::ProcessReferenceCPU(
+            params, weights, static_cast<uint32_t>(lfm.num_beams), input);
+        float max_ref_error = 0.0f;
+        for (size_t i = 0; i < out_total; ++i) {
+            max_ref_error = std::max(max_ref_error, std::abs(result[i] - reference[i]));
+        }
+
+        // ── 2. Максимум по лучам (отсчёт 100 каждого кадра) ────────────────
+        bool peaks_ok = true;
+        for (size_t f = 0; f < params.num_frames; ++f) {
+            size_t best = 0;
+            float best_mag = 0.0f;
+            for (size_t b = 0; b < lfm.num_beams; ++b) {
+                float mag = std::abs(result[(f * lfm.num_beams + b) * params.count_points + 100]);
+                if (mag > best_mag) { best_mag = mag; best = b; }
+            }
+            bool ok = (best == target[f]) && std::abs(best_mag - 1.0f) < 1.0e-3f;
+            peaks_ok &= ok;
+            std::cout << "  Кадр " << f << ": луч " << best << " (" << std::fixed
+                      << std::setprecision(1) << angles[best] << "°), |y| = "
+                      << std::setprecision(4) << best_mag << "  " << (ok ? "✅" : "❌") << "\n";
+        }
+
+        std::cout << std::scientific << std::setprecision(2);
+        std::cout << "\n  max|GPU - CPU| = " << max_ref_error << "\n\n";
+
+        bool passed = (max_ref_error < 1.0e-5f) && peaks_ok;
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_beamformer
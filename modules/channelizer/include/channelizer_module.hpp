@@ -0,0 +1,242 @@
+#pragma once
+
+/**
+ * @file channelizer_module.hpp
+ * @brief Channelizer Module - децимирующий КИХ и полифазная гребёнка фильтров на GPU
+ *
+ * Реализует IComputeModule интерфейс:
+ * - Децимация: КИХ с прореживанием в D раз (фильтр + прореживание за один проход)
+ * - Канализация: полифазная гребёнка на M каналов с прореживанием M
+ * - Коэффициенты в __constant памяти, тайлы по лучу и выходному отсчёту
+ * - Вход [num_beams × count_points] — тот же буфер, что у AntennaFFTProcMax /
+ *   SpectrumMaximaFinder; выход короче в D (M) раз → nFFT меньше в D раз
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "i_compute_module.hpp"
+#include "i_backend.hpp"
+#include "memory/gpu_buffer.hpp"
+#include <CL/cl.h>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+// ════════════════════════════════════════════════════════════════════════════
+// Параметры
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @struct ChannelizerParams
+ * @brief Геометрия входных данных
+ */
+struct ChannelizerParams {
+    uint32_t num_beams = 0;             ///< Количество лучей
+    uint32_t count_points = 0;          ///< Входных отсчётов на луч
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: ChannelizerModule
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class ChannelizerModule
+ * @brief Compute модуль децимации / канализации
+ *
+ * Децимация (коэффициент D, выход fs/D):
+ *   y_b[m] = Σ_k h[k] · x_b[m·D - k],   m < ceil(count_points / D)
+ * Тон на частоте f (|f| < fs/(2D)) остаётся на частоте f.
+ *
+ * Канализация (M каналов, каждый с частотой fs/M):
+ *   y_b,c[m] = Σ_k h[k] · e^{+j·2π·c·k/M} · x_b[m·M - k]
+ * Канал c — полоса вокруг c·fs/M, перенесённая на нулевую частоту;
+ * выход [num_beams × M × out_points] — каждая пара (луч, канал) образует
+ * отдельную строку для SpectrumMaximaFinder.
+ *
+ * Коэффициенты задаются один раз (SetTaps) и переиспользуются;
+ * DesignLowpass() строит ФНЧ-прототип (оконный sinc, окно Хэмминга).
+ *
+ * Использование:
+ * @code
+ * ChannelizerModule ch(backend);
+ * ch.Initialize();
+ * ch.SetTaps(ChannelizerModule::DesignLowpass(64, 0.5f / 8));
+ * ch.Decimate(params, 8, signal, decimated);    // 12 МГц → 1.5 МГц
+ * @endcode
+ */
+class ChannelizerModule : public IComputeModule {
+public:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Конструктор и деструктор
+    // ═══════════════════════════════════════════════════════════════════════
+
+    explicit ChannelizerModule(IBackend* backend);
+    ~ChannelizerModule() override;
+
+    ChannelizerModule(const ChannelizerModule&) = delete;
+    ChannelizerModule& operator=(const ChannelizerModule&) = delete;
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Реализация IComputeModule
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void Initialize() override;
+    bool IsInitialized() const override { return initialized_; }
+    void Cleanup() override;
+
+    std::string GetName() const override { return "Channelizer"; }
+    std::string GetVersion() const override { return "1.0.0"; }
+    std::string GetDescription() const override {
+        return "Decimating FIR and polyphase filter-bank channelizer (taps in constant memory)";
+    }
+
+    IBackend* GetBackend() const override { return backend_; }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Коэффициенты
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Загрузить комплексные коэффициенты фильтра
+     * @throws std::invalid_argument если пусто или не помещается в __constant память
+     */
+    void SetTaps(const std::vector<std::complex<float>>& taps);
+
+    /**
+     * @brief Загрузить вещественные коэффициенты фильтра
+     */
+    void SetTaps(const std::vector<float>& taps);
+
+    uint32_t GetNumTaps() const { return num_taps_; }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Децимация
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Фильтрация с прореживанием (блокирующий)
+     * @param output [num_beams × GetOutputPoints(count_points, decimation)]
+     * @throws std::invalid_argument при неверных параметрах / малом буфере
+     */
+    void Decimate(
+        const ChannelizerParams& params,
+        uint32_t decimation,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> output);
+
+    /**
+     * @brief Фильтрация с прореживанием произвольных cl_mem (только постановка в очередь)
+     */
+    void DecimateAsync(
+        const ChannelizerParams& params,
+        uint32_t decimation,
+        cl_mem input,
+        cl_mem output,
+        cl_event* out_event = nullptr);
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Канализация
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Полифазная гребёнка фильтров (блокирующий)
+     * @param output [num_beams × num_channels × GetOutputPoints(count_points, num_channels)]
+     * @throws std::invalid_argument при неверных параметрах / малом буфере
+     */
+    void Channelize(
+        const ChannelizerParams& params,
+        uint32_t num_channels,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> output);
+
+    /**
+     * @brief Полифазная гребёнка для произвольных cl_mem (только постановка в очередь)
+     */
+    void ChannelizeAsync(
+        const ChannelizerParams& params,
+        uint32_t num_channels,
+        cl_mem input,
+        cl_mem output,
+        cl_event* out_event = nullptr);
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Утилиты
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Выходных отсчётов на луч (канал): ceil(count_points / factor)
+     */
+    static uint32_t GetOutputPoints(uint32_t count_points, uint32_t factor);
+
+    /**
+     * @brief ФНЧ-прототип: оконный sinc (Хэмминг), единичное усиление на нуле
+     * @param num_taps Длина фильтра
+     * @param cutoff   Частота среза, доля fs (0 < cutoff < 0.5), обычно 0.5 / D
+     */
+    static std::vector<float> DesignLowpass(uint32_t num_taps, float cutoff);
+
+    /**
+     * @brief Эталонная децимация на CPU (double) — для тестов
+     */
+    static std::vector<std::complex<float>> DecimateReferenceCPU(
+        const ChannelizerParams& params,
+        uint32_t decimation,
+        const std::vector<std::complex<float>>& taps,
+        const std::vector<std::complex<float>>& input);
+
+    /**
+     * @brief Эталонная канализация на CPU (прямая формула, double) — для тестов
+     */
+    static std::vector<std::complex<float>> ChannelizeReferenceCPU(
+        const ChannelizerParams& params,
+        uint32_t num_channels,
+        const std::vector<std::complex<float>>& taps,
+        const std::vector<std::complex<float>>& input);
+
+private:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Члены класса
+    // ═══════════════════════════════════════════════════════════════════════
+
+    IBackend* backend_;         ///< Указатель на бэкенд (не владеет)
+    bool initialized_;          ///< Флаг инициализации
+
+    cl_program program_;        ///< Скомпилированная программа
+    cl_kernel kernel_decimate_; ///< Kernel: fir_decimate
+    cl_kernel kernel_pfb_;      ///< Kernel: pfb_channelize
+
+    cl_context context_;        ///< Кэш контекста
+    cl_device_id device_;       ///< Кэш устройства
+    cl_command_queue queue_;    ///< Кэш очереди команд
+
+    cl_ulong max_constant_bytes_;   ///< CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE
+    cl_ulong local_mem_bytes_;      ///< CL_DEVICE_LOCAL_MEM_SIZE
+    size_t max_work_group_;         ///< CL_DEVICE_MAX_WORK_GROUP_SIZE
+
+    cl_mem taps_buffer_;        ///< h[num_taps] (переиспользуется)
+    size_t taps_capacity_;      ///< Ёмкость taps_buffer_ (коэффициентов)
+    uint32_t num_taps_;         ///< Длина текущего фильтра
+    cl_mem twiddle_buffer_;     ///< e^{+j·2π·q/M} для текущего M
+    uint32_t twiddle_channels_; ///< M, для которого посчитан twiddle_buffer_
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Приватные методы
+    // ═══════════════════════════════════════════════════════════════════════
+
+    static void ValidateParams(const ChannelizerParams& params);
+    void CheckReady() const;
+    size_t SelectDecimateTile(uint32_t decimation) const;
+    void EnsureTwiddles(uint32_t num_channels);
+
+    void ReleaseBuffers();
+    void CompileKernels();
+    void ReleaseKernels();
+    std::string LoadKernelSource(const std::string& filename);
+};
+
+} // namespace drv_gpu_lib
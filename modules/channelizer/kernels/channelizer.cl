@@ -0,0 +1,151 @@
+/**
+ * @file channelizer.cl
+ * @brief OpenCL kernels децимации: КИХ с прореживанием и полифазная гребёнка фильтров
+ *
+ * Коэффициенты фильтра лежат в __constant памяти (общие для всех лучей).
+ *
+ * Децимирующий КИХ (коэффициент D):
+ *   y_b[m] = Σ_k h[k] · x_b[m·D - k]
+ *
+ * Полифазная гребёнка (M каналов, прореживание M):
+ *   y_b,c[m] = Σ_k h[k] · e^{+j·2π·c·k/M} · x_b[m·M - k]
+ *            = Σ_p e^{+j·2π·c·p/M} · v_p[m],   v_p[m] = Σ_r h[p + r·M] · x_b[m·M - p - r·M]
+ * Канал c — полоса вокруг c·fs/M, перенесённая на нулевую частоту.
+ *
+ * Отсчёты вне [0, count_points) считаются нулевыми.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+inline float2 cmul(float2 a, float2 b) {
+    return (float2)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Децимирующий КИХ
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Фильтрация с прореживанием всех лучей
+ *
+ * NDRange: (out_points с округлением до tile, num_beams), local = (tile, 1);
+ * gid0 = выходной отсчёт, gid1 = луч.
+ * Рабочая группа загружает в локальную память общий для тайла участок входа
+ * длиной (tile - 1)·D + num_taps — каждый входной отсчёт читается из
+ * глобальной памяти один раз на группу.
+ *
+ * @param input        Вход  [num_beams × count_points] complex<float>
+ * @param output       Выход [num_beams × out_points]
+ * @param taps         h[num_taps]
+ * @param span         Локальный буфер (tile - 1)·D + num_taps отсчётов
+ * @param num_taps     Длина фильтра
+ * @param decimation   Коэффициент прореживания D
+ * @param count_points Входных отсчётов на луч
+ * @param out_points   Выходных отсчётов на луч
+ */
+__kernel void fir_decimate(
+    __global const float2* input,
+    __global float2* output,
+    __constant float2* taps,
+    __local float2* span,
+    const uint num_taps,
+    const uint decimation,
+    const uint count_points,
+    const uint out_points)
+{
+    const uint lx = get_local_id(0);
+    const uint tile = get_local_size(0);
+    const uint m0 = get_group_id(0) * tile;
+    const uint beam = get_global_id(1);
+
+    __global const float2* row = input + (size_t)beam * count_points;
+
+    // Первый нужный тайлу отсчёт: m0·D - (num_taps - 1)
+    const int base = (int)(m0 * decimation) - (int)(num_taps - 1);
+    const uint span_len = (tile - 1) * decimation + num_taps;
+
+    for (uint i = lx; i < span_len; i += tile) {
+        int idx = base + (int)i;
+        span[i] = (idx >= 0 && idx < (int)count_points) ? row[idx] : (float2)(0.0f, 0.0f);
+    }
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    const uint m = m0 + lx;
+    if (m >= out_points) return;
+
+    // x[m·D - k] = span[lx·D + num_taps - 1 - k]
+    const uint off = lx * decimation + num_taps - 1;
+    float2 acc = (float2)(0.0f, 0.0f);
+    for (uint k = 0; k < num_taps; ++k) {
+        acc += cmul(taps[k], span[off - k]);
+    }
+
+    output[(size_t)beam * out_points + m] = acc;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Полифазная гребёнка фильтров
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Разбить все лучи на M каналов с прореживанием M
+ *
+ * NDRange: (out_points · M, num_beams), local = (M, 1);
+ * группа = (выходной отсчёт m, луч), lid0 = ветвь p на первом шаге
+ * и канал c на втором (ДПФ по ветвям через локальную память).
+ *
+ * @param input        Вход  [num_beams × count_points] complex<float>
+ * @param output       Выход [num_beams × M × out_points]
+ * @param taps         Прототип ФНЧ h[num_taps]
+ * @param twiddles     e^{+j·2π·q/M}, q < M
+ * @param branch       Локальный буфер M отсчётов (v_p[m])
+ * @param num_taps     Длина прототипа
+ * @param num_channels Число каналов M
+ * @param count_points Входных отсчётов на луч
+ * @param out_points   Выходных отсчётов на канал
+ */
+__kernel void pfb_channelize(
+    __global const float2* input,
+    __global float2* output,
+    __constant float2* taps,
+    __constant float2* twiddles,
+    __local float2* branch,
+    const uint num_taps,
+    const uint num_channels,
+    const uint count_points,
+    const uint out_points)
+{
+    const uint p = get_local_id(0);
+    const uint m = get_group_id(0);
+    const uint beam = get_global_id(1);
+
+    __global const float2* row = input + (size_t)beam * count_points;
+    const int t = (int)(m * num_channels);
+
+    // Ветвь p: v_p[m] = Σ_r h[p + r·M] · x[m·M - p - r·M]
+    float2 v = (float2)(0.0f, 0.0f);
+    for (uint k = p; k < num_taps; k += num_channels) {
+        int idx = t - (int)k;
+        if (idx < 0) break;
+        if (idx < (int)count_points) {
+            v += cmul(taps[k], row[idx]);
+        }
+    }
+    branch[p] = v;
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    // Канал c = p: y_c[m] = Σ_p' v_p'[m] · e^{+j·2π·c·p'/M}
+    const uint c = p;
+    float2 acc = (float2)(0.0f, 0.0f);
+    uint q = 0;
+    for (uint pp = 0; pp < num_channels; ++pp) {
+        acc += cmul(branch[pp], twiddles[q]);
+        q += c;
+        if (q >= num_channels) q -= num_channels;
+    }
+
+    output[((size_t)beam * num_channels + c) * out_points + m] = acc;
+}
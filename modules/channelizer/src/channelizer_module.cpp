@@ -0,0 +1,609 @@
+#include "channelizer_module.hpp"
+#include "logger/logger.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cmath>
+
+// Определено в CMakeLists.txt
+#ifndef CHANNELIZER_KERNELS_PATH
+#define CHANNELIZER_KERNELS_PATH "kernels"
+#endif
+
+namespace drv_gpu_lib {
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+constexpr size_t kMaxDecimateTile = 64;   ///< Выходных отсчётов на группу fir_decimate
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Конструктор и деструктор
+// ════════════════════════════════════════════════════════════════════════════
+
+ChannelizerModule::ChannelizerModule(IBackend* backend)
+    : backend_(backend)
+    , initialized_(false)
+    , program_(nullptr)
+    , kernel_decimate_(nullptr)
+    , kernel_pfb_(nullptr)
+    , context_(nullptr)
+    , device_(nullptr)
+    , queue_(nullptr)
+    , max_constant_bytes_(0)
+    , local_mem_bytes_(0)
+    , max_work_group_(0)
+    , taps_buffer_(nullptr)
+    , taps_capacity_(0)
+    , num_taps_(0)
+    , twiddle_buffer_(nullptr)
+    , twiddle_channels_(0)
+{
+    if (!backend_) {
+        throw std::invalid_argument("ChannelizerModule: backend cannot be null");
+    }
+
+    DRVGPU_LOG_INFO("ChannelizerModule", "Created (not initialized)");
+}
+
+ChannelizerModule::~ChannelizerModule() {
+    Cleanup();
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Жизненный цикл
+// ════════════════════════════════════════════════════════════════════════════
+
+void ChannelizerModule::Initialize() {
+    if (initialized_) {
+        DRVGPU_LOG_WARNING("ChannelizerModule", "Already initialized");
+        return;
+    }
+
+    DRVGPU_LOG_INFO("ChannelizerModule", "Initializing...");
+
+    context_ = static_cast<cl_context>(backend_->GetNativeContext());
+    device_ = static_cast<cl_device_id>(backend_->GetNativeDevice());
+    queue_ = static_cast<cl_command_queue>(backend_->GetNativeQueue());
+
+    if (!context_ || !device_ || !queue_) {
+        throw std::runtime_error("ChannelizerModule: Invalid OpenCL handles from backend");
+    }
+
+    // Лимиты устройства: __constant под коэффициенты, __local под тайлы
+    clGetDeviceInfo(device_, CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE,
+                    sizeof(max_constant_bytes_), &max_constant_bytes_, nullptr);
+    clGetDeviceInfo(device_, CL_DEVICE_LOCAL_MEM_SIZE,
+                    sizeof(local_mem_bytes_), &local_mem_bytes_, nullptr);
+    clGetDeviceInfo(device_, CL_DEVICE_MAX_WORK_GROUP_SIZE,
+                    sizeof(max_work_group_), &max_work_group_, nullptr);
+
+    CompileKernels();
+
+    initialized_ = true;
+    DRVGPU_LOG_INFO("ChannelizerModule", "Initialized successfully ✅ (constant: " +
+                    std::to_string(max_constant_bytes_ / 1024) + " KB, local: " +
+                    std::to_string(local_mem_bytes_ / 1024) + " KB)");
+}
+
+void ChannelizerModule::Cleanup() {
+    if (!initialized_) {
+        return;
+    }
+
+    DRVGPU_LOG_INFO("ChannelizerModule", "Cleanup...");
+
+    ReleaseBuffers();
+    ReleaseKernels();
+
+    initialized_ = false;
+    DRVGPU_LOG_INFO("ChannelizerModule", "Cleanup complete");
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Коэффициенты
+// ════════════════════════════════════════════════════════════════════════════
+
+void ChannelizerModule::SetTaps(const std::vector<std::complex<float>>& taps) {
+    if (!initialized_) {
+        throw std::runtime_error("ChannelizerModule: not initialized");
+    }
+    if (taps.empty()) {
+        throw std::invalid_argument("ChannelizerModule::SetTaps - empty filter");
+    }
+    const size_t bytes = taps.size() * sizeof(cl_float2);
+    if (bytes > max_constant_bytes_) {
+        throw std::invalid_argument(
+            "ChannelizerModule::SetTaps - " + std::to_string(taps.size()) +
+            " taps exceed device constant memory (" +
+            std::to_string(max_constant_bytes_) + " bytes)");
+    }
+
+    if (taps.size() > taps_capacity_) {
+        if (taps_buffer_) {
+            clReleaseMemObject(taps_buffer_);
+            taps_buffer_ = nullptr;
+        }
+        cl_int err;
+        taps_buffer_ = clCreateBuffer(context_, CL_MEM_READ_ONLY, bytes, nullptr, &err);
+        if (err != CL_SUCCESS || !taps_buffer_) {
+            taps_capacity_ = 0;
+            num_taps_ = 0;
+            throw std::runtime_error("ChannelizerModule: Failed to allocate taps buffer");
+        }
+        taps_capacity_ = taps.size();
+    }
+
+    // Блокирующая запись: taps принадлежит вызывающему
+    cl_int err = clEnqueueWriteBuffer(queue_, taps_buffer_, CL_TRUE, 0, bytes,
+                                      taps.data(), 0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        num_taps_ = 0;
+        throw std::runtime_error("ChannelizerModule: Failed to upload taps");
+    }
+
+    num_taps_ = static_cast<uint32_t>(taps.size());
+    DRVGPU_LOG_DEBUG("ChannelizerModule", "Taps: " + std::to_string(num_taps_));
+}
+
+void ChannelizerModule::SetTaps(const std::vector<float>& taps) {
+    std::vector<std::complex<float>> complex_taps(taps.begin(), taps.end());
+    SetTaps(complex_taps);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Децимация
+// ════════════════════════════════════════════════════════════════════════════
+
+void ChannelizerModule::Decimate(
+    const ChannelizerParams& params,
+    uint32_t decimation,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> output)
+{
+    if (!input || !output) {
+        throw std::invalid_argument("ChannelizerModule::Decimate - buffer is null");
+    }
+    ValidateParams(params);
+    if (decimation == 0) {
+        throw std::invalid_argument("ChannelizerModule::Decimate - decimation == 0");
+    }
+    const size_t beams = params.num_beams;
+    if (input->GetNumElements() < beams * params.count_points) {
+        throw std::invalid_argument("ChannelizerModule::Decimate - input buffer too small");
+    }
+    if (output->GetNumElements() < beams * GetOutputPoints(params.count_points, decimation)) {
+        throw std::invalid_argument("ChannelizerModule::Decimate - output buffer too small");
+    }
+
+    DecimateAsync(params, decimation, static_cast<cl_mem>(input->GetPtr()),
+                  static_cast<cl_mem>(output->GetPtr()), nullptr);
+
+    clFinish(queue_); // Ждём завершения
+}
+
+void ChannelizerModule::DecimateAsync(
+    const ChannelizerParams& params,
+    uint32_t decimation,
+    cl_mem input,
+    cl_mem output,
+    cl_event* out_event)
+{
+    CheckReady();
+    ValidateParams(params);
+    if (decimation == 0) {
+        throw std::invalid_argument("ChannelizerModule::DecimateAsync - decimation == 0");
+    }
+    if (input == output) {
+        throw std::invalid_argument("ChannelizerModule::DecimateAsync - input == output");
+    }
+
+    const size_t tile = SelectDecimateTile(decimation);
+    const size_t span_bytes = ((tile - 1) * decimation + num_taps_) * sizeof(cl_float2);
+
+    cl_uint num_taps = num_taps_;
+    cl_uint factor = decimation;
+    cl_uint count_points = params.count_points;
+    cl_uint out_points = GetOutputPoints(params.count_points, decimation);
+
+    cl_int err;
+    err = clSetKernelArg(kernel_decimate_, 0, sizeof(cl_mem), &input);
+    err |= clSetKernelArg(kernel_decimate_, 1, sizeof(cl_mem), &output);
+    err |= clSetKernelArg(kernel_decimate_, 2, sizeof(cl_mem), &taps_buffer_);
+    err |= clSetKernelArg(kernel_decimate_, 3, span_bytes, nullptr);
+    err |= clSetKernelArg(kernel_decimate_, 4, sizeof(cl_uint), &num_taps);
+    err |= clSetKernelArg(kernel_decimate_, 5, sizeof(cl_uint), &factor);
+    err |= clSetKernelArg(kernel_decimate_, 6, sizeof(cl_uint), &count_points);
+    err |= clSetKernelArg(kernel_decimate_, 7, sizeof(cl_uint), &out_points);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("ChannelizerModule::DecimateAsync - Failed to set kernel args");
+    }
+
+    size_t global_size[2] = {
+        ((out_points + tile - 1) / tile) * tile,
+        params.num_beams
+    };
+    size_t local_size[2] = { tile, 1 };
+
+    err = clEnqueueNDRangeKernel(queue_, kernel_decimate_, 2, nullptr,
+                                 global_size, local_size, 0, nullptr, out_event);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("ChannelizerModule::DecimateAsync - Failed to enqueue kernel");
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Канализация
+// ════════════════════════════════════════════════════════════════════════════
+
+void ChannelizerModule::Channelize(
+    const ChannelizerParams& params,
+    uint32_t num_channels,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> output)
+{
+    if (!input || !output) {
+        throw std::invalid_argument("ChannelizerModule::Channelize - buffer is null");
+    }
+    ValidateParams(params);
+    if (num_channels == 0) {
+        throw std::invalid_argument("ChannelizerModule::Channelize - num_channels == 0");
+    }
+    const size_t beams = params.num_beams;
+    if (input->GetNumElements() < beams * params.count_points) {
+        throw std::invalid_argument("ChannelizerModule::Channelize - input buffer too small");
+    }
+    if (output->GetNumElements() <
+        beams * num_channels * GetOutputPoints(params.count_points, num_channels)) {
+        throw std::invalid_argument("ChannelizerModule::Channelize - output buffer too small");
+    }
+
+    ChannelizeAsync(params, num_channels, static_cast<cl_mem>(input->GetPtr()),
+                    static_cast<cl_mem>(output->GetPtr()), nullptr);
+
+    clFinish(queue_); // Ждём завершения
+}
+
+void ChannelizerModule::ChannelizeAsync(
+    const ChannelizerParams& params,
+    uint32_t num_channels,
+    cl_mem input,
+    cl_mem output,
+    cl_event* out_event)
+{
+    CheckReady();
+    ValidateParams(params);
+    if (num_channels < 2 || num_channels > max_work_group_) {
+        throw std::invalid_argument(
+            "ChannelizerModule::ChannelizeAsync - num_channels must be in [2, " +
+            std::to_string(max_work_group_) + "]");
+    }
+    if (input == output) {
+        throw std::invalid_argument("ChannelizerModule::ChannelizeAsync - input == output");
+    }
+    if ((static_cast<cl_ulong>(num_taps_) + num_channels) * sizeof(cl_float2) >
+        max_constant_bytes_) {
+        throw std::invalid_argument(
+            "ChannelizerModule::ChannelizeAsync - taps + twiddles exceed constant memory");
+    }
+
+    EnsureTwiddles(num_channels);
+
+    cl_uint num_taps = num_taps_;
+    cl_uint channels = num_channels;
+    cl_uint count_points = params.count_points;
+    cl_uint out_points = GetOutputPoints(params.count_points, num_channels);
+
+    cl_int err;
+    err = clSetKernelArg(kernel_pfb_, 0, sizeof(cl_mem), &input);
+    err |= clSetKernelArg(kernel_pfb_, 1, sizeof(cl_mem), &output);
+    err |= clSetKernelArg(kernel_pfb_, 2, sizeof(cl_mem), &taps_buffer_);
+    err |= clSetKernelArg(kernel_pfb_, 3, sizeof(cl_mem), &twiddle_buffer_);
+    err |= clSetKernelArg(kernel_pfb_, 4, num_channels * sizeof(cl_float2), nullptr);
+    err |= clSetKernelArg(kernel_pfb_, 5, sizeof(cl_uint), &num_taps);
+    err |= clSetKernelArg(kernel_pfb_, 6, sizeof(cl_uint), &channels);
+    err |= clSetKernelArg(kernel_pfb_, 7, sizeof(cl_uint), &count_points);
+    err |= clSetKernelArg(kernel_pfb_, 8, sizeof(cl_uint), &out_points);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("ChannelizerModule::ChannelizeAsync - Failed to set kernel args");
+    }
+
+    size_t global_size[2] = {
+        static_cast<size_t>(out_points) * num_channels,
+        params.num_beams
+    };
+    size_t local_size[2] = { num_channels, 1 };
+
+    err = clEnqueueNDRangeKernel(queue_, kernel_pfb_, 2, nullptr,
+                                 global_size, local_size, 0, nullptr, out_event);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("ChannelizerModule::ChannelizeAsync - Failed to enqueue kernel");
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Буферы
+// ════════════════════════════════════════════════════════════════════════════
+
+void ChannelizerModule::ValidateParams(const ChannelizerParams& params) {
+    if (params.num_beams == 0 || params.count_points == 0) {
+        throw std::invalid_argument("ChannelizerModule: invalid ChannelizerParams");
+    }
+}
+
+void ChannelizerModule::CheckReady() const {
+    if (!initialized_) {
+        throw std::runtime_error("ChannelizerModule: not initialized");
+    }
+    if (!taps_buffer_ || num_taps_ == 0) {
+        throw std::runtime_error("ChannelizerModule: taps not set (SetTaps)");
+    }
+}
+
+size_t ChannelizerModule::SelectDecimateTile(uint32_t decimation) const {
+    // Наибольший тайл, участок входа которого помещается в локальную память
+    size_t tile = kMaxDecimateTile;
+    while (tile > max_work_group_) {
+        tile /= 2;
+    }
+    for (; tile >= 1; tile /= 2) {
+        const cl_ulong span_bytes =
+            ((tile - 1) * static_cast<cl_ulong>(decimation) + num_taps_) * sizeof(cl_float2);
+        if (span_bytes <= local_mem_bytes_) {
+            return tile;
+        }
+    }
+    throw std::invalid_argument(
+        "ChannelizerModule: filter of " + std::to_string(num_taps_) +
+        " taps does not fit device local memory");
+}
+
+void ChannelizerModule::EnsureTwiddles(uint32_t num_channels) {
+    if (twiddle_buffer_ && twiddle_channels_ == num_channels) {
+        return;
+    }
+    if (twiddle_buffer_) {
+        clReleaseMemObject(twiddle_buffer_);
+        twiddle_buffer_ = nullptr;
+        twiddle_channels_ = 0;
+    }
+
+    std::vector<std::complex<float>> twiddles(num_channels);
+    for (uint32_t q = 0; q < num_channels; ++q) {
+        const double ph = 2.0 * kPi * q / num_channels;
+        twiddles[q] = std::complex<float>(static_cast<float>(std::cos(ph)),
+                                          static_cast<float>(std::sin(ph)));
+    }
+
+    cl_int err;
+    twiddle_buffer_ = clCreateBuffer(context_, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                     num_channels * sizeof(cl_float2),
+                                     twiddles.data(), &err);
+    if (err != CL_SUCCESS || !twiddle_buffer_) {
+        twiddle_buffer_ = nullptr;
+        throw std::runtime_error("ChannelizerModule: Failed to allocate twiddle buffer");
+    }
+    twiddle_channels_ = num_channels;
+}
+
+void ChannelizerModule::ReleaseBuffers() {
+    if (taps_buffer_) {
+        clReleaseMemObject(taps_buffer_);
+        taps_buffer_ = nullptr;
+        taps_capacity_ = 0;
+    }
+    num_taps_ = 0;
+    if (twiddle_buffer_) {
+        clReleaseMemObject(twiddle_buffer_);
+        twiddle_buffer_ = nullptr;
+        twiddle_channels_ = 0;
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Утилиты
+// ════════════════════════════════════════════════════════════════════════════
+
+uint32_t ChannelizerModule::GetOutputPoints(uint32_t count_points, uint32_t factor) {
+    if (factor == 0) {
+        throw std::invalid_argument("ChannelizerModule: factor == 0");
+    }
+    return (count_points + factor - 1) / factor;
+}
+
+std::vector<float> ChannelizerModule::DesignLowpass(uint32_t num_taps, float cutoff) {
+    if (num_taps == 0 || !(cutoff > 0.0f && cutoff < 0.5f)) {
+        throw std::invalid_argument(
+            "ChannelizerModule::DesignLowpass - need num_taps > 0, 0 < cutoff < 0.5");
+    }
+
+    std::vector<double> h(num_taps);
+    const double center = 0.5 * (num_taps - 1);
+    double sum = 0.0;
+    for (uint32_t k = 0; k < num_taps; ++k) {
+        const double t = k - center;
+        const double sinc = (t == 0.0)
+            ? 2.0 * cutoff
+            : std::sin(2.0 * kPi * cutoff * t) / (kPi * t);
+        const double window = (num_taps > 1)
+            ? 0.54 - 0.46 * std::cos(2.0 * kPi * k / (num_taps - 1))
+            : 1.0;
+        h[k] = sinc * window;
+        sum += h[k];
+    }
+
+    std::vector<float> taps(num_taps);
+    for (uint32_t k = 0; k < num_taps; ++k) {
+        taps[k] = static_cast<float>(h[k] / sum);
+    }
+    return taps;
+}
+
+std::vector<std::complex<float>> ChannelizerModule::DecimateReferenceCPU(
+    const ChannelizerParams& params,
+    uint32_t decimation,
+    const std::vector<std::complex<float>>& taps,
+    const std::vector<std::complex<float>>& input)
+{
+    ValidateParams(params);
+    const size_t count = params.count_points;
+    if (taps.empty() || input.size() < params.num_beams * count) {
+        throw std::invalid_argument("ChannelizerModule::DecimateReferenceCPU - size mismatch");
+    }
+    const size_t out_points = GetOutputPoints(params.count_points, decimation);
+
+    std::vector<std::complex<float>> output(params.num_beams * out_points);
+
+    for (size_t b = 0; b < params.num_beams; ++b) {
+        const std::complex<float>* x = &input[b * count];
+        for (size_t m = 0; m < out_points; ++m) {
+            std::complex<double> acc(0.0, 0.0);
+            for (size_t k = 0; k < taps.size(); ++k) {
+                const long long idx = static_cast<long long>(m * decimation) -
+                                      static_cast<long long>(k);
+                if (idx < 0) break;
+                if (idx < static_cast<long long>(count)) {
+                    acc += std::complex<double>(taps[k]) * std::complex<double>(x[idx]);
+                }
+            }
+            output[b * out_points + m] = std::complex<float>(
+                static_cast<float>(acc.real()), static_cast<float>(acc.imag()));
+        }
+    }
+    return output;
+}
+
+std::vector<std::complex<float>> ChannelizerModule::ChannelizeReferenceCPU(
+    const ChannelizerParams& params,
+    uint32_t num_channels,
+    const std::vector<std::complex<float>>& taps,
+    const std::vector<std::complex<float>>& input)
+{
+    ValidateParams(params);
+    const size_t count = params.count_points;
+    if (taps.empty() || input.size() < params.num_beams * count) {
+        throw std::invalid_argument("ChannelizerModule::ChannelizeReferenceCPU - size mismatch");
+    }
+    const size_t out_points = GetOutputPoints(params.count_points, num_channels);
+
+    std::vector<std::complex<float>> output(params.num_beams * num_channels * out_points);
+
+    for (size_t b = 0; b < params.num_beams; ++b) {
+        const std::complex<float>* x = &input[b * count];
+        for (size_t c = 0; c < num_channels; ++c) {
+            for (size_t m = 0; m < out_points; ++m) {
+                std::complex<double> acc(0.0, 0.0);
+                for (size_t k = 0; k < taps.size(); ++k) {
+                    const long long idx = static_cast<long long>(m * num_channels) -
+                                          static_cast<long long>(k);
+                    if (idx < 0) break;
+                    if (idx < static_cast<long long>(count)) {
+                        const double ph = 2.0 * kPi * static_cast<double>((c * k) % num_channels) /
+                                          num_channels;
+                        acc += std::complex<double>(taps[k]) *
+                               std::complex<double>(std::cos(ph), std::sin(ph)) *
+                               std::complex<double>(x[idx]);
+                    }
+                }
+                output[(b * num_channels + c) * out_points + m] = std::complex<float>(
+                    static_cast<float>(acc.real()), static_cast<float>(acc.imag()));
+            }
+        }
+    }
+    return output;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Компиляция kernels
+// ════════════════════════════════════════════════════════════════════════════
+
+void ChannelizerModule::CompileKernels() {
+    std::string kernel_source = LoadKernelSource("channelizer.cl");
+
+    const char* source_ptr = kernel_source.c_str();
+    size_t source_size = kernel_source.size();
+
+    cl_int err;
+    program_ = clCreateProgramWithSource(context_, 1, &source_ptr, &source_size, &err);
+
+    if (err != CL_SUCCESS || !program_) {
+        throw std::runtime_error("ChannelizerModule: Failed to create program");
+    }
+
+    err = clBuildProgram(program_, 1, &device_, nullptr, nullptr, nullptr);
+
+    if (err != CL_SUCCESS) {
+        size_t log_size;
+        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+
+        std::vector<char> log(log_size);
+        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, log_size, log.data(), nullptr);
+
+        DRVGPU_LOG_ERROR("ChannelizerModule", "Kernel compilation failed:");
+        DRVGPU_LOG_ERROR("ChannelizerModule", std::string(log.data()));
+
+        clReleaseProgram(program_);
+        program_ = nullptr;
+
+        throw std::runtime_error("ChannelizerModule: Kernel compilation failed");
+    }
+
+    kernel_decimate_ = clCreateKernel(program_, "fir_decimate", &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create kernel: fir_decimate");
+    }
+
+    kernel_pfb_ = clCreateKernel(program_, "pfb_channelize", &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create kernel: pfb_channelize");
+    }
+
+    DRVGPU_LOG_INFO("ChannelizerModule", "Kernels compiled successfully ✅");
+}
+
+void ChannelizerModule::ReleaseKernels() {
+    if (kernel_decimate_) {
+        clReleaseKernel(kernel_decimate_);
+        kernel_decimate_ = nullptr;
+    }
+    if (kernel_pfb_) {
+        clReleaseKernel(kernel_pfb_);
+        kernel_pfb_ = nullptr;
+    }
+    if (program_) {
+        clReleaseProgram(program_);
+        program_ = nullptr;
+    }
+}
+
+std::string ChannelizerModule::LoadKernelSource(const std::string& filename) {
+    std::vector<std::string> search_paths = {
+        std::string(CHANNELIZER_KERNELS_PATH) + "/" + filename,
+        "modules/channelizer/kernels/" + filename,
+        "../modules/channelizer/kernels/" + filename,
+        "../../modules/channelizer/kernels/" + filename
+    };
+
+    for (const auto& path : search_paths) {
+        std::ifstream file(path);
+        if (file.is_open()) {
+            DRVGPU_LOG_DEBUG("ChannelizerModule", "Kernel loaded from: " + path);
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            return buffer.str();
+        }
+    }
+
+    DRVGPU_LOG_ERROR("ChannelizerModule", "Failed to load kernel: " + filename);
+    for (const auto& path : search_paths) {
+        DRVGPU_LOG_ERROR("ChannelizerModule", "  - " + path);
+    }
+
+    throw std::runtime_error("ChannelizerModule: Failed to load kernel source: " + filename);
+}
+
+} // namespace drv_gpu_lib
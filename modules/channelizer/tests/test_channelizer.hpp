@@ -0,0 +1,174 @@
+#pragma once
+/**
+ * @file test_channelizer.hpp
+ * @brief Тест ChannelizerModule: децимирующий КИХ и полифазная гребёнка на GPU
+ *
+ * fs = 12 МГц, 4 луча по 4001 отсчёту (не кратно D и M).
+ * 1. Децимация D = 8: GPU против DecimateReferenceCPU(), тон 0.3 МГц
+ *    проходит с амплитудой ≈ 1, помеха 4 МГц подавлена
+ * 2. Гребёнка M = 16: GPU против ChannelizeReferenceCPU(), тон в центре
+ *    канала 3 (2.25 МГц) попадает только в канал 3
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "channelizer_module.hpp"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <algorithm>
+#define _USE_MATH_DEFINES  // ✅ Windows: для M_PI
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace test_channelizer {
+
+using namespace drv_gpu_lib;
+
+inline std::complex<float> tone(double f, double fs, size_t n, double amp = 1.0) {
+    double ph = 2.0 * M_PI * f * n / fs;
+    return std::complex<float>(static_cast<float>(amp * std::cos(ph)),
+                               static_cast<float>(amp * std::sin(ph)));
+}
+
+inline float max_abs_error(const std::vector<std::complex<float>>& a,
+                           const std::vector<std::complex<float>>& b) {
+    float err = 0.0f;
+    for (size_t i = 0; i < b.size(); ++i) {
+        err = std::max(err, std::abs(a[i] - b[i]));
+    }
+    return err;
+}
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║   TEST: ChannelizerModule — децимация и гребёнка (ПФБ)   ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        auto module = std::make_shared<ChannelizerModule>(&gpu.GetBackend());
+        module->Initialize();
+        gpu.GetModuleRegistry().RegisterModule("Channelizer", module);
+
+        const double fs = 12.0e6;
+        ChannelizerParams params;
+        params.num_beams = 4;
+        params.count_points = 4001;
+
+        auto& mem_mgr = gpu.GetMemoryManager();
+        const size_t in_total = static_cast<size_t>(params.num_beams) * params.count_points;
+        bool passed = true;
+
+        // ── 1. Децимация ───────────────────────────────────────────────────
+        {
+            const uint32_t D = 8;
+            auto taps_real = ChannelizerModule::DesignLowpass(64, 0.5f / D);
+            std::vector<std::complex<float>> taps(taps_real.begin(), taps_real.end());
+            module->SetTaps(taps);
+
+            std::vector<std::complex<float>> input(in_total);
+            for (size_t b = 0; b < params.num_beams; ++b) {
+                for (size_t n = 0; n < params.count_points; ++n) {
+                    input[b * params.count_points + n] =
+                        tone(0.3e6, fs, n) + tone(4.0e6, fs, n, 0.5);
+                }
+            }
+
+            const uint32_t out_points = ChannelizerModule::GetOutputPoints(params.count_points, D);
+            auto gpu_in = mem_mgr.CreateBuffer<std::complex<float>>(input.data(), input.size());
+            auto gpu_out = mem_mgr.CreateBuffer<std::complex<float>>(
+                static_cast<size_t>(params.num_beams) * out_points);
+
+            module->Decimate(params, D, gpu_in, gpu_out);
+            auto result = gpu_out->Read();
+            auto reference = ChannelizerModule::DecimateReferenceCPU(params, D, taps, input);
+            float ref_error = max_abs_error(result, reference);
+
+            // Установившийся режим: после заполнения фильтра
+            float worst = 0.0f;
+            for (size_t b = 0; b < params.num_beams; ++b) {
+                for (size_t m = taps.size() / D + 1; m < out_points; ++m) {
+                    worst = std::max(worst, std::abs(std::abs(result[b * out_points + m]) - 1.0f));
+                }
+            }
+
+            bool ok = ref_error < 1.0e-5f && worst < 1.0e-2f;
+            passed &= ok;
+            std::cout << "  Децимация D = " << D << ": " << params.count_points << " → "
+                      << out_points << " отсчётов\n";
+            std::cout << std::scientific << std::setprecision(2)
+                      << "    max|GPU - CPU| = " << ref_error
+                      << ", max||y| - 1| = " << worst << "  " << (ok ? "✅" : "❌") << "\n\n";
+        }
+
+        // ── 2. Полифазная гребёнка ─────────────────────────────────────────
+        {
+            const uint32_t M = 16;
+            const uint32_t target = 3;
+            auto taps_real = ChannelizerModule::DesignLowpass(128, 0.5f / M);
+            std::vector<std::complex<float>> taps(taps_real.begin(), taps_real.end());
+            module->SetTaps(taps);
+
+            std::vector<std::complex<float>> input(in_total);
+            for (size_t b = 0; b < params.num_beams; ++b) {
+                for (size_t n = 0; n < params.count_points; ++n) {
+                    input[b * params.count_points + n] = tone(target * fs / M, fs, n);
+                }
+            }
+
+            const uint32_t out_points = ChannelizerModule::GetOutputPoints(params.count_points, M);
+            auto gpu_in = mem_mgr.CreateBuffer<std::complex<float>>(input.data(), input.size());
+            auto gpu_out = mem_mgr.CreateBuffer<std::complex<float>>(
+                static_cast<size_t>(params.num_beams) * M * out_points);
+
+            module->Channelize(params, M, gpu_in, gpu_out);
+            auto result = gpu_out->Read();
+            auto reference = ChannelizerModule::ChannelizeReferenceCPU(params, M, taps, input);
+            float ref_error = max_abs_error(result, reference);
+
+            // Отсчёт в установившемся режиме: |y_target| ≈ 1, остальные ≈ 0
+            const size_t m = out_points / 2;
+            float target_err = 0.0f;
+            float leakage = 0.0f;
+            for (size_t b = 0; b < params.num_beams; ++b) {
+                for (size_t c = 0; c < M; ++c) {
+                    float mag = std::abs(result[(b * M + c) * out_points + m]);
+                    if (c == target) {
+                        target_err = std::max(target_err, std::abs(mag - 1.0f));
+                    } else {
+                        leakage = std::max(leakage, mag);
+                    }
+                }
+            }
+
+            bool ok = ref_error < 1.0e-5f && target_err < 1.0e-2f && leakage < 1.0e-2f;
+            passed &= ok;
+            std::cout << "  Гребёнка M = " << M << ", тон в канале " << target << "\n";
+            std::cout << "    max|GPU - CPU| = " << ref_error
+                      << ", ||y_" << target << "| - 1| = " << target_err
+                      << ", утечка = " << leakage << "  " << (ok ? "✅" : "❌") << "\n\n";
+        }
+
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_channelizer
@@ -0,0 +1,154 @@
+#pragma once
+
+/**
+ * @file vector_expr.hpp
+ * @brief VectorExpr - цепочка поэлементных операций для слияния в один kernel
+ *
+ * Цепочка описывает, что сделать с каждым элементом входа:
+ * @code
+ * // out[i] = 10·log10(|in[i] · conj(ref[i]) · 0.5|²)
+ * VectorExpr expr(VectorDomain::Complex);
+ * expr.ConjMul().Scale(0.5f).Power().Db();
+ * module->Evaluate(expr, input, {ref}, output, n);
+ * @endcode
+ * VectorOpsModule генерирует по цепочке один OpenCL kernel (один проход
+ * по памяти) и кэширует его по Signature(). Значения скаляров в сигнатуру
+ * не входят — они передаются аргументами kernel.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+/**
+ * @enum VectorDomain
+ * @brief Тип элемента: complex<float> (float2) или float
+ */
+enum class VectorDomain {
+    Real,       ///< float
+    Complex     ///< complex<float>
+};
+
+/**
+ * @enum VectorOpType
+ * @brief Шаг цепочки
+ */
+enum class VectorOpType {
+    Mul,        ///< x · operand[k]               (тип operand = тип x)
+    ConjMul,    ///< x · conj(operand[k])         (только Complex)
+    Add,        ///< x + operand[k]               (тип operand = тип x)
+    Scale,      ///< x · s                        (s комплексный для Complex)
+    Magnitude,  ///< |x|                          (Complex → Real)
+    Power,      ///< |x|²                         (Complex → Real)
+    Db          ///< 10·log10(max(x, 1e-30))      (только Real, x — мощность)
+};
+
+/**
+ * @class VectorExpr
+ * @brief Описание цепочки поэлементных операций
+ *
+ * Операнды-буферы (Mul / ConjMul / Add) нумеруются по порядку появления
+ * в цепочке: первый такой шаг берёт operands[0], второй — operands[1] и т.д.
+ */
+class VectorExpr {
+public:
+    /**
+     * @struct Step
+     * @brief Один шаг цепочки
+     */
+    struct Step {
+        VectorOpType type;
+        VectorDomain domain;            ///< Тип x ДО шага
+        std::complex<float> scalar;     ///< Для Scale
+    };
+
+    explicit VectorExpr(VectorDomain input = VectorDomain::Complex)
+        : input_domain_(input), domain_(input), num_operands_(0) {}
+
+    VectorExpr& Mul() { return PushOperand(VectorOpType::Mul); }
+    VectorExpr& Add() { return PushOperand(VectorOpType::Add); }
+
+    VectorExpr& ConjMul() {
+        RequireDomain(VectorDomain::Complex, "ConjMul");
+        return PushOperand(VectorOpType::ConjMul);
+    }
+
+    VectorExpr& Scale(std::complex<float> s) {
+        if (domain_ == VectorDomain::Real && s.imag() != 0.0f) {
+            throw std::invalid_argument("VectorExpr::Scale - complex scalar on real data");
+        }
+        steps_.push_back({VectorOpType::Scale, domain_, s});
+        return *this;
+    }
+
+    VectorExpr& Scale(float s) { return Scale(std::complex<float>(s, 0.0f)); }
+
+    VectorExpr& Magnitude() { return PushReduce(VectorOpType::Magnitude, "Magnitude"); }
+    VectorExpr& Power() { return PushReduce(VectorOpType::Power, "Power"); }
+
+    VectorExpr& Db() {
+        RequireDomain(VectorDomain::Real, "Db");
+        steps_.push_back({VectorOpType::Db, domain_, {}});
+        return *this;
+    }
+
+    VectorDomain GetInputDomain() const { return input_domain_; }
+    VectorDomain GetOutputDomain() const { return domain_; }
+    size_t GetNumOperands() const { return num_operands_; }
+    const std::vector<Step>& GetSteps() const { return steps_; }
+    bool IsEmpty() const { return steps_.empty(); }
+
+    /**
+     * @brief Ключ кэша kernel: типы входа и шагов (без значений скаляров)
+     */
+    std::string Signature() const {
+        std::string sig = (input_domain_ == VectorDomain::Complex) ? "C" : "R";
+        for (const auto& step : steps_) {
+            switch (step.type) {
+                case VectorOpType::Mul:       sig += "*"; break;
+                case VectorOpType::ConjMul:   sig += "~"; break;
+                case VectorOpType::Add:       sig += "+"; break;
+                case VectorOpType::Scale:     sig += "s"; break;
+                case VectorOpType::Magnitude: sig += "m"; break;
+                case VectorOpType::Power:     sig += "p"; break;
+                case VectorOpType::Db:        sig += "d"; break;
+            }
+        }
+        return sig;
+    }
+
+private:
+    VectorDomain input_domain_;
+    VectorDomain domain_;               ///< Тип x после последнего шага
+    size_t num_operands_;
+    std::vector<Step> steps_;
+
+    void RequireDomain(VectorDomain required, const char* op) const {
+        if (domain_ != required) {
+            throw std::invalid_argument(std::string("VectorExpr::") + op +
+                                        " - wrong element type at this step");
+        }
+    }
+
+    VectorExpr& PushOperand(VectorOpType type) {
+        steps_.push_back({type, domain_, {}});
+        ++num_operands_;
+        return *this;
+    }
+
+    VectorExpr& PushReduce(VectorOpType type, const char* op) {
+        RequireDomain(VectorDomain::Complex, op);
+        steps_.push_back({type, domain_, {}});
+        domain_ = VectorDomain::Real;
+        return *this;
+    }
+};
+
+} // namespace drv_gpu_lib
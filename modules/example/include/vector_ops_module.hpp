@@ -8,6 +8,13 @@
  * - Добавление/вычитание скаляра
  * - Сложение двух векторов
  * - In-place и out-of-place варианты
+ * - Комплексные поэлементные операции (умножение, сопряжённое умножение,
+ *   масштаб, модуль, мощность, дБ)
+ * - Слияние цепочки операций (VectorExpr) в один JIT-kernel с кэшем
+ * - Векторизованные float4 / float8 grid-stride варианты float-операций
+ *   и бенчмарк пропускной способности памяти
+ * - Сегментированные редукции [segments × n]: сумма, среднее, энергия,
+ *   минимум/максимум с индексом
  * 
  * @author DrvGPU Team
  * @date 2026-02-03
@@ -18,12 +25,85 @@
 #include "i_compute_module.hpp"
 #include "i_backend.hpp"
 #include "memory/gpu_buffer.hpp"
+#include "vector_expr.hpp"
 #include <CL/cl.h>
+#include <complex>
+#include <cstdint>
+#include <initializer_list>
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace drv_gpu_lib {
 
+// ════════════════════════════════════════════════════════════════════════════
+// Варианты kernels и бенчмарк
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @enum VectorKernelVariant
+ * @brief Вариант kernel для float-операций (AddOne/SubOne/AddVectors)
+ */
+enum class VectorKernelVariant {
+    Auto,       ///< Выбор по размеру, выравниванию и устройству
+    Scalar,     ///< Один float на work-item, NDRange = n
+    Float4,     ///< float4, grid-stride, поэлементный хвост
+    Float8      ///< float8, grid-stride, поэлементный хвост
+};
+
+/**
+ * @struct VectorBandwidthEntry
+ * @brief Результат замера одной операции в одном варианте
+ */
+struct VectorBandwidthEntry {
+    std::string operation;              ///< "AddOneOut" / "AddVectorsOut"
+    VectorKernelVariant variant;        ///< Scalar / Float4 / Float8
+    double time_ms = 0.0;               ///< Среднее время запуска (мс)
+    double gbps = 0.0;                  ///< Достигнутая пропускная способность (ГБ/с)
+    double percent_of_peak = 0.0;       ///< gbps / peak_gbps · 100
+};
+
+/**
+ * @struct VectorBandwidthReport
+ * @brief Результат BenchmarkBandwidth()
+ */
+struct VectorBandwidthReport {
+    size_t size = 0;                    ///< Элементов float в векторе
+    double peak_gbps = 0.0;             ///< Опорная пиковая пропускная способность
+    bool peak_measured = false;         ///< true: пик измерен clEnqueueCopyBuffer
+    std::vector<VectorBandwidthEntry> entries;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Редукции
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @enum VectorReduceOp
+ * @brief Операция редукции сегмента
+ */
+enum class VectorReduceOp {
+    Sum,        ///< Σx
+    Mean,       ///< Σx / n
+    Energy,     ///< Σ|x|²
+    Min,        ///< min x (float) / min |x| (complex) + индекс
+    Max         ///< max x (float) / max |x| (complex) + индекс
+};
+
+/**
+ * @struct VectorReduceResult
+ * @brief Результат редукции одного сегмента (16 байт, формат буфера на GPU)
+ */
+struct VectorReduceResult {
+    std::complex<float> value;          ///< Sum/Mean: сумма/среднее (imag = 0 для float);
+                                        ///< Energy: Σ|x|²; Min/Max: x или |x|
+    uint32_t index = 0;                 ///< Min/Max: позиция в сегменте (первая при равенстве)
+    uint32_t reserved = 0;
+};
+
+static_assert(sizeof(VectorReduceResult) == 16, "VectorReduceResult must match vo_acc");
+
 // ════════════════════════════════════════════════════════════════════════════
 // Class: VectorOpsModule - Модуль операций с векторами
 // ════════════════════════════════════════════════════════════════════════════
@@ -46,6 +126,21 @@ namespace drv_gpu_lib {
  * - AddVectorsOut()     -> C[] = A[] + B[]
  * - AddVectorsInPlace() -> A[] = A[] + B[]
  * 
+ * **Комплексные операции:**
+ * - ComplexMultiplyOut() / ComplexConjMultiplyOut() -> C[] = A[] · B[] / A[] · conj(B[])
+ * - ComplexScaleInPlace() -> A[] = A[] · k
+ * - MagnitudeOut() / PowerOut() / PowerDbOut() -> |A|, |A|², 10·log10|A|²
+ * 
+ * **Слияние цепочек:**
+ * - Evaluate() -> произвольная VectorExpr за один проход по памяти
+ * 
+ * **Редукции:**
+ * - ReduceSegments() -> Sum / Mean / Energy / Min / Max по каждой строке
+ *   [segments × n] (например, по каждому лучу [beams × N])
+ * 
+ * Комплексные операции и Evaluate() собирают kernel по сигнатуре цепочки
+ * при первом вызове и берут его из кэша при последующих.
+ * 
  * Использование:
  * @code
  * // Создать и зарегистрировать модуль
@@ -105,9 +200,9 @@ public:
     // ═══════════════════════════════════════════════════════════════════════
     
     std::string GetName() const override { return "VectorOps"; }
-    std::string GetVersion() const override { return "1.0.0"; }
+    std::string GetVersion() const override { return "1.2.0"; }
     std::string GetDescription() const override {
-        return "Primitive vector operations (add, subtract, scalar operations)";
+        return "Real/complex elementwise vector operations, fused (JIT) op chains and segmented reductions";
     }
     
     IBackend* GetBackend() const override { return backend_; }
@@ -205,6 +300,198 @@ public:
         std::shared_ptr<GPUBuffer<float>> data_a,
         std::shared_ptr<GPUBuffer<float>> input_b,
         size_t size);
+    
+    // ═══════════════════════════════════════════════════════════════════════
+    // Комплексные операции
+    // ═══════════════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Комплексное умножение (out-of-place)
+     * 
+     * C[i] = A[i] · B[i]
+     */
+    void ComplexMultiplyOut(
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input_a,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input_b,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> output,
+        size_t size);
+    
+    /**
+     * @brief Умножение на сопряжённый вектор (out-of-place)
+     * 
+     * C[i] = A[i] · conj(B[i])
+     */
+    void ComplexConjMultiplyOut(
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input_a,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input_b,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> output,
+        size_t size);
+    
+    /**
+     * @brief Умножение на комплексный скаляр (in-place)
+     * 
+     * A[i] = A[i] · k
+     */
+    void ComplexScaleInPlace(
+        std::shared_ptr<GPUBuffer<std::complex<float>>> data,
+        std::complex<float> k,
+        size_t size);
+    
+    /**
+     * @brief Модуль: C[i] = |A[i]|
+     */
+    void MagnitudeOut(
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+        std::shared_ptr<GPUBuffer<float>> output,
+        size_t size);
+    
+    /**
+     * @brief Мощность: C[i] = |A[i]|²
+     */
+    void PowerOut(
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+        std::shared_ptr<GPUBuffer<float>> output,
+        size_t size);
+    
+    /**
+     * @brief Мощность в дБ: C[i] = 10·log10(|A[i]|²) (один проход)
+     */
+    void PowerDbOut(
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+        std::shared_ptr<GPUBuffer<float>> output,
+        size_t size);
+    
+    // ═══════════════════════════════════════════════════════════════════════
+    // Слияние цепочек операций
+    // ═══════════════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Выполнить цепочку операций одним kernel (блокирующий)
+     * 
+     * @param expr     Цепочка (тип входа/выхода — expr.GetInput/OutputDomain())
+     * @param input    Вход [size]
+     * @param operands Буферы-операнды по порядку (expr.GetNumOperands() штук)
+     * @param output   Выход [size] (может совпадать с input при одинаковом типе)
+     * @param size     Количество элементов
+     * @throws std::invalid_argument при пустой цепочке / неверном числе операндов
+     */
+    void Evaluate(
+        const VectorExpr& expr,
+        cl_mem input,
+        const std::vector<cl_mem>& operands,
+        cl_mem output,
+        size_t size);
+    
+    /**
+     * @brief То же, только постановка в очередь
+     * @param out_event [out] Событие завершения (опционально)
+     */
+    void EvaluateAsync(
+        const VectorExpr& expr,
+        cl_mem input,
+        const std::vector<cl_mem>& operands,
+        cl_mem output,
+        size_t size,
+        cl_event* out_event = nullptr);
+    
+    /**
+     * @brief Количество собранных kernels цепочек
+     */
+    size_t GetFusedCacheSize() const { return fused_cache_.size(); }
+    
+    /**
+     * @brief Исходный код kernel для цепочки (для отладки)
+     */
+    static std::string GenerateFusedSource(
+        const VectorExpr& expr,
+        const std::string& kernel_name);
+    
+    // ═══════════════════════════════════════════════════════════════════════
+    // Варианты kernels и бенчмарк
+    // ═══════════════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Задать вариант kernel для float-операций (по умолчанию Auto)
+     * 
+     * Auto: Scalar для коротких векторов, иначе float8 (если устройство
+     * предпочитает ширину ≥ 8) или float4. Если буферы не выровнены на
+     * ширину варианта (sub-buffer со смещением), берётся более узкий.
+     */
+    void SetKernelVariant(VectorKernelVariant variant) { variant_ = variant; }
+    VectorKernelVariant GetKernelVariant() const { return variant_; }
+    
+    /**
+     * @brief Вариант, выбранный последней float-операцией
+     */
+    VectorKernelVariant GetLastVariant() const { return last_variant_; }
+    
+    static const char* VariantName(VectorKernelVariant variant);
+    
+    /**
+     * @brief Замерить пропускную способность AddOneOut / AddVectorsOut во всех вариантах
+     * 
+     * Буферы выделяются внутри. Время — по часам хоста на iterations запусков.
+     * 
+     * @param size       Элементов float в векторе
+     * @param iterations Запусков на замер
+     * @param peak_gbps  Пик устройства (ГБ/с); 0 — измерить копированием буфера
+     */
+    VectorBandwidthReport BenchmarkBandwidth(
+        size_t size,
+        int iterations = 20,
+        double peak_gbps = 0.0);
+    
+    // ═══════════════════════════════════════════════════════════════════════
+    // Редукции
+    // ═══════════════════════════════════════════════════════════════════════
+    
+    /**
+     * @brief Редукция каждой строки [segments × n] (блокирующий)
+     * 
+     * Два прохода: группы сворачивают части строки в partials, затем одна
+     * группа на строку сворачивает partials. Внутри группы — sub-groups
+     * (если устройство поддерживает), иначе дерево в local memory.
+     * 
+     * @param op       Операция
+     * @param input    Данные [segments × n], строки подряд
+     * @param segments Количество строк (лучей)
+     * @param n        Элементов в строке
+     * @return Результат на каждую строку
+     */
+    std::vector<VectorReduceResult> ReduceSegments(
+        VectorReduceOp op,
+        std::shared_ptr<GPUBuffer<float>> input,
+        size_t segments,
+        size_t n);
+    
+    std::vector<VectorReduceResult> ReduceSegments(
+        VectorReduceOp op,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+        size_t segments,
+        size_t n);
+    
+    /**
+     * @brief То же, только постановка в очередь; результат остаётся на GPU
+     * 
+     * @param domain    Тип элемента input
+     * @param output    [segments] × VectorReduceResult (16 байт)
+     * @param out_event [out] Событие завершения (опционально)
+     */
+    void ReduceSegmentsAsync(
+        VectorReduceOp op,
+        VectorDomain domain,
+        cl_mem input,
+        cl_mem output,
+        size_t segments,
+        size_t n,
+        cl_event* out_event = nullptr);
+    
+    /**
+     * @brief true — редукция внутри группы идёт через sub_group_reduce_*
+     */
+    bool HasSubgroupReduce() const { return subgroups_; }
+    
+    static const char* ReduceOpName(VectorReduceOp op);
 
 private:
     // ═══════════════════════════════════════════════════════════════════════
@@ -227,6 +514,66 @@ private:
     cl_device_id device_;       ///< Кэш устройства
     cl_command_queue queue_;    ///< Кэш очереди команд
     
+    /**
+     * @struct FusedKernel
+     * @brief Собранный kernel цепочки
+     */
+    struct FusedKernel {
+        cl_program program = nullptr;
+        cl_kernel kernel = nullptr;
+    };
+    
+    /// Кэш kernels цепочек: VectorExpr::Signature() → kernel
+    std::unordered_map<std::string, FusedKernel> fused_cache_;
+    
+    /**
+     * @struct VectorizedKernels
+     * @brief Kernels одной ширины (float4 или float8)
+     */
+    struct VectorizedKernels {
+        cl_kernel scalar_out = nullptr;       ///< vector_scalar_out_vW
+        cl_kernel scalar_inplace = nullptr;   ///< vector_scalar_inplace_vW
+        cl_kernel add_out = nullptr;          ///< vector_add_vectors_out_vW
+        cl_kernel add_inplace = nullptr;      ///< vector_add_vectors_inplace_vW
+    };
+    
+    /**
+     * @enum VectorizedOp
+     * @brief float-операция для диспетчера вариантов
+     */
+    enum class VectorizedOp { ScalarOut, ScalarInPlace, AddOut, AddInPlace };
+    
+    VectorizedKernels kernels_v4_;          ///< float4 варианты
+    VectorizedKernels kernels_v8_;          ///< float8 варианты
+    VectorKernelVariant variant_;           ///< Заданный вариант
+    VectorKernelVariant last_variant_;      ///< Вариант последнего запуска
+    
+    cl_uint compute_units_;                 ///< CL_DEVICE_MAX_COMPUTE_UNITS
+    size_t max_work_group_;                 ///< CL_DEVICE_MAX_WORK_GROUP_SIZE
+    cl_uint preferred_float_width_;         ///< CL_DEVICE_PREFERRED_VECTOR_WIDTH_FLOAT
+    
+    /**
+     * @struct ReduceKernels
+     * @brief Программа редукции для пары (операция, тип элемента)
+     */
+    struct ReduceKernels {
+        cl_program program = nullptr;
+        cl_kernel partial = nullptr;        ///< vector_reduce_partial
+        cl_kernel finalize = nullptr;       ///< vector_reduce_final
+        size_t local_size = 1;              ///< Степень двойки ≤ лимита kernel
+    };
+    
+    /// Кэш программ редукции: op · 2 + complex → kernels
+    std::unordered_map<int, ReduceKernels> reduce_cache_;
+    
+    bool subgroups_;                        ///< cl_khr_subgroups / cl_intel_subgroups
+    std::string subgroup_options_;          ///< Опции сборки для sub-groups
+    
+    cl_mem reduce_partials_;                ///< partials [segments × groups]
+    size_t reduce_partials_bytes_;
+    cl_mem reduce_output_;                  ///< Результат блокирующего ReduceSegments
+    size_t reduce_output_bytes_;
+    
     // ═══════════════════════════════════════════════════════════════════════
     // Приватные методы
     // ═══════════════════════════════════════════════════════════════════════
@@ -236,6 +583,65 @@ private:
      */
     void CompileKernels();
     
+    /**
+     * @brief Собрать программу из исходного кода (с логом ошибок компиляции)
+     */
+    cl_program BuildProgram(const std::string& source, const std::string& options = "");
+    
+    /**
+     * @brief Kernel цепочки из кэша (собирается при первом обращении)
+     */
+    cl_kernel GetFusedKernel(const VectorExpr& expr);
+    
+    /**
+     * @brief Освободить kernels цепочек
+     */
+    void ReleaseFusedKernels();
+    
+    /**
+     * @brief Создать / освободить float4 и float8 kernels
+     */
+    void CreateVectorizedKernels();
+    void ReleaseVectorizedKernels();
+    
+    /**
+     * @brief Выбрать вариант для операции над буферами mems
+     */
+    VectorKernelVariant SelectVariant(size_t size, std::initializer_list<cl_mem> mems) const;
+    
+    /**
+     * @brief Запустить векторизованный вариант, если он выбран
+     * @return false — выбран Scalar, вызывающий запускает свой kernel сам
+     */
+    bool EnqueueVectorized(VectorizedOp op, cl_mem a, cl_mem b, cl_mem out,
+                           float value, size_t size);
+    
+    /**
+     * @brief Запустить операцию в заданном варианте (без ожидания)
+     */
+    void EnqueueVariant(VectorizedOp op, VectorKernelVariant variant,
+                        cl_mem a, cl_mem b, cl_mem out, float value, size_t size);
+    
+    /**
+     * @brief Определить поддержку sub-groups (вызывается из Initialize)
+     */
+    void DetectSubgroups();
+    
+    /**
+     * @brief Kernels редукции из кэша (собираются при первом обращении)
+     */
+    const ReduceKernels& GetReduceKernels(VectorReduceOp op, VectorDomain domain);
+    
+    /**
+     * @brief Буфер не меньше bytes (пересоздаётся только при росте)
+     */
+    cl_mem EnsureScratch(cl_mem& mem, size_t& capacity, size_t bytes);
+    
+    /**
+     * @brief Освободить kernels и буферы редукций
+     */
+    void ReleaseReduceResources();
+    
     /**
      * @brief Создать kernel объекты из программы
      */
@@ -11,6 +11,10 @@
  * 1. Out-of-place: результат записывается в новый вектор C[]
  * 2. In-place: результат перезаписывает входной вектор A[]
  * 
+ * Для каждой операции есть поэлементный вариант (один float на work-item)
+ * и векторизованные float4 / float8 grid-stride варианты (раздел 4);
+ * вариант выбирает хост по размеру и выравниванию буферов.
+ * 
  * @author DrvGPU Team
  * @date 2026-02-03
  */
@@ -150,3 +154,91 @@ __kernel void vector_add_vectors_inplace(
         data_a[gid] = data_a[gid] + input_b[gid];
     }
 }
+
+// ════════════════════════════════════════════════════════════════════════════
+// 4. Векторизованные варианты (float4 / float8, grid-stride)
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Каждый work-item обрабатывает по W элементов за раз (одно чтение floatW)
+ * и шагает по массиву с шагом get_global_size(0), поэтому NDRange не обязан
+ * покрывать весь вектор — хост запускает столько work-items, сколько
+ * устройство держит одновременно.
+ *
+ * Хвост n % W (< W элементов) обрабатывают первые work-items поэлементно.
+ * Буферы должны быть выровнены на sizeof(floatW) — проверяет хост.
+ *
+ * Сложение/вычитание скаляра — один kernel с аргументом value (+1 / -1).
+ *
+ * @param n Размер вектора в элементах float
+ */
+#define VECTOR_OPS_DEFINE_VECTORIZED(W)                                        \
+__kernel void vector_scalar_out_v##W(                                          \
+    __global const float##W* input,                                            \
+    __global float##W* output,                                                 \
+    const float value,                                                         \
+    const uint n)                                                              \
+{                                                                              \
+    const uint n_vec = n / W;                                                  \
+    const uint stride = get_global_size(0);                                    \
+    for (uint i = get_global_id(0); i < n_vec; i += stride) {                  \
+        output[i] = input[i] + value;                                          \
+    }                                                                          \
+    const uint t = n_vec * W + get_global_id(0);                               \
+    if (t < n) {                                                               \
+        ((__global float*)output)[t] = ((__global const float*)input)[t] + value; \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+__kernel void vector_scalar_inplace_v##W(                                      \
+    __global float##W* data,                                                   \
+    const float value,                                                         \
+    const uint n)                                                              \
+{                                                                              \
+    const uint n_vec = n / W;                                                  \
+    const uint stride = get_global_size(0);                                    \
+    for (uint i = get_global_id(0); i < n_vec; i += stride) {                  \
+        data[i] += value;                                                      \
+    }                                                                          \
+    const uint t = n_vec * W + get_global_id(0);                               \
+    if (t < n) {                                                               \
+        ((__global float*)data)[t] += value;                                   \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+__kernel void vector_add_vectors_out_v##W(                                     \
+    __global const float##W* input_a,                                          \
+    __global const float##W* input_b,                                          \
+    __global float##W* output,                                                 \
+    const uint n)                                                              \
+{                                                                              \
+    const uint n_vec = n / W;                                                  \
+    const uint stride = get_global_size(0);                                    \
+    for (uint i = get_global_id(0); i < n_vec; i += stride) {                  \
+        output[i] = input_a[i] + input_b[i];                                   \
+    }                                                                          \
+    const uint t = n_vec * W + get_global_id(0);                               \
+    if (t < n) {                                                               \
+        ((__global float*)output)[t] = ((__global const float*)input_a)[t] +   \
+                                       ((__global const float*)input_b)[t];    \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+__kernel void vector_add_vectors_inplace_v##W(                                 \
+    __global float##W* data_a,                                                 \
+    __global const float##W* input_b,                                          \
+    const uint n)                                                              \
+{                                                                              \
+    const uint n_vec = n / W;                                                  \
+    const uint stride = get_global_size(0);                                    \
+    for (uint i = get_global_id(0); i < n_vec; i += stride) {                  \
+        data_a[i] += input_b[i];                                               \
+    }                                                                          \
+    const uint t = n_vec * W + get_global_id(0);                               \
+    if (t < n) {                                                               \
+        ((__global float*)data_a)[t] += ((__global const float*)input_b)[t];   \
+    }                                                                          \
+}
+
+VECTOR_OPS_DEFINE_VECTORIZED(4)
+VECTOR_OPS_DEFINE_VECTORIZED(8)
@@ -0,0 +1,207 @@
+// ════════════════════════════════════════════════════════════════════════════
+// vector_reduce.cl - Сегментированные редукции [segments × n]
+//
+// Собирается отдельно на каждую пару (операция, тип элемента):
+//   VO_REDUCE_OP      0 Sum, 1 Mean, 2 Energy, 3 Min, 4 Max
+//   VO_COMPLEX        0 float, 1 float2 (complex)
+//   VO_USE_SUBGROUPS  1 — редукция внутри группы через sub_group_reduce_*
+//
+// Два прохода:
+//   1. vector_reduce_partial: группа (g, segment) сворачивает свою часть
+//      сегмента (grid-stride внутри сегмента) → partials[segment][g]
+//   2. vector_reduce_final: одна группа на сегмент сворачивает partials
+//      → output[segment] (+ деление на n для Mean, sqrt для Min/Max complex)
+//
+// Min/Max: при равных значениях берётся меньший индекс (как std::min_element).
+// Для complex сравнивается |x|, в результат пишется |x|.
+// ════════════════════════════════════════════════════════════════════════════
+
+#ifndef VO_REDUCE_OP
+#define VO_REDUCE_OP 0
+#endif
+
+#ifndef VO_COMPLEX
+#define VO_COMPLEX 0
+#endif
+
+#ifndef VO_USE_SUBGROUPS
+#define VO_USE_SUBGROUPS 0
+#endif
+
+#if VO_USE_SUBGROUPS && defined(cl_khr_subgroups)
+#pragma OPENCL EXTENSION cl_khr_subgroups : enable
+#endif
+
+#define VO_OP_SUM    0
+#define VO_OP_MEAN   1
+#define VO_OP_ENERGY 2
+#define VO_OP_MIN    3
+#define VO_OP_MAX    4
+
+#define VO_NO_INDEX  0xFFFFFFFFu
+
+#if VO_COMPLEX
+typedef float2 vo_elem;
+#else
+typedef float vo_elem;
+#endif
+
+// Частичный результат (16 байт, совпадает с VectorReduceResult на хосте)
+//   Sum/Mean:   v = (re, im)
+//   Energy:     v.x = Σ|x|²
+//   Min/Max:    v.x = ключ сравнения (x или |x|²), idx = позиция в сегменте
+typedef struct {
+    float2 v;
+    uint idx;
+    uint pad;
+} vo_acc;
+
+inline vo_acc vo_identity(void) {
+    vo_acc a;
+    a.v = (float2)(0.0f, 0.0f);
+    a.idx = VO_NO_INDEX;
+    a.pad = 0;
+#if VO_REDUCE_OP == VO_OP_MIN
+    a.v.x = INFINITY;
+#elif VO_REDUCE_OP == VO_OP_MAX
+    a.v.x = -INFINITY;
+#endif
+    return a;
+}
+
+inline vo_acc vo_load(vo_elem x, uint i) {
+    vo_acc a;
+    a.idx = i;
+    a.pad = 0;
+#if VO_REDUCE_OP == VO_OP_SUM || VO_REDUCE_OP == VO_OP_MEAN
+  #if VO_COMPLEX
+    a.v = x;
+  #else
+    a.v = (float2)(x, 0.0f);
+  #endif
+#elif VO_COMPLEX
+    a.v = (float2)(x.x * x.x + x.y * x.y, 0.0f);
+#elif VO_REDUCE_OP == VO_OP_ENERGY
+    a.v = (float2)(x * x, 0.0f);
+#else
+    a.v = (float2)(x, 0.0f);
+#endif
+    return a;
+}
+
+inline vo_acc vo_combine(vo_acc a, vo_acc b) {
+#if VO_REDUCE_OP == VO_OP_MIN
+    return (b.v.x < a.v.x || (b.v.x == a.v.x && b.idx < a.idx)) ? b : a;
+#elif VO_REDUCE_OP == VO_OP_MAX
+    return (b.v.x > a.v.x || (b.v.x == a.v.x && b.idx < a.idx)) ? b : a;
+#else
+    a.v += b.v;
+    return a;
+#endif
+}
+
+#if VO_USE_SUBGROUPS
+inline vo_acc vo_sub_group_reduce(vo_acc a) {
+#if VO_REDUCE_OP == VO_OP_MIN || VO_REDUCE_OP == VO_OP_MAX
+  #if VO_REDUCE_OP == VO_OP_MIN
+    const float best = sub_group_reduce_min(a.v.x);
+  #else
+    const float best = sub_group_reduce_max(a.v.x);
+  #endif
+    a.idx = sub_group_reduce_min(a.v.x == best ? a.idx : VO_NO_INDEX);
+    a.v.x = best;
+#else
+    a.v.x = sub_group_reduce_add(a.v.x);
+    a.v.y = sub_group_reduce_add(a.v.y);
+#endif
+    return a;
+}
+#endif
+
+// Редукция внутри work-group; результат действителен в local_id == 0.
+// Без sub-groups размер группы — степень двойки (задаёт хост).
+inline vo_acc vo_group_reduce(vo_acc a, __local vo_acc* scratch) {
+    const uint lid = get_local_id(0);
+#if VO_USE_SUBGROUPS
+    a = vo_sub_group_reduce(a);
+    if (get_sub_group_local_id() == 0) {
+        scratch[get_sub_group_id()] = a;
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (lid == 0) {
+        const uint num = get_num_sub_groups();
+        for (uint s = 1; s < num; ++s) {
+            a = vo_combine(a, scratch[s]);
+        }
+    }
+    return a;
+#else
+    scratch[lid] = a;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for (uint s = get_local_size(0) / 2; s > 0; s >>= 1) {
+        if (lid < s) {
+            scratch[lid] = vo_combine(scratch[lid], scratch[lid + s]);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    return scratch[0];
+#endif
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Проход 1: NDRange (groups_per_segment · local, segments), local (local, 1)
+// ════════════════════════════════════════════════════════════════════════════
+
+__kernel void vector_reduce_partial(
+    __global const vo_elem* input,
+    __global vo_acc* partials,
+    __local vo_acc* scratch,
+    const uint n,
+    const uint groups_per_segment)
+{
+    const uint segment = get_group_id(1);
+    const uint group = get_group_id(0);
+    const uint local_size = get_local_size(0);
+    __global const vo_elem* row = input + (size_t)segment * n;
+
+    vo_acc a = vo_identity();
+    const uint stride = groups_per_segment * local_size;
+    for (uint i = group * local_size + get_local_id(0); i < n; i += stride) {
+        a = vo_combine(a, vo_load(row[i], i));
+    }
+
+    a = vo_group_reduce(a, scratch);
+    if (get_local_id(0) == 0) {
+        partials[segment * groups_per_segment + group] = a;
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Проход 2: NDRange (local · segments), local (local) — группа на сегмент
+// ════════════════════════════════════════════════════════════════════════════
+
+__kernel void vector_reduce_final(
+    __global const vo_acc* partials,
+    __global vo_acc* output,
+    __local vo_acc* scratch,
+    const uint n,
+    const uint groups_per_segment)
+{
+    const uint segment = get_group_id(0);
+    __global const vo_acc* row = partials + segment * groups_per_segment;
+
+    vo_acc a = vo_identity();
+    for (uint g = get_local_id(0); g < groups_per_segment; g += get_local_size(0)) {
+        a = vo_combine(a, row[g]);
+    }
+
+    a = vo_group_reduce(a, scratch);
+    if (get_local_id(0) == 0) {
+#if VO_REDUCE_OP == VO_OP_MEAN
+        a.v /= (float)n;
+#elif VO_COMPLEX && (VO_REDUCE_OP == VO_OP_MIN || VO_REDUCE_OP == VO_OP_MAX)
+        a.v.x = sqrt(a.v.x);
+#endif
+        output[segment] = a;
+    }
+}
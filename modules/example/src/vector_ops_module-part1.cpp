@@ -29,6 +29,16 @@ VectorOpsModule::VectorOpsModule(IBackend* backend)
     , context_(nullptr)
     , device_(nullptr)
     , queue_(nullptr)
+    , variant_(VectorKernelVariant::Auto)
+    , last_variant_(VectorKernelVariant::Scalar)
+    , compute_units_(1)
+    , max_work_group_(1)
+    , preferred_float_width_(1)
+    , subgroups_(false)
+    , reduce_partials_(nullptr)
+    , reduce_partials_bytes_(0)
+    , reduce_output_(nullptr)
+    , reduce_output_bytes_(0)
 {
     if (!backend_) {
         throw std::invalid_argument("VectorOpsModule: backend cannot be null");
@@ -62,6 +72,15 @@ void VectorOpsModule::Initialize() {
         throw std::runtime_error("VectorOpsModule: Invalid OpenCL handles from backend");
     }
     
+    // Параметры устройства для выбора варианта kernels
+    clGetDeviceInfo(device_, CL_DEVICE_MAX_COMPUTE_UNITS,
+                    sizeof(compute_units_), &compute_units_, nullptr);
+    clGetDeviceInfo(device_, CL_DEVICE_MAX_WORK_GROUP_SIZE,
+                    sizeof(max_work_group_), &max_work_group_, nullptr);
+    clGetDeviceInfo(device_, CL_DEVICE_PREFERRED_VECTOR_WIDTH_FLOAT,
+                    sizeof(preferred_float_width_), &preferred_float_width_, nullptr);
+    DetectSubgroups();
+    
     // Компилируем kernels
     CompileKernels();
     
@@ -106,6 +125,11 @@ void VectorOpsModule::AddOneOut(
     cl_mem output_mem = static_cast<cl_mem>(output->GetPtr());
     int n = static_cast<int>(size);
     
+    if (EnqueueVectorized(VectorizedOp::ScalarOut, input_mem, nullptr, output_mem, 1.0f, size)) {
+        clFinish(queue_);
+        return;
+    }
+    
     // Устанавливаем аргументы kernel
     cl_int err;
     err = clSetKernelArg(kernel_add_one_out_, 0, sizeof(cl_mem), &input_mem);
@@ -139,6 +163,11 @@ void VectorOpsModule::AddOneInPlace(
     cl_mem data_mem = static_cast<cl_mem>(data->GetPtr());
     int n = static_cast<int>(size);
     
+    if (EnqueueVectorized(VectorizedOp::ScalarInPlace, data_mem, nullptr, data_mem, 1.0f, size)) {
+        clFinish(queue_);
+        return;
+    }
+    
     cl_int err;
     err = clSetKernelArg(kernel_add_one_inplace_, 0, sizeof(cl_mem), &data_mem);
     err |= clSetKernelArg(kernel_add_one_inplace_, 1, sizeof(int), &n);
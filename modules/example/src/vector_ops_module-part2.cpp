@@ -24,6 +24,11 @@ void VectorOpsModule::SubOneOut(
     cl_mem output_mem = static_cast<cl_mem>(output->GetPtr());
     int n = static_cast<int>(size);
     
+    if (EnqueueVectorized(VectorizedOp::ScalarOut, input_mem, nullptr, output_mem, -1.0f, size)) {
+        clFinish(queue_);
+        return;
+    }
+    
     cl_int err;
     err = clSetKernelArg(kernel_sub_one_out_, 0, sizeof(cl_mem), &input_mem);
     err |= clSetKernelArg(kernel_sub_one_out_, 1, sizeof(cl_mem), &output_mem);
@@ -55,6 +60,11 @@ void VectorOpsModule::SubOneInPlace(
     cl_mem data_mem = static_cast<cl_mem>(data->GetPtr());
     int n = static_cast<int>(size);
     
+    if (EnqueueVectorized(VectorizedOp::ScalarInPlace, data_mem, nullptr, data_mem, -1.0f, size)) {
+        clFinish(queue_);
+        return;
+    }
+    
     cl_int err;
     err = clSetKernelArg(kernel_sub_one_inplace_, 0, sizeof(cl_mem), &data_mem);
     err |= clSetKernelArg(kernel_sub_one_inplace_, 1, sizeof(int), &n);
@@ -90,6 +100,11 @@ void VectorOpsModule::AddVectorsOut(
     cl_mem out_mem = static_cast<cl_mem>(output->GetPtr());
     int n = static_cast<int>(size);
     
+    if (EnqueueVectorized(VectorizedOp::AddOut, a_mem, b_mem, out_mem, 0.0f, size)) {
+        clFinish(queue_);
+        return;
+    }
+    
     cl_int err;
     err = clSetKernelArg(kernel_add_vectors_out_, 0, sizeof(cl_mem), &a_mem);
     err |= clSetKernelArg(kernel_add_vectors_out_, 1, sizeof(cl_mem), &b_mem);
@@ -124,6 +139,11 @@ void VectorOpsModule::AddVectorsInPlace(
     cl_mem b_mem = static_cast<cl_mem>(input_b->GetPtr());
     int n = static_cast<int>(size);
     
+    if (EnqueueVectorized(VectorizedOp::AddInPlace, a_mem, b_mem, a_mem, 0.0f, size)) {
+        clFinish(queue_);
+        return;
+    }
+    
     cl_int err;
     err = clSetKernelArg(kernel_add_vectors_inplace_, 0, sizeof(cl_mem), &a_mem);
     err |= clSetKernelArg(kernel_add_vectors_inplace_, 1, sizeof(cl_mem), &b_mem);
@@ -153,37 +173,43 @@ void VectorOpsModule::CompileKernels() {
     DRVGPU_LOG_DEBUG("VectorOpsModule", "Kernel source loaded (" + 
                      std::to_string(kernel_source.size()) + " bytes)");
     
-    const char* source_ptr = kernel_source.c_str();
-    size_t source_size = kernel_source.size();
+    DRVGPU_LOG_INFO("VectorOpsModule", "Compiling kernels...");
+    
+    program_ = BuildProgram(kernel_source);
+    
+    DRVGPU_LOG_INFO("VectorOpsModule", "Kernels compiled successfully ✅");
+}
+
+cl_program VectorOpsModule::BuildProgram(const std::string& source, const std::string& options) {
+    const char* source_ptr = source.c_str();
+    size_t source_size = source.size();
     
     cl_int err;
-    program_ = clCreateProgramWithSource(context_, 1, &source_ptr, &source_size, &err);
+    cl_program program = clCreateProgramWithSource(context_, 1, &source_ptr, &source_size, &err);
     
-    if (err != CL_SUCCESS || !program_) {
+    if (err != CL_SUCCESS || !program) {
         throw std::runtime_error("VectorOpsModule: Failed to create program");
     }
     
-    DRVGPU_LOG_INFO("VectorOpsModule", "Compiling kernels...");
-    
-    err = clBuildProgram(program_, 1, &device_, nullptr, nullptr, nullptr);
+    err = clBuildProgram(program, 1, &device_,
+                         options.empty() ? nullptr : options.c_str(), nullptr, nullptr);
     
     if (err != CL_SUCCESS) {
         size_t log_size;
-        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+        clGetProgramBuildInfo(program, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
         
         std::vector<char> log(log_size);
-        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, log_size, log.data(), nullptr);
+        clGetProgramBuildInfo(program, device_, CL_PROGRAM_BUILD_LOG, log_size, log.data(), nullptr);
         
         DRVGPU_LOG_ERROR("VectorOpsModule", "Kernel compilation failed:");
         DRVGPU_LOG_ERROR("VectorOpsModule", std::string(log.data()));
         
-        clReleaseProgram(program_);
-        program_ = nullptr;
+        clReleaseProgram(program);
         
         throw std::runtime_error("VectorOpsModule: Kernel compilation failed");
     }
     
-    DRVGPU_LOG_INFO("VectorOpsModule", "Kernels compiled successfully ✅");
+    return program;
 }
 
 } // namespace drv_gpu_lib
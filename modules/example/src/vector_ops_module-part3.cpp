@@ -45,10 +45,16 @@ void VectorOpsModule::CreateKernelObjects() {
         throw std::runtime_error("Failed to create kernel: vector_add_vectors_inplace");
     }
     
-    DRVGPU_LOG_INFO("VectorOpsModule", "All 6 kernels created ✅");
+    CreateVectorizedKernels();
+    
+    DRVGPU_LOG_INFO("VectorOpsModule", "All 6 kernels created ✅ (+ float4/float8 variants)");
 }
 
 void VectorOpsModule::ReleaseKernels() {
+    ReleaseFusedKernels();
+    ReleaseVectorizedKernels();
+    ReleaseReduceResources();
+    
     if (kernel_add_one_out_) {
         clReleaseKernel(kernel_add_one_out_);
         kernel_add_one_out_ = nullptr;
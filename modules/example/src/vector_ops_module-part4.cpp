@@ -0,0 +1,288 @@
+// ЧАСТЬ 4: Комплексные операции и слияние цепочек (VectorExpr → JIT kernel)
+
+#include "vector_ops_module.hpp"
+#include "logger/logger.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+// ════════════════════════════════════════════════════════════════════════════
+// Комплексные операции (цепочки из одного-двух шагов)
+// ════════════════════════════════════════════════════════════════════════════
+
+void VectorOpsModule::ComplexMultiplyOut(
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input_a,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input_b,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> output,
+    size_t size)
+{
+    VectorExpr expr(VectorDomain::Complex);
+    expr.Mul();
+    Evaluate(expr, static_cast<cl_mem>(input_a->GetPtr()),
+             {static_cast<cl_mem>(input_b->GetPtr())},
+             static_cast<cl_mem>(output->GetPtr()), size);
+}
+
+void VectorOpsModule::ComplexConjMultiplyOut(
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input_a,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input_b,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> output,
+    size_t size)
+{
+    VectorExpr expr(VectorDomain::Complex);
+    expr.ConjMul();
+    Evaluate(expr, static_cast<cl_mem>(input_a->GetPtr()),
+             {static_cast<cl_mem>(input_b->GetPtr())},
+             static_cast<cl_mem>(output->GetPtr()), size);
+}
+
+void VectorOpsModule::ComplexScaleInPlace(
+    std::shared_ptr<GPUBuffer<std::complex<float>>> data,
+    std::complex<float> k,
+    size_t size)
+{
+    VectorExpr expr(VectorDomain::Complex);
+    expr.Scale(k);
+    cl_mem data_mem = static_cast<cl_mem>(data->GetPtr());
+    Evaluate(expr, data_mem, {}, data_mem, size);
+}
+
+void VectorOpsModule::MagnitudeOut(
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+    std::shared_ptr<GPUBuffer<float>> output,
+    size_t size)
+{
+    VectorExpr expr(VectorDomain::Complex);
+    expr.Magnitude();
+    Evaluate(expr, static_cast<cl_mem>(input->GetPtr()), {},
+             static_cast<cl_mem>(output->GetPtr()), size);
+}
+
+void VectorOpsModule::PowerOut(
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+    std::shared_ptr<GPUBuffer<float>> output,
+    size_t size)
+{
+    VectorExpr expr(VectorDomain::Complex);
+    expr.Power();
+    Evaluate(expr, static_cast<cl_mem>(input->GetPtr()), {},
+             static_cast<cl_mem>(output->GetPtr()), size);
+}
+
+void VectorOpsModule::PowerDbOut(
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+    std::shared_ptr<GPUBuffer<float>> output,
+    size_t size)
+{
+    VectorExpr expr(VectorDomain::Complex);
+    expr.Power().Db();
+    Evaluate(expr, static_cast<cl_mem>(input->GetPtr()), {},
+             static_cast<cl_mem>(output->GetPtr()), size);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Слияние цепочек: выполнение
+// ════════════════════════════════════════════════════════════════════════════
+
+void VectorOpsModule::Evaluate(
+    const VectorExpr& expr,
+    cl_mem input,
+    const std::vector<cl_mem>& operands,
+    cl_mem output,
+    size_t size)
+{
+    EvaluateAsync(expr, input, operands, output, size, nullptr);
+
+    clFinish(queue_); // Ждём завершения
+}
+
+void VectorOpsModule::EvaluateAsync(
+    const VectorExpr& expr,
+    cl_mem input,
+    const std::vector<cl_mem>& operands,
+    cl_mem output,
+    size_t size,
+    cl_event* out_event)
+{
+    if (!initialized_) {
+        throw std::runtime_error("VectorOpsModule: not initialized");
+    }
+    if (expr.IsEmpty()) {
+        throw std::invalid_argument("VectorOpsModule::Evaluate - empty expression");
+    }
+    if (operands.size() != expr.GetNumOperands()) {
+        throw std::invalid_argument(
+            "VectorOpsModule::Evaluate - expression needs " +
+            std::to_string(expr.GetNumOperands()) + " operands, got " +
+            std::to_string(operands.size()));
+    }
+    if (!input || !output || size == 0) {
+        throw std::invalid_argument("VectorOpsModule::Evaluate - null buffer or size == 0");
+    }
+
+    cl_kernel kernel = GetFusedKernel(expr);
+
+    // Аргументы: input, operands..., output, scalars..., n
+    cl_uint arg = 0;
+    cl_int err = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &input);
+    for (const cl_mem& operand : operands) {
+        err |= clSetKernelArg(kernel, arg++, sizeof(cl_mem), &operand);
+    }
+    err |= clSetKernelArg(kernel, arg++, sizeof(cl_mem), &output);
+    for (const auto& step : expr.GetSteps()) {
+        if (step.type == VectorOpType::Scale) {
+            cl_float2 s;
+            s.s[0] = step.scalar.real();
+            s.s[1] = step.scalar.imag();
+            err |= clSetKernelArg(kernel, arg++, sizeof(cl_float2), &s);
+        }
+    }
+    cl_uint n = static_cast<cl_uint>(size);
+    err |= clSetKernelArg(kernel, arg++, sizeof(cl_uint), &n);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("VectorOpsModule::Evaluate - Failed to set kernel args");
+    }
+
+    size_t global_size = size;
+    err = clEnqueueNDRangeKernel(queue_, kernel, 1, nullptr,
+                                  &global_size, nullptr, 0, nullptr, out_event);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("VectorOpsModule::Evaluate - Failed to enqueue kernel");
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Слияние цепочек: генерация и кэш kernels
+// ════════════════════════════════════════════════════════════════════════════
+
+std::string VectorOpsModule::GenerateFusedSource(
+    const VectorExpr& expr,
+    const std::string& kernel_name)
+{
+    auto type_of = [](VectorDomain d) {
+        return d == VectorDomain::Complex ? "float2" : "float";
+    };
+
+    std::ostringstream params;
+    std::ostringstream body;
+    std::ostringstream scalars;
+
+    params << "    __global const " << type_of(expr.GetInputDomain()) << "* input,\n";
+
+    size_t operand = 0;
+    size_t scalar = 0;
+    for (const auto& step : expr.GetSteps()) {
+        const bool complex = (step.domain == VectorDomain::Complex);
+        const char* x = complex ? "c" : "r";
+        switch (step.type) {
+            case VectorOpType::Mul:
+            case VectorOpType::ConjMul:
+            case VectorOpType::Add: {
+                params << "    __global const " << type_of(step.domain)
+                       << "* op" << operand << ",\n";
+                std::string rhs = "op" + std::to_string(operand) + "[gid]";
+                if (step.type == VectorOpType::Add) {
+                    body << "    " << x << " += " << rhs << ";\n";
+                } else if (step.type == VectorOpType::ConjMul) {
+                    body << "    c = vo_cmul_conj(c, " << rhs << ");\n";
+                } else if (complex) {
+                    body << "    c = vo_cmul(c, " << rhs << ");\n";
+                } else {
+                    body << "    r *= " << rhs << ";\n";
+                }
+                ++operand;
+                break;
+            }
+            case VectorOpType::Scale:
+                scalars << "    const float2 s" << scalar << ",\n";
+                if (complex) {
+                    body << "    c = vo_cmul(c, s" << scalar << ");\n";
+                } else {
+                    body << "    r *= s" << scalar << ".x;\n";
+                }
+                ++scalar;
+                break;
+            case VectorOpType::Magnitude:
+                body << "    r = hypot(c.x, c.y);\n";
+                break;
+            case VectorOpType::Power:
+                body << "    r = c.x * c.x + c.y * c.y;\n";
+                break;
+            case VectorOpType::Db:
+                body << "    r = 10.0f * log10(fmax(r, 1.0e-30f));\n";
+                break;
+        }
+    }
+
+    params << "    __global " << type_of(expr.GetOutputDomain()) << "* output,\n";
+
+    std::ostringstream src;
+    src << "// VectorExpr: " << expr.Signature() << "\n"
+        << "inline float2 vo_cmul(float2 a, float2 b) {\n"
+        << "    return (float2)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);\n"
+        << "}\n"
+        << "inline float2 vo_cmul_conj(float2 a, float2 b) {\n"
+        << "    return (float2)(a.x * b.x + a.y * b.y, a.y * b.x - a.x * b.y);\n"
+        << "}\n\n"
+        << "__kernel void " << kernel_name << "(\n"
+        << params.str() << scalars.str()
+        << "    const uint n)\n"
+        << "{\n"
+        << "    uint gid = get_global_id(0);\n"
+        << "    if (gid >= n) return;\n\n"
+        << "    float2 c = (float2)(0.0f, 0.0f);\n"
+        << "    float r = 0.0f;\n"
+        << "    " << (expr.GetInputDomain() == VectorDomain::Complex ? "c" : "r")
+        << " = input[gid];\n\n"
+        << body.str() << "\n"
+        << "    output[gid] = "
+        << (expr.GetOutputDomain() == VectorDomain::Complex ? "c" : "r") << ";\n"
+        << "}\n";
+    return src.str();
+}
+
+cl_kernel VectorOpsModule::GetFusedKernel(const VectorExpr& expr) {
+    const std::string signature = expr.Signature();
+
+    auto it = fused_cache_.find(signature);
+    if (it != fused_cache_.end()) {
+        return it->second.kernel;
+    }
+
+    const std::string kernel_name = "vector_fused_" + std::to_string(fused_cache_.size());
+    const std::string source = GenerateFusedSource(expr, kernel_name);
+
+    FusedKernel fused;
+    fused.program = BuildProgram(source);
+
+    cl_int err;
+    fused.kernel = clCreateKernel(fused.program, kernel_name.c_str(), &err);
+    if (err != CL_SUCCESS) {
+        clReleaseProgram(fused.program);
+        throw std::runtime_error("Failed to create kernel: " + kernel_name);
+    }
+
+    fused_cache_.emplace(signature, fused);
+    DRVGPU_LOG_DEBUG("VectorOpsModule", "Fused kernel built: " + signature +
+                     " (" + std::to_string(expr.GetSteps().size()) + " ops)");
+    return fused.kernel;
+}
+
+void VectorOpsModule::ReleaseFusedKernels() {
+    for (auto& entry : fused_cache_) {
+        if (entry.second.kernel) {
+            clReleaseKernel(entry.second.kernel);
+        }
+        if (entry.second.program) {
+            clReleaseProgram(entry.second.program);
+        }
+    }
+    fused_cache_.clear();
+}
+
+} // namespace drv_gpu_lib
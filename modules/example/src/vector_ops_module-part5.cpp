@@ -0,0 +1,329 @@
+// ЧАСТЬ 5: Векторизованные варианты (float4 / float8 grid-stride) и бенчмарк
+
+#include "vector_ops_module.hpp"
+#include "logger/logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+namespace {
+constexpr size_t kVectorizeMinSize = 4096;     ///< Короче — поэлементный kernel
+constexpr size_t kVectorWorkGroup = 256;       ///< Work-group векторизованных kernels
+constexpr size_t kGroupsPerComputeUnit = 8;    ///< Групп на CU для grid-stride
+
+size_t VariantWidth(VectorKernelVariant variant) {
+    switch (variant) {
+        case VectorKernelVariant::Float4: return 4;
+        case VectorKernelVariant::Float8: return 8;
+        default: return 1;
+    }
+}
+
+/// Смещение sub-buffer кратно ширине варианта (базовые буферы выровнены драйвером)
+bool IsAligned(cl_mem mem, size_t bytes) {
+    if (!mem) return true;
+    size_t offset = 0;
+    if (clGetMemObjectInfo(mem, CL_MEM_OFFSET, sizeof(offset), &offset, nullptr) != CL_SUCCESS) {
+        return false;
+    }
+    return offset % bytes == 0;
+}
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Kernels
+// ════════════════════════════════════════════════════════════════════════════
+
+void VectorOpsModule::CreateVectorizedKernels() {
+    auto create = [this](const std::string& name) {
+        cl_int err;
+        cl_kernel kernel = clCreateKernel(program_, name.c_str(), &err);
+        if (err != CL_SUCCESS) {
+            throw std::runtime_error("Failed to create kernel: " + name);
+        }
+        return kernel;
+    };
+
+    kernels_v4_.scalar_out = create("vector_scalar_out_v4");
+    kernels_v4_.scalar_inplace = create("vector_scalar_inplace_v4");
+    kernels_v4_.add_out = create("vector_add_vectors_out_v4");
+    kernels_v4_.add_inplace = create("vector_add_vectors_inplace_v4");
+
+    kernels_v8_.scalar_out = create("vector_scalar_out_v8");
+    kernels_v8_.scalar_inplace = create("vector_scalar_inplace_v8");
+    kernels_v8_.add_out = create("vector_add_vectors_out_v8");
+    kernels_v8_.add_inplace = create("vector_add_vectors_inplace_v8");
+}
+
+void VectorOpsModule::ReleaseVectorizedKernels() {
+    for (VectorizedKernels* set : {&kernels_v4_, &kernels_v8_}) {
+        for (cl_kernel* kernel : {&set->scalar_out, &set->scalar_inplace,
+                                  &set->add_out, &set->add_inplace}) {
+            if (*kernel) {
+                clReleaseKernel(*kernel);
+                *kernel = nullptr;
+            }
+        }
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Выбор варианта
+// ════════════════════════════════════════════════════════════════════════════
+
+const char* VectorOpsModule::VariantName(VectorKernelVariant variant) {
+    switch (variant) {
+        case VectorKernelVariant::Auto:   return "Auto";
+        case VectorKernelVariant::Scalar: return "Scalar";
+        case VectorKernelVariant::Float4: return "float4";
+        case VectorKernelVariant::Float8: return "float8";
+    }
+    return "?";
+}
+
+VectorKernelVariant VectorOpsModule::SelectVariant(
+    size_t size, std::initializer_list<cl_mem> mems) const
+{
+    VectorKernelVariant wanted = variant_;
+    if (wanted == VectorKernelVariant::Auto) {
+        if (size < kVectorizeMinSize) {
+            return VectorKernelVariant::Scalar;
+        }
+        wanted = (preferred_float_width_ >= 8) ? VectorKernelVariant::Float8
+                                               : VectorKernelVariant::Float4;
+    }
+
+    // Сужаем, пока все буферы не окажутся выровнены
+    while (wanted != VectorKernelVariant::Scalar) {
+        const size_t bytes = VariantWidth(wanted) * sizeof(float);
+        bool aligned = std::all_of(mems.begin(), mems.end(),
+                                   [bytes](cl_mem m) { return IsAligned(m, bytes); });
+        if (aligned) break;
+        wanted = (wanted == VectorKernelVariant::Float8) ? VectorKernelVariant::Float4
+                                                         : VectorKernelVariant::Scalar;
+    }
+    return wanted;
+}
+
+bool VectorOpsModule::EnqueueVectorized(
+    VectorizedOp op, cl_mem a, cl_mem b, cl_mem out, float value, size_t size)
+{
+    last_variant_ = SelectVariant(size, {a, b, out});
+    if (last_variant_ == VectorKernelVariant::Scalar) {
+        return false;
+    }
+    EnqueueVariant(op, last_variant_, a, b, out, value, size);
+    return true;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Запуск
+// ════════════════════════════════════════════════════════════════════════════
+
+void VectorOpsModule::EnqueueVariant(
+    VectorizedOp op, VectorKernelVariant variant,
+    cl_mem a, cl_mem b, cl_mem out, float value, size_t size)
+{
+    cl_int err = CL_SUCCESS;
+    cl_kernel kernel = nullptr;
+    size_t global_size = size;
+    size_t local_storage = 0;
+    const size_t* local_size = nullptr;
+
+    if (variant == VectorKernelVariant::Scalar) {
+        // Исходные поэлементные kernels (скаляр зашит: +1 / -1)
+        int n = static_cast<int>(size);
+        switch (op) {
+            case VectorizedOp::ScalarOut:
+                kernel = (value > 0.0f) ? kernel_add_one_out_ : kernel_sub_one_out_;
+                err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &a);
+                err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &out);
+                err |= clSetKernelArg(kernel, 2, sizeof(int), &n);
+                break;
+            case VectorizedOp::ScalarInPlace:
+                kernel = (value > 0.0f) ? kernel_add_one_inplace_ : kernel_sub_one_inplace_;
+                err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &a);
+                err |= clSetKernelArg(kernel, 1, sizeof(int), &n);
+                break;
+            case VectorizedOp::AddOut:
+                kernel = kernel_add_vectors_out_;
+                err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &a);
+                err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &b);
+                err |= clSetKernelArg(kernel, 2, sizeof(cl_mem), &out);
+                err |= clSetKernelArg(kernel, 3, sizeof(int), &n);
+                break;
+            case VectorizedOp::AddInPlace:
+                kernel = kernel_add_vectors_inplace_;
+                err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &a);
+                err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &b);
+                err |= clSetKernelArg(kernel, 2, sizeof(int), &n);
+                break;
+        }
+    } else {
+        const VectorizedKernels& set =
+            (variant == VectorKernelVariant::Float8) ? kernels_v8_ : kernels_v4_;
+        cl_uint n = static_cast<cl_uint>(size);
+        switch (op) {
+            case VectorizedOp::ScalarOut:
+                kernel = set.scalar_out;
+                err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &a);
+                err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &out);
+                err |= clSetKernelArg(kernel, 2, sizeof(float), &value);
+                err |= clSetKernelArg(kernel, 3, sizeof(cl_uint), &n);
+                break;
+            case VectorizedOp::ScalarInPlace:
+                kernel = set.scalar_inplace;
+                err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &a);
+                err |= clSetKernelArg(kernel, 1, sizeof(float), &value);
+                err |= clSetKernelArg(kernel, 2, sizeof(cl_uint), &n);
+                break;
+            case VectorizedOp::AddOut:
+                kernel = set.add_out;
+                err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &a);
+                err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &b);
+                err |= clSetKernelArg(kernel, 2, sizeof(cl_mem), &out);
+                err |= clSetKernelArg(kernel, 3, sizeof(cl_uint), &n);
+                break;
+            case VectorizedOp::AddInPlace:
+                kernel = set.add_inplace;
+                err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &a);
+                err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &b);
+                err |= clSetKernelArg(kernel, 2, sizeof(cl_uint), &n);
+                break;
+        }
+
+        // Grid-stride: столько групп, сколько устройство держит одновременно
+        local_storage = std::min(kVectorWorkGroup, max_work_group_);
+        const size_t n_vec = std::max<size_t>(size / VariantWidth(variant), 1);
+        const size_t groups = std::min((n_vec + local_storage - 1) / local_storage,
+                                       static_cast<size_t>(compute_units_) * kGroupsPerComputeUnit);
+        global_size = std::max<size_t>(groups, 1) * local_storage;
+        local_size = &local_storage;
+    }
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("VectorOpsModule::EnqueueVariant - Failed to set kernel args");
+    }
+
+    err = clEnqueueNDRangeKernel(queue_, kernel, 1, nullptr,
+                                  &global_size, local_size, 0, nullptr, nullptr);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("VectorOpsModule::EnqueueVariant - Failed to enqueue kernel (" +
+                                 std::string(VariantName(variant)) + ")");
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Бенчмарк пропускной способности
+// ════════════════════════════════════════════════════════════════════════════
+
+VectorBandwidthReport VectorOpsModule::BenchmarkBandwidth(
+    size_t size,
+    int iterations,
+    double peak_gbps)
+{
+    if (!initialized_) {
+        throw std::runtime_error("VectorOpsModule: not initialized");
+    }
+    if (size == 0 || iterations <= 0) {
+        throw std::invalid_argument("VectorOpsModule::BenchmarkBandwidth - size/iterations == 0");
+    }
+
+    const size_t bytes = size * sizeof(float);
+    cl_mem buffers[3] = {nullptr, nullptr, nullptr};
+    auto release = [&buffers]() {
+        for (cl_mem& mem : buffers) {
+            if (mem) {
+                clReleaseMemObject(mem);
+                mem = nullptr;
+            }
+        }
+    };
+
+    // Среднее время одного запуска (мс), после прогрева
+    auto time_ms = [this, iterations](auto&& enqueue) {
+        enqueue();
+        clFinish(queue_);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            enqueue();
+        }
+        clFinish(queue_);
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+    };
+    auto to_gbps = [](size_t moved_bytes, double ms) {
+        return (ms > 0.0) ? moved_bytes / (ms * 1.0e6) : 0.0;
+    };
+
+    VectorBandwidthReport report;
+    report.size = size;
+
+    try {
+        const float one = 1.0f;
+        for (cl_mem& mem : buffers) {
+            cl_int err;
+            mem = clCreateBuffer(context_, CL_MEM_READ_WRITE, bytes, nullptr, &err);
+            if (err != CL_SUCCESS || !mem) {
+                throw std::runtime_error("VectorOpsModule::BenchmarkBandwidth - allocation failed");
+            }
+            clEnqueueFillBuffer(queue_, mem, &one, sizeof(one), 0, bytes, 0, nullptr, nullptr);
+        }
+
+        // Опорный пик: копирование буфера средствами драйвера (чтение + запись)
+        if (peak_gbps > 0.0) {
+            report.peak_gbps = peak_gbps;
+        } else {
+            double ms = time_ms([&]() {
+                clEnqueueCopyBuffer(queue_, buffers[0], buffers[2], 0, 0, bytes,
+                                    0, nullptr, nullptr);
+            });
+            report.peak_gbps = to_gbps(2 * bytes, ms);
+            report.peak_measured = true;
+        }
+
+        struct BenchOp { const char* name; VectorizedOp op; size_t streams; };
+        const BenchOp ops[] = {
+            {"AddOneOut", VectorizedOp::ScalarOut, 2},
+            {"AddVectorsOut", VectorizedOp::AddOut, 3}
+        };
+        const VectorKernelVariant variants[] = {
+            VectorKernelVariant::Scalar, VectorKernelVariant::Float4, VectorKernelVariant::Float8
+        };
+
+        for (const auto& bench : ops) {
+            for (auto variant : variants) {
+                double ms = time_ms([&]() {
+                    EnqueueVariant(bench.op, variant, buffers[0], buffers[1], buffers[2],
+                                   1.0f, size);
+                });
+
+                VectorBandwidthEntry entry;
+                entry.operation = bench.name;
+                entry.variant = variant;
+                entry.time_ms = ms;
+                entry.gbps = to_gbps(bench.streams * bytes, ms);
+                entry.percent_of_peak = (report.peak_gbps > 0.0)
+                    ? 100.0 * entry.gbps / report.peak_gbps : 0.0;
+                report.entries.push_back(entry);
+
+                DRVGPU_LOG_DEBUG("VectorOpsModule", std::string("Bandwidth ") + bench.name +
+                                 " [" + VariantName(variant) + "]: " +
+                                 std::to_string(entry.gbps) + " GB/s");
+            }
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+
+    release();
+    return report;
+}
+
+} // namespace drv_gpu_lib
@@ -0,0 +1,304 @@
+// ЧАСТЬ 6: Сегментированные редукции (Sum / Mean / Energy / Min / Max)
+
+#include "vector_ops_module.hpp"
+#include "logger/logger.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+namespace {
+constexpr size_t kReduceWorkGroup = 256;       ///< Верхняя граница work-group редукции
+constexpr size_t kReduceGroupsPerCU = 8;       ///< Групп на CU в первом проходе
+
+int ReduceKey(VectorReduceOp op, VectorDomain domain) {
+    return static_cast<int>(op) * 2 + (domain == VectorDomain::Complex ? 1 : 0);
+}
+
+size_t FloorPowerOfTwo(size_t value) {
+    size_t p = 1;
+    while (p * 2 <= value) p *= 2;
+    return p;
+}
+
+size_t CeilPowerOfTwo(size_t value) {
+    size_t p = 1;
+    while (p < value) p *= 2;
+    return p;
+}
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Sub-groups
+// ════════════════════════════════════════════════════════════════════════════
+
+void VectorOpsModule::DetectSubgroups() {
+    subgroups_ = false;
+    subgroup_options_.clear();
+
+    size_t size = 0;
+    if (clGetDeviceInfo(device_, CL_DEVICE_EXTENSIONS, 0, nullptr, &size) != CL_SUCCESS || size == 0) {
+        return;
+    }
+    std::string extensions(size, '\0');
+    clGetDeviceInfo(device_, CL_DEVICE_EXTENSIONS, size, &extensions[0], nullptr);
+
+    // cl_intel_subgroups даёт sub_group_reduce_* и в OpenCL C 1.2;
+    // cl_khr_subgroups требует OpenCL C 2.0
+    if (extensions.find("cl_intel_subgroups") != std::string::npos) {
+        subgroups_ = true;
+        subgroup_options_ = "-D VO_USE_SUBGROUPS=1";
+    } else if (extensions.find("cl_khr_subgroups") != std::string::npos) {
+        char version[128] = {0};
+        clGetDeviceInfo(device_, CL_DEVICE_OPENCL_C_VERSION, sizeof(version) - 1, version, nullptr);
+        // "OpenCL C 2.0 ..." / "OpenCL C 3.0 ..."
+        const std::string v(version);
+        if (v.size() > 9 && v[9] >= '2') {
+            subgroups_ = true;
+            subgroup_options_ = "-cl-std=CL2.0 -D VO_USE_SUBGROUPS=1";
+        }
+    }
+
+    DRVGPU_LOG_INFO("VectorOpsModule", std::string("Reductions: ") +
+                    (subgroups_ ? "sub-groups" : "local memory tree"));
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Kernels
+// ════════════════════════════════════════════════════════════════════════════
+
+const char* VectorOpsModule::ReduceOpName(VectorReduceOp op) {
+    switch (op) {
+        case VectorReduceOp::Sum:    return "Sum";
+        case VectorReduceOp::Mean:   return "Mean";
+        case VectorReduceOp::Energy: return "Energy";
+        case VectorReduceOp::Min:    return "Min";
+        case VectorReduceOp::Max:    return "Max";
+    }
+    return "?";
+}
+
+const VectorOpsModule::ReduceKernels& VectorOpsModule::GetReduceKernels(
+    VectorReduceOp op, VectorDomain domain)
+{
+    const int key = ReduceKey(op, domain);
+    auto it = reduce_cache_.find(key);
+    if (it != reduce_cache_.end()) {
+        return it->second;
+    }
+
+    const std::string source = LoadKernelSource("vector_reduce.cl");
+    const std::string defines =
+        "-D VO_REDUCE_OP=" + std::to_string(static_cast<int>(op)) +
+        " -D VO_COMPLEX=" + std::string(domain == VectorDomain::Complex ? "1" : "0");
+
+    ReduceKernels kernels;
+    if (subgroups_) {
+        try {
+            kernels.program = BuildProgram(source, defines + " " + subgroup_options_);
+        } catch (const std::exception&) {
+            // Заявленная поддержка не собралась — остаёмся на дереве в local memory
+            DRVGPU_LOG_WARNING("VectorOpsModule",
+                               "Sub-group reduction build failed, falling back to local memory");
+            subgroups_ = false;
+            subgroup_options_.clear();
+        }
+    }
+    if (!kernels.program) {
+        kernels.program = BuildProgram(source, defines);
+    }
+
+    cl_int err;
+    kernels.partial = clCreateKernel(kernels.program, "vector_reduce_partial", &err);
+    if (err == CL_SUCCESS) {
+        kernels.finalize = clCreateKernel(kernels.program, "vector_reduce_final", &err);
+    }
+    if (err != CL_SUCCESS) {
+        if (kernels.partial) clReleaseKernel(kernels.partial);
+        clReleaseProgram(kernels.program);
+        throw std::runtime_error("Failed to create kernel: vector_reduce_partial/final");
+    }
+
+    // Дерево в local memory требует степень двойки
+    size_t limit = std::min(kReduceWorkGroup, max_work_group_);
+    for (cl_kernel kernel : {kernels.partial, kernels.finalize}) {
+        size_t kernel_limit = 0;
+        if (clGetKernelWorkGroupInfo(kernel, device_, CL_KERNEL_WORK_GROUP_SIZE,
+                                     sizeof(kernel_limit), &kernel_limit, nullptr) == CL_SUCCESS &&
+            kernel_limit > 0) {
+            limit = std::min(limit, kernel_limit);
+        }
+    }
+    kernels.local_size = FloorPowerOfTwo(std::max<size_t>(limit, 1));
+
+    DRVGPU_LOG_DEBUG("VectorOpsModule", std::string("Reduce kernels built: ") + ReduceOpName(op) +
+                     (domain == VectorDomain::Complex ? " complex" : " float") +
+                     ", local " + std::to_string(kernels.local_size));
+    return reduce_cache_.emplace(key, kernels).first->second;
+}
+
+cl_mem VectorOpsModule::EnsureScratch(cl_mem& mem, size_t& capacity, size_t bytes) {
+    if (mem && capacity >= bytes) {
+        return mem;
+    }
+    if (mem) {
+        clReleaseMemObject(mem);
+        mem = nullptr;
+        capacity = 0;
+    }
+    cl_int err;
+    mem = clCreateBuffer(context_, CL_MEM_READ_WRITE, bytes, nullptr, &err);
+    if (err != CL_SUCCESS || !mem) {
+        mem = nullptr;
+        throw std::runtime_error("VectorOpsModule: failed to allocate reduction buffer (" +
+                                 std::to_string(bytes) + " bytes)");
+    }
+    capacity = bytes;
+    return mem;
+}
+
+void VectorOpsModule::ReleaseReduceResources() {
+    for (auto& entry : reduce_cache_) {
+        if (entry.second.partial) clReleaseKernel(entry.second.partial);
+        if (entry.second.finalize) clReleaseKernel(entry.second.finalize);
+        if (entry.second.program) clReleaseProgram(entry.second.program);
+    }
+    reduce_cache_.clear();
+
+    for (cl_mem* mem : {&reduce_partials_, &reduce_output_}) {
+        if (*mem) {
+            clReleaseMemObject(*mem);
+            *mem = nullptr;
+        }
+    }
+    reduce_partials_bytes_ = 0;
+    reduce_output_bytes_ = 0;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Запуск
+// ════════════════════════════════════════════════════════════════════════════
+
+void VectorOpsModule::ReduceSegmentsAsync(
+    VectorReduceOp op,
+    VectorDomain domain,
+    cl_mem input,
+    cl_mem output,
+    size_t segments,
+    size_t n,
+    cl_event* out_event)
+{
+    if (!initialized_) {
+        throw std::runtime_error("VectorOpsModule: not initialized");
+    }
+    if (!input || !output || segments == 0 || n == 0) {
+        throw std::invalid_argument("VectorOpsModule::ReduceSegments - null buffer or empty shape");
+    }
+    if (n > std::numeric_limits<cl_uint>::max()) {
+        throw std::invalid_argument("VectorOpsModule::ReduceSegments - segment too long");
+    }
+
+    const ReduceKernels& kernels = GetReduceKernels(op, domain);
+    const size_t local = kernels.local_size;
+
+    // Первый проход: групп на сегмент столько, чтобы занять устройство,
+    // но не больше, чем нужно для покрытия n
+    const size_t target = static_cast<size_t>(compute_units_) * kReduceGroupsPerCU;
+    size_t groups = (target + segments - 1) / segments;
+    groups = std::max<size_t>(std::min(groups, (n + local - 1) / local), 1);
+
+    const size_t partial_bytes = segments * groups * sizeof(VectorReduceResult);
+    cl_mem partials = EnsureScratch(reduce_partials_, reduce_partials_bytes_, partial_bytes);
+
+    const cl_uint n_arg = static_cast<cl_uint>(n);
+    const cl_uint groups_arg = static_cast<cl_uint>(groups);
+    const size_t scratch_bytes = local * sizeof(VectorReduceResult);
+
+    cl_int err = clSetKernelArg(kernels.partial, 0, sizeof(cl_mem), &input);
+    err |= clSetKernelArg(kernels.partial, 1, sizeof(cl_mem), &partials);
+    err |= clSetKernelArg(kernels.partial, 2, scratch_bytes, nullptr);
+    err |= clSetKernelArg(kernels.partial, 3, sizeof(cl_uint), &n_arg);
+    err |= clSetKernelArg(kernels.partial, 4, sizeof(cl_uint), &groups_arg);
+
+    err |= clSetKernelArg(kernels.finalize, 0, sizeof(cl_mem), &partials);
+    err |= clSetKernelArg(kernels.finalize, 1, sizeof(cl_mem), &output);
+    err |= clSetKernelArg(kernels.finalize, 2, scratch_bytes, nullptr);
+    err |= clSetKernelArg(kernels.finalize, 3, sizeof(cl_uint), &n_arg);
+    err |= clSetKernelArg(kernels.finalize, 4, sizeof(cl_uint), &groups_arg);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("VectorOpsModule::ReduceSegments - Failed to set kernel args");
+    }
+
+    const size_t global_partial[2] = { groups * local, segments };
+    const size_t local_partial[2] = { local, 1 };
+    err = clEnqueueNDRangeKernel(queue_, kernels.partial, 2, nullptr,
+                                  global_partial, local_partial, 0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("VectorOpsModule::ReduceSegments - Failed to enqueue partial pass");
+    }
+
+    // Второй проход: группа не шире числа partials в сегменте
+    const size_t local_final = std::min(local, CeilPowerOfTwo(groups));
+    const size_t global_final = local_final * segments;
+    err = clEnqueueNDRangeKernel(queue_, kernels.finalize, 1, nullptr,
+                                  &global_final, &local_final, 0, nullptr, out_event);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("VectorOpsModule::ReduceSegments - Failed to enqueue final pass");
+    }
+}
+
+std::vector<VectorReduceResult> VectorOpsModule::ReduceSegments(
+    VectorReduceOp op,
+    std::shared_ptr<GPUBuffer<float>> input,
+    size_t segments,
+    size_t n)
+{
+    if (!initialized_) {
+        throw std::runtime_error("VectorOpsModule: not initialized");
+    }
+    
+    std::vector<VectorReduceResult> results(segments);
+    cl_mem output = EnsureScratch(reduce_output_, reduce_output_bytes_,
+                                  std::max<size_t>(segments, 1) * sizeof(VectorReduceResult));
+    ReduceSegmentsAsync(op, VectorDomain::Real, static_cast<cl_mem>(input->GetPtr()),
+                        output, segments, n);
+
+    cl_int err = clEnqueueReadBuffer(queue_, output, CL_TRUE, 0,
+                                     segments * sizeof(VectorReduceResult),
+                                     results.data(), 0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("VectorOpsModule::ReduceSegments - Failed to read results");
+    }
+    return results;
+}
+
+std::vector<VectorReduceResult> VectorOpsModule::ReduceSegments(
+    VectorReduceOp op,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> input,
+    size_t segments,
+    size_t n)
+{
+    if (!initialized_) {
+        throw std::runtime_error("VectorOpsModule: not initialized");
+    }
+    
+    std::vector<VectorReduceResult> results(segments);
+    cl_mem output = EnsureScratch(reduce_output_, reduce_output_bytes_,
+                                  std::max<size_t>(segments, 1) * sizeof(VectorReduceResult));
+    ReduceSegmentsAsync(op, VectorDomain::Complex, static_cast<cl_mem>(input->GetPtr()),
+                        output, segments, n);
+
+    cl_int err = clEnqueueReadBuffer(queue_, output, CL_TRUE, 0,
+                                     segments * sizeof(VectorReduceResult),
+                                     results.data(), 0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("VectorOpsModule::ReduceSegments - Failed to read results");
+    }
+    return results;
+}
+
+} // namespace drv_gpu_lib
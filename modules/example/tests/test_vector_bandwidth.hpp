@@ -0,0 +1,126 @@
+#pragma once
+/**
+ * @file test_vector_bandwidth.hpp
+ * @brief Тест векторизованных вариантов VectorOpsModule и бенчмарк ГБ/с
+ *
+ * 1. Каждый вариант (Scalar / float4 / float8) на размерах с хвостом
+ *    (n % 8 != 0) даёт тот же результат, что CPU
+ * 2. Auto: короткий вектор → Scalar, длинный → float4/float8
+ * 3. Таблица достигнутой пропускной способности против пика устройства
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "vector_ops_module.hpp"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace test_vector_bandwidth {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║   TEST: VectorOpsModule — float4/float8, ГБ/с            ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        auto module = std::make_shared<VectorOpsModule>(&gpu.GetBackend());
+        module->Initialize();
+        gpu.GetModuleRegistry().RegisterModule("VectorOps", module);
+
+        auto& mem_mgr = gpu.GetMemoryManager();
+        bool passed = true;
+
+        // ── 1. Корректность вариантов ──────────────────────────────────────
+        const size_t sizes[] = { 7, 1000, (1 << 20) + 5 };
+        const VectorKernelVariant variants[] = {
+            VectorKernelVariant::Scalar, VectorKernelVariant::Float4, VectorKernelVariant::Float8
+        };
+
+        for (size_t n : sizes) {
+            std::vector<float> a(n), b(n);
+            for (size_t i = 0; i < n; ++i) {
+                a[i] = static_cast<float>(i % 1000);
+                b[i] = 0.5f * static_cast<float>(i % 77);
+            }
+            auto gpu_a = mem_mgr.CreateBuffer<float>(a.data(), n);
+            auto gpu_b = mem_mgr.CreateBuffer<float>(b.data(), n);
+            auto gpu_c = mem_mgr.CreateBuffer<float>(n);
+
+            for (auto variant : variants) {
+                module->SetKernelVariant(variant);
+
+                // C = (A + 1) + B; затем C -= 1 → ожидается A + B
+                module->AddOneOut(gpu_a, gpu_c, n);
+                module->AddVectorsInPlace(gpu_c, gpu_b, n);
+                module->SubOneInPlace(gpu_c, n);
+                auto c = gpu_c->Read();
+
+                float err = 0.0f;
+                for (size_t i = 0; i < n; ++i) err = std::max(err, std::abs(c[i] - (a[i] + b[i])));
+
+                bool ok = err == 0.0f && module->GetLastVariant() == variant;
+                passed &= ok;
+                std::cout << "  n = " << std::setw(8) << n << "  " << std::setw(7)
+                          << VectorOpsModule::VariantName(variant) << "  max err = " << err
+                          << "  " << (ok ? "✅" : "❌") << "\n";
+            }
+        }
+
+        // ── 2. Auto ────────────────────────────────────────────────────────
+        module->SetKernelVariant(VectorKernelVariant::Auto);
+        auto small = mem_mgr.CreateBuffer<float>(100);
+        module->AddOneInPlace(small, 100);
+        VectorKernelVariant small_variant = module->GetLastVariant();
+        auto large = mem_mgr.CreateBuffer<float>(1 << 20);
+        module->AddOneInPlace(large, 1 << 20);
+        VectorKernelVariant large_variant = module->GetLastVariant();
+
+        bool auto_ok = small_variant == VectorKernelVariant::Scalar &&
+                       large_variant != VectorKernelVariant::Scalar;
+        passed &= auto_ok;
+        std::cout << "\n  Auto: n = 100 → " << VectorOpsModule::VariantName(small_variant)
+                  << ", n = 2^20 → " << VectorOpsModule::VariantName(large_variant)
+                  << "  " << (auto_ok ? "✅" : "❌") << "\n\n";
+
+        // ── 3. Пропускная способность ──────────────────────────────────────
+        auto report = module->BenchmarkBandwidth(16 * 1024 * 1024, 20);
+        std::cout << "  Бенчмарк: " << report.size << " float ("
+                  << report.size * sizeof(float) / (1024 * 1024) << " МБ на буфер), пик "
+                  << std::fixed << std::setprecision(1) << report.peak_gbps << " ГБ/с"
+                  << (report.peak_measured ? " (clEnqueueCopyBuffer)" : "") << "\n";
+        std::cout << "  ┌────────────────┬─────────┬──────────┬──────────┬────────┐\n";
+        std::cout << "  │ Операция       │ Вариант │ мс       │ ГБ/с     │ % пика │\n";
+        std::cout << "  ├────────────────┼─────────┼──────────┼──────────┼────────┤\n";
+        for (const auto& e : report.entries) {
+            std::cout << "  │ " << std::left << std::setw(15) << e.operation << "│ "
+                      << std::setw(8) << VectorOpsModule::VariantName(e.variant) << "│ "
+                      << std::right << std::setw(8) << std::setprecision(3) << e.time_ms << " │ "
+                      << std::setw(8) << std::setprecision(1) << e.gbps << " │ "
+                      << std::setw(6) << e.percent_of_peak << " │\n";
+        }
+        std::cout << "  └────────────────┴─────────┴──────────┴──────────┴────────┘\n\n";
+
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_vector_bandwidth
@@ -0,0 +1,139 @@
+#pragma once
+/**
+ * @file test_vector_expr.hpp
+ * @brief Тест комплексных операций VectorOpsModule и слияния цепочек (VectorExpr)
+ *
+ * 1. ComplexMultiplyOut / ComplexConjMultiplyOut / MagnitudeOut против CPU
+ * 2. Цепочка 10·log10(|A · conj(B) · k|²) одним kernel против CPU
+ *    и против той же цепочки из отдельных вызовов
+ * 3. Повторный вызов той же цепочки (другой скаляр) берёт kernel из кэша
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "vector_ops_module.hpp"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <algorithm>
+#include <cmath>
+
+namespace test_vector_expr {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║   TEST: VectorOpsModule — комплексные цепочки (JIT)      ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        auto module = std::make_shared<VectorOpsModule>(&gpu.GetBackend());
+        module->Initialize();
+        gpu.GetModuleRegistry().RegisterModule("VectorOps", module);
+
+        const size_t N = 4097;
+        std::vector<std::complex<float>> a(N), b(N);
+        for (size_t i = 0; i < N; ++i) {
+            a[i] = std::complex<float>(std::cos(0.01f * i) + 0.1f, std::sin(0.013f * i));
+            b[i] = std::complex<float>(0.5f + 0.001f * (i % 97), std::cos(0.007f * i));
+        }
+
+        auto& mem_mgr = gpu.GetMemoryManager();
+        auto gpu_a = mem_mgr.CreateBuffer<std::complex<float>>(a.data(), N);
+        auto gpu_b = mem_mgr.CreateBuffer<std::complex<float>>(b.data(), N);
+        auto gpu_c = mem_mgr.CreateBuffer<std::complex<float>>(N);
+        auto gpu_r = mem_mgr.CreateBuffer<float>(N);
+        auto gpu_db = mem_mgr.CreateBuffer<float>(N);
+
+        bool passed = true;
+        auto report = [&](const std::string& name, float error, float tolerance) {
+            bool ok = error < tolerance;
+            passed &= ok;
+            std::cout << "  " << std::left << std::setw(36) << name << std::scientific
+                      << std::setprecision(2) << "max err = " << error << "  "
+                      << (ok ? "✅" : "❌") << "\n";
+        };
+
+        // ── 1. Отдельные операции ──────────────────────────────────────────
+        module->ComplexMultiplyOut(gpu_a, gpu_b, gpu_c, N);
+        auto mul = gpu_c->Read();
+        float err = 0.0f;
+        for (size_t i = 0; i < N; ++i) err = std::max(err, std::abs(mul[i] - a[i] * b[i]));
+        report("ComplexMultiplyOut", err, 1.0e-5f);
+
+        module->ComplexConjMultiplyOut(gpu_a, gpu_b, gpu_c, N);
+        auto cmul = gpu_c->Read();
+        err = 0.0f;
+        for (size_t i = 0; i < N; ++i) {
+            err = std::max(err, std::abs(cmul[i] - a[i] * std::conj(b[i])));
+        }
+        report("ComplexConjMultiplyOut", err, 1.0e-5f);
+
+        module->MagnitudeOut(gpu_a, gpu_r, N);
+        auto mag = gpu_r->Read();
+        err = 0.0f;
+        for (size_t i = 0; i < N; ++i) err = std::max(err, std::abs(mag[i] - std::abs(a[i])));
+        report("MagnitudeOut", err, 1.0e-5f);
+
+        // ── 2. Цепочка одним kernel ────────────────────────────────────────
+        const std::complex<float> k(0.5f, -0.25f);
+        VectorExpr expr(VectorDomain::Complex);
+        expr.ConjMul().Scale(k).Power().Db();
+
+        module->Evaluate(expr, static_cast<cl_mem>(gpu_a->GetPtr()),
+                         {static_cast<cl_mem>(gpu_b->GetPtr())},
+                         static_cast<cl_mem>(gpu_db->GetPtr()), N);
+        auto fused = gpu_db->Read();
+
+        err = 0.0f;
+        for (size_t i = 0; i < N; ++i) {
+            std::complex<double> z = std::complex<double>(a[i]) *
+                                     std::conj(std::complex<double>(b[i])) *
+                                     std::complex<double>(k);
+            double ref = 10.0 * std::log10(std::max(std::norm(z), 1.0e-30));
+            err = std::max(err, static_cast<float>(std::abs(fused[i] - ref)));
+        }
+        report("Fused ~ s p d (vs CPU, dB)", err, 1.0e-3f);
+
+        // Та же цепочка отдельными проходами: conj-mul → scale → power+dB
+        module->ComplexConjMultiplyOut(gpu_a, gpu_b, gpu_c, N);
+        module->ComplexScaleInPlace(gpu_c, k, N);
+        module->PowerDbOut(gpu_c, gpu_r, N);
+        auto chained = gpu_r->Read();
+        err = 0.0f;
+        for (size_t i = 0; i < N; ++i) err = std::max(err, std::abs(fused[i] - chained[i]));
+        report("Fused vs chained (dB)", err, 1.0e-3f);
+
+        // ── 3. Кэш kernels ─────────────────────────────────────────────────
+        const size_t cached = module->GetFusedCacheSize();
+        VectorExpr same(VectorDomain::Complex);
+        same.ConjMul().Scale(2.0f).Power().Db();
+        module->Evaluate(same, static_cast<cl_mem>(gpu_a->GetPtr()),
+                         {static_cast<cl_mem>(gpu_b->GetPtr())},
+                         static_cast<cl_mem>(gpu_db->GetPtr()), N);
+        bool cache_ok = module->GetFusedCacheSize() == cached;
+        passed &= cache_ok;
+        std::cout << "  Кэш: " << cached << " kernels, повтор цепочки без сборки  "
+                  << (cache_ok ? "✅" : "❌") << "\n\n";
+
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_vector_expr
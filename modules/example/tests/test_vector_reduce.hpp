@@ -0,0 +1,227 @@
+#pragma once
+/**
+ * @file test_vector_reduce.hpp
+ * @brief Тест сегментированных редукций VectorOpsModule на CPU-устройстве OpenCL
+ *
+ * CPU-устройство (Intel / PoCL) берётся через OpenCLBackendExternal: DrvGPU
+ * сам открывает только GPU. Если CPU-устройства нет — тест идёт на GPU 0.
+ *
+ * 1. Sum / Mean / Energy / Min / Max для float и complex на [beams × n]
+ *    против CPU (double), n — от меньше одной группы до многих групп
+ * 2. Min/Max: при двух одинаковых экстремумах — индекс первого
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "vector_ops_module.hpp"
+#include "common/backend_type.hpp"
+#include "DrvGPU/backends/opencl/opencl_backend_external.hpp"
+#include "DrvGPU/memory/memory_manager.hpp"
+
+#include <CL/cl.h>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace test_vector_reduce {
+
+using namespace drv_gpu_lib;
+
+/**
+ * @brief Контекст и очередь на первом CPU-устройстве OpenCL (если есть)
+ */
+struct CpuDeviceContext {
+    cl_device_id device = nullptr;
+    cl_context context = nullptr;
+    cl_command_queue queue = nullptr;
+
+    bool Open() {
+        cl_uint num_platforms = 0;
+        if (clGetPlatformIDs(0, nullptr, &num_platforms) != CL_SUCCESS || num_platforms == 0) {
+            return false;
+        }
+        std::vector<cl_platform_id> platforms(num_platforms);
+        clGetPlatformIDs(num_platforms, platforms.data(), nullptr);
+
+        for (cl_platform_id platform : platforms) {
+            if (clGetDeviceIDs(platform, CL_DEVICE_TYPE_CPU, 1, &device, nullptr) != CL_SUCCESS) {
+                continue;
+            }
+            cl_int err;
+            context = clCreateContext(nullptr, 1, &device, nullptr, nullptr, &err);
+            if (err != CL_SUCCESS) {
+                continue;
+            }
+            queue = clCreateCommandQueue(context, device, 0, &err);
+            if (err != CL_SUCCESS) {
+                clReleaseContext(context);
+                context = nullptr;
+                continue;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    ~CpuDeviceContext() {
+        if (queue) clReleaseCommandQueue(queue);
+        if (context) clReleaseContext(context);
+    }
+};
+
+struct Expected {
+    std::complex<double> value;
+    size_t index = 0;
+};
+
+/// Ключ Min/Max: x для float, |x| для complex
+inline double ReduceKey(float x) { return x; }
+inline double ReduceKey(std::complex<float> x) { return std::abs(std::complex<double>(x)); }
+
+/// Эталон по одному сегменту (double)
+template <typename T>
+inline Expected Reference(VectorReduceOp op, const T* row, size_t n) {
+    Expected e;
+    switch (op) {
+        case VectorReduceOp::Sum:
+        case VectorReduceOp::Mean:
+            for (size_t i = 0; i < n; ++i) e.value += std::complex<double>(row[i]);
+            if (op == VectorReduceOp::Mean) e.value /= static_cast<double>(n);
+            break;
+        case VectorReduceOp::Energy:
+            for (size_t i = 0; i < n; ++i) e.value += std::norm(std::complex<double>(row[i]));
+            break;
+        case VectorReduceOp::Min:
+        case VectorReduceOp::Max:
+            e.value = ReduceKey(row[0]);
+            for (size_t i = 1; i < n; ++i) {
+                double k = ReduceKey(row[i]);
+                if ((op == VectorReduceOp::Min && k < e.value.real()) ||
+                    (op == VectorReduceOp::Max && k > e.value.real())) {
+                    e.value = k;
+                    e.index = i;
+                }
+            }
+            break;
+    }
+    return e;
+}
+
+/// Данные [-1, 1] + два одинаковых максимума и два одинаковых минимума
+template <typename T>
+inline std::vector<T> MakeData(size_t beams, size_t n, T high, T low) {
+    std::vector<T> data(beams * n);
+    for (size_t b = 0; b < beams; ++b) {
+        T* row = data.data() + b * n;
+        for (size_t i = 0; i < n; ++i) {
+            float phase = 0.37f * i + 1.3f * b;
+            if constexpr (std::is_same<T, float>::value) {
+                row[i] = std::sin(phase) * 0.9f;
+            } else {
+                row[i] = T(0.6f * std::cos(phase), 0.6f * std::sin(1.7f * phase)) + T(0.05f, 0.0f);
+            }
+        }
+        row[n / 4] = row[n / 2] = high;
+        row[3 * n / 4] = row[n - 1] = low;
+    }
+    return data;
+}
+
+template <typename T>
+inline bool CheckAll(VectorOpsModule& module, MemoryManager& mem_mgr,
+                     size_t beams, size_t n, T high, T low, const char* type) {
+    auto data = MakeData<T>(beams, n, high, low);
+    auto gpu_data = mem_mgr.CreateBuffer<T>(data.data(), data.size());
+
+    bool passed = true;
+    const VectorReduceOp ops[] = {
+        VectorReduceOp::Sum, VectorReduceOp::Mean, VectorReduceOp::Energy,
+        VectorReduceOp::Min, VectorReduceOp::Max
+    };
+
+    for (auto op : ops) {
+        auto results = module.ReduceSegments(op, gpu_data, beams, n);
+
+        double err = 0.0;
+        bool index_ok = true;
+        for (size_t b = 0; b < beams; ++b) {
+            Expected e = Reference(op, data.data() + b * n, n);
+            double scale = 1.0;
+            if (op == VectorReduceOp::Sum || op == VectorReduceOp::Energy) {
+                scale = std::max(1.0, static_cast<double>(n));
+            }
+            err = std::max(err, std::abs(std::complex<double>(results[b].value) - e.value) / scale);
+            if (op == VectorReduceOp::Min || op == VectorReduceOp::Max) {
+                index_ok &= results[b].index == e.index;
+            }
+        }
+
+        bool ok = err < 1.0e-5 && index_ok;
+        passed &= ok;
+        std::cout << "  " << std::left << std::setw(8) << type << std::setw(7)
+                  << VectorOpsModule::ReduceOpName(op) << std::right << " n = " << std::setw(6) << n
+                  << std::scientific << std::setprecision(2) << "  err = " << err
+                  << (index_ok ? "" : "  (index!)") << "  " << (ok ? "✅" : "❌") << "\n";
+    }
+    return passed;
+}
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║   TEST: VectorOpsModule — редукции [beams × N]           ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        // CPU-устройство через external backend, иначе GPU 0
+        CpuDeviceContext cpu;
+        std::unique_ptr<OpenCLBackendExternal> cpu_backend;
+        std::unique_ptr<DrvGPU> gpu;
+        IBackend* backend = nullptr;
+
+        if (cpu.Open()) {
+            cpu_backend = std::make_unique<OpenCLBackendExternal>();
+            cpu_backend->InitializeFromExternalContext(cpu.context, cpu.device, cpu.queue);
+            backend = cpu_backend.get();
+            std::cout << "  ✅ CPU device: " << backend->GetDeviceName() << "\n";
+        } else {
+            gpu = std::make_unique<DrvGPU>(BackendType::OPENCL, 0);
+            gpu->Initialize();
+            backend = &gpu->GetBackend();
+            std::cout << "  ⚠️  CPU-устройство OpenCL не найдено, GPU: " << gpu->GetDeviceName() << "\n";
+        }
+
+        MemoryManager mem_mgr(backend);
+        VectorOpsModule module(backend);
+        module.Initialize();
+        std::cout << "  Редукция в группе: "
+                  << (module.HasSubgroupReduce() ? "sub-groups" : "дерево в local memory") << "\n\n";
+
+        const size_t beams = 5;
+        const size_t sizes[] = { 5, 300, 1000, 70001 };
+        const std::complex<float> high(3.0f, 4.0f);     // |x| = 5
+        const std::complex<float> low(0.0f, 0.0f);      // |x| = 0
+
+        bool passed = true;
+        for (size_t n : sizes) {
+            passed &= CheckAll<float>(module, mem_mgr, beams, n, 5.0f, -5.0f, "float");
+            passed &= CheckAll<std::complex<float>>(module, mem_mgr, beams, n, high, low, "complex");
+        }
+
+        std::cout << "\n  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_vector_reduce
@@ -12,7 +12,9 @@
  */
 
 #include "interface/antenna_fft_params.h"
+#include "dechirp_reference.hpp"
 #include "interface/i_backend.hpp"
+#include "common/warmup.hpp"
 
 #include <CL/cl.h>
 #include <clFFT.h>
@@ -129,6 +131,24 @@ public:
      */
     const AntennaFFTParams& GetParams() const { return params_; }
 
+    /**
+     * @brief Гетеродин ЛЧМ в pre-callback (dechirp перед FFT)
+     *
+     * Каждый луч умножается на сопряжённый опорный ЛЧМ, вычисляемый на лету
+     * (без буфера опоры и без отдельного прохода). Эхо с задержкой τ становится
+     * тоном биений -k·τ, который находит обычный поиск максимумов.
+     * lfm.apply_heterodyne == false выключает гетеродин.
+     *
+     * @throws std::invalid_argument если ЛЧМ невалиден или sample_rate
+     *         не совпадает с AntennaFFTParams::sample_rate
+     */
+    void SetHeterodyne(const LFMParameters& lfm);
+
+    /**
+     * @brief Включён ли гетеродин
+     */
+    bool IsHeterodyneEnabled() const { return dechirp_.enabled; }
+
     /**
      * @brief Получить данные профилирования по пакетам
      */
@@ -139,6 +159,31 @@ public:
      */
     bool WasBatchModeUsed() const { return last_used_batch_mode_; }
 
+    /**
+     * @brief Сколько раз пакет уменьшался из-за нехватки памяти устройства
+     */
+    size_t GetMemoryDegradations() const { return memory_degradations_; }
+
+    /**
+     * @brief Прогрев до первого кадра
+     *
+     * 1. Буферы под наибольший ожидаемый пакет (config.allocate_pools)
+     * 2. Планы FFT под все ожидаемые размеры пакета, включая хвост
+     *    (beam_count % beams_per_batch) и config.batch_sizes
+     * 3. Кадр из нулей (config.run_dummy_frame): JIT kernels, первый запуск
+     *
+     * Kernels компилируются ещё в конструкторе. Безопасно вызывать на
+     * рабочем потоке (drv_gpu_lib::RunWarmupTasks), но не одновременно
+     * с обработкой на этом же объекте.
+     */
+    void Warmup(const drv_gpu_lib::WarmupConfig& config);
+
+    /**
+     * @brief Размеры пакета, которые встретятся при обработке кадра
+     * (по убыванию: полный пакет, затем хвост)
+     */
+    std::vector<size_t> GetExpectedBatchSizes() const;
+
 protected:
     // ═══════════════════════════════════════════════════════════════════════════
     // Виртуальные методы (реализуются производными классами)
@@ -182,6 +227,25 @@ protected:
      */
     virtual void ReleaseBuffers() = 0;
 
+    /**
+     * @brief Испечь планы FFT под размеры пакета (для Warmup)
+     * По умолчанию ничего не делает: план создаётся при первой обработке
+     */
+    virtual void PrebakePlans(const std::vector<size_t>& batch_sizes);
+
+    /**
+     * @brief Выделить буферы, уменьшая пакет при нехватке памяти
+     *
+     * Если AllocateBuffers(num_beams) не удался (и после колбэков
+     * освобождения MemoryManager), размер пересчитывается через
+     * BatchManager::RecalculateAfterAllocationFailure и запоминается в
+     * batch_config_.beams_per_batch — кадр досчитывается меньшими пакетами.
+     *
+     * @return Число лучей, на которое выделены буферы (<= num_beams)
+     * @throws std::runtime_error если не выделить даже на один луч
+     */
+    size_t AllocateBuffersDegrading(size_t num_beams);
+
     // ═══════════════════════════════════════════════════════════════════════════
     // Защищённые утилиты (общая реализация)
     // ═══════════════════════════════════════════════════════════════════════════
@@ -227,15 +291,34 @@ protected:
     cl_mem CreateInputBuffer(const std::vector<std::complex<float>>& input_data);
 
     /**
-     * @brief Создать буфер userdata для pre-callback
+     * @brief Подготовить буфер userdata для pre-callback
+     *
+     * Буфер пересоздаётся только если мал для num_beams, иначе
+     * переписывается заголовок: cl_mem, запомненный испечёнными планами,
+     * остаётся действительным при смене размера пакета.
      */
     void CreatePreCallbackUserData(size_t num_beams);
 
     /**
-     * @brief Создать буфер userdata для post-callback
+     * @brief Подготовить буфер userdata для post-callback (как pre-callback)
      */
     void CreatePostCallbackUserData(size_t num_beams);
 
+    /**
+     * @brief Буфер существует и вмещает size_bytes
+     */
+    static bool HasCapacity(cl_mem mem, size_t size_bytes);
+
+    /**
+     * @brief Учесть буфер в MemoryManager бэкенда под меткой "AntennaFFT/<purpose>"
+     */
+    void TrackBuffer(cl_mem mem, const char* purpose);
+
+    /**
+     * @brief Снять учёт, освободить буфер и обнулить хэндл
+     */
+    void ReleaseTrackedBuffer(cl_mem& mem);
+
     /**
      * @brief Профилировать событие OpenCL
      */
@@ -273,6 +356,7 @@ protected:
     // Буферы userdata для колбэков
     cl_mem pre_callback_userdata_;         // Userdata для pre-callback
     cl_mem post_callback_userdata_;        // Userdata для post-callback
+    DechirpReference dechirp_;             // Опорный ЛЧМ для pre-callback (гетеродин)
 
     // Профилирование
     FFTProfilingResults last_profiling_results_;
@@ -283,6 +367,7 @@ protected:
     // Конфигурация пакетов
     BatchConfig batch_config_;
     size_t current_buffer_beams_;          // Текущий выделенный размер буфера
+    size_t memory_degradations_;           // Уменьшений пакета из-за нехватки памяти
 };
 
 } // namespace antenna_fft
@@ -7,7 +7,8 @@
  * Высокопроизводительная реализация с pre/post колбэками clFFT
  * для zero-copy обработки на GPU.
  *
- * Конвейер: pre-callback (дополнение) -> FFT -> post-callback (амплитуда + выбор)
+ * Конвейер: pre-callback (дополнение) -> FFT -> post-callback (задержка + амплитуда + выбор)
+ *           -> поиск пиков в выбранном окне
  *
  * @author DrvGPU Team
  * @date 2026-02-04
@@ -16,8 +17,12 @@
 #include "antenna_fft_core.h"
 #include "kernels/fft_kernel_sources.hpp"
 #include "fft_plan_cache.hpp"
+#include "interface/combined_delay_param.h"
+#include "memory/memory_manager.hpp"
 
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace antenna_fft {
 
@@ -31,11 +36,17 @@ namespace antenna_fft {
  * Конвейер:
  * 1. Pre-callback: чтение входных данных + дополнение до nFFT
  * 2. clFFT: прямое FFT
- * 3. Post-callback: fftshift + расчёт амплитуды + выбор out_count_points_fft
+ * 3. Post-callback: (опц.) задержка лучей фазовым наклоном + fftshift +
+ *    расчёт амплитуды + выбор out_count_points_fft
+ * 4. find_selected_maxima: max_peaks_count пиков в выбранном окне
+ *
+ * Задержка в частотной области не требует отдельного прохода по nFFT × лучей:
+ * она выполняется в том же post-callback, что и подготовка к поиску максимумов.
  *
  * Использование:
  * ```cpp
  * AntennaFFTProcMax fft(params, backend);
+ * fft.SetBeamDelays(combined_delays, center_frequency);   // опционально
  * auto result = fft.ProcessNew(input_data);
  * ```
  */
@@ -59,6 +70,45 @@ public:
     AntennaFFTProcMax(AntennaFFTProcMax&&) noexcept = default;
     AntennaFFTProcMax& operator=(AntennaFFTProcMax&&) noexcept = default;
 
+    // ═══════════════════════════════════════════════════════════════════════════
+    // Задержка лучей в частотной области (processFFTPost)
+    // ═══════════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Задать задержки лучей из CombinedDelayParam
+     *
+     * τ_b = sin(delay_degrees) / (2 · center_frequency) + delay_time_ns · 1e-9,
+     * D_b = τ_b · sample_rate (требуется params.sample_rate > 0).
+     * Угловая часть учитывается только при center_frequency > 0.
+     * Лучи без записи не задерживаются.
+     *
+     * @throws std::invalid_argument если params.sample_rate не задан
+     */
+    void SetBeamDelays(const std::vector<CombinedDelayParam>& delays, float center_frequency = 0.0f);
+
+    /**
+     * @brief Задать задержки лучей в отсчётах (размер = beam_count)
+     *
+     * Положительная задержка задерживает луч, отрицательная — компенсирует.
+     * Сдвиг циклический по nFFT.
+     */
+    void SetBeamDelaySamples(const std::vector<float>& delay_samples);
+
+    /**
+     * @brief Отключить задержку лучей
+     */
+    void ClearBeamDelays();
+
+    /**
+     * @brief Включена ли задержка лучей
+     */
+    bool HasBeamDelays() const { return !beam_delay_samples_.empty(); }
+
+    /**
+     * @brief Кэш планов FFT (статистика, проверка прогрева)
+     */
+    const FFTPlanCache* GetPlanCache() const { return plan_cache_.get(); }
+
 protected:
     // ═══════════════════════════════════════════════════════════════════════════
     // Реализации виртуальных методов
@@ -93,6 +143,11 @@ protected:
      */
     void ReleaseBuffers() override;
 
+    /**
+     * @brief Испечь планы с колбэками под каждый размер (в кэш планов)
+     */
+    void PrebakePlans(const std::vector<size_t>& batch_sizes) override;
+
 private:
     // ═══════════════════════════════════════════════════════════════════════════
     // Приватные методы
@@ -104,19 +159,27 @@ private:
      */
     void CreateFFTPlanWithCallbacks(size_t num_beams);
 
+    /**
+     * @brief Один проход выделения буферов (без повтора)
+     * @throws std::runtime_error при неудаче (выделенное уже освобождено)
+     */
+    void CreateBuffers(size_t num_beams);
+
     /**
      * @brief Выполнить FFT с колбэками
      * @param input_signal Буфер входных данных
      * @param num_beams Количество лучей для обработки
      * @param start_beam Начальный индекс луча (для батчинга)
      * @param out_fft_event Событие завершения FFT
+     * @param direction Направление (план с колбэками предназначен для прямого)
      * @return true при успехе
      */
     bool ExecuteFFTWithCallbacks(
         cl_mem input_signal,
         size_t num_beams,
         size_t start_beam,
-        cl_event* out_fft_event);
+        cl_event* out_fft_event,
+        FFTDirection direction = FFTDirection::Forward);
 
     /**
      * @brief Прочитать результаты с GPU после FFT
@@ -126,6 +189,49 @@ private:
      */
     std::vector<FFTResult> ReadResults(size_t num_beams, size_t start_beam);
 
+    /**
+     * @brief Подготовить буферы userdata под num_beams
+     *
+     * Планы clFFT хранят cl_mem userdata, переданный в clfftSetPlanCallback.
+     * Если буфер пришлось пересоздать (вырос пакет), закешированные планы
+     * сбрасываются.
+     */
+    void PrepareCallbackUserData(size_t num_beams);
+
+    /**
+     * @brief Сбросить все планы (кэш и текущий)
+     */
+    void InvalidatePlans();
+
+    /**
+     * @brief Подготовить userdata колбэков пакета и таблицу задержек
+     * @param start_beam Начальный индекс луча (для выборки задержек)
+     * @param num_beams Количество лучей в пакете
+     */
+    void UpdateCallbackUserData(size_t start_beam, size_t num_beams);
+
+    /**
+     * @brief Записать apply_delay в заголовок post-callback, если он изменился
+     *
+     * Флаг меняется только в SetBeamDelaySamples / ClearBeamDelays и при пересборке
+     * заголовка (PrepareCallbackUserData), а не на каждом пакете.
+     */
+    void SyncApplyDelayFlag();
+
+    /**
+     * @brief Дождаться записи таблицы задержек (перед повторным заполнением staging)
+     */
+    void WaitDelayTableWrite();
+
+    /**
+     * @brief Запустить поиск пиков по выбранному окну (после FFT)
+     * @return Время kernel (мс)
+     */
+    double RunSelectedMaxima(size_t num_beams);
+
+    void CreateMaximaKernel();
+    void ReleaseMaximaKernel();
+
     // ═══════════════════════════════════════════════════════════════════════════
     // Приватные поля
     // ═══════════════════════════════════════════════════════════════════════════
@@ -136,9 +242,30 @@ private:
 
     // Параметры закешированного плана
     size_t plan_num_beams_;                // Количество лучей, для которого создан план
+    size_t userdata_beams_;                // Количество лучей в раскладке userdata колбэков
+
+    // Поиск пиков по окну processFFTPost
+    cl_program maxima_program_;            // Программа find_selected_maxima
+    cl_kernel maxima_kernel_;              // Kernel find_selected_maxima
+
+    // Задержки лучей в отсчётах (пусто → задержка выключена)
+    std::vector<float> beam_delay_samples_;
+
+    // apply_delay, записанный в заголовок post_callback_userdata_
+    cl_uint written_apply_delay_;
+
+    // Таблица задержек пакета (источник неблокирующей записи; живёт до delay_write_event_)
+    struct EventReleaser {
+        void operator()(cl_event event) const { clReleaseEvent(event); }
+    };
+    std::vector<float> delay_cycles_staging_;
+    std::unique_ptr<std::remove_pointer_t<cl_event>, EventReleaser> delay_write_event_;
 
     // Кэш FFT-планов (избегаем дорогого пересоздания)
     std::unique_ptr<FFTPlanCache> plan_cache_;
+
+    // Колбэк нехватки памяти (EvictIdle кэша планов); снимается раньше plan_cache_
+    drv_gpu_lib::EvictionRegistration plan_eviction_;
 };
 
 } // namespace antenna_fft
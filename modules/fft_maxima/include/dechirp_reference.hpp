@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * @file dechirp_reference.hpp
+ * @brief Гетеродин (dechirp) ЛЧМ в pre-callback FFT: заголовок userdata и фаза опоры
+ *
+ * Опорный ЛЧМ не хранится в памяти — pre-callback вычисляет его фазу
+ * для каждого отсчёта из двух 64-битных констант заголовка и умножает
+ * принятый сигнал на сопряжённую опору:
+ *
+ *   y[n] = x[n] · exp(-j·2π·(f_start·n/fs + (k/2)·(n/fs)²)),  k = (f_stop - f_start) / T
+ *
+ * Фаза хранится в циклах как 64-битная дробь с фиксированной точкой:
+ *   phase_fx(n) = phase_step · n + phase_curve · n²   (по модулю 2^64 = по модулю 1 цикла)
+ * Переполнение ulong в kernel даёт точное приведение фазы к [0, 1) без double.
+ *
+ * Эхо с задержкой τ после dechirp — тон на частоте биений f_b = -k·τ
+ * (отрицательная половина спектра), который находит обычный поиск максимума.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "interface/lfm_parameters.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <stdexcept>
+
+namespace antenna_fft {
+
+// ════════════════════════════════════════════════════════════════════════════
+// Заголовок userdata pre-callback (prepareDataPre)
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @struct PreCallbackHeader
+ * @brief Первые 32 байта userdata pre-callback (должны совпадать с GPU структурой!)
+ *
+ * За заголовком — входные данные [beam_count × count_points] complex<float>.
+ */
+struct PreCallbackHeader {
+    uint32_t beam_count;        ///< Лучей в userdata
+    uint32_t count_points;      ///< Отсчётов на луч
+    uint32_t nFFT;              ///< Размер FFT (дополнение нулями)
+    uint32_t dechirp;           ///< 1 = умножать на сопряжённую опору
+    uint64_t phase_step;        ///< f_start / fs в циклах на отсчёт (дробь 2^-64)
+    uint64_t phase_curve;       ///< k / (2·fs²) в циклах на отсчёт² (дробь 2^-64)
+};
+static_assert(sizeof(PreCallbackHeader) == 32, "PreCallbackHeader must be 32 bytes");
+
+// ════════════════════════════════════════════════════════════════════════════
+// Опорный ЛЧМ
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @struct DechirpReference
+ * @brief Фаза опорного ЛЧМ в формате заголовка pre-callback
+ */
+struct DechirpReference {
+    bool enabled = false;
+    uint64_t phase_step = 0;
+    uint64_t phase_curve = 0;
+
+    /**
+     * @brief Дробная часть числа циклов → 64-битная дробь с фиксированной точкой
+     */
+    static uint64_t ToFixedCycles(double cycles) {
+        double frac = cycles - std::floor(cycles);       // [0, 1)
+        double scaled_hi = std::ldexp(frac, 32);
+        double hi = std::floor(scaled_hi);
+        double lo = std::floor(std::ldexp(scaled_hi - hi, 32));
+        return (static_cast<uint64_t>(hi) << 32) | static_cast<uint64_t>(lo);
+    }
+
+    /**
+     * @brief Опора по LFMParameters (apply_heterodyne == false → выключено)
+     * @throws std::invalid_argument если параметры ЛЧМ невалидны
+     */
+    static DechirpReference FromLFM(const LFMParameters& lfm) {
+        DechirpReference ref;
+        if (!lfm.apply_heterodyne) {
+            return ref;
+        }
+        if (!lfm.IsValid()) {   // IsValid() также вычисляет duration
+            throw std::invalid_argument("DechirpReference: invalid LFMParameters");
+        }
+
+        const double fs = static_cast<double>(lfm.sample_rate);
+        const double duration = static_cast<double>(lfm.count_points) / fs;
+        const double chirp_rate =
+            (static_cast<double>(lfm.f_stop) - static_cast<double>(lfm.f_start)) / duration;
+
+        ref.enabled = true;
+        ref.phase_step = ToFixedCycles(static_cast<double>(lfm.f_start) / fs);
+        ref.phase_curve = ToFixedCycles(0.5 * chirp_rate / (fs * fs));
+        return ref;
+    }
+};
+
+/**
+ * @brief Заполнить заголовок pre-callback
+ */
+inline PreCallbackHeader MakePreCallbackHeader(
+    size_t beam_count, size_t count_points, size_t nFFT,
+    const DechirpReference& dechirp) {
+    PreCallbackHeader header;
+    header.beam_count = static_cast<uint32_t>(beam_count);
+    header.count_points = static_cast<uint32_t>(count_points);
+    header.nFFT = static_cast<uint32_t>(nFFT);
+    header.dechirp = dechirp.enabled ? 1u : 0u;
+    header.phase_step = dechirp.phase_step;
+    header.phase_curve = dechirp.phase_curve;
+    return header;
+}
+
+} // namespace antenna_fft
@@ -19,10 +19,14 @@
  *     Batch 4 (next call): 10 beams → create plan(10) AGAIN!
  *
  * РЕШЕНИЕ:
- *   FFTPlanCache хранит пул планов по ключу (nFFT, batch_size).
+ *   FFTPlanCache хранит пул планов по ключу (nFFT, batch_size, direction, placement).
  *   Планы создаются один раз и переиспользуются.
  *   При уничтожении кеша все планы корректно освобождаются.
  *
+ *   direction и placement в ключе позволяют держать в одном кэше прямой план
+ *   с колбэками и обратный план (без колбэков / in-place) того же размера —
+ *   цепочки FFT → обработка → IFFT без ручного создания планов в модуле.
+ *
  * ИСПОЛЬЗОВАНИЕ:
  *   FFTPlanCache cache(context, queue);
  *
@@ -37,6 +41,11 @@
  *
  *   // Снова 10: мгновенно
  *   auto& plan4 = cache.GetOrCreate(nFFT, 10);
+ *
+ *   // Обратный in-place план (без колбэков) — испечь и выполнить
+ *   FFTPlanKey inv{nFFT, 10, FFTDirection::Backward, FFTPlacement::InPlace};
+ *   cache.GetBaked(inv);
+ *   cache.Enqueue(inv, spectrum, nullptr, 0, nullptr, &event);
  * ============================================================================
  *
  * @author Codo (AI Assistant)
@@ -47,12 +56,44 @@
 #include <CL/cl.h>
 
 #include <map>
+#include <mutex>
+#include <tuple>
 #include <string>
 #include <stdexcept>
 #include <iostream>
 
 namespace antenna_fft {
 
+// ============================================================================
+// Направление и размещение результата
+// ============================================================================
+
+/**
+ * @enum FFTDirection
+ * @brief Направление преобразования, для которого предназначен план
+ *
+ * clFFT задаёт направление при постановке в очередь, но колбэки
+ * (pre/post) привязаны к плану — прямой и обратный планы одного размера
+ * обычно различаются колбэками, поэтому направление входит в ключ.
+ */
+enum class FFTDirection {
+    Forward,    ///< CLFFT_FORWARD
+    Backward    ///< CLFFT_BACKWARD (clFFT масштабирует на 1/nFFT)
+};
+
+/**
+ * @enum FFTPlacement
+ * @brief Размещение результата (задаётся при создании плана)
+ */
+enum class FFTPlacement {
+    OutOfPlace, ///< CLFFT_OUTOFPLACE: input → output
+    InPlace     ///< CLFFT_INPLACE: результат в input
+};
+
+inline clfftDirection ToClfftDirection(FFTDirection direction) {
+    return direction == FFTDirection::Backward ? CLFFT_BACKWARD : CLFFT_FORWARD;
+}
+
 // ============================================================================
 // FFTPlanKey — уникальный ключ плана в кэше
 // ============================================================================
@@ -64,20 +105,25 @@ namespace antenna_fft {
  * План однозначно задаётся:
  * - nFFT: размер FFT (напр., 2048, 4096)
  * - batch_size: количество FFT в пакете (напр., 10, 32)
+ * - direction: прямой / обратный
+ * - placement: out-of-place / in-place
  */
 struct FFTPlanKey {
-    size_t nFFT;        ///< Размер FFT
-    size_t batch_size;  ///< Количество преобразований в пакете
+    size_t nFFT;                                        ///< Размер FFT
+    size_t batch_size;                                  ///< Количество преобразований в пакете
+    FFTDirection direction = FFTDirection::Forward;     ///< Направление
+    FFTPlacement placement = FFTPlacement::OutOfPlace;  ///< Размещение результата
 
     /// Оператор сравнения для std::map
     bool operator<(const FFTPlanKey& other) const {
-        if (nFFT != other.nFFT) return nFFT < other.nFFT;
-        return batch_size < other.batch_size;
+        return std::tie(nFFT, batch_size, direction, placement) <
+               std::tie(other.nFFT, other.batch_size, other.direction, other.placement);
     }
 
     /// Оператор равенства
     bool operator==(const FFTPlanKey& other) const {
-        return nFFT == other.nFFT && batch_size == other.batch_size;
+        return nFFT == other.nFFT && batch_size == other.batch_size &&
+               direction == other.direction && placement == other.placement;
     }
 };
 
@@ -95,6 +141,8 @@ struct FFTPlanEntry {
     size_t use_count = 0;           ///< Сколько раз план использовался
     size_t nFFT = 0;                ///< Размер FFT
     size_t batch_size = 0;          ///< Размер пакета
+    FFTDirection direction = FFTDirection::Forward;     ///< Направление
+    FFTPlacement placement = FFTPlacement::OutOfPlace;  ///< Размещение результата
 };
 
 // ============================================================================
@@ -105,12 +153,15 @@ struct FFTPlanEntry {
  * @class FFTPlanCache
  * @brief Управляет кэшем планов clFFT для разных конфигураций
  *
- * Планы кэшируются по ключу (nFFT, batch_size).
- * Кэш НЕ потокобезопасен (используется из одного потока GPU).
+ * Планы кэшируются по ключу (nFFT, batch_size, direction, placement).
+ * Кэш используется из одного потока GPU; карта планов под mutex_ только
+ * ради EvictIdle(), который приходит из колбэка нехватки памяти
+ * (MemoryManager) в любом потоке.
  *
  * Управление памятью:
  * - Планы освобождаются в деструкторе (RAII)
  * - ClearAll() можно вызвать для принудительного освобождения
+ * - EvictIdle() освобождает все планы, кроме последнего полученного
  */
 class FFTPlanCache {
 public:
@@ -144,7 +195,9 @@ public:
           queue_(other.queue_),
           cache_(std::move(other.cache_)),
           total_creates_(other.total_creates_),
-          total_hits_(other.total_hits_) {
+          total_hits_(other.total_hits_),
+          last_key_(other.last_key_),
+          has_last_key_(other.has_last_key_) {
         other.context_ = nullptr;
         other.queue_ = nullptr;
     }
@@ -155,18 +208,19 @@ public:
 
     /**
      * @brief Получить или создать план для заданной конфигурации
-     * @param nFFT Размер FFT
-     * @param batch_size Количество преобразований в пакете
+     * @param key Ключ плана (nFFT, batch_size, direction, placement)
      * @return Хэндл плана (готов к использованию после Bake)
      *
      * Если план есть в кэше: возврат сразу (попадание в кэш)
      * Если нет: создаётся новый план и добавляется в кэш (промах кэша)
      *
-     * ВАЖНО: Возвращённый план НЕ испечён! Вызвать BakeIfNeeded() или
-     *        вручную bake с колбэками перед использованием.
+     * ВАЖНО: Возвращённый план НЕ испечён! Вызвать GetBaked() (без колбэков)
+     *        или вручную bake с колбэками и MarkBaked() перед использованием.
      */
-    clfftPlanHandle GetOrCreate(size_t nFFT, size_t batch_size) {
-        FFTPlanKey key{nFFT, batch_size};
+    clfftPlanHandle GetOrCreate(const FFTPlanKey& key) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        last_key_ = key;
+        has_last_key_ = true;
 
         auto it = cache_.find(key);
         if (it != cache_.end()) {
@@ -178,11 +232,13 @@ public:
 
         // Промах кэша — создаём новый план
         FFTPlanEntry entry;
-        entry.nFFT = nFFT;
-        entry.batch_size = batch_size;
+        entry.nFFT = key.nFFT;
+        entry.batch_size = key.batch_size;
+        entry.direction = key.direction;
+        entry.placement = key.placement;
 
         // Создание плана
-        size_t dim = nFFT;
+        size_t dim = key.nFFT;
         clfftStatus status = clfftCreateDefaultPlan(&entry.handle, context_, CLFFT_1D, &dim);
         if (status != CLFFT_SUCCESS) {
             throw std::runtime_error(
@@ -192,11 +248,12 @@ public:
         // Настройка плана
         clfftSetPlanPrecision(entry.handle, CLFFT_SINGLE);
         clfftSetLayout(entry.handle, CLFFT_COMPLEX_INTERLEAVED, CLFFT_COMPLEX_INTERLEAVED);
-        clfftSetResultLocation(entry.handle, CLFFT_OUTOFPLACE);
-        clfftSetPlanBatchSize(entry.handle, batch_size);
+        clfftSetResultLocation(entry.handle,
+            key.placement == FFTPlacement::InPlace ? CLFFT_INPLACE : CLFFT_OUTOFPLACE);
+        clfftSetPlanBatchSize(entry.handle, key.batch_size);
 
         size_t strides[1] = {1};
-        size_t dist = nFFT;
+        size_t dist = key.nFFT;
         clfftSetPlanInStride(entry.handle, CLFFT_1D, strides);
         clfftSetPlanOutStride(entry.handle, CLFFT_1D, strides);
         clfftSetPlanDistance(entry.handle, dist, dist);
@@ -210,49 +267,123 @@ public:
         return entry.handle;
     }
 
+    /**
+     * @brief Получить или создать прямой out-of-place план (совместимость)
+     */
+    clfftPlanHandle GetOrCreate(size_t nFFT, size_t batch_size,
+                                FFTDirection direction = FFTDirection::Forward,
+                                FFTPlacement placement = FFTPlacement::OutOfPlace) {
+        return GetOrCreate(FFTPlanKey{nFFT, batch_size, direction, placement});
+    }
+
+    /**
+     * @brief Получить испечённый план без колбэков (создать и испечь при промахе)
+     *
+     * Для планов с колбэками использовать GetOrCreate() + clfftSetPlanCallback
+     * + clfftBakePlan + MarkBaked().
+     */
+    clfftPlanHandle GetBaked(const FFTPlanKey& key) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        clfftPlanHandle handle = GetOrCreate(key);
+        if (IsBaked(key)) {
+            return handle;
+        }
+
+        clfftStatus status = clfftBakePlan(handle, 1, &queue_, nullptr, nullptr);
+        if (status != CLFFT_SUCCESS) {
+            Remove(key);
+            throw std::runtime_error(
+                "[FFTPlanCache] clfftBakePlan failed: " + std::to_string(status));
+        }
+        MarkBaked(key);
+        return handle;
+    }
+
+    /**
+     * @brief Поставить преобразование в очередь по ключу
+     *
+     * Направление и размещение берутся из ключа. Для InPlace output игнорируется.
+     * @throws std::runtime_error если план не создан / не испечён или clFFT вернул ошибку
+     */
+    void Enqueue(const FFTPlanKey& key, cl_mem input, cl_mem output,
+                 cl_uint num_wait_events, const cl_event* wait_events,
+                 cl_event* out_event) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        auto it = cache_.find(key);
+        if (it == cache_.end() || !it->second.baked) {
+            throw std::runtime_error("[FFTPlanCache] Enqueue: plan is not baked (nFFT=" +
+                                     std::to_string(key.nFFT) + ", batch=" +
+                                     std::to_string(key.batch_size) + ")");
+        }
+
+        cl_mem in = input;
+        cl_mem out = output;
+        clfftStatus status = clfftEnqueueTransform(
+            it->second.handle,
+            ToClfftDirection(key.direction),
+            1, &queue_,
+            num_wait_events, wait_events,
+            out_event,
+            &in,
+            key.placement == FFTPlacement::InPlace ? nullptr : &out,
+            nullptr);
+        if (status != CLFFT_SUCCESS) {
+            throw std::runtime_error(
+                "[FFTPlanCache] clfftEnqueueTransform failed: " + std::to_string(status));
+        }
+    }
+
     /**
      * @brief Проверить, есть ли план в кэше
-     * @param nFFT Размер FFT
-     * @param batch_size Размер пакета
-     * @return true, если план закеширован
      */
-    bool HasPlan(size_t nFFT, size_t batch_size) const {
-        FFTPlanKey key{nFFT, batch_size};
+    bool HasPlan(const FFTPlanKey& key) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         return cache_.find(key) != cache_.end();
     }
 
+    bool HasPlan(size_t nFFT, size_t batch_size,
+                 FFTDirection direction = FFTDirection::Forward,
+                 FFTPlacement placement = FFTPlacement::OutOfPlace) const {
+        return HasPlan(FFTPlanKey{nFFT, batch_size, direction, placement});
+    }
+
     /**
      * @brief Проверить, испечён ли закешированный план (готов к выполнению)
-     * @param nFFT Размер FFT
-     * @param batch_size Размер пакета
-     * @return true, если план есть и испечён
      */
-    bool IsBaked(size_t nFFT, size_t batch_size) const {
-        FFTPlanKey key{nFFT, batch_size};
+    bool IsBaked(const FFTPlanKey& key) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         auto it = cache_.find(key);
         return it != cache_.end() && it->second.baked;
     }
 
+    bool IsBaked(size_t nFFT, size_t batch_size,
+                 FFTDirection direction = FFTDirection::Forward,
+                 FFTPlacement placement = FFTPlacement::OutOfPlace) const {
+        return IsBaked(FFTPlanKey{nFFT, batch_size, direction, placement});
+    }
+
     /**
      * @brief Пометить план как испечённый (вызывать после успешного clfftBakePlan)
-     * @param nFFT Размер FFT
-     * @param batch_size Размер пакета
      */
-    void MarkBaked(size_t nFFT, size_t batch_size) {
-        FFTPlanKey key{nFFT, batch_size};
+    void MarkBaked(const FFTPlanKey& key) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         auto it = cache_.find(key);
         if (it != cache_.end()) {
             it->second.baked = true;
         }
     }
 
+    void MarkBaked(size_t nFFT, size_t batch_size,
+                   FFTDirection direction = FFTDirection::Forward,
+                   FFTPlacement placement = FFTPlacement::OutOfPlace) {
+        MarkBaked(FFTPlanKey{nFFT, batch_size, direction, placement});
+    }
+
     /**
      * @brief Удалить конкретный план из кэша
-     * @param nFFT Размер FFT
-     * @param batch_size Размер пакета
      */
-    void Remove(size_t nFFT, size_t batch_size) {
-        FFTPlanKey key{nFFT, batch_size};
+    void Remove(const FFTPlanKey& key) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         auto it = cache_.find(key);
         if (it != cache_.end()) {
             if (it->second.handle) {
@@ -262,12 +393,19 @@ public:
         }
     }
 
+    void Remove(size_t nFFT, size_t batch_size,
+                FFTDirection direction = FFTDirection::Forward,
+                FFTPlacement placement = FFTPlacement::OutOfPlace) {
+        Remove(FFTPlanKey{nFFT, batch_size, direction, placement});
+    }
+
     /**
      * @brief Очистить весь кэш (освободить все планы)
      *
      * Вызывается из деструктора. Безопасно вызывать несколько раз.
      */
     void ClearAll() {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         for (auto& [key, entry] : cache_) {
             if (entry.handle) {
                 clfftDestroyPlan(&entry.handle);
@@ -275,6 +413,39 @@ public:
             }
         }
         cache_.clear();
+        has_last_key_ = false;
+    }
+
+    /**
+     * @brief Освободить все планы, кроме последнего полученного (GetOrCreate)
+     *
+     * Колбэк нехватки памяти: последний план — тот, что сейчас выполняет
+     * модуль; остальные (другие размеры пакета, хвосты) пересоздадутся
+     * при следующем обращении.
+     *
+     * @return Оценка освобождённой памяти устройства (временный буфер clFFT
+     *         + таблица поворотных множителей nFFT комплексных чисел)
+     */
+    size_t EvictIdle() {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+        size_t freed = 0;
+        for (auto it = cache_.begin(); it != cache_.end();) {
+            if (has_last_key_ && it->first == last_key_) {
+                ++it;
+                continue;
+            }
+            if (it->second.handle) {
+                size_t tmp_size = 0;
+                if (it->second.baked) {
+                    clfftGetTmpBufSize(it->second.handle, &tmp_size);
+                }
+                freed += tmp_size + it->first.nFFT * 2 * sizeof(float);
+                clfftDestroyPlan(&it->second.handle);
+            }
+            it = cache_.erase(it);
+        }
+        return freed;
     }
 
     // ========================================================================
@@ -284,22 +455,32 @@ public:
     /**
      * @brief Получить количество закешированных планов
      */
-    size_t GetCacheSize() const { return cache_.size(); }
+    size_t GetCacheSize() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return cache_.size();
+    }
 
     /**
      * @brief Получить общее число созданий планов (промахи кэша)
      */
-    size_t GetTotalCreates() const { return total_creates_; }
+    size_t GetTotalCreates() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return total_creates_;
+    }
 
     /**
      * @brief Получить общее число попаданий в кэш
      */
-    size_t GetTotalHits() const { return total_hits_; }
+    size_t GetTotalHits() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return total_hits_;
+    }
 
     /**
      * @brief Получить долю попаданий в кэш (0.0 — 1.0)
      */
     double GetHitRatio() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         size_t total = total_creates_ + total_hits_;
         return total > 0 ? static_cast<double>(total_hits_) / total : 0.0;
     }
@@ -308,6 +489,7 @@ public:
      * @brief Вывести статистику кэша
      */
     void PrintStats() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         std::cout << "\n  FFTPlanCache Statistics:\n";
         std::cout << "    Cached plans: " << cache_.size() << "\n";
         std::cout << "    Total creates: " << total_creates_ << "\n";
@@ -319,6 +501,8 @@ public:
             for (const auto& [key, entry] : cache_) {
                 std::cout << "      nFFT=" << key.nFFT
                           << " batch=" << key.batch_size
+                          << (key.direction == FFTDirection::Forward ? " fwd" : " inv")
+                          << (key.placement == FFTPlacement::InPlace ? " in-place" : " out-of-place")
                           << " baked=" << (entry.baked ? "yes" : "no")
                           << " uses=" << entry.use_count << "\n";
             }
@@ -338,6 +522,11 @@ private:
 
     size_t total_creates_ = 0;                    ///< Всего созданий планов
     size_t total_hits_ = 0;                       ///< Всего попаданий в кэш
+
+    FFTPlanKey last_key_{0, 0};                   ///< Ключ последнего GetOrCreate
+    bool has_last_key_ = false;
+
+    mutable std::recursive_mutex mutex_;          ///< Карта планов (EvictIdle из другого потока)
 };
 
 } // namespace antenna_fft
@@ -62,6 +62,7 @@ struct AntennaFFTParams {
     size_t count_points;       // Количество точек в луче (входные данные)
     size_t out_count_points_fft; // Количество точек в FFT для вывода
     size_t max_peaks_count;    // Количество максимальных значений (3-5, по умолчанию 3)
+    float sample_rate = 0.0f;  // Частота дискретизации (Гц); 0 → refined_frequency в бинах
     
     // Признаки задачи для масштабируемости
     std::string task_id;       // Идентификатор задачи
@@ -151,6 +151,27 @@ __kernel void padding_kernel(
 // ════════════════════════════════════════════════════════════════════════════
 inline const char*  GetPostKernelSource(){
     return R"CL(
+// Формат спектра (см. SpectrumStorage): задаётся через -D SPECTRUM_STORAGE=N
+//   0 = float2, 1 = half2, 2 = float |X|, 3 = half |X|
+// LOAD_BIN всегда возвращает float2; для амплитудных форматов — (|X|, 0)
+#ifndef SPECTRUM_STORAGE
+#define SPECTRUM_STORAGE 0
+#endif
+
+#if SPECTRUM_STORAGE == 1
+typedef half spectrum_t;
+#define LOAD_BIN(buf, i) vload_half2((i), (buf))
+#elif SPECTRUM_STORAGE == 2
+typedef float spectrum_t;
+#define LOAD_BIN(buf, i) ((float2)((buf)[i], 0.0f))
+#elif SPECTRUM_STORAGE == 3
+typedef half spectrum_t;
+#define LOAD_BIN(buf, i) ((float2)(vload_half((i), (buf)), 0.0f))
+#else
+typedef float2 spectrum_t;
+#define LOAD_BIN(buf, i) ((buf)[i])
+#endif
+
 // Структура результата (должна совпадать с C++ MaxValue)
 typedef struct {
     uint index;
@@ -164,7 +185,7 @@ typedef struct {
 } MaxValue;
 
 __kernel void post_kernel(
-    __global const float2* fft_output,     // FFT результат: beam_count * nFFT
+    __global const spectrum_t* fft_output, // FFT результат: beam_count * nFFT (формат SPECTRUM_STORAGE)
     __global MaxValue* maxima_output,      // Результат: beam_count * 4 структуры
     uint beam_count,
     uint nFFT,
@@ -198,7 +219,7 @@ __kernel void post_kernel(
     // Поиск в диапазоне 1: [0, half_range]
     for (uint i = lid; i < half_range; i += local_size) {
         uint fft_idx = beam_idx * nFFT + i;
-        float2 val = fft_output[fft_idx];
+        float2 val = LOAD_BIN(fft_output, fft_idx);
         float mag = sqrt(val.x * val.x + val.y * val.y);
 
         if (mag > my_max_mag) {
@@ -211,7 +232,7 @@ __kernel void post_kernel(
     uint range2_start = nFFT - half_range;
     for (uint i = range2_start + lid; i < nFFT; i += local_size) {
         uint fft_idx = beam_idx * nFFT + i;
-        float2 val = fft_output[fft_idx];
+        float2 val = LOAD_BIN(fft_output, fft_idx);
         float mag = sqrt(val.x * val.x + val.y * val.y);
 
         if (mag > my_max_mag) {
@@ -246,7 +267,7 @@ __kernel void post_kernel(
         // ШАГ 4: Читаем 3 точки: [center-1, center, center+1]
         // ═══════════════════════════════════════════════════════════════════
         float2 left_val = (float2)(0.0f, 0.0f);
-        float2 center_val = fft_output[base_fft_idx + center_idx];
+        float2 center_val = LOAD_BIN(fft_output, base_fft_idx + center_idx);
         float2 right_val = (float2)(0.0f, 0.0f);
 
         float y_left = 0.0f;
@@ -259,7 +280,7 @@ __kernel void post_kernel(
             // Проверяем что left_idx в одном из диапазонов
             uint left_idx = center_idx - 1;
             if ((left_idx < half_range) || (left_idx >= range2_start)) {
-                left_val = fft_output[base_fft_idx + left_idx];
+                left_val = LOAD_BIN(fft_output, base_fft_idx + left_idx);
                 y_left = sqrt(left_val.x * left_val.x + left_val.y * left_val.y);
                 has_left = true;
             }
@@ -271,7 +292,7 @@ __kernel void post_kernel(
             // Проверяем что right_idx в одном из диапазонов
             uint right_idx = center_idx + 1;
             if ((right_idx < half_range) || (right_idx >= range2_start)) {
-                right_val = fft_output[base_fft_idx + right_idx];
+                right_val = LOAD_BIN(fft_output, base_fft_idx + right_idx);
                 y_right = sqrt(right_val.x * right_val.x + right_val.y * right_val.y);
                 has_right = true;
             }
@@ -383,16 +404,19 @@ __kernel void post_kernel(
 //              ↑                                      ↑
 //              Параметры (beam_count, nFFT...)       input_signal
 //
-// СТРУКТУРА (32 байта):
-//   - beam_count, count_points, nFFT (используются)
-//   - padding1..padding5 (для выравнивания 32 байта = 256 бит)
+// СТРУКТУРА (32 байта, host: PreCallbackHeader в dechirp_reference.hpp):
+//   - beam_count, count_points, nFFT
+//   - dechirp: 1 = гетеродин (умножение на сопряжённый опорный ЛЧМ)
+//   - phase_step, phase_curve: фаза опоры в циклах, ulong дробь 2^-64
 //   Зачем 32 байта? Выравнивание GPU memory для оптимальной производительности
 //
 // ЛОГИКА:
 //   1. inoffset → определяем beam_idx и pos_in_fft
 //   2. Читаем из input_signal[beam_idx * count_points + pos_in_fft]
-//   3. ВОЗВРАЩАЕМ значение (clFFT использует для FFT)
-//   4. Если pos >= count_points → возвращаем (0, 0) - padding
+//   3. dechirp: x · exp(-j·2π·φ(n)), φ(n) = phase_step·n + phase_curve·n² (mod 1
+//      за счёт переполнения ulong). Опора не читается из памяти.
+//   4. ВОЗВРАЩАЕМ значение (clFFT использует для FFT)
+//   5. Если pos >= count_points → возвращаем (0, 0) - padding
 //
 // ОГРАНИЧЕНИЕ - НЕТ beam_offset:
 //   ⚠️ Callback ВСЕГДА читает с луча 0!
@@ -420,11 +444,9 @@ inline const char* GetPreCallbackSource32() {
         "    uint beam_count; "
         "    uint count_points; "
         "    uint nFFT; "
-        "    uint padding1; "
-        "    uint padding2; "
-        "    uint padding3; "
-        "    uint padding4; "
-        "    uint padding5; "
+        "    uint dechirp; "
+        "    ulong phase_step; "
+        "    ulong phase_curve; "
         "} PreCallbackUserData; "
         "float2 prepareDataPre(__global void* input, uint inoffset, __global void* userdata) { "
         "    __global PreCallbackUserData* params = (__global PreCallbackUserData*)userdata; "
@@ -439,12 +461,354 @@ inline const char* GetPreCallbackSource32() {
         "    } "
         "    if (pos_in_fft < count_points) { "
         "        uint input_idx = beam_idx * count_points + pos_in_fft; "
-        "        return input_signal[input_idx]; "
+        "        float2 x = input_signal[input_idx]; "
+        "        if (params->dechirp) { "
+        "            ulong n = pos_in_fft; "
+        "            ulong phase_fx = params->phase_step * n + params->phase_curve * (n * n); "
+        "            float cycles = (float)(phase_fx >> 40) * 5.9604644775390625e-8f; "
+        "            float c; "
+        "            float s = sincos(6.283185307179586f * cycles, &c); "
+        "            x = (float2)(x.x * c + x.y * s, x.y * c - x.x * s); "
+        "        } "
+        "        return x; "
         "    } else { "
         "        return (float2)(0.0f, 0.0f); "
         "    } "
         "}";
 }
 
+// ════════════════════════════════════════════════════════════════════════════
+// GetFFTPostCallbackSource() - clFFT Post-Callback AntennaFFTProcMax (PRODUCTION)
+// ════════════════════════════════════════════════════════════════════════════
+//
+// НАЗНАЧЕНИЕ:
+//   Один проход по спектру сразу после FFT (без отдельного kernel):
+//   1. (опционально) задержка луча фазовым наклоном: X_b[k] *= exp(-j·2π·k_s·D_b / nFFT)
+//   2. запись полного спектра в выходной буфер clFFT
+//   3. fftshift + выбор окна out_count_points_fft вокруг нуля
+//      → комплексные значения и амплитуды в userdata
+//
+// MEMORY LAYOUT:
+//   userdata = [32 байта PostCallbackUserData]
+//              [selected complex: beam_count × out_count (float2)]
+//              [selected magnitude: beam_count × out_count (float)]
+//              [delay_cycles: beam_count (float) = D_b / nFFT]
+//
+// ЗАДЕРЖКА:
+//   k_s — знаковый номер бина (k < nFFT/2 ? k : k - nFFT), D_b — задержка в отсчётах.
+//   Положительная D_b задерживает луч (как FractionalDelayModule), отрицательная —
+//   компенсирует. Сдвиг циклический по nFFT (область дополнения нулями).
+//   apply_delay == 0 → ветка не выполняется (однородно для всех work-item).
+//
+// ВЫЗЫВАЕТСЯ ИЗ:
+//   AntennaFFTProcMax::CreateFFTPlanWithCallbacks()
+//
+// ════════════════════════════════════════════════════════════════════════════
+inline const char* GetFFTPostCallbackSource() {
+    return R"CL(
+typedef struct {
+    uint beam_count;
+    uint nFFT;
+    uint out_count;
+    uint max_peaks_count;
+    uint apply_delay;
+    uint padding1;
+    uint padding2;
+    uint padding3;
+} PostCallbackUserData;
+
+void processFFTPost(__global void* output, uint outoffset, __global void* userdata, float2 fftoutput) {
+    __global PostCallbackUserData* params = (__global PostCallbackUserData*)userdata;
+    uint beam_count = params->beam_count;
+    uint nFFT = params->nFFT;
+    uint out_count = params->out_count;
+
+    uint beam_idx = outoffset / nFFT;
+    uint k = outoffset % nFFT;
+    uint half_n = nFFT / 2;
+
+    __global float2* selected = (__global float2*)((__global char*)userdata + 32);
+    __global float* magnitude = (__global float*)(selected + beam_count * out_count);
+
+    float2 X = fftoutput;
+    if (params->apply_delay) {
+        __global const float* delay_cycles = magnitude + beam_count * out_count;
+        int k_signed = (k < half_n) ? (int)k : (int)k - (int)nFFT;
+        float cycles = (float)k_signed * delay_cycles[beam_idx];
+        cycles -= rint(cycles);
+        float c;
+        float s = sincos(-6.28318530717958647f * cycles, &c);
+        X = (float2)(X.x * c - X.y * s, X.x * s + X.y * c);
+    }
+
+    ((__global float2*)output)[outoffset] = X;
+
+    // fftshift: бин k → позиция (k + nFFT/2) % nFFT, окно по центру
+    uint shifted = (k + half_n) % nFFT;
+    uint window_start = half_n - out_count / 2;
+    if (shifted >= window_start && shifted < window_start + out_count) {
+        uint j = beam_idx * out_count + (shifted - window_start);
+        selected[j] = X;
+        magnitude[j] = length(X);
+    }
+}
+)CL";
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// GetSelectedMaximaKernelSource() - поиск пиков в выбранном окне (после processFFTPost)
+// ════════════════════════════════════════════════════════════════════════════
+//
+// НАЗНАЧЕНИЕ:
+//   По амплитудам окна out_count_points_fft (userdata processFFTPost) находит
+//   max_peaks_count наибольших ЛОКАЛЬНЫХ пиков луча. Для главного пика —
+//   параболическая интерполяция частоты.
+//
+// АРХИТЕКТУРА:
+//   - Одна work-group (256) на луч, max_peaks_count проходов редукции
+//   - Выход: beam_count × max_peaks_count структур MaxValue (32 байта)
+//   - index — позиция в fftshift-спектре; частота знаковая:
+//     (index - nFFT/2 + offset) · bin_width, bin_width = sample_rate / nFFT
+//     (sample_rate == 0 → частота в бинах)
+//
+// ВЫЗЫВАЕТСЯ ИЗ:
+//   AntennaFFTProcMax::RunSelectedMaxima()
+//
+// ════════════════════════════════════════════════════════════════════════════
+inline const char* GetSelectedMaximaKernelSource() {
+    return R"CL(
+#define MAXIMA_LOCAL_SIZE 256
+#define MAX_PEAKS_LIMIT 8
+#define NO_PEAK 0xFFFFFFFFu
+
+typedef struct {
+    uint beam_count;
+    uint nFFT;
+    uint out_count;
+    uint max_peaks_count;
+    uint apply_delay;
+    uint padding1;
+    uint padding2;
+    uint padding3;
+} PostCallbackUserData;
+
+typedef struct {
+    uint index;
+    float real;
+    float imag;
+    float magnitude;
+    float phase;
+    float freq_offset;
+    float refined_frequency;
+    uint pad;
+} MaxValue;
+
+__kernel __attribute__((reqd_work_group_size(MAXIMA_LOCAL_SIZE, 1, 1)))
+void find_selected_maxima(
+    __global const uchar* userdata,     // post_callback_userdata_
+    __global MaxValue* maxima_output,   // beam_count * max_peaks_count
+    float sample_rate)
+{
+    __global const PostCallbackUserData* params = (__global const PostCallbackUserData*)userdata;
+    uint beam_count = params->beam_count;
+    uint nFFT = params->nFFT;
+    uint out_count = params->out_count;
+    uint max_peaks = min(params->max_peaks_count, (uint)MAX_PEAKS_LIMIT);
+
+    uint beam_idx = get_group_id(0);
+    uint lid = get_local_id(0);
+    if (beam_idx >= beam_count) return;
+
+    __global const float2* selected = (__global const float2*)(userdata + 32) + beam_idx * out_count;
+    __global const float* magnitude = (__global const float*)((__global const float2*)(userdata + 32)
+                                      + beam_count * out_count) + beam_idx * out_count;
+
+    __local float local_mag[MAXIMA_LOCAL_SIZE];
+    __local uint local_idx[MAXIMA_LOCAL_SIZE];
+    __local uint chosen[MAX_PEAKS_LIMIT];
+
+    for (uint p = 0; p < max_peaks; ++p) {
+        float best_mag = -1.0f;
+        uint best_idx = NO_PEAK;
+
+        for (uint j = lid; j < out_count; j += MAXIMA_LOCAL_SIZE) {
+            float m = magnitude[j];
+            float m_left = (j > 0) ? magnitude[j - 1] : -1.0f;
+            float m_right = (j + 1 < out_count) ? magnitude[j + 1] : -1.0f;
+            if (!(m > m_left && m >= m_right)) continue;   // только локальные пики
+
+            bool taken = false;
+            for (uint q = 0; q < p; ++q) taken |= (chosen[q] == j);
+            if (!taken && m > best_mag) {
+                best_mag = m;
+                best_idx = j;
+            }
+        }
+
+        local_mag[lid] = best_mag;
+        local_idx[lid] = best_idx;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for (uint stride = MAXIMA_LOCAL_SIZE / 2; stride > 0; stride >>= 1) {
+            if (lid < stride && local_mag[lid + stride] > local_mag[lid]) {
+                local_mag[lid] = local_mag[lid + stride];
+                local_idx[lid] = local_idx[lid + stride];
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        if (lid == 0) chosen[p] = local_idx[0];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if (lid != 0) return;
+
+    uint half_n = nFFT / 2;
+    uint window_start = half_n - out_count / 2;
+    float bin_width = (sample_rate > 0.0f) ? sample_rate / (float)nFFT : 1.0f;
+
+    for (uint p = 0; p < params->max_peaks_count; ++p) {
+        __global MaxValue* out = &maxima_output[beam_idx * params->max_peaks_count + p];
+        uint j = (p < max_peaks) ? chosen[p] : NO_PEAK;
+
+        if (j == NO_PEAK) {
+            out->index = 0;
+            out->real = 0.0f;
+            out->imag = 0.0f;
+            out->magnitude = 0.0f;
+            out->phase = 0.0f;
+            out->freq_offset = 0.0f;
+            out->refined_frequency = 0.0f;
+            out->pad = 0;
+            continue;
+        }
+
+        float2 val = selected[j];
+        float offset = 0.0f;
+
+        // Параболическая интерполяция — только для главного пика
+        if (p == 0 && j > 0 && j + 1 < out_count) {
+            float y_left = magnitude[j - 1];
+            float y_center = magnitude[j];
+            float y_right = magnitude[j + 1];
+            float denom = y_left - 2.0f * y_center + y_right;
+            if (fabs(denom) > 1e-10f) {
+                offset = clamp(0.5f * (y_left - y_right) / denom, -0.5f, 0.5f);
+            }
+        }
+
+        uint shifted_idx = window_start + j;
+        out->index = shifted_idx;
+        out->real = val.x;
+        out->imag = val.y;
+        out->magnitude = magnitude[j];
+        out->phase = atan2(val.y, val.x) * 57.29577951f;
+        out->freq_offset = offset;
+        out->refined_frequency = ((float)shifted_idx - (float)half_n + offset) * bin_width;
+        out->pad = 0;
+    }
+}
+)CL";
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// GetSpectrumStoreCallbackSource() - clFFT Post-Callback упаковки спектра
+// ════════════════════════════════════════════════════════════════════════════
+//
+// НАЗНАЧЕНИЕ:
+//   Спектр после FFT читается post_kernel ровно один раз. Вместо записи
+//   полного float2 (8 байт) post-callback сразу пишет компактное значение
+//   в отдельный буфер (userdata), который потом читает post_kernel.
+//
+// АРХИТЕКТУРА:
+//   - FFT выполняется IN-PLACE в fft_input_ (отдельный fft_output не нужен)
+//   - clFFT вызывает storeSpectrumPost() вместо записи результата
+//   - userdata = компактный буфер спектра (beam_count * nFFT элементов)
+//   - outoffset = индекс бина в пакете (beam * nFFT + k) — совпадает с LOAD_BIN
+//
+// ФОРМАТЫ (storage = SpectrumStorage):
+//   1 COMPLEX_HALF    → vstore_half2_rte  (4 байта, фаза сохраняется)
+//   2 MAGNITUDE_FLOAT → float |X|         (4 байта)
+//   3 MAGNITUDE_HALF  → vstore_half_rte   (2 байта)
+//   vstore_half* — базовые функции OpenCL, расширение cl_khr_fp16 не требуется.
+//   Диапазон half: |X| <= 65504, при больших амплитудах → inf (см. тест точности).
+//
+// ВЫЗЫВАЕТСЯ ИЗ:
+//   SpectrumMaximaFinder::CreateFFTPlanWithCallback()
+//
+// ════════════════════════════════════════════════════════════════════════════
+inline const char* GetSpectrumStoreCallbackSource(unsigned int storage) {
+    switch (storage) {
+        case 1:
+            return R"CL(
+void storeSpectrumPost(__global void* output, uint outoffset, __global void* userdata, float2 fftoutput) {
+    vstore_half2_rte(fftoutput, outoffset, (__global half*)userdata);
+}
+)CL";
+        case 2:
+            return R"CL(
+void storeSpectrumPost(__global void* output, uint outoffset, __global void* userdata, float2 fftoutput) {
+    ((__global float*)userdata)[outoffset] = length(fftoutput);
+}
+)CL";
+        case 3:
+            return R"CL(
+void storeSpectrumPost(__global void* output, uint outoffset, __global void* userdata, float2 fftoutput) {
+    vstore_half_rte(length(fftoutput), outoffset, (__global half*)userdata);
+}
+)CL";
+        default:
+            // COMPLEX_FLOAT: обычная запись в выходной буфер clFFT
+            return R"CL(
+void storeSpectrumPost(__global void* output, uint outoffset, __global void* userdata, float2 fftoutput) {
+    ((__global float2*)output)[outoffset] = fftoutput;
+}
+)CL";
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// GetMatchedFilterPostCallbackSource() - clFFT Post-Callback сжатия импульса
+// ════════════════════════════════════════════════════════════════════════════
+//
+// НАЗНАЧЕНИЕ:
+//   Умножение спектра луча на опорный спектр H[k] = conj(R[k]) прямо при
+//   записи результата прямого FFT — отдельного kernel умножения нет.
+//   Обратный FFT того же буфера даёт взаимную корреляцию с опорой.
+//
+// MEMORY LAYOUT:
+//   userdata = [32 байта MatchedFilterUserData {nFFT, pad×7}]
+//              [H: nFFT (float2), уже сопряжённый]
+//   Один буфер userdata на опору (кэш по LFMParameters), общий для всех лучей.
+//
+// ВЫЗЫВАЕТСЯ ИЗ:
+//   MatchedFilterProcessor::GetForwardPlan()
+//
+// ════════════════════════════════════════════════════════════════════════════
+inline const char* GetMatchedFilterPostCallbackSource() {
+    return R"CL(
+typedef struct {
+    uint nFFT;
+    uint padding1;
+    uint padding2;
+    uint padding3;
+    uint padding4;
+    uint padding5;
+    uint padding6;
+    uint padding7;
+} MatchedFilterUserData;
+
+void multiplyReferencePost(__global void* output, uint outoffset, __global void* userdata, float2 fftoutput) {
+    __global const MatchedFilterUserData* params = (__global const MatchedFilterUserData*)userdata;
+    __global const float2* reference = (__global const float2*)((__global const char*)userdata + 32);
+
+    float2 h = reference[outoffset % params->nFFT];
+    ((__global float2*)output)[outoffset] = (float2)(
+        fftoutput.x * h.x - fftoutput.y * h.y,
+        fftoutput.x * h.y + fftoutput.y * h.x);
+}
+)CL";
+}
+
 } // namespace kernels
 } // namespace antenna_fft
@@ -0,0 +1,267 @@
+#pragma once
+
+/**
+ * @file matched_filter.h
+ * @brief Пакетный согласованный фильтр (сжатие ЛЧМ импульса) + поиск максимума
+ *
+ * Реализует:
+ * - Прямой FFT всех лучей (pre-callback: дополнение нулями)
+ * - Умножение на опорный спектр conj(R[k]) в post-callback прямого FFT
+ * - Обратный FFT → взаимная корреляция с опорой
+ * - post_kernel (как в SpectrumMaximaFinder): пик + параболическая интерполяция
+ *
+ * Планы clFFT берутся из FFTPlanCache, опорные спектры кэшируются
+ * по хэшу LFMParameters.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "interface/i_backend.hpp"
+#include "interface/lfm_parameters.h"
+#include "spectrum_maxima_finder.h"
+#include "fft_plan_cache.hpp"
+
+#include <CL/cl.h>
+#include <clFFT.h>
+#include <complex>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+namespace antenna_fft {
+
+// ════════════════════════════════════════════════════════════════════════════
+// Структуры данных
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @struct MatchedFilterParams
+ * @brief Параметры согласованного фильтра
+ */
+struct MatchedFilterParams {
+    uint32_t beam_count = 0;            ///< Максимум лучей за один вызов
+    uint32_t n_point = 0;               ///< Отсчётов на луч
+    uint32_t reference_points = 0;      ///< Макс. длина опоры (0 = n_point)
+    float sample_rate = 12.0e6f;        ///< Частота дискретизации (Гц)
+
+    // Вычисляемые параметры (заполняются в Initialize)
+    uint32_t nFFT = 0;                  ///< nextPow2(n_point + reference_points - 1) — линейная свёртка
+};
+
+/**
+ * @struct MatchedFilterResult
+ * @brief Пик сжатого импульса одного луча
+ */
+struct MatchedFilterResult {
+    uint32_t beam_id = 0;               ///< Номер луча
+    float delay_samples = 0.0f;         ///< Задержка эха (отсчёты, с параболической поправкой)
+    double delay_seconds = 0.0;         ///< Задержка эха (секунды)
+    float magnitude = 0.0f;             ///< |y| в пике
+    float phase = 0.0f;                 ///< Фаза в пике (градусы)
+    MaxValue peak;                      ///< Сырой результат post_kernel (index — отсчёт корреляции)
+};
+
+/**
+ * @struct MatchedFilterProfiling
+ * @brief Данные профилирования GPU
+ */
+struct MatchedFilterProfiling {
+    double upload_time_ms = 0.0;        ///< Загрузка данных в userdata
+    double forward_fft_time_ms = 0.0;   ///< Прямой FFT + умножение на опору (post-callback)
+    double inverse_fft_time_ms = 0.0;   ///< Обратный FFT
+    double post_kernel_time_ms = 0.0;   ///< Поиск пика
+    double reference_time_ms = 0.0;     ///< Построение опоры (0 при попадании в кэш)
+    double total_time_ms = 0.0;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Класс MatchedFilterProcessor
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class MatchedFilterProcessor
+ * @brief Сжатие ЛЧМ импульса: FFT → ×conj(R) → IFFT → поиск пика
+ *
+ * y_b[m] = Σ_n x_b[n] · conj(r[n - m]) — пик на m = задержке эха (отсчёты).
+ * Отрицательные задержки попадают в конец буфера (m = nFFT - |d|).
+ *
+ * Опора r[n] = exp(j·2π·(f_start·t + k/2·t²)), t = n / fs, n < lfm.count_points —
+ * тот же ЛЧМ, что даёт LFMGeneratorModule. Её спектр считается один раз (CPU, double)
+ * и кэшируется по (f_start, f_stop, sample_rate, count_points).
+ *
+ * clFFT копирует cl_mem userdata в план при clfftSetPlanCallback, поэтому
+ * прямой план (с колбэком ×conj(R)) привязан к своей опоре: у каждой опоры
+ * в кэше свой FFTPlanCache прямых планов (ключ nFFT × число лучей).
+ * Смена ЛЧМ между вызовами не требует повторного bake, освобождение опоры
+ * уничтожает её планы до буфера. Обратные планы (без колбэков) общие.
+ *
+ * Использование:
+ * @code
+ * MatchedFilterParams mp;
+ * mp.beam_count = 64;
+ * mp.n_point = 8192;
+ * mp.reference_points = 2048;
+ * mp.sample_rate = lfm.sample_rate;
+ *
+ * MatchedFilterProcessor mf(mp, backend);
+ * mf.Initialize();
+ * auto peaks = mf.Process(echo, lfm);     // lfm.count_points = длина импульса
+ * @endcode
+ */
+class MatchedFilterProcessor {
+public:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Конструктор / Деструктор
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @param params Параметры обработки
+     * @param backend Указатель на DrvGPU backend (не владеет)
+     */
+    explicit MatchedFilterProcessor(const MatchedFilterParams& params,
+                                    drv_gpu_lib::IBackend* backend);
+    ~MatchedFilterProcessor();
+
+    // Колбэки планов ссылаются на поля объекта → ни копирования, ни перемещения
+    MatchedFilterProcessor(const MatchedFilterProcessor&) = delete;
+    MatchedFilterProcessor& operator=(const MatchedFilterProcessor&) = delete;
+    MatchedFilterProcessor(MatchedFilterProcessor&&) = delete;
+    MatchedFilterProcessor& operator=(MatchedFilterProcessor&&) = delete;
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Публичный интерфейс
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Выделить буферы и скомпилировать post_kernel
+     * @throws std::invalid_argument при неверных параметрах
+     */
+    void Initialize();
+
+    /**
+     * @brief Сжатие импульса лучей с CPU
+     * @param input_data [num_beams × n_point], num_beams <= beam_count
+     * @param lfm        Параметры зондирующего ЛЧМ (опора)
+     */
+    std::vector<MatchedFilterResult> Process(
+        const std::vector<std::complex<float>>& input_data,
+        const LFMParameters& lfm);
+
+    /**
+     * @brief Сжатие импульса лучей, уже лежащих на GPU
+     * @param input_signal cl_mem [num_beams × n_point] complex<float>
+     */
+    std::vector<MatchedFilterResult> Process(
+        cl_mem input_signal, size_t num_beams,
+        const LFMParameters& lfm);
+
+    /**
+     * @brief Прочитать сжатые лучи последнего вызова [num_beams × nFFT]
+     */
+    std::vector<std::complex<float>> ReadCompressed() const;
+
+    /**
+     * @brief Опорный спектр conj(R[k]) на CPU (double) — для тестов и кэша
+     */
+    static std::vector<std::complex<float>> ComputeReferenceSpectrum(
+        const LFMParameters& lfm, uint32_t nFFT);
+
+    /**
+     * @brief Хэш параметров, определяющих опору
+     */
+    static size_t HashReference(const LFMParameters& lfm);
+
+    const MatchedFilterParams& GetParams() const { return params_; }
+    const MatchedFilterProfiling& GetProfilingData() const { return profiling_; }
+    /// Обратные планы (общие для всех опор)
+    const FFTPlanCache* GetPlanCache() const { return plans_.get(); }
+    size_t GetReferenceCacheSize() const { return references_.size(); }
+
+    /**
+     * @brief Число прямых планов всех опор
+     */
+    size_t GetForwardPlanCount() const;
+    bool IsInitialized() const { return initialized_; }
+
+    /**
+     * @brief Освободить все кэшированные опоры (вместе с их прямыми планами)
+     */
+    void ClearReferenceCache();
+
+private:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Приватные типы и методы
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /// Кэшированная опора: userdata post-callback [32 байт заголовок][conj(R)]
+    /// и прямые планы, в которые этот userdata записан при bake
+    struct ReferenceEntry {
+        float f_start = 0.0f;
+        float f_stop = 0.0f;
+        float sample_rate = 0.0f;
+        size_t count_points = 0;
+        cl_mem userdata = nullptr;
+        std::unique_ptr<FFTPlanCache> forward_plans;
+    };
+
+    static uint32_t NextPowerOf2(uint32_t n);
+
+    void AllocateBuffers();
+    void CompilePostKernel();
+
+    /// Опора для lfm (из кэша или построить и загрузить)
+    ReferenceEntry& GetReference(const LFMParameters& lfm);
+
+    /// Сначала планы опоры (они держат её cl_mem), затем буфер
+    void ReleaseReference(ReferenceEntry& entry);
+
+    /// Прямой план опоры (pre: padding, post: ×conj(R)) на num_beams — испечь при промахе
+    FFTPlanKey GetForwardPlan(ReferenceEntry& reference, size_t num_beams);
+
+    /// FFT → ×conj(R) → IFFT → post_kernel → результаты; забирает upload_event
+    std::vector<MatchedFilterResult> Run(size_t num_beams, cl_event upload_event);
+
+    void WritePreCallbackHeader(size_t num_beams);
+    double ProfileEvent(cl_event event);
+    void ReleaseResources();
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Приватные поля
+    // ═══════════════════════════════════════════════════════════════════════
+
+    MatchedFilterParams params_;
+    bool initialized_ = false;
+
+    drv_gpu_lib::IBackend* backend_ = nullptr;
+    cl_context context_ = nullptr;
+    cl_command_queue queue_ = nullptr;
+    cl_device_id device_ = nullptr;
+
+    // Обратные планы clFFT (прямые — в ReferenceEntry)
+    std::unique_ptr<FFTPlanCache> plans_;
+
+    // GPU буферы
+    cl_mem pre_callback_userdata_ = nullptr;    ///< [32 байт PreCallbackHeader][входные лучи]
+    cl_mem spectrum_ = nullptr;                 ///< X·conj(R): [beam_count × nFFT]
+    cl_mem compressed_ = nullptr;               ///< Сжатые лучи: [beam_count × nFFT]
+    cl_mem maxima_output_ = nullptr;            ///< 4 × MaxValue на луч
+    size_t last_num_beams_ = 0;
+
+    ReferenceEntry* current_reference_ = nullptr;  ///< Опора вызова (не владеет — из references_)
+
+    // Кэш опор: хэш → опора (при коллизии хэша сравниваются параметры)
+    std::unordered_map<size_t, ReferenceEntry> references_;
+
+    // post_kernel из SpectrumMaximaFinder
+    cl_program post_program_ = nullptr;
+    cl_kernel post_kernel_ = nullptr;
+
+    MatchedFilterProfiling profiling_;
+
+    static constexpr size_t PRE_CALLBACK_HEADER_SIZE = 32;
+    static constexpr size_t LOCAL_SIZE = 256;
+};
+
+} // namespace antenna_fft
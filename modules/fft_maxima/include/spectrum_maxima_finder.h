@@ -15,7 +15,10 @@
  */
 
 #include "interface/i_backend.hpp"
+#include "memory/regular_buffer.hpp"
 #include "kernels/fft_kernel_sources.hpp"
+#include "dechirp_reference.hpp"
+#include "common/warmup.hpp"
 
 #include <CL/cl.h>
 #include <clFFT.h>
@@ -31,6 +34,59 @@ namespace antenna_fft {
 // Структуры данных
 // ════════════════════════════════════════════════════════════════════════════
 
+/**
+ * @enum SpectrumStorage
+ * @brief Формат хранения спектра между FFT и post-kernel
+ *
+ * Спектр после FFT читается post-kernel'ом ровно один раз, поэтому
+ * полный complex<float> (8 байт/бин) избыточен. В компактных режимах
+ * post-callback clFFT сразу пишет ужатое значение, а FFT выполняется
+ * in-place в fft_input_ (отдельный полноразмерный fft_output_ не нужен).
+ *
+ * | Режим           | Байт/бин | Фаза  | Трафик после FFT |
+ * |-----------------|----------|-------|------------------|
+ * | COMPLEX_FLOAT   | 8        | да    | 1x (как раньше)  |
+ * | COMPLEX_HALF    | 4        | да    | 1/2              |
+ * | MAGNITUDE_FLOAT | 4        | нет   | 1/2              |
+ * | MAGNITUDE_HALF  | 2        | нет   | 1/4              |
+ *
+ * В режимах MAGNITUDE_* в MaxValue: real = magnitude, imag = 0, phase = 0.
+ * Режимы *_HALF ограничены диапазоном half (|X| <= 65504) и ~11 битами мантиссы.
+ * Точность относительно COMPLEX_FLOAT — см. tests/test_spectrum_storage.hpp.
+ */
+enum class SpectrumStorage : uint32_t {
+    COMPLEX_FLOAT = 0,      ///< float2 — полная точность (по умолчанию)
+    COMPLEX_HALF = 1,       ///< half2 — vstore_half2 в post-callback
+    MAGNITUDE_FLOAT = 2,    ///< float |X| — только амплитуда
+    MAGNITUDE_HALF = 3      ///< half |X| — только амплитуда, 2 байта
+};
+
+/**
+ * @brief Размер одного бина спектра в байтах для заданного режима
+ */
+inline size_t SpectrumBytesPerBin(SpectrumStorage storage) {
+    switch (storage) {
+        case SpectrumStorage::COMPLEX_HALF:    return 4;
+        case SpectrumStorage::MAGNITUDE_FLOAT: return 4;
+        case SpectrumStorage::MAGNITUDE_HALF:  return 2;
+        case SpectrumStorage::COMPLEX_FLOAT:
+        default:                               return 8;
+    }
+}
+
+/**
+ * @brief Имя режима хранения (для логов и отчётов)
+ */
+inline const char* SpectrumStorageName(SpectrumStorage storage) {
+    switch (storage) {
+        case SpectrumStorage::COMPLEX_HALF:    return "COMPLEX_HALF";
+        case SpectrumStorage::MAGNITUDE_FLOAT: return "MAGNITUDE_FLOAT";
+        case SpectrumStorage::MAGNITUDE_HALF:  return "MAGNITUDE_HALF";
+        case SpectrumStorage::COMPLEX_FLOAT:
+        default:                               return "COMPLEX_FLOAT";
+    }
+}
+
 /**
  * @struct SpectrumParams
  * @brief Параметры для поиска максимума спектра
@@ -41,6 +97,7 @@ struct SpectrumParams {
     uint32_t repeat_count = 2;          ///< Множитель размера FFT (2^n: 1,2,4,8...)
     float sample_rate = 1000.0f;        ///< Частота дискретизации (Гц)
     uint32_t search_range = 0;          ///< Диапазон поиска максимума (0 = авто = nFFT/4)
+    SpectrumStorage spectrum_storage = SpectrumStorage::COMPLEX_FLOAT;  ///< Формат спектра после FFT
 
     // Вычисляемые параметры (заполняются в Initialize)
     uint32_t nFFT = 0;                  ///< Размер FFT = nextPow2(n_point) * repeat_count
@@ -95,8 +152,9 @@ struct ProfilingData {
  * @brief Поиск максимума спектра после FFT с параболической интерполяцией
  *
  * Алгоритм:
- * 1. Pre-callback: padding n_point → nFFT с нулями
+ * 1. Pre-callback: padding n_point → nFFT с нулями (+ гетеродин ЛЧМ, если задан)
  * 2. FFT: выполнение clFFT с встроенным pre-callback
+ *    (+ post-callback упаковки спектра, если spectrum_storage != COMPLEX_FLOAT)
  * 3. Post-kernel: поиск максимума + парабола (ОТДЕЛЬНЫЙ kernel)
  *
  * Почему post-kernel отдельный?
@@ -171,6 +229,33 @@ public:
     std::vector<SpectrumResult> Process(
         const std::vector<std::complex<float>>& input_data);
 
+    /**
+     * @brief Прогрев: Initialize (буферы, план, post-kernel) и кадр из нулей
+     *
+     * Размер пакета фиксирован (antenna_count) — config.batch_sizes
+     * не используется, allocate_pools выполняется в Initialize.
+     */
+    void Warmup(const drv_gpu_lib::WarmupConfig& config);
+
+    /**
+     * @brief Гетеродин ЛЧМ в pre-callback (dechirp перед FFT)
+     *
+     * Отсчёты каждой антенны умножаются на сопряжённый опорный ЛЧМ прямо
+     * в pre-callback: опора вычисляется по LFMParameters, буфера нет.
+     * Эхо с задержкой τ даёт тон биений -k·τ (ищется в диапазоне
+     * отрицательных частот post-kernel). Можно вызывать до и после Initialize().
+     * lfm.apply_heterodyne == false выключает гетеродин.
+     *
+     * @throws std::invalid_argument если ЛЧМ невалиден или sample_rate
+     *         не совпадает с SpectrumParams::sample_rate
+     */
+    void SetHeterodyne(const LFMParameters& lfm);
+
+    /**
+     * @brief Включён ли гетеродин
+     */
+    bool IsHeterodyneEnabled() const { return dechirp_.enabled; }
+
     /**
      * @brief Получить данные профилирования последнего вызова
      */
@@ -181,6 +266,25 @@ public:
      */
     const SpectrumParams& GetParams() const { return params_; }
 
+    /**
+     * @brief Размер буфера спектра, который читает post-kernel (байт)
+     *
+     * COMPLEX_FLOAT: antenna_count × nFFT × 8, компактные режимы — 4 или 2 байта/бин.
+     */
+    size_t GetSpectrumBufferBytes() const {
+        return static_cast<size_t>(params_.antenna_count) * params_.nFFT *
+               SpectrumBytesPerBin(params_.spectrum_storage);
+    }
+
+    /**
+     * @brief Загрузка входа без копии (устройство в общей с хостом памяти)
+     *
+     * Определяется в Initialize() по MemoryManager::HasUnifiedMemory():
+     * userdata pre-callback создаётся с CL_MEM_ALLOC_HOST_PTR, и Process()
+     * пишет вход через map/unmap вместо clEnqueueWriteBuffer.
+     */
+    bool UsesZeroCopyUpload() const { return upload_buffer_ != nullptr; }
+
     /**
      * @brief Проверить, инициализирован ли объект
      */
@@ -205,15 +309,23 @@ private:
     /// Создать GPU буферы
     void AllocateBuffers();
 
-    /// Создать FFT план с pre-callback
+    /// Создать FFT план с pre-callback (и post-callback упаковки спектра)
     void CreateFFTPlanWithCallback();
 
+    /// Используется ли компактный формат спектра (in-place FFT + post-callback)
+    bool UsesCompactSpectrum() const {
+        return params_.spectrum_storage != SpectrumStorage::COMPLEX_FLOAT;
+    }
+
     /// Скомпилировать post-kernel
     void CompilePostKernel();
 
     /// Загрузить данные в GPU
     cl_event UploadData(const std::vector<std::complex<float>>& input_data);
 
+    /// Записать заголовок pre-callback userdata
+    void WritePreCallbackHeader();
+
     /// Выполнить FFT
     cl_event ExecuteFFT(cl_event wait_event);
 
@@ -251,10 +363,16 @@ private:
 
     // GPU буферы
     cl_mem pre_callback_userdata_ = nullptr;    ///< [32 байт параметры][входные данные]
-    cl_mem fft_input_ = nullptr;                ///< Входной буфер FFT
-    cl_mem fft_output_ = nullptr;               ///< Выходной буфер FFT
+    cl_mem fft_input_ = nullptr;                ///< Входной буфер FFT (in-place в компактных режимах)
+    cl_mem fft_output_ = nullptr;               ///< Спектр для post-kernel (float2 или компактный)
     cl_mem maxima_output_ = nullptr;            ///< Результаты post-kernel
 
+    /// Zero-copy владелец pre_callback_userdata_ (на общей памяти; иначе nullptr)
+    std::shared_ptr<drv_gpu_lib::RegularBuffer<uint8_t>> upload_buffer_;
+
+    // Гетеродин (фаза опорного ЛЧМ в заголовке pre-callback)
+    DechirpReference dechirp_;
+
     // Post-kernel
     cl_program post_program_ = nullptr;
     cl_kernel post_kernel_ = nullptr;
@@ -1,8 +1,12 @@
 #include "antenna_fft_core.h"
 #include "fft_logger.h"
+#include "services/batch_manager.hpp"
+#include "memory/memory_manager.hpp"
 #include <cstring>
+#include <cstddef>
 #include <cmath>
 #include <algorithm>
+#include <functional>
 
 namespace antenna_fft {
 
@@ -26,7 +30,8 @@ AntennaFFTCore::AntennaFFTCore(const AntennaFFTParams& params, drv_gpu_lib::IBac
       post_callback_userdata_(nullptr),
       batch_total_cpu_time_ms_(0.0),
       last_used_batch_mode_(false),
-      current_buffer_beams_(0) {
+      current_buffer_beams_(0),
+      memory_degradations_(0) {
 
     // Проверка параметров
     if (!params_.IsValid()) {
@@ -68,14 +73,8 @@ AntennaFFTCore::AntennaFFTCore(const AntennaFFTParams& params, drv_gpu_lib::IBac
 AntennaFFTCore::~AntennaFFTCore() {
     ReleaseFFTPlan();
 
-    if (pre_callback_userdata_) {
-        clReleaseMemObject(pre_callback_userdata_);
-        pre_callback_userdata_ = nullptr;
-    }
-    if (post_callback_userdata_) {
-        clReleaseMemObject(post_callback_userdata_);
-        post_callback_userdata_ = nullptr;
-    }
+    ReleaseTrackedBuffer(pre_callback_userdata_);
+    ReleaseTrackedBuffer(post_callback_userdata_);
 
     // Примечание: производные классы освобождают свои буферы сами
 }
@@ -94,12 +93,14 @@ AntennaFFTCore::AntennaFFTCore(AntennaFFTCore&& other) noexcept
       buffer_maxima_(other.buffer_maxima_),
       pre_callback_userdata_(other.pre_callback_userdata_),
       post_callback_userdata_(other.post_callback_userdata_),
+      dechirp_(other.dechirp_),
       last_profiling_results_(other.last_profiling_results_),
       batch_profiling_(std::move(other.batch_profiling_)),
       batch_total_cpu_time_ms_(other.batch_total_cpu_time_ms_),
       last_used_batch_mode_(other.last_used_batch_mode_),
       batch_config_(other.batch_config_),
-      current_buffer_beams_(other.current_buffer_beams_) {
+      current_buffer_beams_(other.current_buffer_beams_),
+      memory_degradations_(other.memory_degradations_) {
 
     // Null out moved-from object
     other.plan_handle_ = 0;
@@ -115,8 +116,8 @@ AntennaFFTCore& AntennaFFTCore::operator=(AntennaFFTCore&& other) noexcept {
     if (this != &other) {
         // Release current resources
         ReleaseFFTPlan();
-        if (pre_callback_userdata_) clReleaseMemObject(pre_callback_userdata_);
-        if (post_callback_userdata_) clReleaseMemObject(post_callback_userdata_);
+        ReleaseTrackedBuffer(pre_callback_userdata_);
+        ReleaseTrackedBuffer(post_callback_userdata_);
 
         // Move from other
         params_ = other.params_;
@@ -132,12 +133,14 @@ AntennaFFTCore& AntennaFFTCore::operator=(AntennaFFTCore&& other) noexcept {
         buffer_maxima_ = other.buffer_maxima_;
         pre_callback_userdata_ = other.pre_callback_userdata_;
         post_callback_userdata_ = other.post_callback_userdata_;
+        dechirp_ = other.dechirp_;
         last_profiling_results_ = other.last_profiling_results_;
         batch_profiling_ = std::move(other.batch_profiling_);
         batch_total_cpu_time_ms_ = other.batch_total_cpu_time_ms_;
         last_used_batch_mode_ = other.last_used_batch_mode_;
         batch_config_ = other.batch_config_;
         current_buffer_beams_ = other.current_buffer_beams_;
+        memory_degradations_ = other.memory_degradations_;
 
         // Null out moved-from object
         other.plan_handle_ = 0;
@@ -163,7 +166,7 @@ AntennaFFTResult AntennaFFTCore::ProcessNew(const std::vector<std::complex<float
     AntennaFFTResult result = ProcessNew(input_buffer);
 
     // Release temporary buffer
-    clReleaseMemObject(input_buffer);
+    ReleaseTrackedBuffer(input_buffer);
 
     return result;
 }
@@ -171,6 +174,11 @@ AntennaFFTResult AntennaFFTCore::ProcessNew(const std::vector<std::complex<float
 AntennaFFTResult AntennaFFTCore::ProcessNew(cl_mem input_signal) {
     auto start_time = std::chrono::high_resolution_clock::now();
 
+    // Не хватило памяти на все лучи → кадр уходит в пакетный режим
+    if (!NeedsBatching()) {
+        AllocateBuffersDegrading(params_.beam_count);
+    }
+
     // Check if batching is needed
     if (NeedsBatching()) {
         last_used_batch_mode_ = true;
@@ -212,6 +220,13 @@ AntennaFFTResult AntennaFFTCore::ProcessWithBatching(cl_mem input_signal) {
     while (processed_beams < params_.beam_count) {
         size_t beams_in_batch = std::min(beams_per_batch, params_.beam_count - processed_beams);
 
+        // Нехватка памяти посреди кадра → остаток кадра меньшими пакетами
+        size_t allocated_beams = AllocateBuffersDegrading(beams_in_batch);
+        if (allocated_beams < beams_in_batch) {
+            beams_in_batch = allocated_beams;
+            beams_per_batch = allocated_beams;
+        }
+
         BatchProfilingData batch_prof;
         batch_prof.batch_index = batch_index;
         batch_prof.start_beam = processed_beams;
@@ -304,6 +319,13 @@ bool AntennaFFTCore::CheckAvailableMemory(size_t required_memory, double thresho
     clGetDeviceInfo(device_, CL_DEVICE_GLOBAL_MEM_SIZE, sizeof(global_mem_size), &global_mem_size, nullptr);
 
     size_t available = static_cast<size_t>(global_mem_size * threshold);
+
+    // Бюджет устройства (max_memory_percent) — вместо доли threshold
+    if (const auto* mem_mgr = backend_ ? backend_->GetMemoryManager() : nullptr) {
+        if (mem_mgr->GetMemoryBudget() != 0) {
+            available = mem_mgr->GetMemoryBudgetRemaining();
+        }
+    }
     return required_memory <= available;
 }
 
@@ -322,6 +344,95 @@ void AntennaFFTCore::CalculateBatchConfig() {
     }
 }
 
+size_t AntennaFFTCore::AllocateBuffersDegrading(size_t num_beams) {
+    size_t beams = num_beams;
+
+    while (true) {
+        try {
+            AllocateBuffers(beams);
+            break;
+        } catch (const std::runtime_error& e) {
+            size_t smaller = drv_gpu_lib::BatchManager::RecalculateAfterAllocationFailure(
+                backend_, params_.beam_count, EstimateRequiredMemory(1), beams,
+                batch_config_.memory_usage_limit);
+            if (smaller == 0) {
+                throw;
+            }
+            FFTLogger::Warning("  [Memory] Allocation failed for ", beams, " beams (", e.what(),
+                               "), degrading to ", smaller, " beams per batch");
+            beams = smaller;
+            memory_degradations_++;
+        }
+    }
+
+    if (beams < num_beams) {
+        batch_config_.beams_per_batch = beams;
+    }
+    return beams;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Прогрев
+// ════════════════════════════════════════════════════════════════════════════
+
+std::vector<size_t> AntennaFFTCore::GetExpectedBatchSizes() const {
+    const size_t per_batch = batch_config_.beams_per_batch;
+    if (per_batch == 0 || per_batch >= params_.beam_count) {
+        return { params_.beam_count };
+    }
+
+    std::vector<size_t> sizes = { per_batch };
+    const size_t tail = params_.beam_count % per_batch;
+    if (tail != 0) {
+        sizes.push_back(tail);
+    }
+    return sizes;
+}
+
+void AntennaFFTCore::Warmup(const drv_gpu_lib::WarmupConfig& config) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    auto collect_sizes = [this, &config](size_t limit) {
+        std::vector<size_t> sizes = GetExpectedBatchSizes();
+        for (size_t n : config.batch_sizes) {
+            if (n > 0 && n <= params_.beam_count) sizes.push_back(n);
+        }
+        sizes.erase(std::remove_if(sizes.begin(), sizes.end(),
+                                   [limit](size_t n) { return n > limit; }), sizes.end());
+        std::sort(sizes.begin(), sizes.end(), std::greater<size_t>());
+        sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+        return sizes;
+    };
+
+    std::vector<size_t> sizes = collect_sizes(params_.beam_count);
+
+    // 1. Буферы под наибольший пакет — до планов: планы запоминают userdata колбэков
+    if (config.allocate_pools && !sizes.empty()) {
+        size_t allocated = AllocateBuffersDegrading(sizes.front());
+        if (allocated < sizes.front()) {
+            // Памяти меньше, чем ожидалось — пакет уже уменьшен, размеры пересчитать
+            sizes = collect_sizes(allocated);
+        }
+    }
+
+    // 2. Планы
+    PrebakePlans(sizes);
+
+    // 3. Пробный кадр
+    if (config.run_dummy_frame) {
+        std::vector<std::complex<float>> zeros(params_.beam_count * params_.count_points);
+        ProcessNew(zeros);
+    }
+
+    double warmup_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+    FFTLogger::Info("[AntennaFFT] Warmup: ", sizes.size(), " plan size(s), ", warmup_ms, " ms");
+}
+
+void AntennaFFTCore::PrebakePlans(const std::vector<size_t>& batch_sizes) {
+    (void)batch_sizes;
+}
+
 bool AntennaFFTCore::NeedsBatching() const {
     return batch_config_.beams_per_batch < params_.beam_count;
 }
@@ -336,47 +447,31 @@ cl_mem AntennaFFTCore::CreateInputBuffer(const std::vector<std::complex<float>>&
     if (err != CL_SUCCESS) {
         throw std::runtime_error("Failed to create input buffer: " + std::to_string(err));
     }
+    TrackBuffer(buffer, "input");
 
     return buffer;
 }
 
 void AntennaFFTCore::CreatePreCallbackUserData(size_t num_beams) {
-    // Structure: {beam_count, count_points, nFFT, padding} + input data pointer space
-    // 32 bytes header for alignment
-
-    struct PreCallbackHeader {
-        cl_uint beam_count;
-        cl_uint count_points;
-        cl_uint nFFT;
-        cl_uint padding1;
-        cl_uint padding2;
-        cl_uint padding3;
-        cl_uint padding4;
-        cl_uint padding5;
-    };
+    // Structure: {beam_count, count_points, nFFT, dechirp, phase_step, phase_curve}
+    // 32 bytes header for alignment (PreCallbackHeader, dechirp_reference.hpp)
 
-    PreCallbackHeader header;
-    header.beam_count = static_cast<cl_uint>(num_beams);
-    header.count_points = static_cast<cl_uint>(params_.count_points);
-    header.nFFT = static_cast<cl_uint>(nFFT_);
-    header.padding1 = 0;
-    header.padding2 = 0;
-    header.padding3 = 0;
-    header.padding4 = 0;
-    header.padding5 = 0;
+    PreCallbackHeader header = MakePreCallbackHeader(
+        num_beams, params_.count_points, nFFT_, dechirp_);
 
     // Total size: header (32 bytes) + input data (beam_count * count_points * complex<float>)
     size_t input_data_size = num_beams * params_.count_points * sizeof(std::complex<float>);
     size_t total_size = sizeof(PreCallbackHeader) + input_data_size;
 
     cl_int err;
-    if (pre_callback_userdata_) {
-        clReleaseMemObject(pre_callback_userdata_);
-    }
+    if (!HasCapacity(pre_callback_userdata_, total_size)) {
+        ReleaseTrackedBuffer(pre_callback_userdata_);
 
-    pre_callback_userdata_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, total_size, nullptr, &err);
-    if (err != CL_SUCCESS) {
-        throw std::runtime_error("Failed to create pre-callback userdata: " + std::to_string(err));
+        pre_callback_userdata_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, total_size, nullptr, &err);
+        if (err != CL_SUCCESS) {
+            throw std::runtime_error("Failed to create pre-callback userdata: " + std::to_string(err));
+        }
+        TrackBuffer(pre_callback_userdata_, "pre_callback_userdata");
     }
 
     // Write header
@@ -387,14 +482,43 @@ void AntennaFFTCore::CreatePreCallbackUserData(size_t num_beams) {
     }
 }
 
+void AntennaFFTCore::SetHeterodyne(const LFMParameters& lfm) {
+    if (lfm.apply_heterodyne &&
+        std::fabs(lfm.sample_rate - params_.sample_rate) > 1e-6f * lfm.sample_rate) {
+        throw std::invalid_argument(
+            "SetHeterodyne: LFMParameters::sample_rate must match AntennaFFTParams::sample_rate");
+    }
+
+    dechirp_ = DechirpReference::FromLFM(lfm);
+
+    // Буфер уже создан → обновить только хвост заголовка (dechirp, phase_step, phase_curve)
+    if (pre_callback_userdata_) {
+        PreCallbackHeader header = MakePreCallbackHeader(0, 0, 0, dechirp_);
+        const size_t offset = offsetof(PreCallbackHeader, dechirp);
+        cl_int err = clEnqueueWriteBuffer(queue_, pre_callback_userdata_, CL_TRUE, offset,
+                                          sizeof(PreCallbackHeader) - offset,
+                                          reinterpret_cast<const char*>(&header) + offset,
+                                          0, nullptr, nullptr);
+        if (err != CL_SUCCESS) {
+            throw std::runtime_error("Failed to write pre-callback dechirp: " + std::to_string(err));
+        }
+    }
+}
+
 void AntennaFFTCore::CreatePostCallbackUserData(size_t num_beams) {
-    // Structure for post-callback: {beam_count, nFFT, out_count_points_fft, max_peaks_count}
+    // Structure for post-callback (32 bytes, как у pre-callback):
+    // {beam_count, nFFT, out_count_points_fft, max_peaks_count, apply_delay, padding x3}
+    // apply_delay = 0: таблицу задержек заполняет производный класс (processFFTPost)
 
     struct PostCallbackHeader {
         cl_uint beam_count;
         cl_uint nFFT;
         cl_uint out_count_points_fft;
         cl_uint max_peaks_count;
+        cl_uint apply_delay;
+        cl_uint padding1;
+        cl_uint padding2;
+        cl_uint padding3;
     };
 
     PostCallbackHeader header;
@@ -402,20 +526,26 @@ void AntennaFFTCore::CreatePostCallbackUserData(size_t num_beams) {
     header.nFFT = static_cast<cl_uint>(nFFT_);
     header.out_count_points_fft = static_cast<cl_uint>(params_.out_count_points_fft);
     header.max_peaks_count = static_cast<cl_uint>(params_.max_peaks_count);
+    header.apply_delay = 0;
+    header.padding1 = 0;
+    header.padding2 = 0;
+    header.padding3 = 0;
 
-    // Allocate buffer for header + output data
+    // Allocate buffer for header + output data + per-beam delay table
     size_t output_size = num_beams * params_.out_count_points_fft * sizeof(std::complex<float>);
     size_t magnitude_size = num_beams * params_.out_count_points_fft * sizeof(float);
-    size_t total_size = sizeof(PostCallbackHeader) + output_size + magnitude_size;
+    size_t delay_size = num_beams * sizeof(float);
+    size_t total_size = sizeof(PostCallbackHeader) + output_size + magnitude_size + delay_size;
 
     cl_int err;
-    if (post_callback_userdata_) {
-        clReleaseMemObject(post_callback_userdata_);
-    }
+    if (!HasCapacity(post_callback_userdata_, total_size)) {
+        ReleaseTrackedBuffer(post_callback_userdata_);
 
-    post_callback_userdata_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, total_size, nullptr, &err);
-    if (err != CL_SUCCESS) {
-        throw std::runtime_error("Failed to create post-callback userdata: " + std::to_string(err));
+        post_callback_userdata_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, total_size, nullptr, &err);
+        if (err != CL_SUCCESS) {
+            throw std::runtime_error("Failed to create post-callback userdata: " + std::to_string(err));
+        }
+        TrackBuffer(post_callback_userdata_, "post_callback_userdata");
     }
 
     // Write header
@@ -426,6 +556,28 @@ void AntennaFFTCore::CreatePostCallbackUserData(size_t num_beams) {
     }
 }
 
+bool AntennaFFTCore::HasCapacity(cl_mem mem, size_t size_bytes) {
+    if (!mem) return false;
+    size_t capacity = 0;
+    cl_int err = clGetMemObjectInfo(mem, CL_MEM_SIZE, sizeof(capacity), &capacity, nullptr);
+    return err == CL_SUCCESS && capacity >= size_bytes;
+}
+
+void AntennaFFTCore::TrackBuffer(cl_mem mem, const char* purpose) {
+    if (auto* mem_mgr = backend_ ? backend_->GetMemoryManager() : nullptr) {
+        mem_mgr->RegisterExternalAllocation(mem, std::string("AntennaFFT/") + purpose);
+    }
+}
+
+void AntennaFFTCore::ReleaseTrackedBuffer(cl_mem& mem) {
+    if (!mem) return;
+    if (auto* mem_mgr = backend_ ? backend_->GetMemoryManager() : nullptr) {
+        mem_mgr->UnregisterExternalAllocation(mem);
+    }
+    clReleaseMemObject(mem);
+    mem = nullptr;
+}
+
 double AntennaFFTCore::ProfileEvent(cl_event event, const std::string& operation_name) {
     cl_ulong start_time, end_time;
     clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START, sizeof(start_time), &start_time, nullptr);
@@ -1,7 +1,9 @@
 #include "antenna_fft_release.h"
 #include "fft_logger.h"
 #include "services/gpu_profiler.hpp"
+#include "memory/memory_manager.hpp"
 #include <cstring>
+#include <cmath>
 
 namespace antenna_fft {
 
@@ -13,14 +15,61 @@ AntennaFFTProcMax::AntennaFFTProcMax(const AntennaFFTParams& params, drv_gpu_lib
     : AntennaFFTCore(params, backend),
       buffer_selected_complex_(nullptr),
       buffer_selected_magnitude_(nullptr),
-      plan_num_beams_(0) {
+      plan_num_beams_(0),
+      userdata_beams_(0),
+      maxima_program_(nullptr),
+      maxima_kernel_(nullptr),
+      written_apply_delay_(0) {
 
     // Вызов виртуального Initialize (создание плана с колбэками)
     Initialize();
 }
 
 AntennaFFTProcMax::~AntennaFFTProcMax() {
+    WaitDelayTableWrite();
     ReleaseBuffers();
+    ReleaseMaximaKernel();
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Задержка лучей в частотной области
+// ════════════════════════════════════════════════════════════════════════════
+
+void AntennaFFTProcMax::SetBeamDelays(const std::vector<CombinedDelayParam>& delays,
+                                      float center_frequency) {
+    if (params_.sample_rate <= 0.0f) {
+        throw std::invalid_argument("SetBeamDelays: AntennaFFTParams::sample_rate is not set");
+    }
+
+    const double pi = 3.14159265358979323846;
+    std::vector<float> samples(params_.beam_count, 0.0f);
+
+    for (const auto& d : delays) {
+        if (d.beam_index >= params_.beam_count) continue;
+
+        double tau = static_cast<double>(d.delay_time_ns) * 1.0e-9;
+        if (center_frequency > 0.0f && d.delay_degrees != 0.0f) {
+            // Решётка с шагом λ/2: d / c = 1 / (2 · f_center)
+            tau += std::sin(d.delay_degrees * pi / 180.0) / (2.0 * center_frequency);
+        }
+        samples[d.beam_index] = static_cast<float>(tau * params_.sample_rate);
+    }
+
+    SetBeamDelaySamples(samples);
+}
+
+void AntennaFFTProcMax::SetBeamDelaySamples(const std::vector<float>& delay_samples) {
+    if (delay_samples.size() != params_.beam_count) {
+        throw std::invalid_argument("SetBeamDelaySamples: size != beam_count");
+    }
+    beam_delay_samples_ = delay_samples;
+    SyncApplyDelayFlag();
+    FFTLogger::Info("[AntennaFFTProcMax] Beam delays set (frequency-domain, fused in processFFTPost)");
+}
+
+void AntennaFFTProcMax::ClearBeamDelays() {
+    beam_delay_samples_.clear();
+    SyncApplyDelayFlag();
 }
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -34,14 +83,34 @@ void AntennaFFTProcMax::Initialize() {
     FFTLogger::Info("  nFFT: ", nFFT_);
     FFTLogger::Info("  out_count_points_fft: ", params_.out_count_points_fft);
 
+    if (params_.out_count_points_fft > nFFT_) {
+        throw std::invalid_argument("out_count_points_fft > nFFT");
+    }
+
+    // Kernel поиска пиков по окну post-callback
+    CreateMaximaKernel();
+
     // Создание кэша FFT-планов для данного контекста
+    // (при повторной инициализации сначала снять колбэк старого кэша)
+    plan_eviction_.Reset();
     plan_cache_ = std::make_unique<FFTPlanCache>(context_, queue_);
 
+    // Нехватка памяти на устройстве → освободить неиспользуемые планы.
+    // Колбэк держит FFTPlanCache (адрес не меняется при перемещении модуля).
+    // plan_eviction_ объявлен после plan_cache_ и снимается раньше; снятие
+    // дожидается колбэка, уже запущенного другим потоком
+    if (auto* mem_mgr = backend_->GetMemoryManager()) {
+        FFTPlanCache* cache = plan_cache_.get();
+        plan_eviction_ = mem_mgr->RegisterEvictionCallback(
+            "AntennaFFTProcMax plan cache",
+            [cache](size_t) { return cache->EvictIdle(); });
+    }
+
     // Выделение буферов для начального размера пакета
     size_t initial_beams = batch_config_.beams_per_batch;
     if (initial_beams == 0) initial_beams = params_.beam_count;
 
-    AllocateBuffers(initial_beams);
+    initial_beams = AllocateBuffersDegrading(initial_beams);
     CreateFFTPlanWithCallbacks(initial_beams);
 
     FFTLogger::Info("[AntennaFFTProcMax] Initialized!");
@@ -57,11 +126,15 @@ AntennaFFTResult AntennaFFTProcMax::ProcessSingleBatch(cl_mem input_signal) {
     // Убедиться, что буферы и план готовы для полного пакета
     if (current_buffer_beams_ < params_.beam_count) {
         ReleaseBuffers();
-        ReleaseFFTPlan();
         AllocateBuffers(params_.beam_count);
+    }
+    if (plan_num_beams_ != params_.beam_count) {
         CreateFFTPlanWithCallbacks(params_.beam_count);
     }
 
+    // Раскладка userdata под полный пакет + таблица задержек
+    UpdateCallbackUserData(0, params_.beam_count);
+
     // Копирование входных данных в userdata pre-callback (после заголовка)
     size_t input_size = params_.beam_count * params_.count_points * sizeof(std::complex<float>);
     cl_int err = clEnqueueCopyBuffer(queue_, input_signal, pre_callback_userdata_,
@@ -94,6 +167,9 @@ AntennaFFTResult AntennaFFTProcMax::ProcessSingleBatch(cl_mem input_signal) {
 
     clReleaseEvent(fft_event);
 
+    // Поиск пиков в окне, подготовленном processFFTPost
+    last_profiling_results_.reduction_time_ms = RunSelectedMaxima(params_.beam_count);
+
     // Read results
     result.results = ReadResults(params_.beam_count, 0);
 
@@ -113,14 +189,13 @@ std::vector<FFTResult> AntennaFFTProcMax::ProcessBatch(
             AllocateBuffers(num_beams);
         }
         if (plan_num_beams_ != num_beams) {
-            ReleaseFFTPlan();
+            // Прежний план остаётся в кэше (хвост кадра → следующий полный пакет)
             CreateFFTPlanWithCallbacks(num_beams);
         }
     }
 
-    // Update userdata for this batch
-    CreatePreCallbackUserData(num_beams);
-    CreatePostCallbackUserData(num_beams);
+    // Update userdata (and beam delays) for this batch
+    UpdateCallbackUserData(start_beam, num_beams);
 
     // Copy input data for this batch to userdata (after 32-byte header)
     size_t input_offset = start_beam * params_.count_points * sizeof(std::complex<float>);
@@ -147,10 +222,13 @@ std::vector<FFTResult> AntennaFFTProcMax::ProcessBatch(
 
     // Profile
     double fft_time_ms = ProfileEvent(fft_event, "BatchFFT");
+    clReleaseEvent(fft_event);
+
+    double maxima_time_ms = RunSelectedMaxima(num_beams);
     if (out_profiling) {
         out_profiling->fft_time_ms = fft_time_ms;
         out_profiling->padding_time_ms = 0; // Included in pre-callback
-        out_profiling->post_time_ms = 0;    // Included in post-callback
+        out_profiling->post_time_ms = maxima_time_ms; // Delay/select in post-callback
     }
 
     // Record to GPUProfiler (async, non-blocking)
@@ -161,8 +239,6 @@ std::vector<FFTResult> AntennaFFTProcMax::ProcessBatch(
         fft_time_ms
     );
 
-    clReleaseEvent(fft_event);
-
     // Read results
     return ReadResults(num_beams, start_beam);
 }
@@ -172,45 +248,75 @@ void AntennaFFTProcMax::AllocateBuffers(size_t num_beams) {
 
     ReleaseBuffers();
 
+    // Нехватка памяти → колбэки освобождения MemoryManager и повтор
+    if (auto* mem_mgr = backend_->GetMemoryManager()) {
+        mem_mgr->AllocateWithRetry(EstimateRequiredMemory(num_beams), [&] {
+            CreateBuffers(num_beams);
+            return true;
+        });
+    } else {
+        CreateBuffers(num_beams);
+    }
+
+    FFTLogger::Info("  [Release] Allocated buffers for ", num_beams, " beams");
+}
+
+void AntennaFFTProcMax::CreateBuffers(size_t num_beams) {
     cl_int err;
 
+    // Частично выделенные буферы освобождаются до повтора / уменьшения пакета
+    auto check = [this](cl_int status, const char* name) {
+        if (status != CL_SUCCESS) {
+            ReleaseBuffers();
+            throw std::runtime_error(std::string("Failed to allocate ") + name +
+                                     " buffer: " + std::to_string(status));
+        }
+    };
+
     // FFT buffers
     size_t fft_size = nFFT_ * num_beams * sizeof(std::complex<float>);
     buffer_fft_input_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, fft_size, nullptr, &err);
-    if (err != CL_SUCCESS) throw std::runtime_error("Failed to allocate fft_input buffer");
+    check(err, "fft_input");
+    TrackBuffer(buffer_fft_input_, "fft_input");
 
     buffer_fft_output_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, fft_size, nullptr, &err);
-    if (err != CL_SUCCESS) throw std::runtime_error("Failed to allocate fft_output buffer");
+    check(err, "fft_output");
+    TrackBuffer(buffer_fft_output_, "fft_output");
 
     // Selected spectrum buffers
     size_t selected_size = params_.out_count_points_fft * num_beams * sizeof(std::complex<float>);
     buffer_selected_complex_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, selected_size, nullptr, &err);
-    if (err != CL_SUCCESS) throw std::runtime_error("Failed to allocate selected_complex buffer");
+    check(err, "selected_complex");
+    TrackBuffer(buffer_selected_complex_, "selected_complex");
 
     size_t magnitude_size = params_.out_count_points_fft * num_beams * sizeof(float);
     buffer_selected_magnitude_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, magnitude_size, nullptr, &err);
-    if (err != CL_SUCCESS) throw std::runtime_error("Failed to allocate selected_magnitude buffer");
+    check(err, "selected_magnitude");
+    TrackBuffer(buffer_selected_magnitude_, "selected_magnitude");
 
     // Maxima buffer
     size_t maxima_size = params_.max_peaks_count * num_beams * 32; // MaxValue struct = 32 bytes
     buffer_maxima_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, maxima_size, nullptr, &err);
-    if (err != CL_SUCCESS) throw std::runtime_error("Failed to allocate maxima buffer");
+    check(err, "maxima");
+    TrackBuffer(buffer_maxima_, "maxima");
 
     // Create userdata buffers
-    CreatePreCallbackUserData(num_beams);
-    CreatePostCallbackUserData(num_beams);
+    try {
+        PrepareCallbackUserData(num_beams);
+    } catch (const std::runtime_error&) {
+        ReleaseBuffers();
+        throw;
+    }
 
     current_buffer_beams_ = num_beams;
-
-    FFTLogger::Info("  [Release] Allocated buffers for ", num_beams, " beams");
 }
 
 void AntennaFFTProcMax::ReleaseBuffers() {
-    if (buffer_fft_input_) { clReleaseMemObject(buffer_fft_input_); buffer_fft_input_ = nullptr; }
-    if (buffer_fft_output_) { clReleaseMemObject(buffer_fft_output_); buffer_fft_output_ = nullptr; }
-    if (buffer_selected_complex_) { clReleaseMemObject(buffer_selected_complex_); buffer_selected_complex_ = nullptr; }
-    if (buffer_selected_magnitude_) { clReleaseMemObject(buffer_selected_magnitude_); buffer_selected_magnitude_ = nullptr; }
-    if (buffer_maxima_) { clReleaseMemObject(buffer_maxima_); buffer_maxima_ = nullptr; }
+    ReleaseTrackedBuffer(buffer_fft_input_);
+    ReleaseTrackedBuffer(buffer_fft_output_);
+    ReleaseTrackedBuffer(buffer_selected_complex_);
+    ReleaseTrackedBuffer(buffer_selected_magnitude_);
+    ReleaseTrackedBuffer(buffer_maxima_);
     current_buffer_beams_ = 0;
 }
 
@@ -272,8 +378,8 @@ void AntennaFFTProcMax::CreateFFTPlanWithCallbacks(size_t num_beams) {
         throw std::runtime_error("clfftSetPlanCallback (pre) failed: " + std::to_string(status));
     }
 
-    // Register post-callback
-    const char* post_callback_source = kernels::GetPaddingKernelSource();
+    // Register post-callback (delay + fftshift + select window)
+    const char* post_callback_source = kernels::GetFFTPostCallbackSource();
 
     status = clfftSetPlanCallback(plan_handle_, "processFFTPost", post_callback_source, 0,
                                   POSTCALLBACK, &post_callback_userdata_, 1);
@@ -304,7 +410,8 @@ bool AntennaFFTProcMax::ExecuteFFTWithCallbacks(
     cl_mem input_signal,
     size_t num_beams,
     size_t start_beam,
-    cl_event* out_fft_event) {
+    cl_event* out_fft_event,
+    FFTDirection direction) {
 
     if (!plan_created_) {
         std::cerr << "FFT plan not created!\n";
@@ -314,7 +421,7 @@ bool AntennaFFTProcMax::ExecuteFFTWithCallbacks(
     // Execute FFT (callbacks do padding and post-processing)
     clfftStatus status = clfftEnqueueTransform(
         plan_handle_,
-        CLFFT_FORWARD,
+        ToClfftDirection(direction),
         1, &queue_,
         0, nullptr,
         out_fft_event,
@@ -388,4 +495,172 @@ std::vector<FFTResult> AntennaFFTProcMax::ReadResults(size_t num_beams, size_t s
     return results;
 }
 
+// ════════════════════════════════════════════════════════════════════════════
+// Userdata колбэков и поиск пиков
+// ════════════════════════════════════════════════════════════════════════════
+
+void AntennaFFTProcMax::PrepareCallbackUserData(size_t num_beams) {
+    const cl_mem previous_pre = pre_callback_userdata_;
+    const cl_mem previous_post = post_callback_userdata_;
+
+    CreatePreCallbackUserData(num_beams);
+    CreatePostCallbackUserData(num_beams);
+    userdata_beams_ = num_beams;
+
+    // Заголовок пересобран с apply_delay = 0
+    written_apply_delay_ = 0;
+    SyncApplyDelayFlag();
+
+    if ((previous_pre && previous_pre != pre_callback_userdata_) ||
+        (previous_post && previous_post != post_callback_userdata_)) {
+        InvalidatePlans();
+    }
+}
+
+void AntennaFFTProcMax::InvalidatePlans() {
+    if (plan_cache_) {
+        plan_cache_->ClearAll();
+        plan_handle_ = 0;
+        plan_created_ = false;
+    } else {
+        ReleaseFFTPlan();
+    }
+    plan_num_beams_ = 0;
+    FFTLogger::Info("  [Release] Callback userdata reallocated, cached FFT plans dropped");
+}
+
+void AntennaFFTProcMax::PrebakePlans(const std::vector<size_t>& batch_sizes) {
+    const size_t active = plan_num_beams_;
+
+    for (size_t num_beams : batch_sizes) {
+        if (num_beams == 0) continue;
+        if (userdata_beams_ < num_beams) {
+            PrepareCallbackUserData(num_beams);
+        }
+        CreateFFTPlanWithCallbacks(num_beams);
+    }
+
+    // Вернуть текущий план (из кэша — без повторного bake)
+    if (active != 0) {
+        CreateFFTPlanWithCallbacks(active);
+    }
+    FFTLogger::Info("  [Release] Pre-baked ", batch_sizes.size(), " FFT plan size(s), cache: ",
+                    plan_cache_ ? plan_cache_->GetCacheSize() : 0);
+}
+
+void AntennaFFTProcMax::UpdateCallbackUserData(size_t start_beam, size_t num_beams) {
+    if (userdata_beams_ != num_beams) {
+        PrepareCallbackUserData(num_beams);
+    }
+
+    // apply_delay уже в заголовке (SyncApplyDelayFlag)
+    if (!HasBeamDelays()) return;
+
+    // Таблица задержек пакета: D_b / nFFT (циклов на бин).
+    // Запись неблокирующая: очередь in-order, FFT пакета идёт после неё
+    WaitDelayTableWrite();
+    delay_cycles_staging_.resize(num_beams);
+    for (size_t i = 0; i < num_beams; ++i) {
+        delay_cycles_staging_[i] = beam_delay_samples_[start_beam + i] / static_cast<float>(nFFT_);
+    }
+
+    size_t delay_offset = 32 + num_beams * params_.out_count_points_fft *
+                               (sizeof(std::complex<float>) + sizeof(float));
+    cl_event write_event = nullptr;
+    cl_int err = clEnqueueWriteBuffer(queue_, post_callback_userdata_, CL_FALSE, delay_offset,
+                                      num_beams * sizeof(float), delay_cycles_staging_.data(),
+                                      0, nullptr, &write_event);
+    delay_write_event_.reset(err == CL_SUCCESS ? write_event : nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to write beam delay table: " + std::to_string(err));
+    }
+}
+
+void AntennaFFTProcMax::SyncApplyDelayFlag() {
+    const cl_uint apply_delay = HasBeamDelays() ? 1u : 0u;
+    if (!post_callback_userdata_ || apply_delay == written_apply_delay_) return;
+
+    // Заголовок post-callback: apply_delay по смещению 16 байт (редко — блокирующая запись)
+    cl_int err = clEnqueueWriteBuffer(queue_, post_callback_userdata_, CL_TRUE, 16,
+                                      sizeof(cl_uint), &apply_delay, 0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to write apply_delay flag: " + std::to_string(err));
+    }
+    written_apply_delay_ = apply_delay;
+}
+
+void AntennaFFTProcMax::WaitDelayTableWrite() {
+    if (!delay_write_event_) return;
+    cl_event event = delay_write_event_.get();
+    clWaitForEvents(1, &event);
+    delay_write_event_.reset();
+}
+
+double AntennaFFTProcMax::RunSelectedMaxima(size_t num_beams) {
+    cl_float sample_rate = params_.sample_rate;
+
+    cl_int err;
+    err = clSetKernelArg(maxima_kernel_, 0, sizeof(cl_mem), &post_callback_userdata_);
+    err |= clSetKernelArg(maxima_kernel_, 1, sizeof(cl_mem), &buffer_maxima_);
+    err |= clSetKernelArg(maxima_kernel_, 2, sizeof(cl_float), &sample_rate);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("find_selected_maxima: failed to set args: " + std::to_string(err));
+    }
+
+    const size_t local_size = 256;
+    size_t global_size = num_beams * local_size;
+
+    cl_event maxima_event;
+    err = clEnqueueNDRangeKernel(queue_, maxima_kernel_, 1, nullptr,
+                                 &global_size, &local_size, 0, nullptr, &maxima_event);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("find_selected_maxima: enqueue failed: " + std::to_string(err));
+    }
+
+    clWaitForEvents(1, &maxima_event);
+    double time_ms = ProfileEvent(maxima_event, "SelectedMaxima");
+    clReleaseEvent(maxima_event);
+
+    drv_gpu_lib::GPUProfiler::GetInstance().Record(
+        backend_->GetDeviceIndex(),
+        "AntennaFFT",
+        "SelectedMaxima",
+        time_ms
+    );
+
+    return time_ms;
+}
+
+void AntennaFFTProcMax::CreateMaximaKernel() {
+    if (maxima_kernel_) return;
+
+    const char* source = kernels::GetSelectedMaximaKernelSource();
+    cl_int err;
+    maxima_program_ = clCreateProgramWithSource(context_, 1, &source, nullptr, &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create maxima program: " + std::to_string(err));
+    }
+
+    err = clBuildProgram(maxima_program_, 1, &device_, nullptr, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        size_t log_size = 0;
+        clGetProgramBuildInfo(maxima_program_, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+        std::string log(log_size, '\0');
+        clGetProgramBuildInfo(maxima_program_, device_, CL_PROGRAM_BUILD_LOG, log_size, &log[0], nullptr);
+        clReleaseProgram(maxima_program_);
+        maxima_program_ = nullptr;
+        throw std::runtime_error("Failed to build maxima program:\n" + log);
+    }
+
+    maxima_kernel_ = clCreateKernel(maxima_program_, "find_selected_maxima", &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create find_selected_maxima kernel: " + std::to_string(err));
+    }
+}
+
+void AntennaFFTProcMax::ReleaseMaximaKernel() {
+    if (maxima_kernel_) { clReleaseKernel(maxima_kernel_); maxima_kernel_ = nullptr; }
+    if (maxima_program_) { clReleaseProgram(maxima_program_); maxima_program_ = nullptr; }
+}
+
 } // namespace antenna_fft
@@ -0,0 +1,617 @@
+#include "matched_filter.h"
+#include "dechirp_reference.hpp"
+#include "memory/memory_manager.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+namespace antenna_fft {
+
+namespace {
+
+/**
+ * @brief Итеративный radix-2 FFT (double) — только для построения опоры
+ */
+void FFTRadix2(std::vector<std::complex<double>>& a) {
+    const size_t n = a.size();
+
+    // Бит-реверсная перестановка
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(a[i], a[j]);
+        }
+    }
+
+    // Бабочки
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const double angle = -2.0 * 3.14159265358979323846 / static_cast<double>(len);
+        const size_t half = len / 2;
+        for (size_t k = 0; k < half; ++k) {
+            const std::complex<double> w = std::polar(1.0, angle * static_cast<double>(k));
+            for (size_t i = 0; i < n; i += len) {
+                std::complex<double> u = a[i + k];
+                std::complex<double> v = a[i + k + half] * w;
+                a[i + k] = u + v;
+                a[i + k + half] = u - v;
+            }
+        }
+    }
+}
+
+void HashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+/**
+ * @brief События одного Run: освобождаются на любом выходе, включая исключения
+ *
+ * Загрузку сначала дожидаемся: при ошибке на полпути неблокирующая запись
+ * из памяти хоста не должна пережить буфер вызывающего.
+ */
+struct RunEvents {
+    cl_event upload = nullptr;
+    cl_event fft = nullptr;
+    cl_event ifft = nullptr;
+    cl_event post = nullptr;
+
+    RunEvents() = default;
+    RunEvents(const RunEvents&) = delete;
+    RunEvents& operator=(const RunEvents&) = delete;
+
+    ~RunEvents() {
+        if (upload) {
+            clWaitForEvents(1, &upload);
+        }
+        for (cl_event e : { upload, fft, ifft, post }) {
+            if (e) clReleaseEvent(e);
+        }
+    }
+};
+
+/// Учесть cl_mem модуля в MemoryManager под меткой "MatchedFilter/<purpose>"
+void TrackBuffer(drv_gpu_lib::IBackend* backend, cl_mem mem, const char* purpose) {
+    if (auto* mem_mgr = backend ? backend->GetMemoryManager() : nullptr) {
+        mem_mgr->RegisterExternalAllocation(mem, std::string("MatchedFilter/") + purpose);
+    }
+}
+
+/// Снять учёт и освободить cl_mem
+void ReleaseTrackedBuffer(drv_gpu_lib::IBackend* backend, cl_mem& mem) {
+    if (!mem) return;
+    if (auto* mem_mgr = backend ? backend->GetMemoryManager() : nullptr) {
+        mem_mgr->UnregisterExternalAllocation(mem);
+    }
+    clReleaseMemObject(mem);
+    mem = nullptr;
+}
+
+} // namespace
+
+// ════════════════════════════════════════════════════════════════════════════
+// Конструктор / Деструктор
+// ════════════════════════════════════════════════════════════════════════════
+
+MatchedFilterProcessor::MatchedFilterProcessor(
+    const MatchedFilterParams& params,
+    drv_gpu_lib::IBackend* backend)
+    : params_(params)
+    , backend_(backend) {
+
+    if (!backend_) {
+        throw std::invalid_argument("MatchedFilterProcessor: backend cannot be null");
+    }
+
+    if (!backend_->IsInitialized()) {
+        throw std::runtime_error("MatchedFilterProcessor: backend is not initialized");
+    }
+
+    context_ = static_cast<cl_context>(backend_->GetNativeContext());
+    queue_ = static_cast<cl_command_queue>(backend_->GetNativeQueue());
+    device_ = static_cast<cl_device_id>(backend_->GetNativeDevice());
+
+    if (!context_ || !queue_ || !device_) {
+        throw std::runtime_error("MatchedFilterProcessor: failed to get OpenCL resources from backend");
+    }
+}
+
+MatchedFilterProcessor::~MatchedFilterProcessor() {
+    ReleaseResources();
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Публичные методы
+// ════════════════════════════════════════════════════════════════════════════
+
+void MatchedFilterProcessor::Initialize() {
+    if (initialized_) {
+        return;
+    }
+
+    if (params_.beam_count == 0 || params_.n_point == 0 || params_.sample_rate <= 0.0f) {
+        throw std::invalid_argument("MatchedFilterProcessor: beam_count, n_point and sample_rate must be > 0");
+    }
+    if (params_.reference_points == 0) {
+        params_.reference_points = params_.n_point;
+    }
+    params_.nFFT = NextPowerOf2(params_.n_point + params_.reference_points - 1);
+
+    // Инициализация clFFT (если ещё не сделано)
+    static bool clfft_initialized = false;
+    if (!clfft_initialized) {
+        clfftSetupData setup;
+        setup.major = clfftVersionMajor;
+        setup.minor = clfftVersionMinor;
+        setup.patch = clfftVersionPatch;
+        setup.debugFlags = 0;
+        clfftSetup(&setup);
+        clfft_initialized = true;
+    }
+
+    plans_ = std::make_unique<FFTPlanCache>(context_, queue_);
+
+    AllocateBuffers();
+    CompilePostKernel();
+
+    initialized_ = true;
+}
+
+std::vector<MatchedFilterResult> MatchedFilterProcessor::Process(
+    const std::vector<std::complex<float>>& input_data,
+    const LFMParameters& lfm) {
+
+    if (!initialized_) {
+        throw std::runtime_error("MatchedFilterProcessor::Process: not initialized");
+    }
+
+    size_t num_beams = input_data.size() / params_.n_point;
+    if (input_data.size() % params_.n_point != 0 || num_beams == 0 ||
+        num_beams > params_.beam_count) {
+        throw std::invalid_argument(
+            "MatchedFilterProcessor::Process: input size must be k * n_point, 1 <= k <= beam_count");
+    }
+
+    profiling_ = MatchedFilterProfiling{};
+    current_reference_ = &GetReference(lfm);
+    WritePreCallbackHeader(num_beams);
+
+    cl_event upload_event = nullptr;
+    cl_int err = clEnqueueWriteBuffer(
+        queue_, pre_callback_userdata_, CL_FALSE,
+        PRE_CALLBACK_HEADER_SIZE,
+        input_data.size() * sizeof(std::complex<float>), input_data.data(),
+        0, nullptr, &upload_event);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("MatchedFilterProcessor: upload failed: " + std::to_string(err));
+    }
+
+    return Run(num_beams, upload_event);
+}
+
+std::vector<MatchedFilterResult> MatchedFilterProcessor::Process(
+    cl_mem input_signal, size_t num_beams,
+    const LFMParameters& lfm) {
+
+    if (!initialized_) {
+        throw std::runtime_error("MatchedFilterProcessor::Process: not initialized");
+    }
+    if (!input_signal || num_beams == 0 || num_beams > params_.beam_count) {
+        throw std::invalid_argument("MatchedFilterProcessor::Process: invalid input buffer or num_beams");
+    }
+
+    profiling_ = MatchedFilterProfiling{};
+    current_reference_ = &GetReference(lfm);
+    WritePreCallbackHeader(num_beams);
+
+    // Копия device → device в userdata pre-callback (после заголовка)
+    cl_event upload_event = nullptr;
+    cl_int err = clEnqueueCopyBuffer(
+        queue_, input_signal, pre_callback_userdata_,
+        0, PRE_CALLBACK_HEADER_SIZE,
+        num_beams * params_.n_point * sizeof(std::complex<float>),
+        0, nullptr, &upload_event);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("MatchedFilterProcessor: input copy failed: " + std::to_string(err));
+    }
+
+    return Run(num_beams, upload_event);
+}
+
+std::vector<std::complex<float>> MatchedFilterProcessor::ReadCompressed() const {
+    std::vector<std::complex<float>> result(last_num_beams_ * params_.nFFT);
+    if (result.empty()) {
+        return result;
+    }
+
+    cl_int err = clEnqueueReadBuffer(queue_, compressed_, CL_TRUE, 0,
+                                     result.size() * sizeof(std::complex<float>),
+                                     result.data(), 0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("MatchedFilterProcessor::ReadCompressed failed: " + std::to_string(err));
+    }
+    return result;
+}
+
+std::vector<std::complex<float>> MatchedFilterProcessor::ComputeReferenceSpectrum(
+    const LFMParameters& lfm, uint32_t nFFT) {
+
+    const double fs = lfm.sample_rate;
+    const size_t points = std::min<size_t>(lfm.count_points, nFFT);
+    const double duration = static_cast<double>(lfm.count_points) / fs;
+    const double chirp_rate = (static_cast<double>(lfm.f_stop) - lfm.f_start) / duration;
+
+    // Опора r[n] (та же фаза, что у LFMGeneratorModule)
+    std::vector<std::complex<double>> spectrum(nFFT, std::complex<double>(0.0, 0.0));
+    for (size_t n = 0; n < points; ++n) {
+        double t = static_cast<double>(n) / fs;
+        double cycles = lfm.f_start * t + 0.5 * chirp_rate * t * t;
+        cycles -= std::floor(cycles);
+        spectrum[n] = std::polar(1.0, 2.0 * 3.14159265358979323846 * cycles);
+    }
+
+    FFTRadix2(spectrum);
+
+    std::vector<std::complex<float>> result(nFFT);
+    for (uint32_t k = 0; k < nFFT; ++k) {
+        result[k] = std::complex<float>(static_cast<float>(spectrum[k].real()),
+                                        static_cast<float>(-spectrum[k].imag()));
+    }
+    return result;
+}
+
+size_t MatchedFilterProcessor::HashReference(const LFMParameters& lfm) {
+    size_t seed = 0;
+    HashCombine(seed, std::hash<float>()(lfm.f_start));
+    HashCombine(seed, std::hash<float>()(lfm.f_stop));
+    HashCombine(seed, std::hash<float>()(lfm.sample_rate));
+    HashCombine(seed, std::hash<size_t>()(lfm.count_points));
+    return seed;
+}
+
+void MatchedFilterProcessor::ClearReferenceCache() {
+    for (auto& [hash, entry] : references_) {
+        ReleaseReference(entry);
+    }
+    references_.clear();
+    current_reference_ = nullptr;
+}
+
+size_t MatchedFilterProcessor::GetForwardPlanCount() const {
+    size_t count = 0;
+    for (const auto& [hash, entry] : references_) {
+        if (entry.forward_plans) {
+            count += entry.forward_plans->GetCacheSize();
+        }
+    }
+    return count;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Приватные методы
+// ════════════════════════════════════════════════════════════════════════════
+
+uint32_t MatchedFilterProcessor::NextPowerOf2(uint32_t n) {
+    if (n == 0) return 1;
+    n--;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+    return n + 1;
+}
+
+void MatchedFilterProcessor::AllocateBuffers() {
+    cl_int err;
+
+    const size_t input_bytes = static_cast<size_t>(params_.beam_count) * params_.n_point *
+                               sizeof(std::complex<float>);
+    pre_callback_userdata_ = clCreateBuffer(context_, CL_MEM_READ_WRITE,
+                                            PRE_CALLBACK_HEADER_SIZE + input_bytes, nullptr, &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create pre_callback_userdata buffer: " + std::to_string(err));
+    }
+    TrackBuffer(backend_, pre_callback_userdata_, "pre_callback_userdata");
+
+    const size_t fft_bytes = static_cast<size_t>(params_.beam_count) * params_.nFFT *
+                             sizeof(std::complex<float>);
+    spectrum_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, fft_bytes, nullptr, &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create spectrum buffer: " + std::to_string(err));
+    }
+    TrackBuffer(backend_, spectrum_, "spectrum");
+
+    compressed_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, fft_bytes, nullptr, &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create compressed buffer: " + std::to_string(err));
+    }
+    TrackBuffer(backend_, compressed_, "compressed");
+
+    maxima_output_ = clCreateBuffer(context_, CL_MEM_READ_WRITE,
+                                    params_.beam_count * 4 * sizeof(MaxValue), nullptr, &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create maxima_output buffer: " + std::to_string(err));
+    }
+    TrackBuffer(backend_, maxima_output_, "maxima_output");
+}
+
+void MatchedFilterProcessor::CompilePostKernel() {
+    cl_int err;
+
+    const char* source = kernels::GetPostKernelSource();
+    size_t source_len = strlen(source);
+
+    post_program_ = clCreateProgramWithSource(context_, 1, &source, &source_len, &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("clCreateProgramWithSource failed: " + std::to_string(err));
+    }
+
+    err = clBuildProgram(post_program_, 1, &device_, "-D SPECTRUM_STORAGE=0", nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        size_t log_size;
+        clGetProgramBuildInfo(post_program_, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+        std::vector<char> log(log_size);
+        clGetProgramBuildInfo(post_program_, device_, CL_PROGRAM_BUILD_LOG, log_size, log.data(), nullptr);
+        std::cerr << "Build log:\n" << log.data() << "\n";
+        clReleaseProgram(post_program_);
+        post_program_ = nullptr;
+        throw std::runtime_error("clBuildProgram failed: " + std::to_string(err));
+    }
+
+    post_kernel_ = clCreateKernel(post_program_, "post_kernel", &err);
+    if (err != CL_SUCCESS) {
+        clReleaseProgram(post_program_);
+        post_program_ = nullptr;
+        throw std::runtime_error("clCreateKernel failed: " + std::to_string(err));
+    }
+}
+
+MatchedFilterProcessor::ReferenceEntry& MatchedFilterProcessor::GetReference(
+    const LFMParameters& lfm) {
+    if (!lfm.IsValid()) {
+        throw std::invalid_argument("MatchedFilterProcessor: invalid LFMParameters");
+    }
+    if (lfm.count_points > params_.reference_points) {
+        throw std::invalid_argument(
+            "MatchedFilterProcessor: lfm.count_points exceeds reference_points (" +
+            std::to_string(params_.reference_points) + ")");
+    }
+    if (std::fabs(lfm.sample_rate - params_.sample_rate) > 1e-6f * params_.sample_rate) {
+        throw std::invalid_argument(
+            "MatchedFilterProcessor: LFMParameters::sample_rate must match MatchedFilterParams::sample_rate");
+    }
+
+    const size_t hash = HashReference(lfm);
+    auto it = references_.find(hash);
+    if (it != references_.end()) {
+        ReferenceEntry& e = it->second;
+        if (e.f_start == lfm.f_start && e.f_stop == lfm.f_stop &&
+            e.sample_rate == lfm.sample_rate && e.count_points == lfm.count_points) {
+            return e;
+        }
+        // Коллизия хэша — заменить опору (её планы уходят вместе с ней)
+        if (current_reference_ == &e) {
+            current_reference_ = nullptr;
+        }
+        ReleaseReference(e);
+        references_.erase(it);
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::complex<float>> spectrum = ComputeReferenceSpectrum(lfm, params_.nFFT);
+
+    // userdata post-callback: [32 байт {nFFT, pad×7}][conj(R)]
+    std::vector<char> host(PRE_CALLBACK_HEADER_SIZE + spectrum.size() * sizeof(std::complex<float>), 0);
+    uint32_t nFFT = params_.nFFT;
+    std::memcpy(host.data(), &nFFT, sizeof(nFFT));
+    std::memcpy(host.data() + PRE_CALLBACK_HEADER_SIZE, spectrum.data(),
+                spectrum.size() * sizeof(std::complex<float>));
+
+    cl_int err;
+    cl_mem userdata = clCreateBuffer(context_, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                     host.size(), host.data(), &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create reference buffer: " + std::to_string(err));
+    }
+    TrackBuffer(backend_, userdata, "reference");
+
+    ReferenceEntry entry;
+    entry.f_start = lfm.f_start;
+    entry.f_stop = lfm.f_stop;
+    entry.sample_rate = lfm.sample_rate;
+    entry.count_points = lfm.count_points;
+    entry.userdata = userdata;
+    entry.forward_plans = std::make_unique<FFTPlanCache>(context_, queue_);
+    ReferenceEntry& stored = references_[hash] = std::move(entry);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    profiling_.reference_time_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+    return stored;
+}
+
+void MatchedFilterProcessor::ReleaseReference(ReferenceEntry& entry) {
+    entry.forward_plans.reset();
+    ReleaseTrackedBuffer(backend_, entry.userdata);
+}
+
+FFTPlanKey MatchedFilterProcessor::GetForwardPlan(ReferenceEntry& reference, size_t num_beams) {
+    FFTPlanCache& plans = *reference.forward_plans;
+    FFTPlanKey key{params_.nFFT, num_beams, FFTDirection::Forward, FFTPlacement::OutOfPlace};
+    if (plans.IsBaked(key)) {
+        return key;
+    }
+
+    clfftPlanHandle plan = plans.GetOrCreate(key);
+
+    // Pre-callback: дополнение нулями из userdata (гетеродин выключен)
+    clfftStatus status = clfftSetPlanCallback(plan, "prepareDataPre",
+                                              kernels::GetPreCallbackSource32(), 0,
+                                              PRECALLBACK, &pre_callback_userdata_, 1);
+    if (status != CLFFT_SUCCESS) {
+        plans.Remove(key);
+        throw std::runtime_error("clfftSetPlanCallback (pre) failed: " + std::to_string(status));
+    }
+
+    // Post-callback: X·conj(R). clFFT копирует cl_mem сейчас — план навсегда
+    // привязан к этой опоре, поэтому и живёт в её кэше
+    status = clfftSetPlanCallback(plan, "multiplyReferencePost",
+                                  kernels::GetMatchedFilterPostCallbackSource(), 0,
+                                  POSTCALLBACK, &reference.userdata, 1);
+    if (status != CLFFT_SUCCESS) {
+        plans.Remove(key);
+        throw std::runtime_error("clfftSetPlanCallback (post) failed: " + std::to_string(status));
+    }
+
+    status = clfftBakePlan(plan, 1, &queue_, nullptr, nullptr);
+    if (status != CLFFT_SUCCESS) {
+        plans.Remove(key);
+        throw std::runtime_error("clfftBakePlan (forward) failed: " + std::to_string(status));
+    }
+
+    plans.MarkBaked(key);
+    return key;
+}
+
+std::vector<MatchedFilterResult> MatchedFilterProcessor::Run(
+    size_t num_beams, cl_event upload_event) {
+
+    RunEvents events;
+    events.upload = upload_event;
+
+    FFTPlanCache& forward_plans = *current_reference_->forward_plans;
+    FFTPlanKey forward = GetForwardPlan(*current_reference_, num_beams);
+    FFTPlanKey inverse{params_.nFFT, num_beams, FFTDirection::Backward, FFTPlacement::OutOfPlace};
+    plans_->GetBaked(inverse);
+
+    // 1. FFT + ×conj(R) в post-callback (вход игнорируется — данные даёт pre-callback)
+    forward_plans.Enqueue(forward, compressed_, spectrum_, 1, &events.upload, &events.fft);
+
+    // 2. IFFT → корреляция (clFFT масштабирует на 1/nFFT)
+    plans_->Enqueue(inverse, spectrum_, compressed_, 1, &events.fft, &events.ifft);
+
+    // 3. post_kernel по всему буферу: ширина бина = 1 → refined_frequency = отсчёт пика
+    cl_uint beams = static_cast<cl_uint>(num_beams);
+    cl_uint nFFT = params_.nFFT;
+    cl_uint search_range = params_.nFFT;
+    float bin_scale = static_cast<float>(params_.nFFT);
+
+    cl_int err = clSetKernelArg(post_kernel_, 0, sizeof(cl_mem), &compressed_);
+    err |= clSetKernelArg(post_kernel_, 1, sizeof(cl_mem), &maxima_output_);
+    err |= clSetKernelArg(post_kernel_, 2, sizeof(cl_uint), &beams);
+    err |= clSetKernelArg(post_kernel_, 3, sizeof(cl_uint), &nFFT);
+    err |= clSetKernelArg(post_kernel_, 4, sizeof(cl_uint), &search_range);
+    err |= clSetKernelArg(post_kernel_, 5, sizeof(float), &bin_scale);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("clSetKernelArg failed: " + std::to_string(err));
+    }
+
+    size_t global_size = num_beams * LOCAL_SIZE;
+    size_t local_size = LOCAL_SIZE;
+    err = clEnqueueNDRangeKernel(queue_, post_kernel_, 1, nullptr,
+                                 &global_size, &local_size,
+                                 1, &events.ifft, &events.post);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("clEnqueueNDRangeKernel failed: " + std::to_string(err));
+    }
+
+    // 4. Результаты
+    std::vector<MaxValue> raw(num_beams * 4);
+    err = clEnqueueReadBuffer(queue_, maxima_output_, CL_TRUE, 0,
+                              raw.size() * sizeof(MaxValue), raw.data(),
+                              1, &events.post, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("MatchedFilterProcessor: read results failed: " + std::to_string(err));
+    }
+
+    profiling_.upload_time_ms = ProfileEvent(events.upload);
+    profiling_.forward_fft_time_ms = ProfileEvent(events.fft);
+    profiling_.inverse_fft_time_ms = ProfileEvent(events.ifft);
+    profiling_.post_kernel_time_ms = ProfileEvent(events.post);
+    profiling_.total_time_ms = profiling_.upload_time_ms + profiling_.forward_fft_time_ms +
+                               profiling_.inverse_fft_time_ms + profiling_.post_kernel_time_ms +
+                               profiling_.reference_time_ms;
+
+    last_num_beams_ = num_beams;
+
+    std::vector<MatchedFilterResult> results(num_beams);
+    const float half = 0.5f * static_cast<float>(params_.nFFT);
+    for (size_t b = 0; b < num_beams; ++b) {
+        MatchedFilterResult& r = results[b];
+        r.beam_id = static_cast<uint32_t>(b);
+        r.peak = raw[b * 4 + 0];
+
+        // Отрицательные задержки лежат в конце буфера
+        float delay = r.peak.refined_frequency;
+        if (delay >= half) {
+            delay -= static_cast<float>(params_.nFFT);
+        }
+        r.delay_samples = delay;
+        r.delay_seconds = static_cast<double>(delay) / params_.sample_rate;
+        r.magnitude = r.peak.magnitude;
+        r.phase = r.peak.phase;
+    }
+    return results;
+}
+
+void MatchedFilterProcessor::WritePreCallbackHeader(size_t num_beams) {
+    PreCallbackHeader header = MakePreCallbackHeader(
+        num_beams, params_.n_point, params_.nFFT, DechirpReference{});
+
+    cl_int err = clEnqueueWriteBuffer(queue_, pre_callback_userdata_, CL_TRUE,
+                                      0, sizeof(header), &header, 0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to write pre_callback header: " + std::to_string(err));
+    }
+}
+
+double MatchedFilterProcessor::ProfileEvent(cl_event event) {
+    if (!event) return 0.0;
+
+    clWaitForEvents(1, &event);
+
+    cl_ulong start = 0, end = 0;
+    cl_int err1 = clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START,
+                                          sizeof(cl_ulong), &start, nullptr);
+    cl_int err2 = clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END,
+                                          sizeof(cl_ulong), &end, nullptr);
+    if (err1 != CL_SUCCESS || err2 != CL_SUCCESS) {
+        return 0.0;
+    }
+    return (end - start) / 1e6;
+}
+
+void MatchedFilterProcessor::ReleaseResources() {
+    if (post_kernel_) {
+        clReleaseKernel(post_kernel_);
+        post_kernel_ = nullptr;
+    }
+    if (post_program_) {
+        clReleaseProgram(post_program_);
+        post_program_ = nullptr;
+    }
+
+    // Планы (деструктор FFTPlanCache освобождает все); прямые — вместе с опорами
+    plans_.reset();
+
+    ClearReferenceCache();
+
+    ReleaseTrackedBuffer(backend_, pre_callback_userdata_);
+    ReleaseTrackedBuffer(backend_, spectrum_);
+    ReleaseTrackedBuffer(backend_, compressed_);
+    ReleaseTrackedBuffer(backend_, maxima_output_);
+
+    last_num_beams_ = 0;
+    initialized_ = false;
+}
+
+} // namespace antenna_fft
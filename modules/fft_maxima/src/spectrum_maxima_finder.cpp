@@ -1,4 +1,5 @@
 #include "spectrum_maxima_finder.h"
+#include "memory/memory_manager.hpp"
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
@@ -7,6 +8,27 @@
 
 namespace antenna_fft {
 
+namespace {
+
+/// Учесть cl_mem модуля в MemoryManager под меткой "SpectrumMaximaFinder/<purpose>"
+void TrackBuffer(drv_gpu_lib::IBackend* backend, cl_mem mem, const char* purpose) {
+    if (auto* mem_mgr = backend ? backend->GetMemoryManager() : nullptr) {
+        mem_mgr->RegisterExternalAllocation(mem, std::string("SpectrumMaximaFinder/") + purpose);
+    }
+}
+
+/// Снять учёт и освободить cl_mem
+void ReleaseTrackedBuffer(drv_gpu_lib::IBackend* backend, cl_mem& mem) {
+    if (!mem) return;
+    if (auto* mem_mgr = backend ? backend->GetMemoryManager() : nullptr) {
+        mem_mgr->UnregisterExternalAllocation(mem);
+    }
+    clReleaseMemObject(mem);
+    mem = nullptr;
+}
+
+} // anonymous namespace
+
 // ════════════════════════════════════════════════════════════════════════════
 // Конструктор / Деструктор
 // ════════════════════════════════════════════════════════════════════════════
@@ -52,6 +74,8 @@ SpectrumMaximaFinder::SpectrumMaximaFinder(SpectrumMaximaFinder&& other) noexcep
     , fft_input_(other.fft_input_)
     , fft_output_(other.fft_output_)
     , maxima_output_(other.maxima_output_)
+    , upload_buffer_(std::move(other.upload_buffer_))
+    , dechirp_(other.dechirp_)
     , post_program_(other.post_program_)
     , post_kernel_(other.post_kernel_)
     , profiling_(other.profiling_) {
@@ -84,6 +108,8 @@ SpectrumMaximaFinder& SpectrumMaximaFinder::operator=(SpectrumMaximaFinder&& oth
         fft_input_ = other.fft_input_;
         fft_output_ = other.fft_output_;
         maxima_output_ = other.maxima_output_;
+        upload_buffer_ = std::move(other.upload_buffer_);
+        dechirp_ = other.dechirp_;
         post_program_ = other.post_program_;
         post_kernel_ = other.post_kernel_;
         profiling_ = other.profiling_;
@@ -122,6 +148,8 @@ void SpectrumMaximaFinder::Initialize() {
     std::cout << "  📊 nFFT: " << params_.nFFT << "\n";
     std::cout << "  📊 search_range: " << params_.search_range << "\n";
     std::cout << "  📊 sample_rate: " << params_.sample_rate << " Hz\n";
+    std::cout << "  📊 spectrum_storage: " << SpectrumStorageName(params_.spectrum_storage)
+              << " (" << SpectrumBytesPerBin(params_.spectrum_storage) << " B/bin)\n";
 
     // 2. Создать GPU буферы
     AllocateBuffers();
@@ -139,6 +167,16 @@ void SpectrumMaximaFinder::Initialize() {
     std::cout << "[SpectrumMaximaFinder] Инициализация завершена!\n\n";
 }
 
+void SpectrumMaximaFinder::Warmup(const drv_gpu_lib::WarmupConfig& config) {
+    Initialize();
+
+    if (config.run_dummy_frame) {
+        std::vector<std::complex<float>> zeros(
+            static_cast<size_t>(params_.antenna_count) * params_.n_point);
+        Process(zeros);
+    }
+}
+
 std::vector<SpectrumResult> SpectrumMaximaFinder::Process(
     const std::vector<std::complex<float>>& input_data) {
 
@@ -184,6 +222,22 @@ std::vector<SpectrumResult> SpectrumMaximaFinder::Process(
     return results;
 }
 
+void SpectrumMaximaFinder::SetHeterodyne(const LFMParameters& lfm) {
+    if (lfm.apply_heterodyne &&
+        std::fabs(lfm.sample_rate - params_.sample_rate) > 1e-6f * lfm.sample_rate) {
+        throw std::invalid_argument(
+            "SpectrumMaximaFinder::SetHeterodyne: LFMParameters::sample_rate "
+            "must match SpectrumParams::sample_rate");
+    }
+
+    dechirp_ = DechirpReference::FromLFM(lfm);
+
+    // После Initialize() заголовок уже на GPU — перезаписать (план не меняется)
+    if (pre_callback_userdata_) {
+        WritePreCallbackHeader();
+    }
+}
+
 void SpectrumMaximaFinder::PrintInfo() const {
     std::cout << "\n";
     std::cout << "════════════════════════════════════════════════════════════\n";
@@ -197,6 +251,10 @@ void SpectrumMaximaFinder::PrintInfo() const {
     std::cout << std::setw(25) << "  nFFT:" << params_.nFFT << "\n";
     std::cout << std::setw(25) << "  Search range:" << params_.search_range << "\n";
     std::cout << std::setw(25) << "  Sample rate:" << params_.sample_rate << " Hz\n";
+    std::cout << std::setw(25) << "  Spectrum storage:" << SpectrumStorageName(params_.spectrum_storage)
+              << " (" << GetSpectrumBufferBytes() / 1024.0 << " KB)\n";
+    std::cout << std::setw(25) << "  Heterodyne:" << (dechirp_.enabled ? "Yes" : "No") << "\n";
+    std::cout << std::setw(25) << "  Zero-copy upload:" << (UsesZeroCopyUpload() ? "Yes" : "No") << "\n";
     std::cout << std::setw(25) << "  Initialized:" << (initialized_ ? "Yes" : "No") << "\n";
     std::cout << "════════════════════════════════════════════════════════════\n\n";
 }
@@ -233,44 +291,32 @@ void SpectrumMaximaFinder::AllocateBuffers() {
     cl_int err;
 
     // 1. Pre-callback userdata: [32 bytes header][input data]
-    // Header: {beam_count, count_points, nFFT, pad, pad, pad, pad, pad}
+    // Header: {beam_count, count_points, nFFT, dechirp, phase_step, phase_curve}
     size_t input_data_size = params_.antenna_count * params_.n_point * sizeof(std::complex<float>);
     size_t userdata_size = PRE_CALLBACK_HEADER_SIZE + input_data_size;
 
-    pre_callback_userdata_ = clCreateBuffer(context_, CL_MEM_READ_WRITE,
-                                             userdata_size, nullptr, &err);
-    if (err != CL_SUCCESS) {
-        throw std::runtime_error("Failed to create pre_callback_userdata buffer: " + std::to_string(err));
+    // На общей памяти (CPU / APU / iGPU) — zero-copy буфер: вход пишется через map
+    drv_gpu_lib::MemoryManager* mem_mgr = backend_->GetMemoryManager();
+    if (mem_mgr && mem_mgr->HasUnifiedMemory()) {
+        drv_gpu_lib::ScopedMemoryTag tag("SpectrumMaximaFinder/pre_callback_userdata");
+        upload_buffer_ = mem_mgr->CreateZeroCopyBuffer<uint8_t>(userdata_size);
+        pre_callback_userdata_ = upload_buffer_->GetCLMem();
+        clRetainMemObject(pre_callback_userdata_);  // ReleaseResources освобождает как обычный
+    } else {
+        pre_callback_userdata_ = clCreateBuffer(context_, CL_MEM_READ_WRITE,
+                                                 userdata_size, nullptr, &err);
+        if (err != CL_SUCCESS) {
+            throw std::runtime_error("Failed to create pre_callback_userdata buffer: " + std::to_string(err));
+        }
+        TrackBuffer(backend_, pre_callback_userdata_, "pre_callback_userdata");
     }
 
     // Записать заголовок (32 bytes)
-    struct PreCallbackHeader {
-        uint32_t beam_count;
-        uint32_t count_points;
-        uint32_t nFFT;
-        uint32_t padding1;
-        uint32_t padding2;
-        uint32_t padding3;
-        uint32_t padding4;
-        uint32_t padding5;
-    };
-    static_assert(sizeof(PreCallbackHeader) == 32, "PreCallbackHeader must be 32 bytes");
-
-    PreCallbackHeader header = {
-        params_.antenna_count,
-        params_.n_point,
-        params_.nFFT,
-        0, 0, 0, 0, 0
-    };
-
-    err = clEnqueueWriteBuffer(queue_, pre_callback_userdata_, CL_TRUE,
-                               0, sizeof(header), &header,
-                               0, nullptr, nullptr);
-    if (err != CL_SUCCESS) {
-        throw std::runtime_error("Failed to write pre_callback header: " + std::to_string(err));
-    }
+    WritePreCallbackHeader();
 
     // 2. FFT буферы
+    // В компактных режимах FFT идёт in-place в fft_input_, а post-callback
+    // пишет в fft_output_ ужатый спектр (2-4 байта/бин вместо 8)
     size_t fft_buffer_size = params_.antenna_count * params_.nFFT * sizeof(std::complex<float>);
 
     fft_input_ = clCreateBuffer(context_, CL_MEM_READ_WRITE,
@@ -278,12 +324,14 @@ void SpectrumMaximaFinder::AllocateBuffers() {
     if (err != CL_SUCCESS) {
         throw std::runtime_error("Failed to create fft_input buffer: " + std::to_string(err));
     }
+    TrackBuffer(backend_, fft_input_, "fft_input");
 
     fft_output_ = clCreateBuffer(context_, CL_MEM_READ_WRITE,
-                                  fft_buffer_size, nullptr, &err);
+                                  GetSpectrumBufferBytes(), nullptr, &err);
     if (err != CL_SUCCESS) {
         throw std::runtime_error("Failed to create fft_output buffer: " + std::to_string(err));
     }
+    TrackBuffer(backend_, fft_output_, "fft_output");
 
     // 3. Maxima output: antenna_count * 4 * sizeof(MaxValue)
     size_t maxima_size = params_.antenna_count * 4 * sizeof(MaxValue);
@@ -294,6 +342,19 @@ void SpectrumMaximaFinder::AllocateBuffers() {
     if (err != CL_SUCCESS) {
         throw std::runtime_error("Failed to create maxima_output buffer: " + std::to_string(err));
     }
+    TrackBuffer(backend_, maxima_output_, "maxima_output");
+}
+
+void SpectrumMaximaFinder::WritePreCallbackHeader() {
+    PreCallbackHeader header = MakePreCallbackHeader(
+        params_.antenna_count, params_.n_point, params_.nFFT, dechirp_);
+
+    cl_int err = clEnqueueWriteBuffer(queue_, pre_callback_userdata_, CL_TRUE,
+                                      0, sizeof(header), &header,
+                                      0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to write pre_callback header: " + std::to_string(err));
+    }
 }
 
 void SpectrumMaximaFinder::CreateFFTPlanWithCallback() {
@@ -320,7 +381,7 @@ void SpectrumMaximaFinder::CreateFFTPlanWithCallback() {
     // Настроить план
     clfftSetPlanPrecision(plan_handle_, CLFFT_SINGLE);
     clfftSetLayout(plan_handle_, CLFFT_COMPLEX_INTERLEAVED, CLFFT_COMPLEX_INTERLEAVED);
-    clfftSetResultLocation(plan_handle_, CLFFT_OUTOFPLACE);
+    clfftSetResultLocation(plan_handle_, UsesCompactSpectrum() ? CLFFT_INPLACE : CLFFT_OUTOFPLACE);
     clfftSetPlanBatchSize(plan_handle_, params_.antenna_count);
 
     size_t strides[1] = {1};
@@ -338,6 +399,18 @@ void SpectrumMaximaFinder::CreateFFTPlanWithCallback() {
         throw std::runtime_error("clfftSetPlanCallback (pre) failed: " + std::to_string(status));
     }
 
+    // Регистрировать post-callback упаковки спектра (userdata = fft_output_)
+    if (UsesCompactSpectrum()) {
+        const char* post_callback_source = kernels::GetSpectrumStoreCallbackSource(
+            static_cast<uint32_t>(params_.spectrum_storage));
+        status = clfftSetPlanCallback(plan_handle_, "storeSpectrumPost", post_callback_source, 0,
+                                       POSTCALLBACK, &fft_output_, 1);
+        if (status != CLFFT_SUCCESS) {
+            clfftDestroyPlan(&plan_handle_);
+            throw std::runtime_error("clfftSetPlanCallback (post) failed: " + std::to_string(status));
+        }
+    }
+
     // Bake план
     status = clfftBakePlan(plan_handle_, 1, &queue_, nullptr, nullptr);
     if (status != CLFFT_SUCCESS) {
@@ -361,8 +434,10 @@ void SpectrumMaximaFinder::CompilePostKernel() {
         throw std::runtime_error("clCreateProgramWithSource failed: " + std::to_string(err));
     }
 
-    // Скомпилировать
-    err = clBuildProgram(post_program_, 1, &device_, nullptr, nullptr, nullptr);
+    // Скомпилировать (формат спектра выбирается макросом SPECTRUM_STORAGE)
+    std::string build_options = "-D SPECTRUM_STORAGE=" +
+        std::to_string(static_cast<uint32_t>(params_.spectrum_storage));
+    err = clBuildProgram(post_program_, 1, &device_, build_options.c_str(), nullptr, nullptr);
     if (err != CL_SUCCESS) {
         // Получить лог ошибок
         size_t log_size;
@@ -388,6 +463,14 @@ cl_event SpectrumMaximaFinder::UploadData(const std::vector<std::complex<float>>
     cl_event event = nullptr;
     size_t data_size = input_data.size() * sizeof(std::complex<float>);
 
+    // Общая память: map отдаёт сами данные буфера — одна memcpy, без копии драйвера
+    if (upload_buffer_) {
+        void* region = upload_buffer_->MapRegion(
+            PRE_CALLBACK_HEADER_SIZE, data_size, CL_MAP_WRITE_INVALIDATE_REGION);
+        std::memcpy(region, input_data.data(), data_size);
+        return upload_buffer_->UnmapRegion(region);
+    }
+
     // Записать данные в userdata после заголовка (offset = 32)
     cl_int err = clEnqueueWriteBuffer(
         queue_,
@@ -411,15 +494,16 @@ cl_event SpectrumMaximaFinder::ExecuteFFT(cl_event wait_event) {
     cl_event event = nullptr;
 
     // Выполнить FFT с pre-callback
+    // Компактный режим: in-place, результат пишет post-callback в fft_output_
     clfftStatus status = clfftEnqueueTransform(
         plan_handle_,
         CLFFT_FORWARD,
         1, &queue_,
         (wait_event ? 1 : 0), (wait_event ? &wait_event : nullptr),
         &event,
-        &fft_input_,    // Input (pre-callback читает из userdata)
-        &fft_output_,   // Output
-        nullptr         // Temp buffer
+        &fft_input_,                                        // Input (pre-callback читает из userdata)
+        UsesCompactSpectrum() ? nullptr : &fft_output_,     // Output
+        nullptr                                             // Temp buffer
     );
 
     if (status != CLFFT_SUCCESS) {
@@ -549,23 +633,13 @@ void SpectrumMaximaFinder::ReleaseResources() {
         plan_created_ = false;
     }
 
-    // Буферы
-    if (pre_callback_userdata_) {
-        clReleaseMemObject(pre_callback_userdata_);
-        pre_callback_userdata_ = nullptr;
-    }
-    if (fft_input_) {
-        clReleaseMemObject(fft_input_);
-        fft_input_ = nullptr;
-    }
-    if (fft_output_) {
-        clReleaseMemObject(fft_output_);
-        fft_output_ = nullptr;
-    }
-    if (maxima_output_) {
-        clReleaseMemObject(maxima_output_);
-        maxima_output_ = nullptr;
-    }
+    // Буферы (pre_callback_userdata_ zero-copy-режима не зарегистрирован —
+    // его учитывает upload_buffer_)
+    ReleaseTrackedBuffer(backend_, pre_callback_userdata_);
+    ReleaseTrackedBuffer(backend_, fft_input_);
+    ReleaseTrackedBuffer(backend_, fft_output_);
+    ReleaseTrackedBuffer(backend_, maxima_output_);
+    upload_buffer_.reset();
 
     initialized_ = false;
 }
@@ -0,0 +1,108 @@
+#pragma once
+/**
+ * @file test_dechirp.hpp
+ * @brief Тест гетеродина ЛЧМ в pre-callback SpectrumMaximaFinder
+ *
+ * Эхо ЛЧМ с задержкой d_a отсчётов на каждой антенне. После dechirp
+ * в pre-callback эхо — тон биений f_b = -k·τ_a, его частоту находит
+ * обычный post-kernel (отрицательные частоты → fs - k·τ_a).
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "spectrum_maxima_finder.h"
+#include "interface/lfm_parameters.h"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <cmath>
+
+namespace test_dechirp {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║     TEST: гетеродин ЛЧМ в pre-callback (dechirp)         ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        LFMParameters lfm;
+        lfm.f_start = 1.0e6f;
+        lfm.f_stop = 3.0e6f;
+        lfm.sample_rate = 12.0e6f;
+        lfm.count_points = 4096;
+        lfm.num_beams = 16;
+        lfm.apply_heterodyne = true;
+        lfm.IsValid();
+
+        const double fs = lfm.sample_rate;
+        const double chirp_rate = lfm.GetChirpRate();
+
+        // Эхо: s_a[n] = ref(n - d_a), d_a = 10 + 5·a отсчётов
+        std::vector<double> delays(lfm.num_beams);
+        std::vector<std::complex<float>> echo(lfm.num_beams * lfm.count_points);
+        for (size_t a = 0; a < lfm.num_beams; ++a) {
+            delays[a] = 10.0 + 5.0 * static_cast<double>(a);
+            for (size_t n = 0; n < lfm.count_points; ++n) {
+                double t = (static_cast<double>(n) - delays[a]) / fs;
+                if (t < 0.0) continue;
+                double cycles = lfm.f_start * t + 0.5 * chirp_rate * t * t;
+                double ph = 2.0 * 3.14159265358979323846 * (cycles - std::floor(cycles));
+                echo[a * lfm.count_points + n] = std::complex<float>(
+                    static_cast<float>(std::cos(ph)), static_cast<float>(std::sin(ph)));
+            }
+        }
+
+        antenna_fft::SpectrumParams sp;
+        sp.antenna_count = static_cast<uint32_t>(lfm.num_beams);
+        sp.n_point = static_cast<uint32_t>(lfm.count_points);
+        sp.repeat_count = 2;
+        sp.sample_rate = lfm.sample_rate;
+
+        antenna_fft::SpectrumMaximaFinder finder(sp, &gpu.GetBackend());
+        finder.Initialize();
+        finder.SetHeterodyne(lfm);
+        auto results = finder.Process(echo);
+
+        const double bin_width = fs / finder.GetParams().nFFT;
+        std::cout << "  Антенна  d, отсч   f_b ожид. (Гц)   f найд. (Гц)\n";
+        std::cout << "  ─────────────────────────────────────────────────\n";
+
+        bool passed = true;
+        for (const auto& r : results) {
+            double tau = delays[r.antenna_id] / fs;
+            double expected = fs - chirp_rate * tau;       // -k·τ в отрицательной половине
+            double found = r.interpolated.refined_frequency;
+            bool ok = std::abs(found - expected) < 0.5 * bin_width;
+            passed &= ok;
+            std::cout << std::fixed << std::setprecision(1)
+                      << "  " << std::setw(5) << r.antenna_id
+                      << std::setw(10) << delays[r.antenna_id]
+                      << std::setw(17) << expected << std::setw(16) << found
+                      << "  " << (ok ? "✅" : "❌") << "\n";
+        }
+
+        const auto& prof = finder.GetProfilingData();
+        std::cout << "\n  FFT (с dechirp в pre-callback): " << std::setprecision(3)
+                  << prof.fft_time_ms << " мс\n";
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_dechirp
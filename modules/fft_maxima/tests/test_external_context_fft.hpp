@@ -20,6 +20,9 @@
  *   │ Вариант B: cl_context + ExternalCLBufferAdapter                │
  *   │   Обёртка ExternalCLBufferAdapter<complex<float>> над cl_mem   │
  *   │   Read()/Write() для загрузки/выгрузки данных                  │
+ *   │                                                                  │
+ *   │ Вариант D: ExternalCLBufferAdapter + события                   │
+ *   │   Производитель и вычисления на разных очередях, без блокировок │
  *   └──────────────────────────────────────────────────────────────────┘
  *              |
  *              v
@@ -539,6 +542,95 @@ static bool TestC_SvmToClMem(ExternalOpenCLContext& ext_ctx) {
     }
 }
 
+// ============================================================================
+// ТЕСТ D: Событийный обмен через ExternalCLBufferAdapter (две очереди)
+// ============================================================================
+
+/**
+ * @brief Тест D: производитель → очередь вычислений → частичное чтение
+ *
+ * 1. Производитель: WriteAsync в свой буфер на очереди ext_ctx → produced
+ * 2. SignalCompute({produced}) → ready (очередь адаптера сброшена)
+ * 3. Очередь вычислений (вторая cl_command_queue того же контекста):
+ *    clEnqueueCopyBuffer с wait-list {ready} → computed
+ * 4. Адаптер результата: WaitForCompute(computed) + ReadAsync диапазона
+ * Хост нигде не ждёт до последнего clWaitForEvents.
+ */
+static bool TestD_AdapterEvents_CrossQueue(ExternalOpenCLContext& ext_ctx) {
+    std::cout << "\n  ── TEST D: ExternalCLBufferAdapter events, cross-queue ──\n";
+
+    cl_command_queue compute_queue = nullptr;
+    cl_mem src = nullptr;
+    cl_mem dst = nullptr;
+
+    try {
+        const size_t total_elements = TEST_BEAM_COUNT * TEST_COUNT_POINTS;
+        const size_t bytes = total_elements * sizeof(std::complex<float>);
+        cl_int err;
+
+        compute_queue = clCreateCommandQueue(ext_ctx.GetContext(), ext_ctx.GetDevice(), 0, &err);
+        src = clCreateBuffer(ext_ctx.GetContext(), CL_MEM_READ_WRITE, bytes, nullptr, &err);
+        dst = clCreateBuffer(ext_ctx.GetContext(), CL_MEM_READ_WRITE, bytes, nullptr, &err);
+        if (!compute_queue || !src || !dst) {
+            throw std::runtime_error("failed to create queue/buffers");
+        }
+
+        std::vector<std::complex<float>> produced_data(total_elements);
+        for (size_t i = 0; i < total_elements; ++i) {
+            produced_data[i] = std::complex<float>(static_cast<float>(i), -0.5f * i);
+        }
+
+        drv_gpu_lib::ExternalCLBufferAdapter<std::complex<float>> producer(
+            src, total_elements, ext_ctx.GetQueue());
+        drv_gpu_lib::ExternalCLBufferAdapter<std::complex<float>> result(
+            dst, total_elements, ext_ctx.GetQueue());
+        producer.SetComputeQueue(compute_queue);
+        result.SetComputeQueue(compute_queue);
+
+        // 1-2. Производитель → событие готовности для очереди вычислений
+        cl_event produced = producer.WriteAsync(produced_data);
+        cl_event ready = producer.SignalCompute({produced});
+
+        // 3. «Вычисления» на своей очереди
+        cl_event computed = nullptr;
+        err = clEnqueueCopyBuffer(compute_queue, src, dst, 0, 0, bytes, 1, &ready, &computed);
+        if (err != CL_SUCCESS) {
+            throw std::runtime_error("clEnqueueCopyBuffer failed: " + std::to_string(err));
+        }
+        clFlush(compute_queue);
+
+        // 4. Частичное асинхронное чтение после вычислений (второй луч)
+        const size_t offset = TEST_COUNT_POINTS;
+        std::vector<std::complex<float>> beam(TEST_COUNT_POINTS);
+        result.WaitForCompute(computed);
+        cl_event read = result.ReadAsync(beam.data(), offset, beam.size());
+
+        clWaitForEvents(1, &read);
+        for (cl_event e : { produced, ready, computed, read }) {
+            clReleaseEvent(e);
+        }
+
+        bool ok = result.NeedsCrossQueueSync();
+        for (size_t i = 0; i < beam.size() && ok; ++i) {
+            ok = beam[i] == produced_data[offset + i];
+        }
+        std::cout << "   Range [" << offset << ", " << offset + beam.size() << ") "
+                  << (ok ? "matches producer data" : "MISMATCH") << "\n";
+
+        clReleaseMemObject(dst);
+        clReleaseMemObject(src);
+        clReleaseCommandQueue(compute_queue);
+        return ok;
+
+    } catch (const std::exception& e) {
+        std::cerr << "   EXCEPTION: " << e.what() << "\n";
+        if (dst) clReleaseMemObject(dst);
+        if (src) clReleaseMemObject(src);
+        if (compute_queue) clReleaseCommandQueue(compute_queue);
+        return false;
+    }
+}
+
 // ============================================================================
 // ОСНОВНОЙ ТЕСТ
 // ============================================================================
@@ -551,6 +643,7 @@ static bool TestC_SvmToClMem(ExternalOpenCLContext& ext_ctx) {
  *   A: cl_mem вход → CPU выход
  *   B: ExternalCLBufferAdapter вход → CPU выход
  *   C: SVM → cl_mem конвертация → FFT → CPU выход
+ *   D: ExternalCLBufferAdapter, события между двумя очередями
  */
 inline int run() {
     std::cout << R"(
@@ -562,6 +655,7 @@ inline int run() {
 |       A: cl_mem input -> CPU output                                |
 |       B: ExternalCLBufferAdapter -> CPU output                     |
 |       C: SVM -> cl_mem conversion -> FFT                           |
+|       D: ExternalCLBufferAdapter events, cross-queue               |
 |                                                                    |
 |     Key feature: owns_resources_ = false                           |
 |       DrvGPU does NOT destroy external context!                    |
@@ -617,6 +711,15 @@ inline int run() {
             std::cout << "   >>> TEST C: FAILED\n";
         }
 
+        // Test D: Adapter events, две очереди
+        if (TestD_AdapterEvents_CrossQueue(ext_ctx)) {
+            passed++;
+            std::cout << "   >>> TEST D: PASSED\n";
+        } else {
+            failed++;
+            std::cout << "   >>> TEST D: FAILED\n";
+        }
+
         // ══════════════════════════════════════════════════════════════
         // Проверяем что внешний контекст жив
         // ══════════════════════════════════════════════════════════════
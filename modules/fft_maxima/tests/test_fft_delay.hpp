@@ -0,0 +1,113 @@
+#pragma once
+/**
+ * @file test_fft_delay.hpp
+ * @brief Тест задержки лучей фазовым наклоном в processFFTPost (AntennaFFTProcMax)
+ *
+ * Тон точно на бине m: X[m] — вещественный. После задержки D отсчётов
+ * фаза пика должна сдвинуться на -360° · m · D / nFFT, амплитуда и индекс —
+ * не меняться. Проверяется против прогона без задержки.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "modules/fft_maxima/include/antenna_fft_release.h"
+#include "modules/fft_maxima/include/fft_logger.h"
+
+#include "backends/opencl/opencl_backend.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <algorithm>
+
+namespace test_fft_delay {
+
+using namespace antenna_fft;
+
+inline float WrapDeg(float d) {
+    while (d > 180.0f) d -= 360.0f;
+    while (d < -180.0f) d += 360.0f;
+    return d;
+}
+
+inline int run() {
+    std::cout << "\n";
+    std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+    std::cout << "║     TEST: AntennaFFTProcMax — задержка в processFFTPost  ║\n";
+    std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+    try {
+        FFTLogger::SetLevel(FFTLogger::Level::Warning);
+
+        drv_gpu_lib::OpenCLBackend backend;
+        backend.Initialize(0);
+        std::cout << "  ✅ GPU: " << backend.GetDeviceName() << "\n\n";
+
+        AntennaFFTParams params(8, 1024, 512, 3, "delay_test", "fft_delay");
+        params.sample_rate = 12.0e6f;
+
+        AntennaFFTProcMax fft(params, &backend);
+        const size_t nFFT = fft.GetNFFT();
+
+        // Тон на бине m_b = 40 + 10·b (в окне ±out/2 вокруг нуля)
+        std::vector<std::complex<float>> data(params.beam_count * params.count_points);
+        std::vector<int> bins(params.beam_count);
+        for (size_t b = 0; b < params.beam_count; ++b) {
+            bins[b] = 40 + 10 * static_cast<int>(b);
+            for (size_t n = 0; n < params.count_points; ++n) {
+                double ph = 2.0 * 3.14159265358979323846 * bins[b] * n / nFFT;
+                data[b * params.count_points + n] = std::complex<float>(
+                    static_cast<float>(std::cos(ph)), static_cast<float>(std::sin(ph)));
+            }
+        }
+
+        auto reference = fft.ProcessNew(data);
+
+        std::vector<float> delays(params.beam_count);
+        for (size_t b = 0; b < params.beam_count; ++b) {
+            delays[b] = 0.37f + 1.5f * static_cast<float>(b) - 4.0f;
+        }
+        fft.SetBeamDelaySamples(delays);
+        auto delayed = fft.ProcessNew(data);
+
+        std::cout << "  Луч  бин   D, отсч   Δφ ожид.   Δφ факт.   idx  |X|\n";
+        std::cout << "  ──────────────────────────────────────────────────────\n";
+
+        bool passed = true;
+        for (size_t b = 0; b < params.beam_count; ++b) {
+            const auto& ref = reference.results[b].max_values[0];
+            const auto& got = delayed.results[b].max_values[0];
+
+            float expected = WrapDeg(-360.0f * bins[b] * delays[b] / static_cast<float>(nFFT));
+            float actual = WrapDeg(got.phase - ref.phase);
+            bool idx_ok = (got.index_point == ref.index_point) &&
+                          (ref.index_point == nFFT / 2 + bins[b]);
+            bool mag_ok = std::abs(got.amplitude - ref.amplitude) < 1e-3f * ref.amplitude;
+            bool phase_ok = std::abs(WrapDeg(actual - expected)) < 0.1f;
+            passed &= idx_ok && mag_ok && phase_ok;
+
+            std::cout << std::fixed << std::setprecision(3)
+                      << "  " << std::setw(3) << b << std::setw(6) << bins[b]
+                      << std::setw(10) << delays[b]
+                      << std::setw(11) << expected << std::setw(11) << actual
+                      << "   " << (idx_ok ? "✅" : "❌") << "   " << (mag_ok ? "✅" : "❌")
+                      << (phase_ok ? "" : "  ❌ фаза") << "\n";
+        }
+
+        std::cout << "\n  Частота луча 0: " << delayed.results[0].refined_frequency
+                  << " Гц (ожидалось " << bins[0] * params.sample_rate / nFFT << ")\n";
+        std::cout << "  find_selected_maxima: " << std::setprecision(3)
+                  << fft.GetLastProfilingResults().reduction_time_ms << " мс\n";
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_fft_delay
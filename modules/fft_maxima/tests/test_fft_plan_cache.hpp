@@ -0,0 +1,112 @@
+#pragma once
+/**
+ * @file test_fft_plan_cache.hpp
+ * @brief Тест FFTPlanCache: прямой/обратный, in-place/out-of-place, round-trip
+ *
+ * 1. FFT (out-of-place) → IFFT (in-place) возвращает исходный сигнал
+ * 2. Ключи с разным направлением/размещением — разные планы, повтор — попадание
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "fft_plan_cache.hpp"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+namespace test_fft_plan_cache {
+
+using namespace drv_gpu_lib;
+using namespace antenna_fft;
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║     TEST: FFTPlanCache — FFT → IFFT round-trip           ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        auto& backend = gpu.GetBackend();
+        cl_context context = static_cast<cl_context>(backend.GetNativeContext());
+        cl_command_queue queue = static_cast<cl_command_queue>(backend.GetNativeQueue());
+
+        clfftSetupData setup;
+        setup.major = clfftVersionMajor;
+        setup.minor = clfftVersionMinor;
+        setup.patch = clfftVersionPatch;
+        setup.debugFlags = 0;
+        clfftSetup(&setup);
+
+        const size_t nFFT = 4096;
+        const size_t batch = 16;
+        std::vector<std::complex<float>> signal(nFFT * batch);
+        std::mt19937 rng(7);
+        std::normal_distribution<float> dist(0.0f, 1.0f);
+        for (auto& v : signal) v = std::complex<float>(dist(rng), dist(rng));
+
+        auto& mem_mgr = gpu.GetMemoryManager();
+        auto input = mem_mgr.CreateBuffer<std::complex<float>>(signal.data(), signal.size());
+        auto spectrum = mem_mgr.CreateBuffer<std::complex<float>>(signal.size());
+        cl_mem in_mem = static_cast<cl_mem>(input->GetPtr());
+        cl_mem spec_mem = static_cast<cl_mem>(spectrum->GetPtr());
+
+        FFTPlanCache cache(context, queue);
+        FFTPlanKey fwd{nFFT, batch, FFTDirection::Forward, FFTPlacement::OutOfPlace};
+        FFTPlanKey inv{nFFT, batch, FFTDirection::Backward, FFTPlacement::InPlace};
+
+        bool passed = true;
+
+        // ── 1. Round-trip ───────────────────────────────────────────────────
+        cache.GetBaked(fwd);
+        cache.GetBaked(inv);
+        cl_event fft_event = nullptr;
+        cl_event ifft_event = nullptr;
+        cache.Enqueue(fwd, in_mem, spec_mem, 0, nullptr, &fft_event);
+        cache.Enqueue(inv, spec_mem, nullptr, 1, &fft_event, &ifft_event);
+        clWaitForEvents(1, &ifft_event);
+        clReleaseEvent(fft_event);
+        clReleaseEvent(ifft_event);
+
+        auto restored = spectrum->Read();
+        float max_error = 0.0f;
+        for (size_t i = 0; i < signal.size(); ++i) {
+            max_error = std::max(max_error, std::abs(restored[i] - signal[i]));
+        }
+        bool ok1 = max_error < 1.0e-4f;
+        passed &= ok1;
+        std::cout << "  1. IFFT(FFT(x)) - x: max = " << std::scientific << std::setprecision(2)
+                  << max_error << "  " << (ok1 ? "✅" : "❌") << "\n";
+
+        // ── 2. Ключи ────────────────────────────────────────────────────────
+        cache.GetBaked(fwd);
+        bool ok2 = cache.GetCacheSize() == 2 && cache.GetTotalCreates() == 2 &&
+                   cache.GetTotalHits() == 1 &&
+                   !cache.HasPlan(nFFT, batch, FFTDirection::Backward, FFTPlacement::OutOfPlace);
+        passed &= ok2;
+        std::cout << "  2. Планов: " << cache.GetCacheSize() << ", созданий: "
+                  << cache.GetTotalCreates() << ", попаданий: " << cache.GetTotalHits()
+                  << "  " << (ok2 ? "✅" : "❌") << "\n";
+        cache.PrintStats();
+
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_fft_plan_cache
@@ -0,0 +1,148 @@
+#pragma once
+/**
+ * @file test_fft_warmup.hpp
+ * @brief Тест прогрева: первый кадр после Warmup против «холодного» первого кадра
+ *
+ * 1. AntennaFFTProcMax и SpectrumMaximaFinder прогреваются параллельно
+ *    через RunWarmupTasks (как задачи GPUManager::WarmupAll)
+ * 2. Первый кадр прогретого AntennaFFTProcMax не создаёт и не печёт планов:
+ *    все ожидаемые размеры пакета (включая хвост) испечены в Warmup.
+ *    Время холодного и прогретого кадра — только для информации
+ * 3. Результаты прогретого и холодного совпадают: пробный кадр из нулей
+ *    и пред-испечённые планы других размеров не портят обработку
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-12
+ */
+
+#include "drv_gpu.hpp"
+#include "antenna_fft_release.h"
+#include "spectrum_maxima_finder.h"
+#include "common/backend_type.hpp"
+#include "common/warmup.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <chrono>
+#include <cmath>
+
+namespace test_fft_warmup {
+
+using namespace drv_gpu_lib;
+using namespace antenna_fft;
+
+/// Тоны с частотой, зависящей от номера луча
+inline std::vector<std::complex<float>> MakeSignal(size_t beams, size_t points) {
+    std::vector<std::complex<float>> signal(beams * points);
+    for (size_t b = 0; b < beams; ++b) {
+        const float freq = 0.01f + 0.003f * static_cast<float>(b % 50);
+        for (size_t i = 0; i < points; ++i) {
+            const float phase = 2.0f * 3.14159265f * freq * static_cast<float>(i);
+            signal[b * points + i] = std::complex<float>(std::cos(phase), std::sin(phase));
+        }
+    }
+    return signal;
+}
+
+/// Время ProcessNew в мс
+inline double TimeFrame(AntennaFFTProcMax& fft, const std::vector<std::complex<float>>& signal,
+                        AntennaFFTResult& result) {
+    auto start = std::chrono::high_resolution_clock::now();
+    result = fft.ProcessNew(signal);
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+}
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║     TEST: Warmup — первый кадр без bake планов           ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        IBackend* backend = &gpu.GetBackend();
+
+        AntennaFFTParams params(256, 4096, 16, 3, "warmup", "test_fft_warmup");
+        const auto signal = MakeSignal(params.beam_count, params.count_points);
+
+        SpectrumParams spectrum_params;
+        spectrum_params.antenna_count = 16;
+        spectrum_params.n_point = 2048;
+        spectrum_params.sample_rate = 12.0e6f;
+
+        bool passed = true;
+
+        // ── 1. Параллельный прогрев ─────────────────────────────────────────
+        AntennaFFTProcMax warm(params, backend);
+        SpectrumMaximaFinder finder(spectrum_params, backend);
+
+        WarmupConfig config;
+        config.batch_sizes = { params.beam_count / 3 };  // лишний размер — в кэш планов
+
+        std::vector<WarmupTask> tasks = {
+            { "AntennaFFTProcMax", 0, [&] { warm.Warmup(config); } },
+            { "SpectrumMaximaFinder", 0, [&] { finder.Warmup(config); } },
+        };
+        auto results = RunWarmupTasks(tasks, config.parallel);
+        std::cout << FormatWarmupResults(results);
+
+        bool ok1 = finder.IsInitialized();
+        for (const auto& r : results) ok1 &= r.success;
+        passed &= ok1;
+        std::cout << "  1. Прогрев (ожидаемых размеров пакета: "
+                  << warm.GetExpectedBatchSizes().size() << ")  " << (ok1 ? "✅" : "❌") << "\n";
+
+        // ── 2. Первый кадр после Warmup: планы только из кэша ────────────────
+        const FFTPlanCache* plans = warm.GetPlanCache();
+        bool ok2 = plans != nullptr;
+        for (size_t n : warm.GetExpectedBatchSizes()) {
+            ok2 &= plans && plans->IsBaked(warm.GetNFFT(), n);
+        }
+        const size_t creates_before = plans ? plans->GetTotalCreates() : 0;
+        const size_t cached_before = plans ? plans->GetCacheSize() : 0;
+
+        AntennaFFTProcMax cold(params, backend);
+
+        AntennaFFTResult cold_result;
+        AntennaFFTResult warm_result;
+        double cold_ms = TimeFrame(cold, signal, cold_result);
+        double warm_ms = TimeFrame(warm, signal, warm_result);
+
+        ok2 &= plans && plans->GetTotalCreates() == creates_before &&
+               plans->GetCacheSize() == cached_before;
+        passed &= ok2;
+        std::cout << "  2. Первый кадр после Warmup: новых планов "
+                  << (plans ? plans->GetTotalCreates() - creates_before : 0)
+                  << ", все размеры испечены  " << (ok2 ? "✅" : "❌") << "\n";
+        std::cout << "     (время: холодный " << std::fixed << std::setprecision(2)
+                  << cold_ms << " ms, после Warmup " << warm_ms << " ms)\n";
+
+        // ── 3. Совпадение результатов ───────────────────────────────────────
+        bool ok3 = cold_result.results.size() == warm_result.results.size() &&
+                   warm_result.results.size() == params.beam_count;
+        for (size_t b = 0; ok3 && b < warm_result.results.size(); ++b) {
+            const auto& c = cold_result.results[b].max_values;
+            const auto& w = warm_result.results[b].max_values;
+            ok3 = !c.empty() && c.size() == w.size() &&
+                  c[0].index_point == w[0].index_point &&
+                  std::abs(c[0].amplitude - w[0].amplitude) <= 1.0e-3f * std::abs(c[0].amplitude);
+        }
+        passed &= ok3;
+        std::cout << "  3. Результаты совпадают с холодным  " << (ok3 ? "✅" : "❌") << "\n";
+
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_fft_warmup
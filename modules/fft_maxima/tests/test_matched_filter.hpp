@@ -0,0 +1,180 @@
+#pragma once
+/**
+ * @file test_matched_filter.hpp
+ * @brief Тест MatchedFilterProcessor: сжатие ЛЧМ импульса + поиск задержки
+ *
+ * 1. Эхо ЛЧМ импульса с известной задержкой на каждом луче → пик корреляции
+ *    на задержке (с параболической поправкой) и амплитуда ≈ длина импульса
+ * 2. Повторный вызов: опора из кэша, план из кэша
+ * 3. Смена опоры A → B → A: прямой план привязан к своей опоре,
+ *    пики каждого вызова на своих задержках
+ * 4. Буферы модуля учтены в MemoryManager под метками "MatchedFilter/..."
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "matched_filter.h"
+#include "interface/lfm_parameters.h"
+#include "common/backend_type.hpp"
+#include "memory/memory_manager.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <cmath>
+
+namespace test_matched_filter {
+
+using namespace drv_gpu_lib;
+
+/// Эхо: импульс lfm с задержкой delays[b] на луче b
+inline std::vector<std::complex<float>> MakeEcho(const LFMParameters& lfm,
+                                                 const std::vector<size_t>& delays,
+                                                 size_t n_point) {
+    const double fs = lfm.sample_rate;
+    const double chirp_rate = lfm.GetChirpRate();
+    std::vector<std::complex<float>> echo(delays.size() * n_point);
+    for (size_t b = 0; b < delays.size(); ++b) {
+        for (size_t n = 0; n < lfm.count_points; ++n) {
+            double t = static_cast<double>(n) / fs;
+            double cycles = lfm.f_start * t + 0.5 * chirp_rate * t * t;
+            double ph = 2.0 * 3.14159265358979323846 * (cycles - std::floor(cycles));
+            echo[b * n_point + delays[b] + n] = std::complex<float>(
+                static_cast<float>(std::cos(ph)), static_cast<float>(std::sin(ph)));
+        }
+    }
+    return echo;
+}
+
+/// Все пики на ожидаемых задержках с амплитудой ≈ длине импульса
+inline bool PeaksMatch(const std::vector<antenna_fft::MatchedFilterResult>& results,
+                       const std::vector<size_t>& delays, size_t count_points) {
+    bool ok = results.size() == delays.size();
+    for (const auto& r : results) {
+        ok &= std::abs(r.delay_samples - static_cast<float>(delays[r.beam_id])) < 0.5f &&
+              std::abs(r.magnitude - static_cast<float>(count_points)) < 0.01f * count_points;
+    }
+    return ok;
+}
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║     TEST: MatchedFilterProcessor — сжатие ЛЧМ импульса   ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        // Зондирующий импульс: 1024 отсчёта, 1 → 3 МГц
+        LFMParameters lfm;
+        lfm.f_start = 1.0e6f;
+        lfm.f_stop = 3.0e6f;
+        lfm.sample_rate = 12.0e6f;
+        lfm.count_points = 1024;
+        lfm.IsValid();
+
+        antenna_fft::MatchedFilterParams mp;
+        mp.beam_count = 8;
+        mp.n_point = 4096;
+        mp.reference_points = 1024;
+        mp.sample_rate = lfm.sample_rate;
+
+        antenna_fft::MatchedFilterProcessor mf(mp, &gpu.GetBackend());
+        mf.Initialize();
+
+        // Эхо: импульс с задержкой d_b = 100 + 371·b отсчётов
+        std::vector<size_t> delays(mp.beam_count);
+        for (size_t b = 0; b < mp.beam_count; ++b) {
+            delays[b] = 100 + 371 * b;
+        }
+        const auto echo = MakeEcho(lfm, delays, mp.n_point);
+
+        // ── 1. Задержки ─────────────────────────────────────────────────────
+        auto results = mf.Process(echo, lfm);
+        const auto first = mf.GetProfilingData();
+
+        std::cout << "  nFFT = " << mf.GetParams().nFFT << "\n\n";
+        std::cout << "  Луч   d ожид.   d найд.     |y|\n";
+        std::cout << "  ─────────────────────────────────────\n";
+        bool passed = true;
+        for (const auto& r : results) {
+            bool ok = std::abs(r.delay_samples - static_cast<float>(delays[r.beam_id])) < 0.5f &&
+                      std::abs(r.magnitude - static_cast<float>(lfm.count_points)) <
+                          0.01f * lfm.count_points;
+            passed &= ok;
+            std::cout << std::fixed << std::setprecision(2)
+                      << "  " << std::setw(3) << r.beam_id << std::setw(10) << delays[r.beam_id]
+                      << std::setw(10) << r.delay_samples << std::setw(10) << r.magnitude
+                      << "  " << (ok ? "✅" : "❌") << "\n";
+        }
+
+        // ── 2. Кэш опор и планов ────────────────────────────────────────────
+        mf.Process(echo, lfm);
+        const auto second = mf.GetProfilingData();
+        bool cached = mf.GetReferenceCacheSize() == 1 && second.reference_time_ms == 0.0 &&
+                      mf.GetForwardPlanCount() == 1 && mf.GetPlanCache()->GetCacheSize() == 1;
+        passed &= cached;
+
+        std::cout << std::setprecision(3)
+                  << "\n  Опора: " << first.reference_time_ms << " мс (1-й вызов), "
+                  << second.reference_time_ms << " мс (кэш)  " << (cached ? "✅" : "❌") << "\n";
+        std::cout << "  FFT+×conj(R): " << second.forward_fft_time_ms << " мс, IFFT: "
+                  << second.inverse_fft_time_ms << " мс, пик: "
+                  << second.post_kernel_time_ms << " мс\n\n";
+
+        // ── 3. Смена опоры A → B → A ────────────────────────────────────────
+        // B: ЛЧМ 0.5 → 4.5 МГц (другая скорость), другие задержки
+        LFMParameters lfm_b = lfm;
+        lfm_b.f_start = 0.5e6f;
+        lfm_b.f_stop = 4.5e6f;
+        lfm_b.IsValid();
+        std::vector<size_t> delays_b(mp.beam_count);
+        for (size_t b = 0; b < mp.beam_count; ++b) {
+            delays_b[b] = 2900 - 290 * b;
+        }
+        const auto echo_b = MakeEcho(lfm_b, delays_b, mp.n_point);
+
+        bool ok_a1 = PeaksMatch(mf.Process(echo, lfm), delays, lfm.count_points);
+        bool ok_b = PeaksMatch(mf.Process(echo_b, lfm_b), delays_b, lfm_b.count_points);
+        bool ok_a2 = PeaksMatch(mf.Process(echo, lfm), delays, lfm.count_points);
+        bool switched = ok_a1 && ok_b && ok_a2 && mf.GetReferenceCacheSize() == 2 &&
+                        mf.GetForwardPlanCount() == 2;
+        passed &= switched;
+        std::cout << "  Опора A → B → A: " << (ok_a1 ? "A ✅ " : "A ❌ ")
+                  << (ok_b ? "B ✅ " : "B ❌ ") << (ok_a2 ? "A ✅" : "A ❌")
+                  << ", прямых планов: " << mf.GetForwardPlanCount() << "\n";
+
+        // После очистки кэша опор планы пересобираются на новой опоре
+        mf.ClearReferenceCache();
+        bool ok_clear = PeaksMatch(mf.Process(echo_b, lfm_b), delays_b, lfm_b.count_points) &&
+                        mf.GetForwardPlanCount() == 1;
+        passed &= ok_clear;
+        std::cout << "  После ClearReferenceCache: " << (ok_clear ? "✅" : "❌") << "\n\n";
+
+        // ── 4. Учёт памяти по меткам ────────────────────────────────────────
+        auto* mem_mgr = gpu.GetBackend().GetMemoryManager();
+        const size_t fft_bytes = static_cast<size_t>(mp.beam_count) * mf.GetParams().nFFT *
+                                 sizeof(std::complex<float>);
+        bool tracked = mem_mgr &&
+            mem_mgr->GetTagStatistics("MatchedFilter/spectrum").current_bytes == fft_bytes &&
+            mem_mgr->GetTagStatistics("MatchedFilter/compressed").current_bytes == fft_bytes &&
+            mem_mgr->GetTagStatistics("MatchedFilter/reference").live_allocations == 1;
+        passed &= tracked;
+        std::cout << "  Метки MatchedFilter/* в MemoryManager: " << (tracked ? "✅" : "❌") << "\n\n";
+
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_matched_filter
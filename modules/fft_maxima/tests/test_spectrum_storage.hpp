@@ -0,0 +1,236 @@
+#pragma once
+/**
+ * @file test_spectrum_storage.hpp
+ * @brief Отчёт точности компактных форматов спектра SpectrumMaximaFinder
+ *
+ * Одни и те же данные обрабатываются во всех режимах SpectrumStorage,
+ * результаты сравниваются с эталонным COMPLEX_FLOAT:
+ * - совпадение индекса максимума
+ * - ошибка уточнённой частоты (Гц)
+ * - относительная ошибка амплитуды
+ * - ошибка фазы (только COMPLEX_HALF)
+ * - объём буфера спектра и время post-kernel
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "spectrum_maxima_finder.h"
+#include "drv_gpu.hpp"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <random>
+#include <algorithm>
+#define _USE_MATH_DEFINES  // ✅ Windows: для M_PI
+#include <cmath>
+#include <string>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace test_spectrum_storage {
+
+using namespace antenna_fft;
+using namespace drv_gpu_lib;
+
+// ════════════════════════════════════════════════════════════════════════════
+// Накопленная статистика по одному режиму
+// ════════════════════════════════════════════════════════════════════════════
+
+struct StorageAccuracy {
+    SpectrumStorage storage;
+    size_t spectrum_bytes = 0;
+    double post_kernel_ms = 0.0;
+    uint32_t index_mismatch = 0;
+    float max_freq_error_hz = 0.0f;
+    float max_mag_rel_error = 0.0f;
+    float max_phase_error_deg = 0.0f;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Генерация тестовых данных: тон + шум, разная частота/амплитуда на антенну
+// ════════════════════════════════════════════════════════════════════════════
+
+inline std::vector<std::complex<float>> GenerateTestData(const SpectrumParams& params) {
+    std::vector<std::complex<float>> data(params.antenna_count * params.n_point);
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+
+    for (uint32_t antenna = 0; antenna < params.antenna_count; ++antenna) {
+        float freq = params.sample_rate * (0.01f + 0.003f * antenna);
+        float amp = 1.0f + 0.05f * antenna;  // пик < 65504 (диапазон half)
+        for (uint32_t t = 0; t < params.n_point; ++t) {
+            float phase = 2.0f * static_cast<float>(M_PI) * freq * t / params.sample_rate;
+            data[antenna * params.n_point + t] = std::complex<float>(
+                amp * std::cos(phase) + noise(rng),
+                amp * std::sin(phase) + noise(rng));
+        }
+    }
+    return data;
+}
+
+inline float WrapPhaseDeg(float d) {
+    while (d > 180.0f) d -= 360.0f;
+    while (d < -180.0f) d += 360.0f;
+    return std::abs(d);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Сравнение с эталоном
+// ════════════════════════════════════════════════════════════════════════════
+
+inline StorageAccuracy Compare(
+    SpectrumStorage storage,
+    const std::vector<SpectrumResult>& reference,
+    const std::vector<SpectrumResult>& results) {
+
+    StorageAccuracy acc;
+    acc.storage = storage;
+
+    bool has_phase = (storage == SpectrumStorage::COMPLEX_FLOAT ||
+                      storage == SpectrumStorage::COMPLEX_HALF);
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const MaxValue& ref = reference[i].interpolated;
+        const MaxValue& got = results[i].interpolated;
+
+        if (ref.index != got.index) acc.index_mismatch++;
+
+        acc.max_freq_error_hz = std::max(acc.max_freq_error_hz,
+            std::abs(ref.refined_frequency - got.refined_frequency));
+
+        if (ref.magnitude > 0.0f) {
+            acc.max_mag_rel_error = std::max(acc.max_mag_rel_error,
+                std::abs(ref.magnitude - got.magnitude) / ref.magnitude);
+        }
+
+        if (has_phase) {
+            acc.max_phase_error_deg = std::max(acc.max_phase_error_deg,
+                WrapPhaseDeg(ref.phase - got.phase));
+        }
+    }
+    return acc;
+}
+
+inline void PrintReport(const std::vector<StorageAccuracy>& report, size_t reference_bytes) {
+    std::cout << "\n📋 ОТЧЁТ ТОЧНОСТИ (эталон: COMPLEX_FLOAT):\n";
+    std::cout << "──────────────────────────────────────────────────────────────────────────────\n";
+    std::cout << std::left << std::setw(18) << "  Режим"
+              << std::right << std::setw(10) << "Буфер"
+              << std::setw(8) << "Доля"
+              << std::setw(10) << "Post ms"
+              << std::setw(8) << "idx≠"
+              << std::setw(12) << "Δf, Гц"
+              << std::setw(12) << "Δ|X|/|X|"
+              << std::setw(10) << "Δφ, °" << "\n";
+    std::cout << "──────────────────────────────────────────────────────────────────────────────\n";
+
+    for (const auto& a : report) {
+        bool has_phase = (a.storage == SpectrumStorage::COMPLEX_FLOAT ||
+                          a.storage == SpectrumStorage::COMPLEX_HALF);
+        std::cout << std::left << std::setw(18) << (std::string("  ") + SpectrumStorageName(a.storage))
+                  << std::right << std::fixed
+                  << std::setw(8) << std::setprecision(1) << (a.spectrum_bytes / 1024.0) << "KB"
+                  << std::setw(8) << std::setprecision(2)
+                  << (static_cast<double>(a.spectrum_bytes) / reference_bytes)
+                  << std::setw(10) << std::setprecision(3) << a.post_kernel_ms
+                  << std::setw(8) << a.index_mismatch
+                  << std::setw(12) << std::setprecision(4) << a.max_freq_error_hz
+                  << std::setw(12) << std::scientific << std::setprecision(2) << a.max_mag_rel_error
+                  << std::fixed;
+        if (has_phase) {
+            std::cout << std::setw(10) << std::setprecision(3) << a.max_phase_error_deg;
+        } else {
+            std::cout << std::setw(10) << "—";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "──────────────────────────────────────────────────────────────────────────────\n\n";
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Главная функция теста
+// ════════════════════════════════════════════════════════════════════════════
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║     TEST: SpectrumStorage — компактный спектр            ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        SpectrumParams base;
+        base.antenna_count = 64;
+        base.n_point = 4000;
+        base.repeat_count = 2;
+        base.sample_rate = 12.0e6f;
+
+        const SpectrumStorage modes[] = {
+            SpectrumStorage::COMPLEX_FLOAT,
+            SpectrumStorage::COMPLEX_HALF,
+            SpectrumStorage::MAGNITUDE_FLOAT,
+            SpectrumStorage::MAGNITUDE_HALF
+        };
+
+        auto input_data = GenerateTestData(base);
+
+        std::vector<SpectrumResult> reference;
+        std::vector<StorageAccuracy> report;
+        size_t reference_bytes = 0;
+        uint32_t nFFT = 0;
+
+        for (SpectrumStorage mode : modes) {
+            SpectrumParams params = base;
+            params.spectrum_storage = mode;
+
+            SpectrumMaximaFinder finder(params, &gpu.GetBackend());
+            finder.Initialize();
+
+            // Прогрев (JIT + первый запуск), затем измеряемый запуск
+            finder.Process(input_data);
+            auto results = finder.Process(input_data);
+
+            if (mode == SpectrumStorage::COMPLEX_FLOAT) {
+                reference = results;
+                reference_bytes = finder.GetSpectrumBufferBytes();
+                nFFT = finder.GetParams().nFFT;
+            }
+
+            StorageAccuracy acc = Compare(mode, reference, results);
+            acc.spectrum_bytes = finder.GetSpectrumBufferBytes();
+            acc.post_kernel_ms = finder.GetProfilingData().post_kernel_time_ms;
+            report.push_back(acc);
+        }
+
+        PrintReport(report, reference_bytes);
+
+        // Критерии: индекс максимума совпадает, частота — в пределах 1% бина
+        float bin_width = base.sample_rate / static_cast<float>(nFFT);
+        bool passed = true;
+        for (const auto& a : report) {
+            bool ok = (a.index_mismatch == 0) && (a.max_freq_error_hz < 0.01f * bin_width);
+            if (!ok) {
+                std::cout << "  ❌ " << SpectrumStorageName(a.storage) << " вне допуска\n";
+                passed = false;
+            }
+        }
+
+        std::cout << "  ИТОГО: " << (passed ? "✅ ВСЕ РЕЖИМЫ В ДОПУСКЕ" : "❌ ЕСТЬ ОШИБКИ") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_spectrum_storage
@@ -0,0 +1,214 @@
+#pragma once
+
+/**
+ * @file fractional_delay_module.hpp
+ * @brief Fractional Delay Module - задержка лучей (целый сдвиг + Farrow) на GPU
+ *
+ * Реализует IComputeModule интерфейс:
+ * - Задержка каждого луча на D_b = τ_b · fs отсчётов
+ * - Целая часть — сдвиг индекса, дробная — кубический Лагранж (структура Фарроу)
+ * - Работа in-place на том же буфере [num_beams × count_points],
+ *   который потребляет AntennaFFTProcMax::ProcessNew(cl_mem)
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "i_compute_module.hpp"
+#include "i_backend.hpp"
+#include "memory/gpu_buffer.hpp"
+#include "interface/DelayParameter.h"
+#include "interface/combined_delay_param.h"
+#include <CL/cl.h>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+// ════════════════════════════════════════════════════════════════════════════
+// Параметры
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @struct FractionalDelayParams
+ * @brief Геометрия данных и параметры пересчёта углов в задержки
+ */
+struct FractionalDelayParams {
+    uint32_t num_beams = 0;             ///< Количество лучей
+    uint32_t count_points = 0;          ///< Отсчётов на луч
+    float sample_rate = 12.0e6f;        ///< Частота дискретизации (Гц)
+    float center_frequency = 0.0f;      ///< Центральная частота (Гц) для пересчёта углов
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: FractionalDelayModule
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class FractionalDelayModule
+ * @brief Compute модуль дробной задержки лучей
+ *
+ * Задержка луча (секунды):
+ *   τ_b = sin(delay_degrees) / (2 · center_frequency) + delay_time_ns · 1e-9
+ * Угловая часть — решётка с шагом d = λ/2 (как в LFMGeneratorModule);
+ * для DelayParameter используется только угловая часть.
+ * Лучи, отсутствующие в списке задержек, не задерживаются.
+ *
+ * Задержка применяется к отсчётам как есть (без поворота фазы несущей).
+ * Отсчёты, «въехавшие» из-за границы сигнала, равны нулю.
+ *
+ * In-place: данные копируются во внутренний scratch буфер (device → device),
+ * затем kernel пишет результат обратно — данные не покидают GPU.
+ *
+ * Использование:
+ * @code
+ * FractionalDelayModule delay(backend);
+ * delay.Initialize();
+ * delay.ApplyInPlace(params, combined_delays, signal);   // signal: GPUBuffer
+ * fft.ProcessNew(static_cast<cl_mem>(signal->GetPtr()));
+ * @endcode
+ */
+class FractionalDelayModule : public IComputeModule {
+public:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Конструктор и деструктор
+    // ═══════════════════════════════════════════════════════════════════════
+
+    explicit FractionalDelayModule(IBackend* backend);
+    ~FractionalDelayModule() override;
+
+    FractionalDelayModule(const FractionalDelayModule&) = delete;
+    FractionalDelayModule& operator=(const FractionalDelayModule&) = delete;
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Реализация IComputeModule
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void Initialize() override;
+    bool IsInitialized() const override { return initialized_; }
+    void Cleanup() override;
+
+    std::string GetName() const override { return "FractionalDelay"; }
+    std::string GetVersion() const override { return "1.0.0"; }
+    std::string GetDescription() const override {
+        return "Per-beam integer + Farrow (cubic Lagrange) fractional delay";
+    }
+
+    IBackend* GetBackend() const override { return backend_; }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Задержка (блокирующие)
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Задержать лучи in-place по CombinedDelayParam
+     * @throws std::invalid_argument при неверных параметрах / малом буфере
+     */
+    void ApplyInPlace(
+        const FractionalDelayParams& params,
+        const std::vector<CombinedDelayParam>& delays,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> data);
+
+    /**
+     * @brief Задержать лучи in-place по DelayParameter (только угол)
+     */
+    void ApplyInPlace(
+        const FractionalDelayParams& params,
+        const std::vector<DelayParameter>& delays,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> data);
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Задержка (без ожидания, cl_mem)
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief In-place задержка произвольного cl_mem (только постановка в очередь)
+     *
+     * @param params         Геометрия данных
+     * @param beam_delays_s  Задержка каждого луча (секунды), размер = num_beams
+     * @param data           cl_mem [num_beams × count_points] complex<float>
+     * @param out_event      [out] Событие завершения (опционально)
+     */
+    void ApplyInPlaceAsync(
+        const FractionalDelayParams& params,
+        const std::vector<double>& beam_delays_s,
+        cl_mem data,
+        cl_event* out_event = nullptr);
+
+    /**
+     * @brief Out-of-place задержка (input и output не должны совпадать)
+     */
+    void ApplyAsync(
+        const FractionalDelayParams& params,
+        const std::vector<double>& beam_delays_s,
+        cl_mem input,
+        cl_mem output,
+        cl_event* out_event = nullptr);
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Утилиты
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Пересчитать CombinedDelayParam в задержки лучей (секунды)
+     */
+    static std::vector<double> ComputeDelaySeconds(
+        const FractionalDelayParams& params,
+        const std::vector<CombinedDelayParam>& delays);
+
+    /**
+     * @brief Пересчитать DelayParameter в задержки лучей (секунды)
+     */
+    static std::vector<double> ComputeDelaySeconds(
+        const FractionalDelayParams& params,
+        const std::vector<DelayParameter>& delays);
+
+    /**
+     * @brief Эталонная задержка на CPU (тот же алгоритм, double) — для тестов
+     */
+    static std::vector<std::complex<float>> ApplyReferenceCPU(
+        const FractionalDelayParams& params,
+        const std::vector<double>& beam_delays_s,
+        const std::vector<std::complex<float>>& input);
+
+private:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Члены класса
+    // ═══════════════════════════════════════════════════════════════════════
+
+    IBackend* backend_;         ///< Указатель на бэкенд (не владеет)
+    bool initialized_;          ///< Флаг инициализации
+
+    cl_program program_;        ///< Скомпилированная программа
+    cl_kernel kernel_delay_;    ///< Kernel: farrow_delay
+
+    cl_context context_;        ///< Кэш контекста
+    cl_device_id device_;       ///< Кэш устройства
+    cl_command_queue queue_;    ///< Кэш очереди команд
+
+    cl_mem delay_buffer_;       ///< {m_b, μ_b} на луч (переиспользуется)
+    size_t delay_capacity_;     ///< Ёмкость delay_buffer_ (лучей)
+    cl_mem scratch_buffer_;     ///< Копия входа для in-place режима
+    size_t scratch_bytes_;      ///< Размер scratch_buffer_
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Приватные методы
+    // ═══════════════════════════════════════════════════════════════════════
+
+    static void ValidateParams(const FractionalDelayParams& params);
+    void UploadDelays(const FractionalDelayParams& params,
+                      const std::vector<double>& beam_delays_s);
+    void EnsureScratch(size_t bytes);
+    void EnqueueDelay(const FractionalDelayParams& params,
+                      cl_mem input, cl_mem output, cl_event* out_event);
+
+    void ReleaseBuffers();
+    void CompileKernels();
+    void ReleaseKernels();
+    std::string LoadKernelSource(const std::string& filename);
+};
+
+} // namespace drv_gpu_lib
@@ -0,0 +1,67 @@
+/**
+ * @file farrow_delay.cl
+ * @brief OpenCL kernel дробной задержки лучей (целый сдвиг + Farrow / кубический Лагранж)
+ *
+ * y_b[n] = x_b(n - D_b),  D_b = m_b + μ_b  (m — целая часть, μ ∈ [0, 1))
+ *
+ * Позиция p = n - m - μ лежит между x[i+1] и x[i], i = n - m - 1, f = 1 - μ.
+ * Интерполяция по 4 точкам x[i-1], x[i], x[i+1], x[i+2] в форме Фарроу:
+ *   y = ((c3·f + c2)·f + c1)·f + c0
+ * Отсчёты вне [0, count_points) считаются нулевыми.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+inline float2 load_or_zero(__global const float2* row, int idx, int count) {
+    return (idx >= 0 && idx < count) ? row[idx] : (float2)(0.0f, 0.0f);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Дробная задержка всех лучей
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Задержать каждый луч на D_b отсчётов
+ *
+ * NDRange: (count_points, num_beams), gid0 = отсчёт, gid1 = луч
+ *
+ * @param input        Вход  [num_beams × count_points] complex<float>
+ * @param output       Выход [num_beams × count_points] (не совпадает с input)
+ * @param delays       {m_b (целое, как float), μ_b} на луч
+ * @param num_beams    Количество лучей
+ * @param count_points Отсчётов на луч
+ */
+__kernel void farrow_delay(
+    __global const float2* input,
+    __global float2* output,
+    __global const float2* delays,
+    const uint num_beams,
+    const uint count_points)
+{
+    uint n = get_global_id(0);
+    uint beam = get_global_id(1);
+
+    if (n >= count_points || beam >= num_beams) return;
+
+    float2 d = delays[beam];
+    int m = (int)d.x;
+    float f = 1.0f - d.y;
+
+    __global const float2* row = input + (size_t)beam * count_points;
+    int count = (int)count_points;
+    int i = (int)n - m - 1;
+
+    float2 xm1 = load_or_zero(row, i - 1, count);
+    float2 x0  = load_or_zero(row, i,     count);
+    float2 x1  = load_or_zero(row, i + 1, count);
+    float2 x2  = load_or_zero(row, i + 2, count);
+
+    // Коэффициенты Фарроу для кубического Лагранжа (узлы -1, 0, 1, 2)
+    float2 c0 = x0;
+    float2 c1 = -xm1 * (1.0f / 3.0f) - x0 * 0.5f + x1 - x2 * (1.0f / 6.0f);
+    float2 c2 = (xm1 + x1) * 0.5f - x0;
+    float2 c3 = (x2 - xm1) * (1.0f / 6.0f) + (x0 - x1) * 0.5f;
+
+    output[(size_t)beam * count_points + n] = ((c3 * f + c2) * f + c1) * f + c0;
+}
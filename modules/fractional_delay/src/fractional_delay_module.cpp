@@ -0,0 +1,462 @@
+#include "fractional_delay_module.hpp"
+#include "logger/logger.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cmath>
+
+// Определено в CMakeLists.txt
+#ifndef FRACTIONAL_DELAY_KERNELS_PATH
+#define FRACTIONAL_DELAY_KERNELS_PATH "kernels"
+#endif
+
+namespace drv_gpu_lib {
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+constexpr size_t kLocalSize = 256;
+
+/// Разложить задержку в отсчётах на {целая часть, дробь ∈ [0, 1)}
+inline void SplitDelay(double delay_samples, double& integer_part, double& fraction) {
+    integer_part = std::floor(delay_samples);
+    fraction = delay_samples - integer_part;
+}
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Конструктор и деструктор
+// ════════════════════════════════════════════════════════════════════════════
+
+FractionalDelayModule::FractionalDelayModule(IBackend* backend)
+    : backend_(backend)
+    , initialized_(false)
+    , program_(nullptr)
+    , kernel_delay_(nullptr)
+    , context_(nullptr)
+    , device_(nullptr)
+    , queue_(nullptr)
+    , delay_buffer_(nullptr)
+    , delay_capacity_(0)
+    , scratch_buffer_(nullptr)
+    , scratch_bytes_(0)
+{
+    if (!backend_) {
+        throw std::invalid_argument("FractionalDelayModule: backend cannot be null");
+    }
+
+    DRVGPU_LOG_INFO("FractionalDelayModule", "Created (not initialized)");
+}
+
+FractionalDelayModule::~FractionalDelayModule() {
+    Cleanup();
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Жизненный цикл
+// ════════════════════════════════════════════════════════════════════════════
+
+void FractionalDelayModule::Initialize() {
+    if (initialized_) {
+        DRVGPU_LOG_WARNING("FractionalDelayModule", "Already initialized");
+        return;
+    }
+
+    DRVGPU_LOG_INFO("FractionalDelayModule", "Initializing...");
+
+    context_ = static_cast<cl_context>(backend_->GetNativeContext());
+    device_ = static_cast<cl_device_id>(backend_->GetNativeDevice());
+    queue_ = static_cast<cl_command_queue>(backend_->GetNativeQueue());
+
+    if (!context_ || !device_ || !queue_) {
+        throw std::runtime_error("FractionalDelayModule: Invalid OpenCL handles from backend");
+    }
+
+    CompileKernels();
+
+    initialized_ = true;
+    DRVGPU_LOG_INFO("FractionalDelayModule", "Initialized successfully ✅");
+}
+
+void FractionalDelayModule::Cleanup() {
+    if (!initialized_) {
+        return;
+    }
+
+    DRVGPU_LOG_INFO("FractionalDelayModule", "Cleanup...");
+
+    ReleaseBuffers();
+    ReleaseKernels();
+
+    initialized_ = false;
+    DRVGPU_LOG_INFO("FractionalDelayModule", "Cleanup complete");
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Задержка (блокирующие)
+// ════════════════════════════════════════════════════════════════════════════
+
+void FractionalDelayModule::ApplyInPlace(
+    const FractionalDelayParams& params,
+    const std::vector<CombinedDelayParam>& delays,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> data)
+{
+    if (!data) {
+        throw std::invalid_argument("FractionalDelayModule::ApplyInPlace - data buffer is null");
+    }
+    if (data->GetNumElements() < static_cast<size_t>(params.num_beams) * params.count_points) {
+        throw std::invalid_argument("FractionalDelayModule::ApplyInPlace - data buffer too small");
+    }
+
+    ApplyInPlaceAsync(params, ComputeDelaySeconds(params, delays),
+                      static_cast<cl_mem>(data->GetPtr()), nullptr);
+
+    clFinish(queue_); // Ждём завершения
+}
+
+void FractionalDelayModule::ApplyInPlace(
+    const FractionalDelayParams& params,
+    const std::vector<DelayParameter>& delays,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> data)
+{
+    if (!data) {
+        throw std::invalid_argument("FractionalDelayModule::ApplyInPlace - data buffer is null");
+    }
+    if (data->GetNumElements() < static_cast<size_t>(params.num_beams) * params.count_points) {
+        throw std::invalid_argument("FractionalDelayModule::ApplyInPlace - data buffer too small");
+    }
+
+    ApplyInPlaceAsync(params, ComputeDelaySeconds(params, delays),
+                      static_cast<cl_mem>(data->GetPtr()), nullptr);
+
+    clFinish(queue_);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Задержка (без ожидания)
+// ════════════════════════════════════════════════════════════════════════════
+
+void FractionalDelayModule::ApplyInPlaceAsync(
+    const FractionalDelayParams& params,
+    const std::vector<double>& beam_delays_s,
+    cl_mem data,
+    cl_event* out_event)
+{
+    if (!initialized_) {
+        throw std::runtime_error("FractionalDelayModule: not initialized");
+    }
+    ValidateParams(params);
+    UploadDelays(params, beam_delays_s);
+
+    const size_t bytes = static_cast<size_t>(params.num_beams) * params.count_points *
+                         sizeof(cl_float2);
+    EnsureScratch(bytes);
+
+    // data → scratch (device → device), затем scratch → data через kernel
+    cl_int err = clEnqueueCopyBuffer(queue_, data, scratch_buffer_, 0, 0, bytes,
+                                     0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("FractionalDelayModule::ApplyInPlaceAsync - Failed to copy to scratch");
+    }
+
+    EnqueueDelay(params, scratch_buffer_, data, out_event);
+}
+
+void FractionalDelayModule::ApplyAsync(
+    const FractionalDelayParams& params,
+    const std::vector<double>& beam_delays_s,
+    cl_mem input,
+    cl_mem output,
+    cl_event* out_event)
+{
+    if (!initialized_) {
+        throw std::runtime_error("FractionalDelayModule: not initialized");
+    }
+    if (input == output) {
+        throw std::invalid_argument(
+            "FractionalDelayModule::ApplyAsync - input == output (use ApplyInPlaceAsync)");
+    }
+    ValidateParams(params);
+    UploadDelays(params, beam_delays_s);
+
+    EnqueueDelay(params, input, output, out_event);
+}
+
+void FractionalDelayModule::EnqueueDelay(
+    const FractionalDelayParams& params,
+    cl_mem input,
+    cl_mem output,
+    cl_event* out_event)
+{
+    cl_uint num_beams = params.num_beams;
+    cl_uint count_points = params.count_points;
+
+    cl_int err;
+    err = clSetKernelArg(kernel_delay_, 0, sizeof(cl_mem), &input);
+    err |= clSetKernelArg(kernel_delay_, 1, sizeof(cl_mem), &output);
+    err |= clSetKernelArg(kernel_delay_, 2, sizeof(cl_mem), &delay_buffer_);
+    err |= clSetKernelArg(kernel_delay_, 3, sizeof(cl_uint), &num_beams);
+    err |= clSetKernelArg(kernel_delay_, 4, sizeof(cl_uint), &count_points);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("FractionalDelayModule::EnqueueDelay - Failed to set kernel args");
+    }
+
+    size_t global_size[2] = {
+        ((count_points + kLocalSize - 1) / kLocalSize) * kLocalSize,
+        num_beams
+    };
+    size_t local_size[2] = { kLocalSize, 1 };
+
+    err = clEnqueueNDRangeKernel(queue_, kernel_delay_, 2, nullptr,
+                                 global_size, local_size, 0, nullptr, out_event);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("FractionalDelayModule::EnqueueDelay - Failed to enqueue kernel");
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Буферы
+// ════════════════════════════════════════════════════════════════════════════
+
+void FractionalDelayModule::ValidateParams(const FractionalDelayParams& params) {
+    if (params.num_beams == 0 || params.count_points == 0 || params.sample_rate <= 0.0f) {
+        throw std::invalid_argument("FractionalDelayModule: invalid FractionalDelayParams");
+    }
+}
+
+void FractionalDelayModule::UploadDelays(
+    const FractionalDelayParams& params,
+    const std::vector<double>& beam_delays_s)
+{
+    if (beam_delays_s.size() != params.num_beams) {
+        throw std::invalid_argument("FractionalDelayModule: beam_delays_s.size() != num_beams");
+    }
+
+    std::vector<cl_float2> packed(params.num_beams);
+    for (size_t b = 0; b < beam_delays_s.size(); ++b) {
+        double integer_part, fraction;
+        SplitDelay(beam_delays_s[b] * params.sample_rate, integer_part, fraction);
+        packed[b].s[0] = static_cast<float>(integer_part);
+        packed[b].s[1] = static_cast<float>(fraction);
+    }
+
+    if (packed.size() > delay_capacity_) {
+        if (delay_buffer_) {
+            clReleaseMemObject(delay_buffer_);
+            delay_buffer_ = nullptr;
+        }
+        cl_int err;
+        delay_buffer_ = clCreateBuffer(context_, CL_MEM_READ_ONLY,
+                                       packed.size() * sizeof(cl_float2), nullptr, &err);
+        if (err != CL_SUCCESS || !delay_buffer_) {
+            delay_capacity_ = 0;
+            throw std::runtime_error("FractionalDelayModule: Failed to allocate delay buffer");
+        }
+        delay_capacity_ = packed.size();
+    }
+
+    // Блокирующая запись: packed — локальный вектор
+    cl_int err = clEnqueueWriteBuffer(queue_, delay_buffer_, CL_TRUE, 0,
+                                      packed.size() * sizeof(cl_float2),
+                                      packed.data(), 0, nullptr, nullptr);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("FractionalDelayModule: Failed to upload delays");
+    }
+}
+
+void FractionalDelayModule::EnsureScratch(size_t bytes) {
+    if (bytes <= scratch_bytes_) {
+        return;
+    }
+    if (scratch_buffer_) {
+        clReleaseMemObject(scratch_buffer_);
+        scratch_buffer_ = nullptr;
+    }
+    cl_int err;
+    scratch_buffer_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, bytes, nullptr, &err);
+    if (err != CL_SUCCESS || !scratch_buffer_) {
+        scratch_bytes_ = 0;
+        throw std::runtime_error("FractionalDelayModule: Failed to allocate scratch buffer");
+    }
+    scratch_bytes_ = bytes;
+}
+
+void FractionalDelayModule::ReleaseBuffers() {
+    if (delay_buffer_) {
+        clReleaseMemObject(delay_buffer_);
+        delay_buffer_ = nullptr;
+        delay_capacity_ = 0;
+    }
+    if (scratch_buffer_) {
+        clReleaseMemObject(scratch_buffer_);
+        scratch_buffer_ = nullptr;
+        scratch_bytes_ = 0;
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Утилиты
+// ════════════════════════════════════════════════════════════════════════════
+
+std::vector<double> FractionalDelayModule::ComputeDelaySeconds(
+    const FractionalDelayParams& params,
+    const std::vector<CombinedDelayParam>& delays)
+{
+    std::vector<double> result(params.num_beams, 0.0);
+    const bool has_carrier = params.center_frequency > 0.0f;
+
+    for (const auto& d : delays) {
+        if (d.beam_index >= params.num_beams) {
+            continue;
+        }
+        double tau = static_cast<double>(d.delay_time_ns) * 1.0e-9;
+        if (has_carrier && d.delay_degrees != 0.0f) {
+            tau += std::sin(d.delay_degrees * kPi / 180.0) /
+                   (2.0 * static_cast<double>(params.center_frequency));
+        }
+        result[d.beam_index] = tau;
+    }
+    return result;
+}
+
+std::vector<double> FractionalDelayModule::ComputeDelaySeconds(
+    const FractionalDelayParams& params,
+    const std::vector<DelayParameter>& delays)
+{
+    if (params.center_frequency <= 0.0f) {
+        throw std::invalid_argument(
+            "FractionalDelayModule: center_frequency required for angle delays");
+    }
+
+    std::vector<double> result(params.num_beams, 0.0);
+    for (const auto& d : delays) {
+        if (d.beam_index >= params.num_beams) {
+            continue;
+        }
+        result[d.beam_index] = std::sin(d.delay_degrees * kPi / 180.0) /
+                               (2.0 * static_cast<double>(params.center_frequency));
+    }
+    return result;
+}
+
+std::vector<std::complex<float>> FractionalDelayModule::ApplyReferenceCPU(
+    const FractionalDelayParams& params,
+    const std::vector<double>& beam_delays_s,
+    const std::vector<std::complex<float>>& input)
+{
+    ValidateParams(params);
+    const size_t count = params.count_points;
+    if (beam_delays_s.size() != params.num_beams || input.size() < params.num_beams * count) {
+        throw std::invalid_argument("FractionalDelayModule::ApplyReferenceCPU - size mismatch");
+    }
+
+    std::vector<std::complex<float>> output(params.num_beams * count);
+
+    for (size_t b = 0; b < params.num_beams; ++b) {
+        double integer_part, fraction;
+        SplitDelay(beam_delays_s[b] * params.sample_rate, integer_part, fraction);
+        const long long m = static_cast<long long>(integer_part);
+        const double f = 1.0 - fraction;
+        const std::complex<float>* row = &input[b * count];
+
+        auto at = [&](long long idx) {
+            return (idx >= 0 && idx < static_cast<long long>(count))
+                ? std::complex<double>(row[idx]) : std::complex<double>(0.0, 0.0);
+        };
+
+        for (size_t n = 0; n < count; ++n) {
+            long long i = static_cast<long long>(n) - m - 1;
+            auto xm1 = at(i - 1), x0 = at(i), x1 = at(i + 1), x2 = at(i + 2);
+            auto c1 = -xm1 / 3.0 - x0 * 0.5 + x1 - x2 / 6.0;
+            auto c2 = (xm1 + x1) * 0.5 - x0;
+            auto c3 = (x2 - xm1) / 6.0 + (x0 - x1) * 0.5;
+            auto y = ((c3 * f + c2) * f + c1) * f + x0;
+            output[b * count + n] = std::complex<float>(
+                static_cast<float>(y.real()), static_cast<float>(y.imag()));
+        }
+    }
+    return output;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Компиляция kernels
+// ════════════════════════════════════════════════════════════════════════════
+
+void FractionalDelayModule::CompileKernels() {
+    std::string kernel_source = LoadKernelSource("farrow_delay.cl");
+
+    const char* source_ptr = kernel_source.c_str();
+    size_t source_size = kernel_source.size();
+
+    cl_int err;
+    program_ = clCreateProgramWithSource(context_, 1, &source_ptr, &source_size, &err);
+
+    if (err != CL_SUCCESS || !program_) {
+        throw std::runtime_error("FractionalDelayModule: Failed to create program");
+    }
+
+    err = clBuildProgram(program_, 1, &device_, nullptr, nullptr, nullptr);
+
+    if (err != CL_SUCCESS) {
+        size_t log_size;
+        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+
+        std::vector<char> log(log_size);
+        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, log_size, log.data(), nullptr);
+
+        DRVGPU_LOG_ERROR("FractionalDelayModule", "Kernel compilation failed:");
+        DRVGPU_LOG_ERROR("FractionalDelayModule", std::string(log.data()));
+
+        clReleaseProgram(program_);
+        program_ = nullptr;
+
+        throw std::runtime_error("FractionalDelayModule: Kernel compilation failed");
+    }
+
+    kernel_delay_ = clCreateKernel(program_, "farrow_delay", &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create kernel: farrow_delay");
+    }
+
+    DRVGPU_LOG_INFO("FractionalDelayModule", "Kernels compiled successfully ✅");
+}
+
+void FractionalDelayModule::ReleaseKernels() {
+    if (kernel_delay_) {
+        clReleaseKernel(kernel_delay_);
+        kernel_delay_ = nullptr;
+    }
+    if (program_) {
+        clReleaseProgram(program_);
+        program_ = nullptr;
+    }
+}
+
+std::string FractionalDelayModule::LoadKernelSource(const std::string& filename) {
+    std::vector<std::string> search_paths = {
+        std::string(FRACTIONAL_DELAY_KERNELS_PATH) + "/" + filename,
+        "modules/fractional_delay/kernels/" + filename,
+        "../modules/fractional_delay/kernels/" + filename,
+        "../../modules/fractional_delay/kernels/" + filename
+    };
+
+    for (const auto& path : search_paths) {
+        std::ifstream file(path);
+        if (file.is_open()) {
+            DRVGPU_LOG_DEBUG("FractionalDelayModule", "Kernel loaded from: " + path);
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            return buffer.str();
+        }
+    }
+
+    DRVGPU_LOG_ERROR("FractionalDelayModule", "Failed to load kernel: " + filename);
+    for (const auto& path : search_paths) {
+        DRVGPU_LOG_ERROR("FractionalDelayModule", "  - " + path);
+    }
+
+    throw std::runtime_error("FractionalDelayModule: Failed to load kernel source: " + filename);
+}
+
+} // namespace drv_gpu_lib
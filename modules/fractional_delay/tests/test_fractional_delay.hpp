@@ -0,0 +1,119 @@
+#pragma once
+/**
+ * @file test_fractional_delay.hpp
+ * @brief Тест FractionalDelayModule: in-place задержка лучей на GPU
+ *
+ * 1. GPU против ApplyReferenceCPU() (тот же алгоритм)
+ * 2. Точность интерполяции против аналитически задержанного тона
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "fractional_delay_module.hpp"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <algorithm>
+#define _USE_MATH_DEFINES  // ✅ Windows: для M_PI
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace test_fractional_delay {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║     TEST: FractionalDelayModule — Farrow задержка        ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        auto module = std::make_shared<FractionalDelayModule>(&gpu.GetBackend());
+        module->Initialize();
+        gpu.GetModuleRegistry().RegisterModule("FractionalDelay", module);
+
+        FractionalDelayParams params;
+        params.num_beams = 16;
+        params.count_points = 4096;
+        params.sample_rate = 12.0e6f;
+        params.center_frequency = 1.5e6f;
+
+        // Узкополосный тон 0.05·fs на каждом луче
+        const double tone = 0.05 * params.sample_rate;
+        const size_t total = static_cast<size_t>(params.num_beams) * params.count_points;
+        std::vector<std::complex<float>> input(total);
+        for (size_t b = 0; b < params.num_beams; ++b) {
+            for (size_t n = 0; n < params.count_points; ++n) {
+                double ph = 2.0 * M_PI * tone * n / params.sample_rate;
+                input[b * params.count_points + n] = std::complex<float>(
+                    static_cast<float>(std::cos(ph)), static_cast<float>(std::sin(ph)));
+            }
+        }
+
+        // Смесь: время (целые + дробные отсчёты, в т.ч. отрицательные) и углы
+        std::vector<CombinedDelayParam> delays;
+        for (size_t b = 0; b < params.num_beams; ++b) {
+            CombinedDelayParam d;
+            d.beam_index = b;
+            d.delay_degrees = (b % 2 == 0) ? 0.0f : 0.5f * static_cast<float>(b);
+            d.delay_time_ns = 37.3f * static_cast<float>(b) - 150.0f;
+            delays.push_back(d);
+        }
+        auto delays_s = FractionalDelayModule::ComputeDelaySeconds(params, delays);
+
+        auto& mem_mgr = gpu.GetMemoryManager();
+        auto gpu_data = mem_mgr.CreateBuffer<std::complex<float>>(input.data(), total);
+
+        module->ApplyInPlace(params, delays, gpu_data);
+        auto result = gpu_data->Read();
+
+        // ── 1. GPU против CPU ──────────────────────────────────────────────
+        auto reference = FractionalDelayModule::ApplyReferenceCPU(params, delays_s, input);
+        float max_ref_error = 0.0f;
+        for (size_t i = 0; i < total; ++i) {
+            max_ref_error = std::max(max_ref_error, std::abs(result[i] - reference[i]));
+        }
+
+        // ── 2. Против аналитики (без краёв, где «въезжают» нули) ───────────
+        const size_t guard = 64;
+        float max_interp_error = 0.0f;
+        for (size_t b = 0; b < params.num_beams; ++b) {
+            double delay_samples = delays_s[b] * params.sample_rate;
+            for (size_t n = guard; n + guard < params.count_points; ++n) {
+                double ph = 2.0 * M_PI * tone * (n - delay_samples) / params.sample_rate;
+                std::complex<float> expected(static_cast<float>(std::cos(ph)),
+                                             static_cast<float>(std::sin(ph)));
+                max_interp_error = std::max(max_interp_error,
+                    std::abs(result[b * params.count_points + n] - expected));
+            }
+        }
+
+        std::cout << std::scientific << std::setprecision(2);
+        std::cout << "  1. max|GPU - CPU|       = " << max_ref_error << "\n";
+        std::cout << "  2. max|GPU - аналитика| = " << max_interp_error
+                  << " (тон 0.05·fs, кубический Лагранж)\n\n";
+
+        bool passed = (max_ref_error < 1.0e-5f) && (max_interp_error < 1.0e-3f);
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_fractional_delay
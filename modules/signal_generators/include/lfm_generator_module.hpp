@@ -0,0 +1,221 @@
+#pragma once
+
+/**
+ * @file lfm_generator_module.hpp
+ * @brief LFM Generator Module - генерация ЛЧМ сигналов по лучам прямо на GPU
+ *
+ * Реализует IComputeModule интерфейс:
+ * - Синтез ЛЧМ сигнала для всех лучей одним kernel
+ * - Задержка τ_b каждого луча по углу (фазовая прогрессия решётки)
+ * - Фаза накапливается в double (если устройство поддерживает fp64)
+ *
+ * Результат пишется прямо в device буфер → нет передачи host → device.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "i_compute_module.hpp"
+#include "i_backend.hpp"
+#include "memory/gpu_buffer.hpp"
+#include "interface/lfm_parameters.h"
+#include <CL/cl.h>
+#include <complex>
+#include <string>
+#include <memory>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: LFMGeneratorModule - Генератор ЛЧМ сигналов
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class LFMGeneratorModule
+ * @brief Compute модуль генерации ЛЧМ сигналов по LFMParameters
+ *
+ * Сигнал луча b:
+ *   s_b[n] = A * exp(j * 2π * (f_start * t + k * t² / 2)),  t = n / fs - τ_b
+ *   k = (f_stop - f_start) / duration,  duration = count_points / fs
+ *
+ * Задержка луча (линейная решётка, шаг d = λ/2, λ по центральной частоте):
+ * - задана сетка углов (angle_start_deg != angle_stop_deg):
+ *     θ_b = angle_start_deg + b * angle_step_deg,  τ_b = d * sin(θ_b) / c
+ * - иначе (один угол steering_angle):
+ *     τ_b = b * d * sin(steering_angle) / c
+ *
+ * Раскладка выхода: [num_beams × count_points] complex<float>, луч за лучом —
+ * готовый вход для AntennaFFTProcMax / SpectrumMaximaFinder.
+ *
+ * Использование:
+ * @code
+ * auto gen = std::make_shared<LFMGeneratorModule>(backend);
+ * gen->Initialize();
+ *
+ * LFMParameters p;
+ * p.f_start = 1.0e6f; p.f_stop = 2.0e6f; p.num_beams = 256; p.count_points = 8192;
+ * auto signal = mem_mgr.CreateBuffer<std::complex<float>>(p.num_beams * p.count_points);
+ * gen->Generate(p, signal);
+ * @endcode
+ */
+class LFMGeneratorModule : public IComputeModule {
+public:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Конструктор и деструктор
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Создать LFMGeneratorModule привязанный к бэкенду
+     * @param backend Указатель на IBackend (OpenCL)
+     */
+    explicit LFMGeneratorModule(IBackend* backend);
+
+    /**
+     * @brief Деструктор (очищает kernels и буфер задержек)
+     */
+    ~LFMGeneratorModule() override;
+
+    // Запрет копирования
+    LFMGeneratorModule(const LFMGeneratorModule&) = delete;
+    LFMGeneratorModule& operator=(const LFMGeneratorModule&) = delete;
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Реализация IComputeModule: Жизненный цикл
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Инициализировать модуль (компилировать kernels)
+     * @throws std::runtime_error если компиляция не удалась
+     */
+    void Initialize() override;
+
+    bool IsInitialized() const override { return initialized_; }
+
+    void Cleanup() override;
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Реализация IComputeModule: Информация
+    // ═══════════════════════════════════════════════════════════════════════
+
+    std::string GetName() const override { return "LFMGenerator"; }
+    std::string GetVersion() const override { return "1.0.0"; }
+    std::string GetDescription() const override {
+        return "Per-beam LFM chirp synthesis with steering delays";
+    }
+
+    IBackend* GetBackend() const override { return backend_; }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Генерация
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Сгенерировать ЛЧМ для всех лучей (задержки из углов LFMParameters)
+     *
+     * @param params    Параметры ЛЧМ (проверяются через IsValid())
+     * @param output    Выходной буфер, не меньше num_beams * count_points
+     * @param amplitude Амплитуда сигнала
+     * @throws std::invalid_argument при неверных параметрах / малом буфере
+     */
+    void Generate(
+        const LFMParameters& params,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> output,
+        float amplitude = 1.0f);
+
+    /**
+     * @brief Сгенерировать ЛЧМ с явными задержками лучей
+     *
+     * @param params         Параметры ЛЧМ
+     * @param beam_delays_s  Задержка каждого луча (секунды), размер = num_beams
+     * @param output         Выходной буфер
+     * @param amplitude      Амплитуда сигнала
+     */
+    void Generate(
+        const LFMParameters& params,
+        const std::vector<double>& beam_delays_s,
+        std::shared_ptr<GPUBuffer<std::complex<float>>> output,
+        float amplitude = 1.0f);
+
+    /**
+     * @brief Сгенерировать ЛЧМ в произвольный cl_mem (без ожидания)
+     *
+     * Kernel только ставится в очередь backend'а; при out_event != nullptr
+     * возвращается событие завершения (освобождает вызывающий).
+     *
+     * @param params         Параметры ЛЧМ
+     * @param beam_delays_s  Задержка каждого луча (секунды)
+     * @param output         cl_mem не меньше num_beams * count_points * 8 байт
+     * @param amplitude      Амплитуда сигнала
+     * @param out_event      [out] Событие завершения kernel (опционально)
+     */
+    void GenerateAsync(
+        const LFMParameters& params,
+        const std::vector<double>& beam_delays_s,
+        cl_mem output,
+        float amplitude = 1.0f,
+        cl_event* out_event = nullptr);
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Утилиты
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Рассчитать задержки лучей по углам LFMParameters
+     * @return Вектор τ_b (секунды), размер = num_beams
+     */
+    static std::vector<double> ComputeBeamDelays(const LFMParameters& params);
+
+    /**
+     * @brief Эталонная генерация на CPU (double) — для тестов
+     */
+    static std::vector<std::complex<float>> GenerateReferenceCPU(
+        const LFMParameters& params,
+        const std::vector<double>& beam_delays_s,
+        float amplitude = 1.0f);
+
+    /**
+     * @brief Используется ли double для фазы (cl_khr_fp64)
+     */
+    bool UsesDoublePrecision() const { return use_double_; }
+
+private:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Члены класса
+    // ═══════════════════════════════════════════════════════════════════════
+
+    IBackend* backend_;         ///< Указатель на бэкенд (не владеет)
+    bool initialized_;          ///< Флаг инициализации
+    bool use_double_;           ///< Фаза в double (fp64 поддерживается)
+
+    // OpenCL объекты
+    cl_program program_;        ///< Скомпилированная программа
+    cl_kernel kernel_generate_; ///< Kernel: lfm_generate
+
+    cl_context context_;        ///< Кэш контекста
+    cl_device_id device_;       ///< Кэш устройства
+    cl_command_queue queue_;    ///< Кэш очереди команд
+
+    cl_mem delay_buffer_;       ///< Задержки лучей на GPU (переиспользуется)
+    size_t delay_capacity_;     ///< Ёмкость delay_buffer_ (лучей)
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Приватные методы
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Загрузить задержки в delay_buffer_ (с перевыделением при росте)
+     */
+    void UploadDelays(const std::vector<double>& beam_delays_s);
+
+    void CompileKernels();
+    void ReleaseKernels();
+
+    /**
+     * @brief Загрузить исходный код kernel из файла
+     * @param filename Имя файла (напр., "lfm_generator.cl")
+     */
+    std::string LoadKernelSource(const std::string& filename);
+};
+
+} // namespace drv_gpu_lib
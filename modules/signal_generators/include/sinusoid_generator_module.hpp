@@ -0,0 +1,204 @@
+#pragma once
+
+/**
+ * @file sinusoid_generator_module.hpp
+ * @brief Sinusoid Generator Module - суммы синусоид по лучам (RaySinusoidMap) на GPU
+ *
+ * Реализует IComputeModule интерфейс:
+ * - Сцена (RaySinusoidMap) упаковывается в компактный буфер параметров один раз
+ * - Все лучи генерируются одним kernel
+ * - Опционально аддитивный гауссов шум (counter-based RNG Philox2x32-10)
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "i_compute_module.hpp"
+#include "i_backend.hpp"
+#include "memory/gpu_buffer.hpp"
+#include "interface/lfm_parameters.h"
+#include <CL/cl.h>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+namespace drv_gpu_lib {
+
+// ════════════════════════════════════════════════════════════════════════════
+// Упакованная сцена
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @struct PackedTone
+ * @brief Один тон в GPU раскладке (16 байт, как SinusoidTone в kernel)
+ *
+ * Фаза считается в фиксированной точке: n · cycles_step по модулю 2^64 —
+ * дробная часть числа циклов без потери точности при любом n.
+ * В float произведение n · (1/period) теряет точность само по себе
+ * (при n = 10^6 шаг float ≈ 0.03 цикла).
+ */
+struct PackedTone {
+    float amplitude = 0.0f;
+    float phase_rad = 0.0f;
+    uint64_t cycles_step = 0;           ///< Циклов на отсчёт, дробь 2^-64
+};
+
+static_assert(sizeof(PackedTone) == 16, "PackedTone must match SinusoidTone in sinusoid_generator.cl");
+
+/**
+ * @struct PackedSinusoidScene
+ * @brief RaySinusoidMap в CSR раскладке (как в GPU буферах)
+ *
+ * Тоны луча r: tones[ray_offsets[r] .. ray_offsets[r+1]).
+ */
+struct PackedSinusoidScene {
+    uint32_t num_rays = 0;
+    uint32_t count_points = 0;
+    std::vector<uint32_t> ray_offsets;  ///< num_rays + 1
+    std::vector<PackedTone> tones;
+
+    size_t GetToneCount() const { return tones.size(); }
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// Class: SinusoidGeneratorModule
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class SinusoidGeneratorModule
+ * @brief Compute модуль генерации многотональных сцен
+ *
+ * s_r[n] = Σ_k A_k · exp(j·(2π·n / period_k + φ_k)) + σ·(N(0,1) + j·N(0,1))
+ *
+ * Лучи, отсутствующие в RaySinusoidMap, содержат только шум (или нули).
+ * Ключи map вне [0, num_rays) игнорируются.
+ *
+ * Шум детерминирован: одинаковый seed → одинаковый кадр. Для новых
+ * кадров достаточно менять старшее слово seed (номер кадра).
+ *
+ * Использование:
+ * @code
+ * SinusoidGeneratorModule gen(backend);
+ * gen.Initialize();
+ * gen.SetScene(ray_map, SinusoidGenParams(64, 4000));   // один раз
+ * for (uint32_t frame = 0; ...; ++frame) {
+ *     gen.Generate(signal, 0.1f, (uint64_t(frame) << 32) | 42);
+ * }
+ * @endcode
+ */
+class SinusoidGeneratorModule : public IComputeModule {
+public:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Конструктор и деструктор
+    // ═══════════════════════════════════════════════════════════════════════
+
+    explicit SinusoidGeneratorModule(IBackend* backend);
+    ~SinusoidGeneratorModule() override;
+
+    SinusoidGeneratorModule(const SinusoidGeneratorModule&) = delete;
+    SinusoidGeneratorModule& operator=(const SinusoidGeneratorModule&) = delete;
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Реализация IComputeModule
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void Initialize() override;
+    bool IsInitialized() const override { return initialized_; }
+    void Cleanup() override;
+
+    std::string GetName() const override { return "SinusoidGenerator"; }
+    std::string GetVersion() const override { return "1.0.0"; }
+    std::string GetDescription() const override {
+        return "Per-ray multi-tone synthesis with counter-based noise";
+    }
+
+    IBackend* GetBackend() const override { return backend_; }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Сцена
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Упаковать RaySinusoidMap в CSR раскладку
+     * @throws std::invalid_argument если period <= 0
+     */
+    static PackedSinusoidScene PackScene(
+        const RaySinusoidMap& ray_map,
+        const SinusoidGenParams& gen_params);
+
+    /**
+     * @brief Упаковать и загрузить сцену на GPU (переиспользуется между Generate)
+     */
+    void SetScene(const RaySinusoidMap& ray_map, const SinusoidGenParams& gen_params);
+
+    /**
+     * @brief Загрузить уже упакованную сцену
+     */
+    void SetScene(const PackedSinusoidScene& scene);
+
+    const PackedSinusoidScene& GetScene() const { return scene_; }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Генерация
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Сгенерировать все лучи текущей сцены (блокирующий)
+     *
+     * @param output      Буфер не меньше num_rays * count_points
+     * @param noise_sigma СКО шума на компоненту (0 — без шума)
+     * @param seed        Seed RNG: младшее слово — ключ, старшее — номер кадра
+     */
+    void Generate(
+        std::shared_ptr<GPUBuffer<std::complex<float>>> output,
+        float noise_sigma = 0.0f,
+        uint64_t seed = 0);
+
+    /**
+     * @brief Поставить генерацию в очередь (без ожидания)
+     * @param out_event [out] Событие завершения (опционально, освобождает вызывающий)
+     */
+    void GenerateAsync(
+        cl_mem output,
+        float noise_sigma = 0.0f,
+        uint64_t seed = 0,
+        cl_event* out_event = nullptr);
+
+    /**
+     * @brief Эталонная генерация на CPU (без шума) — для тестов
+     */
+    static std::vector<std::complex<float>> GenerateReferenceCPU(
+        const PackedSinusoidScene& scene);
+
+private:
+    // ═══════════════════════════════════════════════════════════════════════
+    // Члены класса
+    // ═══════════════════════════════════════════════════════════════════════
+
+    IBackend* backend_;         ///< Указатель на бэкенд (не владеет)
+    bool initialized_;          ///< Флаг инициализации
+
+    cl_program program_;        ///< Скомпилированная программа
+    cl_kernel kernel_generate_; ///< Kernel: sinusoid_generate
+
+    cl_context context_;        ///< Кэш контекста
+    cl_device_id device_;       ///< Кэш устройства
+    cl_command_queue queue_;    ///< Кэш очереди команд
+
+    PackedSinusoidScene scene_; ///< Текущая сцена (host копия)
+    cl_mem offsets_buffer_;     ///< ray_offsets на GPU
+    cl_mem tones_buffer_;       ///< tones на GPU
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Приватные методы
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void ReleaseSceneBuffers();
+    void CompileKernels();
+    void ReleaseKernels();
+    std::string LoadKernelSource(const std::string& filename);
+};
+
+} // namespace drv_gpu_lib
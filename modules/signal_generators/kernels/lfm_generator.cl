@@ -0,0 +1,69 @@
+/**
+ * @file lfm_generator.cl
+ * @brief OpenCL kernel генерации ЛЧМ (LFM chirp) сигналов по лучам
+ *
+ * s_b[n] = A * exp(j * 2π * (f_start * t + 0.5 * k * t^2)),  t = n / fs - τ_b
+ *
+ * Раскладка выхода: [луч0: count_points][луч1: count_points]...
+ * (совпадает с входом AntennaFFTProcMax / SpectrumMaximaFinder)
+ *
+ * Точность фазы:
+ * - LFM_USE_DOUBLE (устройство с cl_khr_fp64): фаза накапливается в double,
+ *   в float переводится только дробная часть числа периодов → нет дрейфа
+ * - иначе float с той же редукцией (для длинных сигналов возможен дрейф)
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#ifdef LFM_USE_DOUBLE
+#pragma OPENCL EXTENSION cl_khr_fp64 : enable
+typedef double real_t;
+#else
+typedef float real_t;
+#endif
+
+// ════════════════════════════════════════════════════════════════════════════
+// Генерация ЛЧМ для всех лучей
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Сгенерировать ЛЧМ сигнал для всех лучей
+ *
+ * NDRange: (count_points, num_beams), gid0 = отсчёт, gid1 = луч
+ *
+ * @param output          Выход [num_beams × count_points] complex<float>
+ * @param beam_delay_s    Задержка τ_b каждого луча (секунды)
+ * @param num_beams       Количество лучей
+ * @param count_points    Отсчётов на луч
+ * @param f_start         Начальная частота (Гц)
+ * @param chirp_rate      Скорость ЛЧМ k = (f_stop - f_start) / duration (Гц/с)
+ * @param inv_sample_rate 1 / fs (с)
+ * @param amplitude       Амплитуда
+ */
+__kernel void lfm_generate(
+    __global float2* output,
+    __global const real_t* beam_delay_s,
+    const uint num_beams,
+    const uint count_points,
+    const real_t f_start,
+    const real_t chirp_rate,
+    const real_t inv_sample_rate,
+    const float amplitude)
+{
+    uint n = get_global_id(0);
+    uint beam = get_global_id(1);
+
+    if (n >= count_points || beam >= num_beams) return;
+
+    real_t t = (real_t)n * inv_sample_rate - beam_delay_s[beam];
+
+    // Фаза в периодах: f0*t + k*t^2/2
+    real_t cycles = t * (f_start + (real_t)0.5 * chirp_rate * t);
+    real_t frac = cycles - floor(cycles);
+
+    float c;
+    float s = sincos((float)frac * 6.28318530717958647f, &c);
+
+    output[(size_t)beam * count_points + n] = (float2)(amplitude * c, amplitude * s);
+}
@@ -0,0 +1,115 @@
+/**
+ * @file sinusoid_generator.cl
+ * @brief OpenCL kernel генерации суммы синусоид по лучам (RaySinusoidMap)
+ *
+ * s_r[n] = Σ_k A_k * exp(j * (2π * n / period_k + φ_k)) + шум
+ *
+ * Параметры сцены упакованы компактно (CSR):
+ * - ray_offsets[num_rays + 1] — диапазон тонов луча r: [ray_offsets[r], ray_offsets[r+1])
+ * - tones[] SinusoidTone = {amplitude, phase_rad, cycles_step}
+ *
+ * Фаза в фиксированной точке: cycles_step — циклов на отсчёт (1/period) как
+ * дробь 2^-64, n · cycles_step по модулю 2^64 — точная дробная часть числа
+ * циклов при любом n. В float уже само произведение n · (1/period) теряет
+ * точность (n = 10^6: шаг float ≈ 0.03 цикла ≈ 0.2 рад).
+ *
+ * Шум: counter-based RNG Philox2x32-10 (counter = индекс отсчёта, key = seed)
+ * → воспроизводим, не требует состояния, одинаков при любом NDRange.
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#define PHILOX_M2x32  0xD256D193u
+#define PHILOX_W32    0x9E3779B9u
+#define TWO_PI        6.28318530717958647f
+#define INV_2_32      2.3283064365386963e-10f
+#define INV_2_24      5.9604644775390625e-8f
+
+// Раскладка = PackedTone (sinusoid_generator_module.hpp), 16 байт
+typedef struct {
+    float amplitude;
+    float phase_rad;
+    ulong cycles_step;      // циклов на отсчёт, дробь 2^-64
+} SinusoidTone;
+
+// ════════════════════════════════════════════════════════════════════════════
+// Philox2x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+// ════════════════════════════════════════════════════════════════════════════
+
+inline uint2 philox2x32_10(uint2 ctr, uint key) {
+    for (int i = 0; i < 10; ++i) {
+        uint hi = mul_hi(PHILOX_M2x32, ctr.x);
+        uint lo = PHILOX_M2x32 * ctr.x;
+        ctr = (uint2)(hi ^ key ^ ctr.y, lo);
+        key += PHILOX_W32;
+    }
+    return ctr;
+}
+
+// Box-Muller: два равномерных uint → комплексный N(0, 1) на компоненту
+inline float2 gaussian2(uint2 r) {
+    float u1 = ((float)r.x + 1.0f) * INV_2_32;   // (0, 1]
+    float u2 = (float)r.y * INV_2_32;            // [0, 1)
+    float rad = sqrt(-2.0f * log(u1));
+    float c;
+    float s = sincos(TWO_PI * u2, &c);
+    return (float2)(rad * c, rad * s);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Генерация всех лучей
+// ════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Сумма синусоид + шум для всех лучей
+ *
+ * NDRange: (count_points, num_rays), gid0 = отсчёт, gid1 = луч
+ *
+ * @param output       Выход [num_rays × count_points] complex<float>
+ * @param ray_offsets  CSR смещения тонов (num_rays + 1)
+ * @param tones        Тоны {A, phase_rad, cycles_step}
+ * @param num_rays     Количество лучей
+ * @param count_points Отсчётов на луч
+ * @param noise_sigma  СКО шума на компоненту (0 — без шума)
+ * @param seed_lo      Ключ Philox
+ * @param seed_hi      Старшее слово counter (номер кадра и т.п.)
+ */
+__kernel void sinusoid_generate(
+    __global float2* output,
+    __global const uint* ray_offsets,
+    __global const SinusoidTone* tones,
+    const uint num_rays,
+    const uint count_points,
+    const float noise_sigma,
+    const uint seed_lo,
+    const uint seed_hi)
+{
+    uint n = get_global_id(0);
+    uint ray = get_global_id(1);
+
+    if (n >= count_points || ray >= num_rays) return;
+
+    uint first = ray_offsets[ray];
+    uint last = ray_offsets[ray + 1];
+
+    float2 acc = (float2)(0.0f, 0.0f);
+    for (uint k = first; k < last; ++k) {
+        SinusoidTone tone = tones[k];
+        // Дробная часть циклов: n · step mod 2^64, старшие 24 бита → float [0, 1)
+        ulong phase_fx = (ulong)n * tone.cycles_step;
+        float cycles = (float)(uint)(phase_fx >> 40) * INV_2_24;
+        float c;
+        float s = sincos(TWO_PI * cycles + tone.phase_rad, &c);
+        acc += tone.amplitude * (float2)(c, s);
+    }
+
+    size_t idx = (size_t)ray * count_points + n;
+
+    if (noise_sigma > 0.0f) {
+        uint2 r = philox2x32_10((uint2)((uint)idx, seed_hi), seed_lo);
+        acc += noise_sigma * gaussian2(r);
+    }
+
+    output[idx] = acc;
+}
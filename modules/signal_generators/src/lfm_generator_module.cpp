@@ -0,0 +1,380 @@
+#include "lfm_generator_module.hpp"
+#include "logger/logger.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cmath>
+
+// Определено в CMakeLists.txt
+#ifndef SIGNAL_GEN_KERNELS_PATH
+#define SIGNAL_GEN_KERNELS_PATH "kernels"
+#endif
+
+namespace drv_gpu_lib {
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+constexpr size_t kLocalSize = 256;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Конструктор и деструктор
+// ════════════════════════════════════════════════════════════════════════════
+
+LFMGeneratorModule::LFMGeneratorModule(IBackend* backend)
+    : backend_(backend)
+    , initialized_(false)
+    , use_double_(false)
+    , program_(nullptr)
+    , kernel_generate_(nullptr)
+    , context_(nullptr)
+    , device_(nullptr)
+    , queue_(nullptr)
+    , delay_buffer_(nullptr)
+    , delay_capacity_(0)
+{
+    if (!backend_) {
+        throw std::invalid_argument("LFMGeneratorModule: backend cannot be null");
+    }
+
+    DRVGPU_LOG_INFO("LFMGeneratorModule", "Created (not initialized)");
+}
+
+LFMGeneratorModule::~LFMGeneratorModule() {
+    Cleanup();
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Жизненный цикл
+// ════════════════════════════════════════════════════════════════════════════
+
+void LFMGeneratorModule::Initialize() {
+    if (initialized_) {
+        DRVGPU_LOG_WARNING("LFMGeneratorModule", "Already initialized");
+        return;
+    }
+
+    DRVGPU_LOG_INFO("LFMGeneratorModule", "Initializing...");
+
+    context_ = static_cast<cl_context>(backend_->GetNativeContext());
+    device_ = static_cast<cl_device_id>(backend_->GetNativeDevice());
+    queue_ = static_cast<cl_command_queue>(backend_->GetNativeQueue());
+
+    if (!context_ || !device_ || !queue_) {
+        throw std::runtime_error("LFMGeneratorModule: Invalid OpenCL handles from backend");
+    }
+
+    use_double_ = backend_->SupportsDoublePrecision();
+    if (!use_double_) {
+        DRVGPU_LOG_WARNING("LFMGeneratorModule",
+            "fp64 not supported - phase accumulated in float (drift on long chirps)");
+    }
+
+    CompileKernels();
+
+    initialized_ = true;
+    DRVGPU_LOG_INFO("LFMGeneratorModule", "Initialized successfully ✅");
+}
+
+void LFMGeneratorModule::Cleanup() {
+    if (!initialized_) {
+        return;
+    }
+
+    DRVGPU_LOG_INFO("LFMGeneratorModule", "Cleanup...");
+
+    ReleaseKernels();
+
+    if (delay_buffer_) {
+        clReleaseMemObject(delay_buffer_);
+        delay_buffer_ = nullptr;
+        delay_capacity_ = 0;
+    }
+
+    initialized_ = false;
+    DRVGPU_LOG_INFO("LFMGeneratorModule", "Cleanup complete");
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Генерация
+// ════════════════════════════════════════════════════════════════════════════
+
+void LFMGeneratorModule::Generate(
+    const LFMParameters& params,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> output,
+    float amplitude)
+{
+    Generate(params, ComputeBeamDelays(params), output, amplitude);
+}
+
+void LFMGeneratorModule::Generate(
+    const LFMParameters& params,
+    const std::vector<double>& beam_delays_s,
+    std::shared_ptr<GPUBuffer<std::complex<float>>> output,
+    float amplitude)
+{
+    if (!output) {
+        throw std::invalid_argument("LFMGeneratorModule::Generate - output buffer is null");
+    }
+    if (!params.IsValid()) {
+        throw std::invalid_argument("LFMGeneratorModule::Generate - invalid LFMParameters");
+    }
+    if (output->GetNumElements() < params.num_beams * params.count_points) {
+        throw std::invalid_argument("LFMGeneratorModule::Generate - output buffer too small");
+    }
+
+    GenerateAsync(params, beam_delays_s,
+                  static_cast<cl_mem>(output->GetPtr()), amplitude, nullptr);
+
+    clFinish(queue_); // Ждём завершения
+}
+
+void LFMGeneratorModule::GenerateAsync(
+    const LFMParameters& params,
+    const std::vector<double>& beam_delays_s,
+    cl_mem output,
+    float amplitude,
+    cl_event* out_event)
+{
+    if (!initialized_) {
+        throw std::runtime_error("LFMGeneratorModule: not initialized");
+    }
+    if (!params.IsValid()) {
+        throw std::invalid_argument("LFMGeneratorModule::GenerateAsync - invalid LFMParameters");
+    }
+    if (beam_delays_s.size() != params.num_beams) {
+        throw std::invalid_argument(
+            "LFMGeneratorModule::GenerateAsync - beam_delays_s.size() != num_beams");
+    }
+
+    UploadDelays(beam_delays_s);
+
+    // Параметры ЛЧМ считаются в double (duration в LFMParameters — float)
+    const double fs = static_cast<double>(params.sample_rate);
+    const double duration = static_cast<double>(params.count_points) / fs;
+    const double f_start = static_cast<double>(params.f_start);
+    const double chirp_rate = (static_cast<double>(params.f_stop) - f_start) / duration;
+    const double inv_fs = 1.0 / fs;
+
+    cl_uint num_beams = static_cast<cl_uint>(params.num_beams);
+    cl_uint count_points = static_cast<cl_uint>(params.count_points);
+
+    cl_int err;
+    err = clSetKernelArg(kernel_generate_, 0, sizeof(cl_mem), &output);
+    err |= clSetKernelArg(kernel_generate_, 1, sizeof(cl_mem), &delay_buffer_);
+    err |= clSetKernelArg(kernel_generate_, 2, sizeof(cl_uint), &num_beams);
+    err |= clSetKernelArg(kernel_generate_, 3, sizeof(cl_uint), &count_points);
+
+    if (use_double_) {
+        err |= clSetKernelArg(kernel_generate_, 4, sizeof(cl_double), &f_start);
+        err |= clSetKernelArg(kernel_generate_, 5, sizeof(cl_double), &chirp_rate);
+        err |= clSetKernelArg(kernel_generate_, 6, sizeof(cl_double), &inv_fs);
+    } else {
+        cl_float f_start_f = static_cast<cl_float>(f_start);
+        cl_float chirp_rate_f = static_cast<cl_float>(chirp_rate);
+        cl_float inv_fs_f = static_cast<cl_float>(inv_fs);
+        err |= clSetKernelArg(kernel_generate_, 4, sizeof(cl_float), &f_start_f);
+        err |= clSetKernelArg(kernel_generate_, 5, sizeof(cl_float), &chirp_rate_f);
+        err |= clSetKernelArg(kernel_generate_, 6, sizeof(cl_float), &inv_fs_f);
+    }
+    err |= clSetKernelArg(kernel_generate_, 7, sizeof(cl_float), &amplitude);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("LFMGeneratorModule::GenerateAsync - Failed to set kernel args");
+    }
+
+    // 2D NDRange: (отсчёты, лучи)
+    size_t global_size[2] = {
+        ((params.count_points + kLocalSize - 1) / kLocalSize) * kLocalSize,
+        params.num_beams
+    };
+    size_t local_size[2] = { kLocalSize, 1 };
+
+    err = clEnqueueNDRangeKernel(queue_, kernel_generate_, 2, nullptr,
+                                 global_size, local_size, 0, nullptr, out_event);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("LFMGeneratorModule::GenerateAsync - Failed to enqueue kernel");
+    }
+}
+
+void LFMGeneratorModule::UploadDelays(const std::vector<double>& beam_delays_s) {
+    const size_t elem_size = use_double_ ? sizeof(cl_double) : sizeof(cl_float);
+
+    if (beam_delays_s.size() > delay_capacity_) {
+        if (delay_buffer_) {
+            clReleaseMemObject(delay_buffer_);
+            delay_buffer_ = nullptr;
+        }
+        cl_int err;
+        delay_buffer_ = clCreateBuffer(context_, CL_MEM_READ_ONLY,
+                                       beam_delays_s.size() * elem_size, nullptr, &err);
+        if (err != CL_SUCCESS || !delay_buffer_) {
+            delay_capacity_ = 0;
+            throw std::runtime_error("LFMGeneratorModule: Failed to allocate delay buffer");
+        }
+        delay_capacity_ = beam_delays_s.size();
+    }
+
+    // Блокирующая запись: host вектор может быть временным
+    cl_int err;
+    if (use_double_) {
+        err = clEnqueueWriteBuffer(queue_, delay_buffer_, CL_TRUE, 0,
+                                   beam_delays_s.size() * elem_size,
+                                   beam_delays_s.data(), 0, nullptr, nullptr);
+    } else {
+        std::vector<float> delays_f(beam_delays_s.begin(), beam_delays_s.end());
+        err = clEnqueueWriteBuffer(queue_, delay_buffer_, CL_TRUE, 0,
+                                   delays_f.size() * elem_size,
+                                   delays_f.data(), 0, nullptr, nullptr);
+    }
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("LFMGeneratorModule: Failed to upload beam delays");
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Утилиты
+// ════════════════════════════════════════════════════════════════════════════
+
+std::vector<double> LFMGeneratorModule::ComputeBeamDelays(const LFMParameters& params) {
+    std::vector<double> delays(params.num_beams, 0.0);
+
+    // d = λ/2  →  d / c = 1 / (2 * f_center)
+    const double f_center = 0.5 * (static_cast<double>(params.f_start) +
+                                   static_cast<double>(params.f_stop));
+    if (f_center <= 0.0) {
+        return delays;
+    }
+    const double d_over_c = 0.5 / f_center;
+    const double deg2rad = kPi / 180.0;
+
+    const bool has_angle_grid = (params.angle_stop_deg != params.angle_start_deg);
+
+    for (size_t b = 0; b < params.num_beams; ++b) {
+        if (has_angle_grid) {
+            double theta = (params.angle_start_deg + b * static_cast<double>(params.angle_step_deg))
+                           * deg2rad;
+            delays[b] = d_over_c * std::sin(theta);
+        } else {
+            delays[b] = static_cast<double>(b) * d_over_c *
+                        std::sin(params.steering_angle * deg2rad);
+        }
+    }
+    return delays;
+}
+
+std::vector<std::complex<float>> LFMGeneratorModule::GenerateReferenceCPU(
+    const LFMParameters& params,
+    const std::vector<double>& beam_delays_s,
+    float amplitude)
+{
+    if (!params.IsValid() || beam_delays_s.size() != params.num_beams) {
+        throw std::invalid_argument("LFMGeneratorModule::GenerateReferenceCPU - invalid params");
+    }
+
+    const double fs = static_cast<double>(params.sample_rate);
+    const double duration = static_cast<double>(params.count_points) / fs;
+    const double f_start = static_cast<double>(params.f_start);
+    const double chirp_rate = (static_cast<double>(params.f_stop) - f_start) / duration;
+
+    std::vector<std::complex<float>> result(params.num_beams * params.count_points);
+
+    for (size_t b = 0; b < params.num_beams; ++b) {
+        for (size_t n = 0; n < params.count_points; ++n) {
+            double t = static_cast<double>(n) / fs - beam_delays_s[b];
+            double cycles = t * (f_start + 0.5 * chirp_rate * t);
+            double phase = 2.0 * kPi * (cycles - std::floor(cycles));
+            result[b * params.count_points + n] = std::complex<float>(
+                static_cast<float>(amplitude * std::cos(phase)),
+                static_cast<float>(amplitude * std::sin(phase)));
+        }
+    }
+    return result;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Компиляция kernels
+// ════════════════════════════════════════════════════════════════════════════
+
+void LFMGeneratorModule::CompileKernels() {
+    std::string kernel_source = LoadKernelSource("lfm_generator.cl");
+
+    const char* source_ptr = kernel_source.c_str();
+    size_t source_size = kernel_source.size();
+
+    cl_int err;
+    program_ = clCreateProgramWithSource(context_, 1, &source_ptr, &source_size, &err);
+
+    if (err != CL_SUCCESS || !program_) {
+        throw std::runtime_error("LFMGeneratorModule: Failed to create program");
+    }
+
+    const char* options = use_double_ ? "-D LFM_USE_DOUBLE" : "";
+    err = clBuildProgram(program_, 1, &device_, options, nullptr, nullptr);
+
+    if (err != CL_SUCCESS) {
+        size_t log_size;
+        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+
+        std::vector<char> log(log_size);
+        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, log_size, log.data(), nullptr);
+
+        DRVGPU_LOG_ERROR("LFMGeneratorModule", "Kernel compilation failed:");
+        DRVGPU_LOG_ERROR("LFMGeneratorModule", std::string(log.data()));
+
+        clReleaseProgram(program_);
+        program_ = nullptr;
+
+        throw std::runtime_error("LFMGeneratorModule: Kernel compilation failed");
+    }
+
+    kernel_generate_ = clCreateKernel(program_, "lfm_generate", &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create kernel: lfm_generate");
+    }
+
+    DRVGPU_LOG_INFO("LFMGeneratorModule",
+        std::string("Kernels compiled successfully ✅ (phase: ") +
+        (use_double_ ? "double" : "float") + ")");
+}
+
+void LFMGeneratorModule::ReleaseKernels() {
+    if (kernel_generate_) {
+        clReleaseKernel(kernel_generate_);
+        kernel_generate_ = nullptr;
+    }
+    if (program_) {
+        clReleaseProgram(program_);
+        program_ = nullptr;
+    }
+}
+
+std::string LFMGeneratorModule::LoadKernelSource(const std::string& filename) {
+    std::vector<std::string> search_paths = {
+        std::string(SIGNAL_GEN_KERNELS_PATH) + "/" + filename,
+        "modules/signal_generators/kernels/" + filename,
+        "../modules/signal_generators/kernels/" + filename,
+        "../../modules/signal_generators/kernels/" + filename
+    };
+
+    for (const auto& path : search_paths) {
+        std::ifstream file(path);
+        if (file.is_open()) {
+            DRVGPU_LOG_DEBUG("LFMGeneratorModule", "Kernel loaded from: " + path);
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            return buffer.str();
+        }
+    }
+
+    DRVGPU_LOG_ERROR("LFMGeneratorModule", "Failed to load kernel: " + filename);
+    for (const auto& path : search_paths) {
+        DRVGPU_LOG_ERROR("LFMGeneratorModule", "  - " + path);
+    }
+
+    throw std::runtime_error("LFMGeneratorModule: Failed to load kernel source: " + filename);
+}
+
+} // namespace drv_gpu_lib
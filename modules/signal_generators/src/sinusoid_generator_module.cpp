@@ -0,0 +1,370 @@
+#include "sinusoid_generator_module.hpp"
+#include "logger/logger.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+// Определено в CMakeLists.txt
+#ifndef SIGNAL_GEN_KERNELS_PATH
+#define SIGNAL_GEN_KERNELS_PATH "kernels"
+#endif
+
+namespace drv_gpu_lib {
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+constexpr size_t kLocalSize = 256;
+
+/// Дробная часть числа циклов → 64-битная дробь (как DechirpReference::ToFixedCycles)
+uint64_t ToFixedCycles(double cycles) {
+    double frac = cycles - std::floor(cycles);       // [0, 1)
+    double scaled_hi = std::ldexp(frac, 32);
+    double hi = std::floor(scaled_hi);
+    double lo = std::floor(std::ldexp(scaled_hi - hi, 32));
+    return (static_cast<uint64_t>(hi) << 32) | static_cast<uint64_t>(lo);
+}
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Конструктор и деструктор
+// ════════════════════════════════════════════════════════════════════════════
+
+SinusoidGeneratorModule::SinusoidGeneratorModule(IBackend* backend)
+    : backend_(backend)
+    , initialized_(false)
+    , program_(nullptr)
+    , kernel_generate_(nullptr)
+    , context_(nullptr)
+    , device_(nullptr)
+    , queue_(nullptr)
+    , offsets_buffer_(nullptr)
+    , tones_buffer_(nullptr)
+{
+    if (!backend_) {
+        throw std::invalid_argument("SinusoidGeneratorModule: backend cannot be null");
+    }
+
+    DRVGPU_LOG_INFO("SinusoidGeneratorModule", "Created (not initialized)");
+}
+
+SinusoidGeneratorModule::~SinusoidGeneratorModule() {
+    Cleanup();
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Жизненный цикл
+// ════════════════════════════════════════════════════════════════════════════
+
+void SinusoidGeneratorModule::Initialize() {
+    if (initialized_) {
+        DRVGPU_LOG_WARNING("SinusoidGeneratorModule", "Already initialized");
+        return;
+    }
+
+    DRVGPU_LOG_INFO("SinusoidGeneratorModule", "Initializing...");
+
+    context_ = static_cast<cl_context>(backend_->GetNativeContext());
+    device_ = static_cast<cl_device_id>(backend_->GetNativeDevice());
+    queue_ = static_cast<cl_command_queue>(backend_->GetNativeQueue());
+
+    if (!context_ || !device_ || !queue_) {
+        throw std::runtime_error("SinusoidGeneratorModule: Invalid OpenCL handles from backend");
+    }
+
+    CompileKernels();
+
+    initialized_ = true;
+    DRVGPU_LOG_INFO("SinusoidGeneratorModule", "Initialized successfully ✅");
+}
+
+void SinusoidGeneratorModule::Cleanup() {
+    if (!initialized_) {
+        return;
+    }
+
+    DRVGPU_LOG_INFO("SinusoidGeneratorModule", "Cleanup...");
+
+    ReleaseSceneBuffers();
+    ReleaseKernels();
+    scene_ = PackedSinusoidScene();
+
+    initialized_ = false;
+    DRVGPU_LOG_INFO("SinusoidGeneratorModule", "Cleanup complete");
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Сцена
+// ════════════════════════════════════════════════════════════════════════════
+
+PackedSinusoidScene SinusoidGeneratorModule::PackScene(
+    const RaySinusoidMap& ray_map,
+    const SinusoidGenParams& gen_params)
+{
+    if (gen_params.num_rays == 0 || gen_params.count_points == 0) {
+        throw std::invalid_argument("SinusoidGeneratorModule::PackScene - empty SinusoidGenParams");
+    }
+
+    PackedSinusoidScene scene;
+    scene.num_rays = static_cast<uint32_t>(gen_params.num_rays);
+    scene.count_points = static_cast<uint32_t>(gen_params.count_points);
+    scene.ray_offsets.assign(scene.num_rays + 1, 0);
+
+    for (uint32_t ray = 0; ray < scene.num_rays; ++ray) {
+        scene.ray_offsets[ray] = static_cast<uint32_t>(scene.GetToneCount());
+
+        auto it = ray_map.find(static_cast<int>(ray));
+        if (it == ray_map.end()) {
+            continue;
+        }
+
+        for (const auto& sp : it->second) {
+            if (sp.period <= 0.0f) {
+                throw std::invalid_argument(
+                    "SinusoidGeneratorModule::PackScene - period must be > 0 (ray " +
+                    std::to_string(ray) + ")");
+            }
+            PackedTone tone;
+            tone.amplitude = sp.amplitude;
+            tone.phase_rad = static_cast<float>(sp.phase_deg * kPi / 180.0);
+            tone.cycles_step = ToFixedCycles(1.0 / static_cast<double>(sp.period));
+            scene.tones.push_back(tone);
+        }
+    }
+    scene.ray_offsets[scene.num_rays] = static_cast<uint32_t>(scene.GetToneCount());
+
+    return scene;
+}
+
+void SinusoidGeneratorModule::SetScene(
+    const RaySinusoidMap& ray_map,
+    const SinusoidGenParams& gen_params)
+{
+    SetScene(PackScene(ray_map, gen_params));
+}
+
+void SinusoidGeneratorModule::SetScene(const PackedSinusoidScene& scene) {
+    if (!initialized_) {
+        throw std::runtime_error("SinusoidGeneratorModule: not initialized");
+    }
+    if (scene.ray_offsets.size() != static_cast<size_t>(scene.num_rays) + 1) {
+        throw std::invalid_argument("SinusoidGeneratorModule::SetScene - bad ray_offsets size");
+    }
+
+    ReleaseSceneBuffers();
+
+    cl_int err;
+    offsets_buffer_ = clCreateBuffer(context_, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                     scene.ray_offsets.size() * sizeof(cl_uint),
+                                     const_cast<uint32_t*>(scene.ray_offsets.data()), &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("SinusoidGeneratorModule: Failed to create offsets buffer");
+    }
+
+    // Пустая сцена (только шум) — буфер на один тон, kernel к нему не обращается
+    std::vector<PackedTone> tones = scene.tones;
+    if (tones.empty()) {
+        tones.resize(1);
+    }
+    tones_buffer_ = clCreateBuffer(context_, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                   tones.size() * sizeof(PackedTone), tones.data(), &err);
+    if (err != CL_SUCCESS) {
+        ReleaseSceneBuffers();
+        throw std::runtime_error("SinusoidGeneratorModule: Failed to create tones buffer");
+    }
+
+    scene_ = scene;
+
+    DRVGPU_LOG_DEBUG("SinusoidGeneratorModule",
+        "Scene: " + std::to_string(scene_.num_rays) + " rays, " +
+        std::to_string(scene_.GetToneCount()) + " tones");
+}
+
+void SinusoidGeneratorModule::ReleaseSceneBuffers() {
+    if (offsets_buffer_) {
+        clReleaseMemObject(offsets_buffer_);
+        offsets_buffer_ = nullptr;
+    }
+    if (tones_buffer_) {
+        clReleaseMemObject(tones_buffer_);
+        tones_buffer_ = nullptr;
+    }
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Генерация
+// ════════════════════════════════════════════════════════════════════════════
+
+void SinusoidGeneratorModule::Generate(
+    std::shared_ptr<GPUBuffer<std::complex<float>>> output,
+    float noise_sigma,
+    uint64_t seed)
+{
+    if (!output) {
+        throw std::invalid_argument("SinusoidGeneratorModule::Generate - output buffer is null");
+    }
+    if (output->GetNumElements() <
+        static_cast<size_t>(scene_.num_rays) * scene_.count_points) {
+        throw std::invalid_argument("SinusoidGeneratorModule::Generate - output buffer too small");
+    }
+
+    GenerateAsync(static_cast<cl_mem>(output->GetPtr()), noise_sigma, seed, nullptr);
+
+    clFinish(queue_); // Ждём завершения
+}
+
+void SinusoidGeneratorModule::GenerateAsync(
+    cl_mem output,
+    float noise_sigma,
+    uint64_t seed,
+    cl_event* out_event)
+{
+    if (!initialized_) {
+        throw std::runtime_error("SinusoidGeneratorModule: not initialized");
+    }
+    if (!offsets_buffer_ || !tones_buffer_) {
+        throw std::runtime_error("SinusoidGeneratorModule: scene not set (call SetScene)");
+    }
+
+    cl_uint num_rays = scene_.num_rays;
+    cl_uint count_points = scene_.count_points;
+    cl_float sigma = std::max(noise_sigma, 0.0f);
+    cl_uint seed_lo = static_cast<cl_uint>(seed & 0xFFFFFFFFu);
+    cl_uint seed_hi = static_cast<cl_uint>(seed >> 32);
+
+    cl_int err;
+    err = clSetKernelArg(kernel_generate_, 0, sizeof(cl_mem), &output);
+    err |= clSetKernelArg(kernel_generate_, 1, sizeof(cl_mem), &offsets_buffer_);
+    err |= clSetKernelArg(kernel_generate_, 2, sizeof(cl_mem), &tones_buffer_);
+    err |= clSetKernelArg(kernel_generate_, 3, sizeof(cl_uint), &num_rays);
+    err |= clSetKernelArg(kernel_generate_, 4, sizeof(cl_uint), &count_points);
+    err |= clSetKernelArg(kernel_generate_, 5, sizeof(cl_float), &sigma);
+    err |= clSetKernelArg(kernel_generate_, 6, sizeof(cl_uint), &seed_lo);
+    err |= clSetKernelArg(kernel_generate_, 7, sizeof(cl_uint), &seed_hi);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("SinusoidGeneratorModule::GenerateAsync - Failed to set kernel args");
+    }
+
+    size_t global_size[2] = {
+        ((count_points + kLocalSize - 1) / kLocalSize) * kLocalSize,
+        num_rays
+    };
+    size_t local_size[2] = { kLocalSize, 1 };
+
+    err = clEnqueueNDRangeKernel(queue_, kernel_generate_, 2, nullptr,
+                                 global_size, local_size, 0, nullptr, out_event);
+
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("SinusoidGeneratorModule::GenerateAsync - Failed to enqueue kernel");
+    }
+}
+
+std::vector<std::complex<float>> SinusoidGeneratorModule::GenerateReferenceCPU(
+    const PackedSinusoidScene& scene)
+{
+    std::vector<std::complex<float>> result(
+        static_cast<size_t>(scene.num_rays) * scene.count_points);
+
+    for (uint32_t ray = 0; ray < scene.num_rays; ++ray) {
+        for (uint32_t n = 0; n < scene.count_points; ++n) {
+            std::complex<double> acc(0.0, 0.0);
+            for (uint32_t k = scene.ray_offsets[ray]; k < scene.ray_offsets[ray + 1]; ++k) {
+                const PackedTone& tone = scene.tones[k];
+                // Та же фаза, что в kernel: n · step mod 2^64 (переполнение uint64_t)
+                const uint64_t phase_fx = static_cast<uint64_t>(n) * tone.cycles_step;
+                double phase = 2.0 * kPi * std::ldexp(static_cast<double>(phase_fx), -64) +
+                               tone.phase_rad;
+                acc += static_cast<double>(tone.amplitude) *
+                       std::complex<double>(std::cos(phase), std::sin(phase));
+            }
+            result[static_cast<size_t>(ray) * scene.count_points + n] =
+                std::complex<float>(static_cast<float>(acc.real()),
+                                    static_cast<float>(acc.imag()));
+        }
+    }
+    return result;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Компиляция kernels
+// ════════════════════════════════════════════════════════════════════════════
+
+void SinusoidGeneratorModule::CompileKernels() {
+    std::string kernel_source = LoadKernelSource("sinusoid_generator.cl");
+
+    const char* source_ptr = kernel_source.c_str();
+    size_t source_size = kernel_source.size();
+
+    cl_int err;
+    program_ = clCreateProgramWithSource(context_, 1, &source_ptr, &source_size, &err);
+
+    if (err != CL_SUCCESS || !program_) {
+        throw std::runtime_error("SinusoidGeneratorModule: Failed to create program");
+    }
+
+    err = clBuildProgram(program_, 1, &device_, nullptr, nullptr, nullptr);
+
+    if (err != CL_SUCCESS) {
+        size_t log_size;
+        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+
+        std::vector<char> log(log_size);
+        clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, log_size, log.data(), nullptr);
+
+        DRVGPU_LOG_ERROR("SinusoidGeneratorModule", "Kernel compilation failed:");
+        DRVGPU_LOG_ERROR("SinusoidGeneratorModule", std::string(log.data()));
+
+        clReleaseProgram(program_);
+        program_ = nullptr;
+
+        throw std::runtime_error("SinusoidGeneratorModule: Kernel compilation failed");
+    }
+
+    kernel_generate_ = clCreateKernel(program_, "sinusoid_generate", &err);
+    if (err != CL_SUCCESS) {
+        throw std::runtime_error("Failed to create kernel: sinusoid_generate");
+    }
+
+    DRVGPU_LOG_INFO("SinusoidGeneratorModule", "Kernels compiled successfully ✅");
+}
+
+void SinusoidGeneratorModule::ReleaseKernels() {
+    if (kernel_generate_) {
+        clReleaseKernel(kernel_generate_);
+        kernel_generate_ = nullptr;
+    }
+    if (program_) {
+        clReleaseProgram(program_);
+        program_ = nullptr;
+    }
+}
+
+std::string SinusoidGeneratorModule::LoadKernelSource(const std::string& filename) {
+    std::vector<std::string> search_paths = {
+        std::string(SIGNAL_GEN_KERNELS_PATH) + "/" + filename,
+        "modules/signal_generators/kernels/" + filename,
+        "../modules/signal_generators/kernels/" + filename,
+        "../../modules/signal_generators/kernels/" + filename
+    };
+
+    for (const auto& path : search_paths) {
+        std::ifstream file(path);
+        if (file.is_open()) {
+            DRVGPU_LOG_DEBUG("SinusoidGeneratorModule", "Kernel loaded from: " + path);
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            return buffer.str();
+        }
+    }
+
+    DRVGPU_LOG_ERROR("SinusoidGeneratorModule", "Failed to load kernel: " + filename);
+    for (const auto& path : search_paths) {
+        DRVGPU_LOG_ERROR("SinusoidGeneratorModule", "  - " + path);
+    }
+
+    throw std::runtime_error("SinusoidGeneratorModule: Failed to load kernel source: " + filename);
+}
+
+} // namespace drv_gpu_lib
@@ -0,0 +1,105 @@
+#pragma once
+/**
+ * @file test_lfm_generator.hpp
+ * @brief Тест LFMGeneratorModule: точность GPU против CPU (double) и скорость
+ *
+ * Сценарий: 256 лучей × 8192 точек (типичный кадр тестовых стендов),
+ * сетка углов SetAngle(), сравнение с GenerateReferenceCPU().
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "lfm_generator_module.hpp"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+namespace test_lfm_generator {
+
+using namespace drv_gpu_lib;
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║     TEST: LFMGeneratorModule — ЛЧМ на GPU                ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n";
+
+        auto module = std::make_shared<LFMGeneratorModule>(&gpu.GetBackend());
+        module->Initialize();
+        gpu.GetModuleRegistry().RegisterModule("LFMGenerator", module);
+        std::cout << "  ✅ Фаза: " << (module->UsesDoublePrecision() ? "double" : "float") << "\n\n";
+
+        LFMParameters params;
+        params.f_start = 1.0e6f;
+        params.f_stop = 2.0e6f;
+        params.sample_rate = 12.0e6f;
+        params.num_beams = 256;
+        params.count_points = 8192;
+        params.SetAngle();
+
+        if (!params.IsValid()) {
+            std::cerr << "  ❌ Неверные LFMParameters\n";
+            return 1;
+        }
+
+        const size_t total = params.num_beams * params.count_points;
+        auto delays = LFMGeneratorModule::ComputeBeamDelays(params);
+
+        auto& mem_mgr = gpu.GetMemoryManager();
+        auto gpu_signal = mem_mgr.CreateBuffer<std::complex<float>>(total);
+
+        // Прогрев (JIT), затем измеряемый запуск
+        module->Generate(params, delays, gpu_signal);
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        module->Generate(params, delays, gpu_signal);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        auto gpu_result = gpu_signal->Read();
+
+        auto t2 = std::chrono::high_resolution_clock::now();
+        auto cpu_result = LFMGeneratorModule::GenerateReferenceCPU(params, delays);
+        auto t3 = std::chrono::high_resolution_clock::now();
+
+        float max_error = 0.0f;
+        for (size_t i = 0; i < total; ++i) {
+            max_error = std::max(max_error, std::abs(gpu_result[i] - cpu_result[i]));
+        }
+
+        double gpu_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        double cpu_ms = std::chrono::duration<double, std::milli>(t3 - t2).count();
+
+        std::cout << "  📊 " << params.num_beams << " лучей × " << params.count_points << " точек\n";
+        std::cout << "  Углы: " << params.angle_start_deg << "° … " << params.angle_stop_deg
+                  << "°, шаг " << params.angle_step_deg << "°\n";
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "  GPU: " << gpu_ms << " мс   CPU (double): " << cpu_ms << " мс\n";
+        std::cout << std::scientific << std::setprecision(2);
+        std::cout << "  Макс. ошибка |GPU - CPU|: " << max_error << "\n\n";
+
+        // float sincos от приведённой фазы: ~1e-6; float-фаза без fp64 — грубее
+        const float tolerance = module->UsesDoublePrecision() ? 1.0e-4f : 1.0e-2f;
+        bool passed = max_error < tolerance;
+
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_lfm_generator
@@ -0,0 +1,183 @@
+#pragma once
+/**
+ * @file test_sinusoid_generator.hpp
+ * @brief Тест SinusoidGeneratorModule: многотональная сцена → SpectrumMaximaFinder
+ *
+ * 1. Сцена без шума: сравнение с GenerateReferenceCPU()
+ * 2. Шум: СКО на пустом луче, воспроизводимость по seed
+ * 3. Сцена + шум → SpectrumMaximaFinder: максимум на частоте сильнейшего тона
+ * 4. Длинный сигнал (2^20 отсчётов): фаза в конце луча совпадает с точной
+ *    (фаза в фиксированной точке, без потери точности на больших n)
+ *
+ * @author DrvGPU Team
+ * @date 2026-02-10
+ */
+
+#include "drv_gpu.hpp"
+#include "sinusoid_generator_module.hpp"
+#include "spectrum_maxima_finder.h"
+#include "common/backend_type.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <complex>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+namespace test_sinusoid_generator {
+
+using namespace drv_gpu_lib;
+
+// ════════════════════════════════════════════════════════════════════════════
+// Сцена: на каждом луче сильный тон + 2 слабых, последний луч — только шум
+// ════════════════════════════════════════════════════════════════════════════
+
+inline RaySinusoidMap MakeScene(size_t num_rays) {
+    RaySinusoidMap scene;
+    for (size_t ray = 0; ray + 1 < num_rays; ++ray) {
+        float main_period = 20.0f + 0.5f * static_cast<float>(ray);
+        scene[static_cast<int>(ray)] = {
+            SinusoidParameter(1.0f, main_period, 10.0f * ray),
+            SinusoidParameter(0.3f, 7.3f, 45.0f),
+            SinusoidParameter(0.2f, 113.0f, -30.0f)
+        };
+    }
+    return scene;
+}
+
+inline int run() {
+    try {
+        std::cout << "\n";
+        std::cout << "╔══════════════════════════════════════════════════════════╗\n";
+        std::cout << "║     TEST: SinusoidGeneratorModule — сцены на GPU         ║\n";
+        std::cout << "╚══════════════════════════════════════════════════════════╝\n\n";
+
+        DrvGPU gpu(BackendType::OPENCL, 0);
+        gpu.Initialize();
+        std::cout << "  ✅ GPU: " << gpu.GetDeviceName() << "\n\n";
+
+        auto module = std::make_shared<SinusoidGeneratorModule>(&gpu.GetBackend());
+        module->Initialize();
+        gpu.GetModuleRegistry().RegisterModule("SinusoidGenerator", module);
+
+        SinusoidGenParams gen_params(64, 4000);
+        auto ray_map = MakeScene(gen_params.num_rays);
+        module->SetScene(ray_map, gen_params);
+
+        const size_t total = gen_params.num_rays * gen_params.count_points;
+        auto& mem_mgr = gpu.GetMemoryManager();
+        auto gpu_signal = mem_mgr.CreateBuffer<std::complex<float>>(total);
+
+        bool passed = true;
+
+        // ── 1. Без шума против CPU ─────────────────────────────────────────
+        module->Generate(gpu_signal);
+        auto t0 = std::chrono::high_resolution_clock::now();
+        module->Generate(gpu_signal);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        auto clean = gpu_signal->Read();
+
+        auto reference = SinusoidGeneratorModule::GenerateReferenceCPU(module->GetScene());
+        float max_error = 0.0f;
+        for (size_t i = 0; i < total; ++i) {
+            max_error = std::max(max_error, std::abs(clean[i] - reference[i]));
+        }
+        bool ok1 = max_error < 1.0e-3f;
+        passed &= ok1;
+        std::cout << "  1. Без шума: max|GPU - CPU| = " << std::scientific << std::setprecision(2)
+                  << max_error << std::fixed << std::setprecision(3) << ", GPU "
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " мс  "
+                  << (ok1 ? "✅" : "❌") << "\n";
+
+        // ── 2. Шум: СКО и воспроизводимость ────────────────────────────────
+        const float sigma = 0.1f;
+        const uint64_t seed = (uint64_t(1) << 32) | 42u;
+        module->Generate(gpu_signal, sigma, seed);
+        auto noisy_a = gpu_signal->Read();
+        module->Generate(gpu_signal, sigma, seed);
+        auto noisy_b = gpu_signal->Read();
+
+        // Последний луч — только шум
+        size_t noise_begin = (gen_params.num_rays - 1) * gen_params.count_points;
+        double sum = 0.0, sum_sq = 0.0;
+        for (size_t i = noise_begin; i < total; ++i) {
+            sum += noisy_a[i].real() + noisy_a[i].imag();
+            sum_sq += noisy_a[i].real() * noisy_a[i].real() + noisy_a[i].imag() * noisy_a[i].imag();
+        }
+        double count = 2.0 * gen_params.count_points;
+        double mean = sum / count;
+        double stddev = std::sqrt(sum_sq / count - mean * mean);
+        bool same = std::equal(noisy_a.begin(), noisy_a.end(), noisy_b.begin());
+        bool ok2 = same && std::abs(mean) < 0.01 && std::abs(stddev - sigma) < 0.01;
+        passed &= ok2;
+        std::cout << "  2. Шум: mean = " << std::setprecision(4) << mean
+                  << ", σ = " << stddev << " (ожидалось " << sigma << "), "
+                  << (same ? "воспроизводим" : "НЕ воспроизводим") << "  "
+                  << (ok2 ? "✅" : "❌") << "\n";
+
+        // ── 3. Сцена → SpectrumMaximaFinder ────────────────────────────────
+        antenna_fft::SpectrumParams sp;
+        sp.antenna_count = static_cast<uint32_t>(gen_params.num_rays - 1);
+        sp.n_point = static_cast<uint32_t>(gen_params.count_points);
+        sp.repeat_count = 2;
+        sp.sample_rate = 12.0e6f;
+
+        std::vector<std::complex<float>> finder_input(
+            noisy_a.begin(), noisy_a.begin() + noise_begin);
+
+        antenna_fft::SpectrumMaximaFinder finder(sp, &gpu.GetBackend());
+        finder.Initialize();
+        auto results = finder.Process(finder_input);
+
+        float bin_width = sp.sample_rate / static_cast<float>(finder.GetParams().nFFT);
+        uint32_t wrong = 0;
+        for (const auto& r : results) {
+            float period = ray_map[static_cast<int>(r.antenna_id)][0].period;
+            float expected = sp.sample_rate / period;
+            if (std::abs(r.interpolated.refined_frequency - expected) > bin_width) {
+                wrong++;
+            }
+        }
+        bool ok3 = (wrong == 0);
+        passed &= ok3;
+        std::cout << "  3. SpectrumMaximaFinder: " << (results.size() - wrong) << "/"
+                  << results.size() << " лучей — максимум на основном тоне  "
+                  << (ok3 ? "✅" : "❌") << "\n";
+
+        // ── 4. Фаза на длинном сигнале ─────────────────────────────────────
+        // period = 2.5 → 0.4 цикла на отсчёт; точная дробная часть: (2n mod 5) / 5
+        SinusoidGenParams long_params(1, size_t(1) << 20);
+        RaySinusoidMap long_map;
+        long_map[0] = { SinusoidParameter(1.0f, 2.5f, 0.0f) };
+        module->SetScene(long_map, long_params);
+
+        auto long_signal = mem_mgr.CreateBuffer<std::complex<float>>(long_params.count_points);
+        module->Generate(long_signal);
+        auto long_data = long_signal->Read();
+
+        const double two_pi = 2.0 * 3.14159265358979323846;
+        float long_error = 0.0f;
+        for (size_t n = long_params.count_points - 4096; n < long_params.count_points; ++n) {
+            double phase = two_pi * static_cast<double>((2 * n) % 5) / 5.0;
+            std::complex<float> expected(static_cast<float>(std::cos(phase)),
+                                         static_cast<float>(std::sin(phase)));
+            long_error = std::max(long_error, std::abs(long_data[n] - expected));
+        }
+        bool ok4 = long_error < 1.0e-4f;
+        passed &= ok4;
+        std::cout << "  4. Фаза при n ≈ 10^6: max|GPU - exp(j·2π·0.4·n)| = " << std::scientific
+                  << std::setprecision(2) << long_error << std::fixed << "  "
+                  << (ok4 ? "✅" : "❌") << "\n\n";
+
+        std::cout << "  ИТОГО: " << (passed ? "✅ PASSED" : "❌ FAILED") << "\n\n";
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ ОШИБКА: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+} // namespace test_sinusoid_generator
@@ -4,10 +4,33 @@
 #include "DrvGPU/tests/multi_gpu.hpp"
 #include "DrvGPU/tests/example_external_context_usage.hpp"
 #include "modules/example/tests/test_vector_ops.hpp"
+#include "modules/example/tests/test_vector_expr.hpp"
+#include "modules/example/tests/test_vector_bandwidth.hpp"
+#include "modules/example/tests/test_vector_reduce.hpp"
 //#include "modules/search_maxim/tests/test_antenna_module.hpp"
 //#include "modules/fft_maxima/tests/test_fft_maxima.hpp"
 #include "modules/fft_maxima/tests/test_spectrum_maxima.hpp"
+#include "modules/fft_maxima/tests/test_spectrum_storage.hpp"
+#include "modules/fft_maxima/tests/test_fft_delay.hpp"
+#include "modules/fft_maxima/tests/test_dechirp.hpp"
+#include "modules/fft_maxima/tests/test_matched_filter.hpp"
+#include "modules/fft_maxima/tests/test_fft_plan_cache.hpp"
+#include "modules/fft_maxima/tests/test_fft_warmup.hpp"
+#include "modules/signal_generators/tests/test_lfm_generator.hpp"
+#include "modules/signal_generators/tests/test_sinusoid_generator.hpp"
+#include "modules/fractional_delay/tests/test_fractional_delay.hpp"
+#include "modules/beamformer/tests/test_beamformer.hpp"
+#include "modules/channelizer/tests/test_channelizer.hpp"
 #include "DrvGPU/tests/test_services.hpp"
+#include "DrvGPU/tests/test_svm_buffer.hpp"
+#include "DrvGPU/tests/test_memory_strategy.hpp"
+#include "DrvGPU/tests/test_frame_arena.hpp"
+#include "DrvGPU/tests/test_memory_pressure.hpp"
+#include "DrvGPU/tests/test_memory_tags.hpp"
+#include "DrvGPU/tests/test_allocation_scaling.hpp"
+#include "DrvGPU/tests/test_gpu_manager_init.hpp"
+#include "DrvGPU/tests/test_gpu_config_limits.hpp"
+#include "DrvGPU/tests/test_module_lookup.hpp"
 
 //int main(int argc, char* argv[]) {
 int main() {
@@ -22,12 +45,35 @@ int main() {
 //  external_context_example::run();
 
 //  test_example_mat::run();  
+//  test_vector_expr::run();
+//  test_vector_bandwidth::run();
+//  test_vector_reduce::run();
 //  test_find_3_max::run();
 //  test_fft_max::run();
   test_spectrum_maxima::run();
+//  test_spectrum_storage::run();
+//  test_fft_delay::run();
+//  test_dechirp::run();
+//  test_matched_filter::run();
+//  test_fft_plan_cache::run();
+//  test_fft_warmup::run();
+//  test_lfm_generator::run();
+//  test_sinusoid_generator::run();
+//  test_fractional_delay::run();
+//  test_beamformer::run();
+//  test_channelizer::run();
 
   // Services multithreaded tests
   test_services::run();
+//  test_svm_buffer::run();
+//  test_memory_strategy::run();
+//  test_frame_arena::run();
+//  test_memory_pressure::run();
+//  test_memory_tags::run();
+//  test_allocation_scaling::run();
+//  test_gpu_manager_init::run();
+//  test_gpu_config_limits::run();
+//  test_module_lookup::run();
 
    std::cout << "\n✅ Все тесты завершены!" << std::endl;
   return 0;